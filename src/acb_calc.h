@@ -43,6 +43,7 @@ typedef struct
     slong depth_limit;
     int use_heap;
     int verbose;
+    int use_threads;
 }
 acb_calc_integrate_opt_struct;
 
@@ -63,6 +64,14 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
     const acb_t a, const acb_t b, const mag_t tol,
     slong deg_limit, int verbose, slong prec);
 
+void acb_calc_gl_cache_prewarm(slong deg, slong prec);
+
+void acb_calc_gl_cache_set_limit(slong max_bytes);
+
+void acb_calc_gl_cache_get_stats(slong * hits, slong * misses, slong * size);
+
+void acb_calc_gl_cache_clear(void);
+
 #ifdef __cplusplus
 }
 #endif
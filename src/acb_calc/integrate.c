@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "acb.h"
 #include "arb_calc.h"
 #include "acb_calc.h"
@@ -106,6 +107,304 @@ _acb_overlaps(acb_t tmp, const acb_t a, const acb_t b, slong prec)
     return acb_contains_zero(tmp);
 }
 
+/*
+    Threaded version. The pending subintervals are kept in a heap ordered
+    by error. In each round, up to INTEGRATE_BATCH subintervals with the
+    largest error are taken from the heap; for each of them the
+    Gauss-Legendre rule is attempted and, in case of failure, both halves
+    are evaluated. These tasks run in parallel against the tolerance of
+    the start of the round, and their results are merged in order.
+    The batch size does not depend on the number of threads, so neither
+    does the result.
+*/
+
+#define INTEGRATE_BATCH 64
+
+typedef struct
+{
+    acb_struct a, b, v, u, mid, vl, vr;
+    mag_struct m, ml, mr;
+    int gl_status;
+    slong feval;
+}
+integrate_task_struct;
+
+typedef struct
+{
+    integrate_task_struct * tasks;
+    acb_calc_func_t f;
+    void * param;
+    mag_srcptr tol;
+    slong deg_limit;
+    int verbose;
+    slong prec;
+}
+integrate_work_t;
+
+static void
+integrate_worker(slong i, integrate_work_t * work)
+{
+    integrate_task_struct * task = work->tasks + i;
+    slong prec = work->prec;
+
+    task->gl_status = ARB_CALC_NO_CONVERGENCE;
+    task->feval = 0;
+
+    if (acb_is_finite(&task->v))
+    {
+        task->gl_status = acb_calc_integrate_gl_auto_deg(&task->u,
+            &task->feval, work->f, work->param, &task->a, &task->b,
+            work->tol, work->deg_limit, work->verbose > 1, prec);
+
+        if (task->gl_status == ARB_CALC_SUCCESS)
+            return;
+    }
+
+    acb_add(&task->mid, &task->a, &task->b, prec);
+    acb_mul_2exp_si(&task->mid, &task->mid, -1);
+
+    quad_simple(&task->vl, work->f, work->param, &task->a, &task->mid, prec);
+    mag_hypot(&task->ml, arb_radref(acb_realref(&task->vl)), arb_radref(acb_imagref(&task->vl)));
+
+    quad_simple(&task->vr, work->f, work->param, &task->mid, &task->b, prec);
+    mag_hypot(&task->mr, arb_radref(acb_realref(&task->vr)), arb_radref(acb_imagref(&task->vr)));
+}
+
+static int
+acb_calc_integrate_threaded(acb_t res, acb_calc_func_t f, void * param,
+    const acb_t a, const acb_t b, slong goal, const mag_t tol,
+    slong depth_limit, slong eval_limit, slong deg_limit, int verbose,
+    slong prec)
+{
+    acb_ptr as, bs, vs;
+    mag_ptr ms;
+    acb_t s, u;
+    mag_t tmpm, new_tol;
+    integrate_task_struct * tasks;
+    integrate_work_t work;
+    slong depth, depth_max, eval, k, nb, leaf_interval_count, alloc;
+    int stopping, status;
+
+    status = ARB_CALC_SUCCESS;
+
+    acb_init(s);
+    acb_init(u);
+    mag_init(tmpm);
+    mag_init(new_tol);
+
+    tasks = flint_malloc(INTEGRATE_BATCH * sizeof(integrate_task_struct));
+    for (k = 0; k < INTEGRATE_BATCH; k++)
+    {
+        acb_init(&tasks[k].a);
+        acb_init(&tasks[k].b);
+        acb_init(&tasks[k].v);
+        acb_init(&tasks[k].u);
+        acb_init(&tasks[k].mid);
+        acb_init(&tasks[k].vl);
+        acb_init(&tasks[k].vr);
+        mag_init(&tasks[k].m);
+        mag_init(&tasks[k].ml);
+        mag_init(&tasks[k].mr);
+    }
+
+    alloc = 4;
+    as = _acb_vec_init(alloc);
+    bs = _acb_vec_init(alloc);
+    vs = _acb_vec_init(alloc);
+    ms = _mag_vec_init(alloc);
+
+    /* Compute initial crude estimate for the whole interval. */
+    acb_set(as, a);
+    acb_set(bs, b);
+    quad_simple(vs, f, param, as, bs, prec);
+    mag_hypot(ms, arb_radref(acb_realref(vs)), arb_radref(acb_imagref(vs)));
+
+    depth = depth_max = 1;
+    eval = 1;
+    stopping = 0;
+    leaf_interval_count = 0;
+
+    /* Adjust absolute tolerance based on new information. */
+    acb_get_mag_lower(tmpm, vs);
+    mag_mul_2exp_si(tmpm, tmpm, -goal);
+    mag_max(new_tol, tol, tmpm);
+
+    acb_zero(s);
+
+    work.tasks = tasks;
+    work.f = f;
+    work.param = param;
+    work.tol = new_tol;
+    work.deg_limit = deg_limit;
+    work.verbose = verbose;
+    work.prec = prec;
+
+    while (depth >= 1)
+    {
+        if (stopping == 0 && eval >= eval_limit - 1)
+        {
+            if (verbose > 0)
+                flint_printf("stopping at eval_limit %wd\n", eval_limit);
+            status = ARB_CALC_NO_CONVERGENCE;
+            stopping = 1;
+        }
+
+        /* Take the subintervals with the largest error from the heap. */
+        nb = 0;
+        while (depth >= 1 && nb < INTEGRATE_BATCH)
+        {
+            /* We are done with this subinterval. */
+            if (mag_cmp(ms, new_tol) < 0 ||
+                _acb_overlaps(u, as, bs, prec) || stopping)
+            {
+                acb_add(s, s, vs, prec);
+                leaf_interval_count++;
+            }
+            else
+            {
+                acb_swap(&tasks[nb].a, as);
+                acb_swap(&tasks[nb].b, bs);
+                acb_swap(&tasks[nb].v, vs);
+                mag_swap(&tasks[nb].m, ms);
+                nb++;
+            }
+
+            depth--;
+            if (depth > 0)
+            {
+                acb_swap(as, as + depth);
+                acb_swap(bs, bs + depth);
+                acb_swap(vs, vs + depth);
+                mag_swap(ms, ms + depth);
+                heap_up(as, bs, vs, ms, depth);
+            }
+        }
+
+        if (nb == 0)
+            continue;
+
+        flint_parallel_do((do_func_t) integrate_worker, &work, nb, -1,
+                                                     FLINT_PARALLEL_DYNAMIC);
+
+        for (k = 0; k < nb; k++)
+        {
+            integrate_task_struct * task = tasks + k;
+
+            eval += task->feval;
+
+            /* We are done with this subinterval. */
+            if (task->gl_status == ARB_CALC_SUCCESS)
+            {
+                /* We know that the result is real. */
+                if (acb_is_real(&task->v))
+                    arb_zero(acb_imagref(&task->u));
+
+                acb_add(s, s, &task->u, prec);
+                leaf_interval_count++;
+
+                /* Adjust absolute tolerance based on new information. */
+                acb_get_mag_lower(tmpm, &task->u);
+                mag_mul_2exp_si(tmpm, tmpm, -goal);
+                mag_max(new_tol, new_tol, tmpm);
+                continue;
+            }
+
+            if (stopping == 0 && depth >= depth_limit - 1)
+            {
+                if (verbose > 0)
+                    flint_printf("stopping at depth_limit %wd\n", depth_limit);
+                status = ARB_CALC_NO_CONVERGENCE;
+                stopping = 1;
+            }
+
+            if (stopping)
+            {
+                acb_add(s, s, &task->v, prec);
+                leaf_interval_count++;
+                continue;
+            }
+
+            if (depth >= alloc - 2)
+            {
+                slong j;
+                as = flint_realloc(as, 2 * alloc * sizeof(acb_struct));
+                bs = flint_realloc(bs, 2 * alloc * sizeof(acb_struct));
+                vs = flint_realloc(vs, 2 * alloc * sizeof(acb_struct));
+                ms = flint_realloc(ms, 2 * alloc * sizeof(mag_struct));
+                for (j = alloc; j < 2 * alloc; j++)
+                {
+                    acb_init(as + j);
+                    acb_init(bs + j);
+                    acb_init(vs + j);
+                    mag_init(ms + j);
+                }
+                alloc *= 2;
+            }
+
+            /* Bisection: push [a, mid] and [mid, b]. */
+            eval += 2;
+
+            acb_set(as + depth, &task->a);
+            acb_set(bs + depth, &task->mid);
+            acb_swap(vs + depth, &task->vl);
+            mag_swap(ms + depth, &task->ml);
+            heap_down(as, bs, vs, ms, depth + 1);
+            depth++;
+
+            acb_set(as + depth, &task->mid);
+            acb_set(bs + depth, &task->b);
+            acb_swap(vs + depth, &task->vr);
+            mag_swap(ms + depth, &task->mr);
+            heap_down(as, bs, vs, ms, depth + 1);
+            depth++;
+
+            /* Adjust absolute tolerance based on new information. */
+            acb_get_mag_lower(tmpm, vs + depth - 2);
+            mag_mul_2exp_si(tmpm, tmpm, -goal);
+            mag_max(new_tol, new_tol, tmpm);
+            acb_get_mag_lower(tmpm, vs + depth - 1);
+            mag_mul_2exp_si(tmpm, tmpm, -goal);
+            mag_max(new_tol, new_tol, tmpm);
+
+            depth_max = FLINT_MAX(depth, depth_max);
+        }
+    }
+
+    if (verbose > 0)
+    {
+        flint_printf("depth %wd/%wd, eval %wd/%wd, %wd leaf intervals\n",
+            depth_max, depth_limit, eval, eval_limit, leaf_interval_count);
+    }
+
+    acb_set(res, s);
+
+    for (k = 0; k < INTEGRATE_BATCH; k++)
+    {
+        acb_clear(&tasks[k].a);
+        acb_clear(&tasks[k].b);
+        acb_clear(&tasks[k].v);
+        acb_clear(&tasks[k].u);
+        acb_clear(&tasks[k].mid);
+        acb_clear(&tasks[k].vl);
+        acb_clear(&tasks[k].vr);
+        mag_clear(&tasks[k].m);
+        mag_clear(&tasks[k].ml);
+        mag_clear(&tasks[k].mr);
+    }
+    flint_free(tasks);
+
+    _acb_vec_clear(as, alloc);
+    _acb_vec_clear(bs, alloc);
+    _acb_vec_clear(vs, alloc);
+    _mag_vec_clear(ms, alloc);
+    acb_clear(s);
+    acb_clear(u);
+    mag_clear(tmpm);
+    mag_clear(new_tol);
+
+    return status;
+}
+
 int
 acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     const acb_t a, const acb_t b,
@@ -130,15 +429,6 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
         return acb_calc_integrate(res, f, param, a, b, goal, tol, opt, prec);
     }
 
-    status = ARB_CALC_SUCCESS;
-
-    acb_init(s);
-    acb_init(t);
-    acb_init(u);
-    mag_init(tmpm);
-    mag_init(tmpn);
-    mag_init(new_tol);
-
     depth_limit = options->depth_limit;
     if (depth_limit <= 0)
         depth_limit = 2 * prec;
@@ -157,6 +447,19 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     verbose = options->verbose;
     use_heap = options->use_heap;
 
+    if (options->use_threads)
+        return acb_calc_integrate_threaded(res, f, param, a, b, goal, tol,
+            depth_limit, eval_limit, deg_limit, verbose, prec);
+
+    status = ARB_CALC_SUCCESS;
+
+    acb_init(s);
+    acb_init(t);
+    acb_init(u);
+    mag_init(tmpm);
+    mag_init(tmpn);
+    mag_init(new_tol);
+
     alloc = 4;
     as = _acb_vec_init(alloc);
     bs = _acb_vec_init(alloc);
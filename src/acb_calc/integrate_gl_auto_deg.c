@@ -29,40 +29,89 @@ const slong gl_steps[GL_STEPS] = {1, 2, 4, 6, 8, 12, 16, 22, 32, 46, 64,
     5792, 8192, 11586, 16384, 23170, 32768, 46340, 65536, 92682,
     131072, 185364, 262144, 370728, 524288, 741456};
 
+/*
+  The cache is global and shared by all threads; it is protected by a mutex
+  which is held while missing nodes are computed, so that concurrent
+  requests for the same degree do not duplicate the work. The optional size
+  limit (in bytes, 0 meaning no limit) is enforced by first evicting the
+  other degrees and then, if the requested table alone is too large, by
+  computing the nodes without storing them.
+*/
+
 typedef struct
 {
     slong gl_prec[GL_STEPS];
     arb_ptr gl_nodes[GL_STEPS];
     arb_ptr gl_weights[GL_STEPS];
+    slong size;
+    slong limit;
+    slong hits;
+    slong misses;
+    int registered;
 }
 gl_cache_struct;
 
-FLINT_TLS_PREFIX gl_cache_struct * gl_cache = NULL;
+static gl_cache_struct gl_cache[1];
 
-void gl_cleanup(void)
+#if FLINT_USES_PTHREAD
+#include <pthread.h>
+
+static pthread_once_t gl_cache_initialised = PTHREAD_ONCE_INIT;
+static pthread_mutex_t gl_cache_mutex;
+
+static void gl_cache_mutex_init(void)
 {
-    slong i;
+    pthread_mutex_init(&gl_cache_mutex, NULL);
+}
+#endif
 
-    if (gl_cache == NULL)
-        return;
+static void gl_lock(void)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&gl_cache_initialised, gl_cache_mutex_init);
+    pthread_mutex_lock(&gl_cache_mutex);
+#endif
+}
 
-    for (i = 0; i < GL_STEPS; i++)
+static void gl_unlock(void)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&gl_cache_mutex);
+#endif
+}
+
+static slong gl_entry_size(slong i, slong wp)
+{
+    if (wp == 0)
+        return 0;
+
+    return 2 * ((gl_steps[i] + 1) / 2) * (sizeof(arb_struct) +
+                ((wp + FLINT_BITS - 1) / FLINT_BITS) * sizeof(mp_limb_t));
+}
+
+static void gl_clear_entry(slong i)
+{
+    if (gl_cache->gl_prec[i] != 0)
     {
-        if (gl_cache->gl_prec[i] != 0)
-        {
-            _arb_vec_clear(gl_cache->gl_nodes[i], (gl_steps[i] + 1) / 2);
-            _arb_vec_clear(gl_cache->gl_weights[i], (gl_steps[i] + 1) / 2);
-        }
+        _arb_vec_clear(gl_cache->gl_nodes[i], (gl_steps[i] + 1) / 2);
+        _arb_vec_clear(gl_cache->gl_weights[i], (gl_steps[i] + 1) / 2);
+        gl_cache->size -= gl_entry_size(i, gl_cache->gl_prec[i]);
+        gl_cache->gl_prec[i] = 0;
     }
-
-    flint_free(gl_cache);
-    gl_cache = NULL;
 }
 
-void gl_init(void)
+void gl_cleanup(void)
 {
-    gl_cache = flint_calloc(1, sizeof(gl_cache_struct));
-    flint_register_cleanup_function(gl_cleanup);
+    slong i;
+
+    gl_lock();
+
+    for (i = 0; i < GL_STEPS; i++)
+        gl_clear_entry(i);
+
+    gl_cache->registered = 0;
+
+    gl_unlock();
 }
 
 /* Compute GL node and weight of index k for n = gl_steps[i]. Cached. */
@@ -81,28 +130,82 @@ nodes_worker(slong jj, nodes_work_t * work)
     arb_hypgeom_legendre_p_ui_root(work->nodes + jj, work->weights + jj, work->n, jj, work->wp);
 }
 
-/* if k >= 0, compute the node and weight of index k */
-/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
-void
-acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+/*
+  Nodes and weights are returned with a radius of two ulps at the target
+  precision rather than the radius inherited from the cached values, so that
+  the output does not depend on the precision the cache happens to hold.
+  This makes integration results independent of the evaluation history
+  (and of the thread that computes them). The cache is kept at least
+  GL_GUARD_BITS above the target precision for this bound to be valid.
+*/
+
+#define GL_GUARD_BITS 16
+
+static void
+gl_set_round(arb_t y, const arb_t x, int neg, slong prec)
 {
-    slong n, kk, wp;
-    int all;
+    mag_t t;
 
-    if (i < 0 || i >= GL_STEPS || prec < 2)
-        flint_abort();
+    if (neg)
+        arb_neg_round(y, x, prec);
+    else
+        arb_set_round(y, x, prec);
+
+    if (arb_is_exact(x) || arf_is_zero(arb_midref(y)))
+        return;
+
+    mag_init(t);
+    mag_set_ui_2exp_si(t, 1, arf_abs_bound_lt_2exp_si(arb_midref(y)) - prec + 1);
+    mag_max(arb_radref(y), arb_radref(y), t);
+    mag_clear(t);
+}
+
+/*
+  Make the entry of index i accurate to prec + GL_GUARD_BITS, unless this
+  would exceed the size limit. Returns whether the entry can be used.
+  The cache must be locked.
+*/
+static int
+gl_cache_ensure(slong i, slong prec)
+{
+    slong n, wp, cur, new;
+    slong j;
+
+    if (!gl_cache->registered)
+    {
+        flint_register_cleanup_function(gl_cleanup);
+        gl_cache->registered = 1;
+    }
+
+    if (gl_cache->gl_prec[i] >= prec + GL_GUARD_BITS)
+    {
+        gl_cache->hits++;
+        return 1;
+    }
 
-    if (gl_cache == NULL)
-        gl_init();
+    gl_cache->misses++;
 
     n = gl_steps[i];
+    wp = FLINT_MAX(prec + GL_GUARD_BITS, gl_cache->gl_prec[i] * 2 + 30);
+    cur = gl_entry_size(i, gl_cache->gl_prec[i]);
+    new = gl_entry_size(i, wp);
 
-    if (k >= n)
-        flint_abort();
+    if (gl_cache->limit > 0 && gl_cache->size - cur + new > gl_cache->limit)
+    {
+        for (j = 0; j < GL_STEPS; j++)
+            if (j != i)
+                gl_clear_entry(j);
 
-    all = (k < 0);
+        if (gl_cache->size - cur + new > gl_cache->limit)
+        {
+            wp = prec + GL_GUARD_BITS;
+            new = gl_entry_size(i, wp);
+
+            if (gl_cache->size - cur + new > gl_cache->limit)
+                return 0;
+        }
+    }
 
-    if (gl_cache->gl_prec[i] < prec)
     {
         nodes_work_t work;
 
@@ -112,8 +215,6 @@ acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
             gl_cache->gl_weights[i] = _arb_vec_init((n + 1) / 2);
         }
 
-        wp = FLINT_MAX(prec, gl_cache->gl_prec[i] * 2 + 30);
-
         work.nodes = gl_cache->gl_nodes[i];
         work.weights = gl_cache->gl_weights[i];
         work.n = n;
@@ -121,15 +222,78 @@ acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
 
         flint_parallel_do((do_func_t) nodes_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_STRIDED);
 
+        gl_cache->size += new - cur;
         gl_cache->gl_prec[i] = wp;
     }
 
+    return 1;
+}
+
+/* if k >= 0, compute the node and weight of index k */
+/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
+void
+acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+{
+    slong n, kk, wp;
+    int all;
+
+    if (i < 0 || i >= GL_STEPS || prec < 2)
+        flint_abort();
+
+    n = gl_steps[i];
+
+    if (k >= n)
+        flint_abort();
+
+    all = (k < 0);
+
+    gl_lock();
+
+    if (gl_cache_ensure(i, prec))
+    {
+        if (all)
+        {
+            for (k = 0; k < (n + 1) / 2; k++)
+            {
+                gl_set_round(x + k, gl_cache->gl_nodes[i] + k, 0, prec);
+                gl_set_round(w + k, gl_cache->gl_weights[i] + k, 0, prec);
+            }
+        }
+        else
+        {
+            if (2 * k < n)
+                kk = k;
+            else
+                kk = n - 1 - k;
+
+            gl_set_round(x, gl_cache->gl_nodes[i] + kk, 2 * k >= n, prec);
+            gl_set_round(w, gl_cache->gl_weights[i] + kk, 0, prec);
+        }
+
+        gl_unlock();
+        return;
+    }
+
+    gl_unlock();
+
+    /* too large for the cache */
+    wp = prec + GL_GUARD_BITS;
+
     if (all)
     {
+        nodes_work_t work;
+
+        work.nodes = x;
+        work.weights = w;
+        work.n = n;
+        work.wp = wp;
+
+        flint_parallel_do((do_func_t) nodes_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_STRIDED);
+
         for (k = 0; k < (n + 1) / 2; k++)
         {
-            arb_set_round(x + k, gl_cache->gl_nodes[i] + k, prec);
-            arb_set_round(w + k, gl_cache->gl_weights[i] + k, prec);
+            gl_set_round(x + k, x + k, 0, prec);
+            gl_set_round(w + k, w + k, 0, prec);
         }
     }
     else
@@ -139,15 +303,68 @@ acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
         else
             kk = n - 1 - k;
 
-        if (2 * k < n)
-            arb_set_round(x, gl_cache->gl_nodes[i] + kk, prec);
-        else
-            arb_neg_round(x, gl_cache->gl_nodes[i] + kk, prec);
-
-        arb_set_round(w, gl_cache->gl_weights[i] + kk, prec);
+        arb_hypgeom_legendre_p_ui_root(x, w, n, kk, wp);
+        gl_set_round(x, x, 2 * k >= n, prec);
+        gl_set_round(w, w, 0, prec);
     }
 }
 
+void
+acb_calc_gl_cache_prewarm(slong deg, slong prec)
+{
+    slong i;
+
+    prec = FLINT_MAX(prec, 2);
+
+    gl_lock();
+    for (i = 0; i < GL_STEPS && gl_steps[i] <= deg; i++)
+        gl_cache_ensure(i, prec);
+    gl_unlock();
+}
+
+void
+acb_calc_gl_cache_set_limit(slong max_bytes)
+{
+    slong i;
+
+    gl_lock();
+
+    gl_cache->limit = FLINT_MAX(max_bytes, 0);
+
+    /* evict the largest tables first */
+    for (i = GL_STEPS - 1; i >= 0 && gl_cache->limit > 0 &&
+                                gl_cache->size > gl_cache->limit; i--)
+        gl_clear_entry(i);
+
+    gl_unlock();
+}
+
+void
+acb_calc_gl_cache_get_stats(slong * hits, slong * misses, slong * size)
+{
+    gl_lock();
+    *hits = gl_cache->hits;
+    *misses = gl_cache->misses;
+    *size = gl_cache->size;
+    gl_unlock();
+}
+
+void
+acb_calc_gl_cache_clear(void)
+{
+    slong i;
+
+    gl_lock();
+
+    for (i = 0; i < GL_STEPS; i++)
+        gl_clear_entry(i);
+
+    gl_cache->hits = 0;
+    gl_cache->misses = 0;
+
+    gl_unlock();
+}
+
 typedef struct
 {
     slong n;
@@ -383,13 +600,15 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
         {
             acb_zero(s);
 
+            /* same roundings as in the threaded case */
             for (k = 0; k < best_n; k++)
             {
                 acb_calc_gl_node(x, w, i, k, prec);
                 acb_mul_arb(wide, delta, x, prec);
                 acb_add(wide, wide, mid, prec);
                 f(v, wide, param, 0, prec);
-                acb_addmul_arb(s, v, w, prec);
+                acb_mul_arb(v, v, w, prec);
+                acb_add(s, s, v, prec);
             }
         }
 
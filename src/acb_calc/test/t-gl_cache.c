@@ -0,0 +1,141 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "acb.h"
+#include "acb_calc.h"
+
+int
+f_exp(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
+{
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    acb_exp(res, z, prec);
+    return 0;
+}
+
+/* 1/(1+(100x-40)^2) */
+int
+f_runge(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
+{
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    acb_mul_ui(res, z, 100, prec);
+    acb_sub_ui(res, res, 40, prec);
+    acb_sqr(res, res, prec);
+    acb_add_ui(res, res, 1, prec);
+    acb_inv(res, res, prec);
+
+    return 0;
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("gl_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 20 * flint_test_multiplier(); iter++)
+    {
+        acb_t a, b, z, w;
+        mag_t tol;
+        acb_calc_integrate_opt_t opt;
+        slong prec, hits, misses, size, hits2, misses2, size2;
+
+        acb_init(a);
+        acb_init(b);
+        acb_init(z);
+        acb_init(w);
+        mag_init(tol);
+        acb_calc_integrate_opt_init(opt);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+        opt->use_threads = n_randint(state, 2);
+
+        prec = 2 + n_randint(state, 300);
+        mag_set_ui_2exp_si(tol, 1, -prec);
+        acb_zero(a);
+        acb_one(b);
+
+        acb_calc_gl_cache_clear();
+        acb_calc_gl_cache_set_limit(n_randint(state, 2) ? 0 :
+                                                    n_randint(state, 100000));
+
+        /* a prewarmed cache serves the integration without misses */
+        acb_calc_gl_cache_prewarm(prec, prec);
+        acb_calc_gl_cache_get_stats(&hits, &misses, &size);
+
+        acb_calc_integrate(z, f_runge, NULL, a, b, prec, tol, opt, prec);
+        acb_calc_gl_cache_get_stats(&hits2, &misses2, &size2);
+
+        if (hits2 < hits || size2 < 0)
+        {
+            flint_printf("FAIL (stats)\n");
+            flint_printf("hits = %wd, misses = %wd, size = %wd\n", hits, misses, size);
+            flint_printf("hits2 = %wd, misses2 = %wd, size2 = %wd\n", hits2, misses2, size2);
+            flint_abort();
+        }
+
+        acb_calc_gl_cache_set_limit(0);
+        acb_calc_gl_cache_prewarm(256, prec);
+        acb_calc_gl_cache_get_stats(&hits, &misses, &size);
+        acb_calc_integrate(w, f_runge, NULL, a, b, prec, tol, opt, prec);
+        acb_calc_gl_cache_get_stats(&hits2, &misses2, &size2);
+
+        if (misses2 != misses || hits2 < hits || size2 != size)
+        {
+            flint_printf("FAIL (prewarm)\n");
+            flint_printf("hits = %wd, misses = %wd, size = %wd\n", hits, misses, size);
+            flint_printf("hits2 = %wd, misses2 = %wd, size2 = %wd\n", hits2, misses2, size2);
+            flint_abort();
+        }
+
+        /* the result does not depend on the state of the cache */
+        if (!acb_equal(z, w))
+        {
+            flint_printf("FAIL (limit)\n");
+            flint_printf("z = "); acb_printn(z, 20,  0); flint_printf("\n");
+            flint_printf("w = "); acb_printn(w, 20,  0); flint_printf("\n");
+            flint_abort();
+        }
+
+        /* check against the exact value */
+        acb_calc_integrate(z, f_exp, NULL, a, b, prec, tol, opt, prec);
+        acb_one(w);
+        acb_exp(w, w, prec);
+        acb_sub_ui(w, w, 1, prec);
+
+        if (!acb_overlaps(z, w) || acb_rel_accuracy_bits(z) < prec - 10)
+        {
+            flint_printf("FAIL (exp)\n");
+            flint_printf("z = "); acb_printn(z, 20,  0); flint_printf("\n");
+            flint_printf("w = "); acb_printn(w, 20,  0); flint_printf("\n");
+            flint_abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(z);
+        acb_clear(w);
+        mag_clear(tol);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -239,6 +239,42 @@ f_abs(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
     return 0;
 }
 
+/* |x^4 + 10x^3 + 19x^2 - 6x - 6| */
+int
+f_abs_poly(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
+{
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    acb_add_si(res, z, 10, prec);
+    acb_mul(res, res, z, prec);
+    acb_add_si(res, res, 19, prec);
+    acb_mul(res, res, z, prec);
+    acb_add_si(res, res, -6, prec);
+    acb_mul(res, res, z, prec);
+    acb_add_si(res, res, -6, prec);
+
+    acb_real_abs(res, res, order != 0, prec);
+
+    return 0;
+}
+
+/* 1/(1+(100x-40)^2) */
+int
+f_runge(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
+{
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    acb_mul_ui(res, z, 100, prec);
+    acb_sub_ui(res, res, 40, prec);
+    acb_sqr(res, res, prec);
+    acb_add_ui(res, res, 1, prec);
+    acb_inv(res, res, prec);
+
+    return 0;
+}
+
 /* sign(sin(x))*cos(1+x) */
 int
 f_sgn(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
@@ -376,6 +412,7 @@ int main(void)
             opt->deg_limit = n_randint(state, 100);
 
         opt->use_heap = n_randint(state, 2);
+        opt->use_threads = n_randint(state, 2);
 
         integral = n_randint(state, 9);
 
@@ -714,6 +751,58 @@ int main(void)
         mag_clear(tol);
     }
 
+    /* the threaded mode gives the same result for any number of threads */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        acb_t a, b, z, w;
+        slong prec;
+        mag_t tol;
+        acb_calc_integrate_opt_t opt;
+        int integral;
+
+        acb_init(a);
+        acb_init(b);
+        acb_init(z);
+        acb_init(w);
+        mag_init(tol);
+        acb_calc_integrate_opt_init(opt);
+        opt->use_threads = 1;
+
+        prec = 2 + n_randint(state, 200);
+        mag_set_ui_2exp_si(tol, 1, -prec);
+        acb_zero(a);
+        acb_one(b);
+        integral = n_randint(state, 2);
+
+        /* integrands that do not use cached constants */
+        flint_set_num_threads(1);
+        if (integral == 0)
+            acb_calc_integrate(z, f_abs_poly, NULL, a, b, prec, tol, opt, prec);
+        else
+            acb_calc_integrate(z, f_runge, NULL, a, b, prec, tol, opt, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 3));
+        if (integral == 0)
+            acb_calc_integrate(w, f_abs_poly, NULL, a, b, prec, tol, opt, prec);
+        else
+            acb_calc_integrate(w, f_runge, NULL, a, b, prec, tol, opt, prec);
+
+        if (!acb_equal(z, w))
+        {
+            flint_printf("FAIL (threads, iter = %wd)\n", iter);
+            flint_printf("integral = %d, prec = %wd\n", integral, prec);
+            flint_printf("z = "); acb_printn(z, 20,  0); flint_printf("\n");
+            flint_printf("w = "); acb_printn(w, 20,  0); flint_printf("\n");
+            flint_abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(z);
+        acb_clear(w);
+        mag_clear(tol);
+    }
+
     flint_randclear(state);
     flint_cleanup_master();
     flint_printf("PASS\n");
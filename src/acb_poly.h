@@ -479,6 +479,14 @@ slong _acb_poly_validate_roots(acb_ptr roots,
 void _acb_poly_refine_roots_durand_kerner(acb_ptr roots,
         acb_srcptr poly, slong len, slong prec);
 
+void _acb_poly_refine_roots_aberth(acb_ptr roots,
+        acb_srcptr poly, slong len, slong prec);
+
+int _acb_poly_find_roots_d(acb_ptr roots, acb_srcptr poly, slong len,
+        slong maxiter);
+
+#define ACB_POLY_FIND_ROOTS_ABERTH_CUTOFF 32
+
 slong _acb_poly_find_roots(acb_ptr roots,
     acb_srcptr poly,
     acb_srcptr initial, slong len, slong maxiter, slong prec);
@@ -76,6 +76,7 @@ _acb_poly_find_roots(acb_ptr roots,
 {
     slong iter, i, deg;
     slong rootmag, max_rootmag, correction, max_correction;
+    int aberth;
 
     deg = len - 1;
 
@@ -101,10 +102,14 @@ _acb_poly_find_roots(acb_ptr roots,
         return 1;
     }
 
-    if (initial == NULL)
-        _acb_poly_roots_initial_values(roots, deg, prec);
-    else
+    /* For large degree, use a warm start computed in double precision
+       and the Aberth method, whose steps are computed in parallel. */
+    aberth = (deg >= ACB_POLY_FIND_ROOTS_ABERTH_CUTOFF);
+
+    if (initial != NULL)
         _acb_vec_set(roots, initial, deg);
+    else if (!aberth || !_acb_poly_find_roots_d(roots, poly, len, 100 + deg / 8))
+        _acb_poly_roots_initial_values(roots, deg, prec);
 
     if (maxiter == 0)
         maxiter = 2 * deg + n_sqrt(prec);
@@ -118,7 +123,10 @@ _acb_poly_find_roots(acb_ptr roots,
             max_rootmag = FLINT_MAX(rootmag, max_rootmag);
         }
 
-        _acb_poly_refine_roots_durand_kerner(roots, poly, len, prec);
+        if (aberth)
+            _acb_poly_refine_roots_aberth(roots, poly, len, prec);
+        else
+            _acb_poly_refine_roots_durand_kerner(roots, poly, len, prec);
 
         max_correction = -ARF_PREC_EXACT;
         for (i = 0; i < deg; i++)
@@ -0,0 +1,273 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <math.h>
+#include "thread_support.h"
+#include "acb_poly.h"
+
+/*
+    Aberth iteration in double precision, used to warm start the
+    multiprecision iteration. Points outside the unit circle are handled
+    by evaluating the reversed polynomial at 1/z, which avoids overflow
+    for large degrees. Like _acb_poly_refine_roots_aberth, each step only
+    uses the roots of the previous step, so the result does not depend
+    on the number of threads.
+*/
+
+typedef struct
+{
+    double * re;
+    double * im;
+    double * new_re;
+    double * new_im;
+    int * done;
+    const double * cre;
+    const double * cim;
+    slong deg;
+}
+aberth_d_work_t;
+
+/* (a + bi) / (c + di) using Smith's algorithm */
+static void
+_cdiv(double * x, double * y, double a, double b, double c, double d)
+{
+    double r, t;
+
+    if (fabs(c) >= fabs(d))
+    {
+        r = d / c;
+        t = c + d * r;
+        *x = (a + b * r) / t;
+        *y = (b - a * r) / t;
+    }
+    else
+    {
+        r = c / d;
+        t = c * r + d;
+        *x = (a * r + b) / t;
+        *y = (b * r - a) / t;
+    }
+}
+
+static void
+aberth_d_worker(slong i, aberth_d_work_t * work)
+{
+    const double * cre = work->cre;
+    const double * cim = work->cim;
+    slong deg = work->deg;
+    double zr, zi, pr, pi, dr, di, wr, wi, sr, si, tr, ti, u;
+    slong j;
+
+    zr = work->re[i];
+    zi = work->im[i];
+
+    work->new_re[i] = zr;
+    work->new_im[i] = zi;
+
+    if (work->done[i])
+        return;
+
+    if (zr * zr + zi * zi <= 1.0)
+    {
+        /* w = p(z) / p'(z) */
+        pr = cre[deg];
+        pi = cim[deg];
+        dr = di = 0.0;
+
+        for (j = deg - 1; j >= 0; j--)
+        {
+            u = dr * zr - di * zi + pr;
+            di = dr * zi + di * zr + pi;
+            dr = u;
+            u = pr * zr - pi * zi + cre[j];
+            pi = pr * zi + pi * zr + cim[j];
+            pr = u;
+        }
+
+        if (pr == 0.0 && pi == 0.0)
+        {
+            work->done[i] = 1;
+            return;
+        }
+
+        if (dr == 0.0 && di == 0.0)
+            return;
+
+        _cdiv(&wr, &wi, pr, pi, dr, di);
+    }
+    else
+    {
+        /* with y = 1/z and r the reversed polynomial,
+           p(z) / p'(z) = z / (deg - y r'(y) / r(y)) */
+        double yr, yi;
+
+        _cdiv(&yr, &yi, 1.0, 0.0, zr, zi);
+
+        pr = cre[0];
+        pi = cim[0];
+        dr = di = 0.0;
+
+        for (j = 1; j <= deg; j++)
+        {
+            u = dr * yr - di * yi + pr;
+            di = dr * yi + di * yr + pi;
+            dr = u;
+            u = pr * yr - pi * yi + cre[j];
+            pi = pr * yi + pi * yr + cim[j];
+            pr = u;
+        }
+
+        if (pr == 0.0 && pi == 0.0)
+        {
+            work->done[i] = 1;
+            return;
+        }
+
+        _cdiv(&tr, &ti, dr, di, pr, pi);
+        u = tr * yr - ti * yi;
+        ti = tr * yi + ti * yr;
+        tr = deg - u;
+        ti = -ti;
+
+        if (tr == 0.0 && ti == 0.0)
+            return;
+
+        _cdiv(&wr, &wi, zr, zi, tr, ti);
+    }
+
+    /* s = sum 1/(z - z_j) */
+    sr = si = 0.0;
+    for (j = 0; j < deg; j++)
+    {
+        if (j != i)
+        {
+            _cdiv(&tr, &ti, 1.0, 0.0, zr - work->re[j], zi - work->im[j]);
+            sr += tr;
+            si += ti;
+        }
+    }
+
+    /* w = w / (1 - w s) */
+    tr = 1.0 - (wr * sr - wi * si);
+    ti = -(wr * si + wi * sr);
+    _cdiv(&wr, &wi, wr, wi, tr, ti);
+
+    if (!isfinite(wr) || !isfinite(wi))
+        return;
+
+    work->new_re[i] = zr - wr;
+    work->new_im[i] = zi - wi;
+
+    if (wr * wr + wi * wi <= 1e-28 * (zr * zr + zi * zi))
+        work->done[i] = 1;
+}
+
+int
+_acb_poly_find_roots_d(acb_ptr roots, acb_srcptr poly, slong len, slong maxiter)
+{
+    aberth_d_work_t work;
+    double * cre, * cim, * re, * im, * new_re, * new_im;
+    double r, t;
+    int * done;
+    slong i, iter, deg, left;
+    int success = 0;
+
+    deg = len - 1;
+
+    if (deg < 1)
+        return 0;
+
+    /* the coefficients must be representable without underflow or overflow */
+    for (i = 0; i < len; i++)
+    {
+        if (!acb_is_finite(poly + i))
+            return 0;
+
+        if ((!arf_is_zero(arb_midref(acb_realref(poly + i))) &&
+                 (arf_cmpabs_2exp_si(arb_midref(acb_realref(poly + i)), -900) < 0 ||
+                  arf_cmpabs_2exp_si(arb_midref(acb_realref(poly + i)), 900) > 0)) ||
+            (!arf_is_zero(arb_midref(acb_imagref(poly + i))) &&
+                 (arf_cmpabs_2exp_si(arb_midref(acb_imagref(poly + i)), -900) < 0 ||
+                  arf_cmpabs_2exp_si(arb_midref(acb_imagref(poly + i)), 900) > 0)))
+            return 0;
+    }
+
+    cre = flint_malloc(sizeof(double) * 6 * len);
+    cim = cre + len;
+    re = cim + len;
+    im = re + len;
+    new_re = im + len;
+    new_im = new_re + len;
+    done = flint_calloc(len, sizeof(int));
+
+    for (i = 0; i < len; i++)
+    {
+        cre[i] = arf_get_d(arb_midref(acb_realref(poly + i)), ARF_RND_NEAR);
+        cim[i] = arf_get_d(arb_midref(acb_imagref(poly + i)), ARF_RND_NEAR);
+    }
+
+    if (cre[deg] == 0.0 && cim[deg] == 0.0)
+        goto cleanup;
+
+    /* initial values on a circle of radius |p(0) / lc|^(1/deg) */
+    r = sqrt(cre[0] * cre[0] + cim[0] * cim[0]) /
+            sqrt(cre[deg] * cre[deg] + cim[deg] * cim[deg]);
+    r = (r == 0.0) ? 1.0 : pow(r, 1.0 / deg);
+
+    for (i = 0; i < deg; i++)
+    {
+        t = 6.283185307179586 * i / deg + 0.4;
+        re[i] = r * cos(t);
+        im[i] = r * sin(t);
+    }
+
+    work.re = re;
+    work.im = im;
+    work.new_re = new_re;
+    work.new_im = new_im;
+    work.done = done;
+    work.cre = cre;
+    work.cim = cim;
+    work.deg = deg;
+
+    for (iter = 0; iter < maxiter; iter++)
+    {
+        flint_parallel_do((do_func_t) aberth_d_worker, &work, deg, -1,
+                                                    FLINT_PARALLEL_UNIFORM);
+
+        left = 0;
+        for (i = 0; i < deg; i++)
+        {
+            re[i] = new_re[i];
+            im[i] = new_im[i];
+            left += !done[i];
+        }
+
+        if (left == 0)
+            break;
+    }
+
+    for (i = 0; i < deg; i++)
+        if (!isfinite(re[i]) || !isfinite(im[i]))
+            goto cleanup;
+
+    for (i = 0; i < deg; i++)
+        acb_set_d_d(roots + i, re[i], im[i]);
+
+    success = 1;
+
+cleanup:
+    flint_free(cre);
+    flint_free(done);
+
+    return success;
+}
@@ -11,6 +11,30 @@
 
 #include "arb_poly.h"
 #include "acb_poly.h"
+#include "thread_support.h"
+
+/* Compute the real products concurrently when min(len1, len2) * prec
+   is at least this large (and more than one thread is available). */
+#define MULLOW_TRANSPOSE_THREAD_CUTOFF 20000.0
+
+typedef struct
+{
+    arb_ptr res[4];
+    arb_srcptr x[4];
+    arb_srcptr y[4];
+    slong len1;
+    slong len2;
+    slong n;
+    slong prec;
+}
+mullow_transpose_work_t;
+
+static void
+_acb_poly_mullow_transpose_worker(slong i, mullow_transpose_work_t * work)
+{
+    _arb_poly_mullow(work->res[i], work->x[i], work->len1,
+                     work->y[i], work->len2, work->n, work->prec);
+}
 
 void
 _acb_poly_mullow_transpose(acb_ptr res,
@@ -53,20 +77,60 @@ _acb_poly_mullow_transpose(acb_ptr res,
         f[i] = *acb_imagref(res + i);
     }
 
-    _arb_poly_mullow(e, a, len1, c, len2, n, prec);
-    _arb_poly_mullow(t, b, len1, d, len2, n, prec);
-    _arb_vec_sub(e, e, t, n, prec);
-
-    _arb_poly_mullow(f, a, len1, d, len2, n, prec);
-    /* squaring */
-    if (poly1 == poly2 && len1 == len2)
+    if (flint_get_num_threads() > 1 &&
+        (double) FLINT_MIN(len1, len2) * FLINT_MIN(prec, WORD(1) << 20)
+            >= MULLOW_TRANSPOSE_THREAD_CUTOFF)
     {
-        _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        /* compute the real products concurrently; the results are the
+           same as in the serial version */
+        mullow_transpose_work_t work;
+        arb_ptr u = NULL;
+        int squaring = (poly1 == poly2 && len1 == len2);
+
+        if (!squaring)
+            u = _arb_vec_init(n);
+
+        work.res[0] = e; work.x[0] = a; work.y[0] = c;
+        work.res[1] = t; work.x[1] = b; work.y[1] = d;
+        work.res[2] = f; work.x[2] = a; work.y[2] = d;
+        work.res[3] = u; work.x[3] = b; work.y[3] = c;
+        work.len1 = len1;
+        work.len2 = len2;
+        work.n = n;
+        work.prec = prec;
+
+        flint_parallel_do((do_func_t) _acb_poly_mullow_transpose_worker,
+            &work, squaring ? 3 : 4, -1, FLINT_PARALLEL_DYNAMIC);
+
+        _arb_vec_sub(e, e, t, n, prec);
+
+        if (squaring)
+        {
+            _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        }
+        else
+        {
+            _arb_vec_add(f, f, u, n, prec);
+            _arb_vec_clear(u, n);
+        }
     }
     else
     {
-        _arb_poly_mullow(t, b, len1, c, len2, n, prec);
-        _arb_vec_add(f, f, t, n, prec);
+        _arb_poly_mullow(e, a, len1, c, len2, n, prec);
+        _arb_poly_mullow(t, b, len1, d, len2, n, prec);
+        _arb_vec_sub(e, e, t, n, prec);
+
+        _arb_poly_mullow(f, a, len1, d, len2, n, prec);
+        /* squaring */
+        if (poly1 == poly2 && len1 == len2)
+        {
+            _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        }
+        else
+        {
+            _arb_poly_mullow(t, b, len1, c, len2, n, prec);
+            _arb_vec_add(f, f, t, n, prec);
+        }
     }
 
     for (i = 0; i < n; i++)
@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "thread_support.h"
+#include "acb_poly.h"
+
+typedef struct
+{
+    acb_ptr out;
+    acb_srcptr roots;
+    acb_srcptr poly;
+    slong len;
+    slong prec;
+}
+aberth_work_t;
+
+/* one Aberth correction for the root of index i, using the old roots only */
+static void
+aberth_worker(slong i, aberth_work_t * work)
+{
+    acb_srcptr roots = work->roots;
+    acb_srcptr poly = work->poly;
+    slong len = work->len;
+    slong prec = work->prec;
+    acb_t z, p, d, s, t;
+    slong j;
+
+    acb_init(z);
+    acb_init(p);
+    acb_init(d);
+    acb_init(s);
+    acb_init(t);
+
+    acb_get_mid(z, roots + i);
+
+    /* p = poly(z), d = poly'(z) */
+    acb_get_mid(p, poly + len - 1);
+    acb_zero(d);
+    for (j = len - 2; j >= 0; j--)
+    {
+        acb_mul(d, d, z, prec);
+        acb_add(d, d, p, prec);
+        acb_mul(p, p, z, prec);
+        acb_get_mid(t, poly + j);
+        acb_add(p, p, t, prec);
+    }
+
+    acb_get_mid(p, p);
+    acb_get_mid(d, d);
+
+    if (acb_is_zero(p) || acb_is_zero(d))
+    {
+        acb_set(work->out + i, z);
+    }
+    else
+    {
+        /* s = sum 1/(z - z_j) */
+        acb_zero(s);
+        for (j = 0; j < len - 1; j++)
+        {
+            if (j != i)
+            {
+                acb_get_mid(t, roots + j);
+                acb_sub(t, z, t, prec);
+                acb_inv(t, t, prec);
+                acb_add(s, s, t, prec);
+            }
+        }
+
+        /* w = (p/d) / (1 - (p/d) s) */
+        acb_div(p, p, d, prec);
+        acb_get_mid(p, p);
+        acb_mul(t, p, s, prec);
+        acb_sub_ui(t, t, 1, prec);
+        acb_neg(t, t);
+        acb_get_mid(t, t);
+        acb_div(p, p, t, prec);
+        acb_get_mid(p, p);
+
+        acb_sub(work->out + i, z, p, prec);
+        acb_get_mid(work->out + i, work->out + i);
+
+        arf_get_mag(arb_radref(acb_realref(work->out + i)), arb_midref(acb_realref(p)));
+        arf_get_mag(arb_radref(acb_imagref(work->out + i)), arb_midref(acb_imagref(p)));
+    }
+
+    acb_clear(z);
+    acb_clear(p);
+    acb_clear(d);
+    acb_clear(s);
+    acb_clear(t);
+}
+
+void
+_acb_poly_refine_roots_aberth(acb_ptr roots,
+        acb_srcptr poly, slong len, slong prec)
+{
+    aberth_work_t work;
+    acb_ptr out;
+
+    if (len < 2)
+        return;
+
+    out = _acb_vec_init(len - 1);
+
+    work.out = out;
+    work.roots = roots;
+    work.poly = poly;
+    work.len = len;
+    work.prec = prec;
+
+    flint_parallel_do((do_func_t) aberth_worker, &work, len - 1, -1,
+                                                   FLINT_PARALLEL_UNIFORM);
+
+    _acb_vec_swap(roots, out, len - 1);
+    _acb_vec_clear(out, len - 1);
+}
@@ -91,6 +91,67 @@ int main(void)
         acb_poly_clear(C);
     }
 
+    /* large degree: warm start and threaded Aberth iteration */
+    for (iter = 0; iter < 10 * flint_test_multiplier(); iter++)
+    {
+        acb_poly_t A;
+        acb_t t;
+        acb_ptr roots, roots2;
+        slong i, deg, isolated, isolated2;
+        slong prec = 53 + n_randint(state, 300);
+
+        acb_init(t);
+        acb_poly_init(A);
+
+        deg = ACB_POLY_FIND_ROOTS_ABERTH_CUTOFF + n_randint(state, 80);
+        acb_poly_fit_length(A, deg + 1);
+        for (i = 0; i <= deg; i++)
+            acb_set_si(A->coeffs + i, (slong) n_randint(state, 2001) - 1000);
+        acb_one(A->coeffs + deg);
+        _acb_poly_set_length(A, deg + 1);
+
+        roots = _acb_vec_init(deg);
+        roots2 = _acb_vec_init(deg);
+
+        flint_set_num_threads(1);
+        isolated = acb_poly_find_roots(roots, A, NULL, 0, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 3));
+        isolated2 = acb_poly_find_roots(roots2, A, NULL, 0, prec);
+
+        for (i = 0; i < deg && isolated2 == isolated; i++)
+            if (!acb_equal(roots + i, roots2 + i))
+                isolated2 = -1;
+
+        if (isolated != deg || isolated2 != isolated)
+        {
+            flint_printf("FAIL: large degree\n");
+            flint_printf("deg = %wd, prec = %wd, isolated = %wd, isolated2 = %wd\n",
+                deg, prec, isolated, isolated2);
+            acb_poly_printd(A, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < isolated; i++)
+        {
+            acb_poly_evaluate(t, A, roots + i, prec);
+            if (!acb_contains_zero(t))
+            {
+                flint_printf("FAIL: poly(root) does not contain zero (large degree)\n");
+                acb_poly_printd(A, 15); flint_printf("\n\n");
+                acb_printd(roots + i, 15); flint_printf("\n\n");
+                acb_printd(t, 15); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        _acb_vec_clear(roots, deg);
+        _acb_vec_clear(roots2, deg);
+
+        acb_clear(t);
+        acb_poly_clear(A);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
@@ -16,6 +16,7 @@ int main(void)
 {
     slong iter;
     flint_rand_t state;
+    const slong max_threads = 5;
 
     flint_printf("mullow_transpose....");
     fflush(stdout);
@@ -165,8 +166,62 @@ int main(void)
         acb_poly_clear(ab2);
     }
 
+    /* the threaded version must give the same result as the serial one */
+    for (iter = 0; iter < 300 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        slong bits, trunc;
+        acb_poly_t a, b, c, d;
+
+        bits = 2 + n_randint(state, 1000);
+        trunc = n_randint(state, 200);
+
+        acb_poly_init(a);
+        acb_poly_init(b);
+        acb_poly_init(c);
+        acb_poly_init(d);
+
+        acb_poly_randtest(a, state, 1 + n_randint(state, 200), bits, 10);
+        acb_poly_randtest(b, state, 1 + n_randint(state, 200), bits, 10);
+
+        if (n_randint(state, 4) == 0)
+            acb_poly_set(b, a);
+
+        flint_set_num_threads(1);
+        acb_poly_mullow_transpose(c, a, b, trunc, bits);
+
+        flint_set_num_threads(2 + n_randint(state, max_threads - 1));
+        acb_poly_mullow_transpose(d, a, b, trunc, bits);
+
+        if (!acb_poly_equal(c, d))
+        {
+            flint_printf("FAIL (threads)\n\n");
+            flint_printf("bits = %wd\n", bits);
+            flint_printf("trunc = %wd\n", trunc);
+            flint_abort();
+        }
+
+        flint_set_num_threads(1);
+        acb_poly_mullow_transpose(c, a, a, trunc, bits);
+
+        flint_set_num_threads(2 + n_randint(state, max_threads - 1));
+        acb_poly_mullow_transpose(d, a, a, trunc, bits);
+
+        if (!acb_poly_equal(c, d))
+        {
+            flint_printf("FAIL (threads, squaring)\n\n");
+            flint_printf("bits = %wd\n", bits);
+            flint_printf("trunc = %wd\n", trunc);
+            flint_abort();
+        }
+
+        acb_poly_clear(a);
+        acb_poly_clear(b);
+        acb_poly_clear(c);
+        acb_poly_clear(d);
+    }
+
     flint_randclear(state);
-    flint_cleanup();
+    flint_cleanup_master();
     flint_printf("PASS\n");
     return 0;
 }
@@ -329,6 +329,88 @@ int arb_fpwrap_cdouble_modular_j(complex_double * res, complex_double tau, int f
 int arb_fpwrap_cdouble_modular_lambda(complex_double * res, complex_double tau, int flags);
 int arb_fpwrap_cdouble_modular_delta(complex_double * res, complex_double tau, int flags);
 
+/* Vector versions */
+
+int arb_fpwrap_double_vec_exp(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_exp(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_expm1(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_expm1(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_log(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_log(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_log1p(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_log1p(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_pow(double * res, const double * x, const double * y, slong n, int flags);
+int arb_fpwrap_cdouble_vec_pow(complex_double * res, const complex_double * x, const complex_double * y, slong n, int flags);
+
+int arb_fpwrap_double_vec_sqrt(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_sqrt(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_rsqrt(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_rsqrt(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_cbrt(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_cbrt(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_sin(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_sin(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_cos(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_cos(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_tan(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_tan(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_sin_pi(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_sin_pi(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_cos_pi(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_cos_pi(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_asin(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_asin(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_acos(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_acos(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_atan(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_atan(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_atan2(double * res, const double * x1, const double * x2, slong n, int flags);
+
+int arb_fpwrap_double_vec_asinh(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_asinh(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_acosh(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_acosh(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_atanh(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_atanh(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_gamma(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_gamma(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_rgamma(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_rgamma(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_lgamma(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_lgamma(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_digamma(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_digamma(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_zeta(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_zeta(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_erf(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_erf(complex_double * res, const complex_double * x, slong n, int flags);
+
+int arb_fpwrap_double_vec_erfc(double * res, const double * x, slong n, int flags);
+int arb_fpwrap_cdouble_vec_erfc(complex_double * res, const complex_double * x, slong n, int flags);
+
 #ifdef __cplusplus
 }
 #endif
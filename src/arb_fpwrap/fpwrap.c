@@ -9,6 +9,7 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
 #include "double_extras.h"
 #include "acb.h"
 #include "acb_dirichlet.h"
@@ -17,6 +18,7 @@
 #include "acb_elliptic.h"
 #include "acb_modular.h"
 #include "arb_fpwrap.h"
+#include "thread_support.h"
 
 int
 arb_accurate_enough_d(const arb_t x, int flags)
@@ -747,6 +749,310 @@ int arb_fpwrap_cdouble_4_int(complex_double * res, acb_func_4_int func, complex_
     return status;
 }
 
+/* Vector versions. A first pass evaluates every entry at the initial
+   working precision, reusing the temporaries within blocks of entries.
+   Only the entries that are not accurate after the first pass are
+   retried with increasing precision. Both passes are scheduled
+   dynamically over the available threads since the cost of an entry
+   can vary a lot; each entry is computed independently, so the output
+   does not depend on the number of threads. */
+
+#define FPWRAP_VEC_BLOCK 256
+
+#define FPWRAP_VEC_DONE 0
+#define FPWRAP_VEC_RETRY 1
+#define FPWRAP_VEC_FAIL 2
+
+typedef struct
+{
+    double * dres;
+    complex_double * cres;
+    const double * dx1;
+    const double * dx2;
+    const complex_double * cx1;
+    const complex_double * cx2;
+    arb_func_1 arb_f1;
+    arb_func_2 arb_f2;
+    acb_func_1 acb_f1;
+    acb_func_2 acb_f2;
+    slong n;
+    int flags;
+    char * status;
+    const slong * retry;
+}
+fpwrap_vec_struct;
+
+static void
+_fpwrap_vec_set_nan(fpwrap_vec_struct * work, slong i)
+{
+    if (work->dres != NULL)
+    {
+        work->dres[i] = D_NAN;
+    }
+    else
+    {
+        work->cres[i].real = D_NAN;
+        work->cres[i].imag = D_NAN;
+    }
+}
+
+/* sets the inputs of entry i; returns 0 if some input is not finite */
+static int
+_fpwrap_vec_set_input(acb_t x1, acb_t x2, const fpwrap_vec_struct * work, slong i)
+{
+    if (work->dres != NULL)
+    {
+        arb_set_d(acb_realref(x1), work->dx1[i]);
+        if (work->dx2 != NULL)
+            arb_set_d(acb_realref(x2), work->dx2[i]);
+
+        return arb_is_finite(acb_realref(x1)) &&
+            (work->dx2 == NULL || arb_is_finite(acb_realref(x2)));
+    }
+    else
+    {
+        acb_set_d_d(x1, work->cx1[i].real, work->cx1[i].imag);
+        if (work->cx2 != NULL)
+            acb_set_d_d(x2, work->cx2[i].real, work->cx2[i].imag);
+
+        return acb_is_finite(x1) && (work->cx2 == NULL || acb_is_finite(x2));
+    }
+}
+
+/* evaluates entry i at precision wp; returns 1 and sets the output if the
+   result is accurate enough */
+static int
+_fpwrap_vec_eval(acb_t res, const acb_t x1, const acb_t x2,
+    fpwrap_vec_struct * work, slong i, slong wp)
+{
+    int flags = work->flags;
+
+    if (work->dres != NULL)
+    {
+        if (work->dx2 == NULL)
+            work->arb_f1(acb_realref(res), acb_realref(x1), wp);
+        else
+            work->arb_f2(acb_realref(res), acb_realref(x1), acb_realref(x2), wp);
+
+        if (!arb_accurate_enough_d(acb_realref(res), flags))
+            return 0;
+
+        work->dres[i] = arf_get_d(arb_midref(acb_realref(res)), ARF_RND_NEAR);
+    }
+    else
+    {
+        if (work->cx2 == NULL)
+            work->acb_f1(res, x1, wp);
+        else
+            work->acb_f2(res, x1, x2, wp);
+
+        if (!acb_accurate_enough_d(res, flags))
+            return 0;
+
+        work->cres[i].real = arf_get_d(arb_midref(acb_realref(res)), ARF_RND_NEAR);
+        work->cres[i].imag = arf_get_d(arb_midref(acb_imagref(res)), ARF_RND_NEAR);
+    }
+
+    return 1;
+}
+
+static void
+_fpwrap_vec_first_pass(slong b, fpwrap_vec_struct * work)
+{
+    acb_t res, x1, x2;
+    slong i, start, stop;
+
+    start = b * FPWRAP_VEC_BLOCK;
+    stop = FLINT_MIN(start + FPWRAP_VEC_BLOCK, work->n);
+
+    acb_init(res);
+    acb_init(x1);
+    acb_init(x2);
+
+    for (i = start; i < stop; i++)
+    {
+        if (!_fpwrap_vec_set_input(x1, x2, work, i))
+        {
+            _fpwrap_vec_set_nan(work, i);
+            work->status[i] = FPWRAP_VEC_FAIL;
+        }
+        else if (_fpwrap_vec_eval(res, x1, x2, work, i, WP_INITIAL))
+        {
+            work->status[i] = FPWRAP_VEC_DONE;
+        }
+        else
+        {
+            work->status[i] = FPWRAP_VEC_RETRY;
+        }
+    }
+
+    acb_clear(res);
+    acb_clear(x1);
+    acb_clear(x2);
+}
+
+static void
+_fpwrap_vec_retry(slong j, fpwrap_vec_struct * work)
+{
+    acb_t res, x1, x2;
+    slong i, wp;
+
+    i = work->retry[j];
+
+    acb_init(res);
+    acb_init(x1);
+    acb_init(x2);
+
+    _fpwrap_vec_set_input(x1, x2, work, i);
+
+    for (wp = 2 * WP_INITIAL; ; wp *= 2)
+    {
+        if (_fpwrap_vec_eval(res, x1, x2, work, i, wp))
+        {
+            work->status[i] = FPWRAP_VEC_DONE;
+            break;
+        }
+
+        if (wp >= double_wp_max(work->flags))
+        {
+            _fpwrap_vec_set_nan(work, i);
+            work->status[i] = FPWRAP_VEC_FAIL;
+            break;
+        }
+    }
+
+    acb_clear(res);
+    acb_clear(x1);
+    acb_clear(x2);
+}
+
+static int
+_arb_fpwrap_vec(fpwrap_vec_struct * work)
+{
+    slong i, num_retry, n = work->n;
+    slong * retry;
+    int status = FPWRAP_SUCCESS;
+
+    if (n <= 0)
+        return FPWRAP_SUCCESS;
+
+    work->status = flint_malloc(n * sizeof(char));
+
+    flint_parallel_do((do_func_t) _fpwrap_vec_first_pass, work,
+        (n + FPWRAP_VEC_BLOCK - 1) / FPWRAP_VEC_BLOCK, -1,
+        FLINT_PARALLEL_DYNAMIC);
+
+    num_retry = 0;
+    for (i = 0; i < n; i++)
+        num_retry += (work->status[i] == FPWRAP_VEC_RETRY);
+
+    if (num_retry != 0)
+    {
+        retry = flint_malloc(num_retry * sizeof(slong));
+
+        num_retry = 0;
+        for (i = 0; i < n; i++)
+            if (work->status[i] == FPWRAP_VEC_RETRY)
+                retry[num_retry++] = i;
+
+        work->retry = retry;
+        flint_parallel_do((do_func_t) _fpwrap_vec_retry, work, num_retry, -1,
+            FLINT_PARALLEL_DYNAMIC);
+
+        flint_free(retry);
+    }
+
+    for (i = 0; i < n; i++)
+        if (work->status[i] != FPWRAP_VEC_DONE)
+            status = FPWRAP_UNABLE;
+
+    flint_free(work->status);
+
+    return status;
+}
+
+static void
+_fpwrap_vec_init(fpwrap_vec_struct * work, slong n, int flags)
+{
+    memset(work, 0, sizeof(fpwrap_vec_struct));
+    work->n = n;
+    work->flags = flags;
+}
+
+int arb_fpwrap_double_vec_1(double * res, arb_func_1 func, const double * x, slong n, int flags)
+{
+    fpwrap_vec_struct work;
+
+    _fpwrap_vec_init(&work, n, flags);
+    work.dres = res;
+    work.dx1 = x;
+    work.arb_f1 = func;
+
+    return _arb_fpwrap_vec(&work);
+}
+
+int arb_fpwrap_double_vec_2(double * res, arb_func_2 func, const double * x1, const double * x2, slong n, int flags)
+{
+    fpwrap_vec_struct work;
+
+    _fpwrap_vec_init(&work, n, flags);
+    work.dres = res;
+    work.dx1 = x1;
+    work.dx2 = x2;
+    work.arb_f2 = func;
+
+    return _arb_fpwrap_vec(&work);
+}
+
+int arb_fpwrap_cdouble_vec_1(complex_double * res, acb_func_1 func, const complex_double * x, slong n, int flags)
+{
+    fpwrap_vec_struct work;
+
+    _fpwrap_vec_init(&work, n, flags);
+    work.cres = res;
+    work.cx1 = x;
+    work.acb_f1 = func;
+
+    return _arb_fpwrap_vec(&work);
+}
+
+int arb_fpwrap_cdouble_vec_2(complex_double * res, acb_func_2 func, const complex_double * x1, const complex_double * x2, slong n, int flags)
+{
+    fpwrap_vec_struct work;
+
+    _fpwrap_vec_init(&work, n, flags);
+    work.cres = res;
+    work.cx1 = x1;
+    work.cx2 = x2;
+    work.acb_f2 = func;
+
+    return _arb_fpwrap_vec(&work);
+}
+
+#define DEF_DOUBLE_VEC_FUN_1(name, arb_fun) \
+    int arb_fpwrap_double_vec_ ## name(double * res, const double * x, slong n, int flags) \
+    { \
+        return arb_fpwrap_double_vec_1(res, arb_fun, x, n, flags); \
+    } \
+
+#define DEF_DOUBLE_VEC_FUN_2(name, arb_fun) \
+    int arb_fpwrap_double_vec_ ## name(double * res, const double * x1, const double * x2, slong n, int flags) \
+    { \
+        return arb_fpwrap_double_vec_2(res, arb_fun, x1, x2, n, flags); \
+    } \
+
+#define DEF_CDOUBLE_VEC_FUN_1(name, acb_fun) \
+    int arb_fpwrap_cdouble_vec_ ## name(complex_double * res, const complex_double * x, slong n, int flags) \
+    { \
+        return arb_fpwrap_cdouble_vec_1(res, acb_fun, x, n, flags); \
+    } \
+
+#define DEF_CDOUBLE_VEC_FUN_2(name, acb_fun) \
+    int arb_fpwrap_cdouble_vec_ ## name(complex_double * res, const complex_double * x1, const complex_double * x2, slong n, int flags) \
+    { \
+        return arb_fpwrap_cdouble_vec_2(res, acb_fun, x1, x2, n, flags); \
+    } \
+
 #define DEF_DOUBLE_FUN_1(name, arb_fun) \
     int arb_fpwrap_double_ ## name(double * res, double x, int flags) \
     { \
@@ -1542,6 +1848,60 @@ int arb_fpwrap_cdouble_lambertw(complex_double * res, complex_double x, slong br
     return status;
 }
 
+DEF_DOUBLE_VEC_FUN_1(exp, arb_exp)
+DEF_CDOUBLE_VEC_FUN_1(exp, acb_exp)
+DEF_DOUBLE_VEC_FUN_1(expm1, arb_expm1)
+DEF_CDOUBLE_VEC_FUN_1(expm1, acb_expm1)
+DEF_DOUBLE_VEC_FUN_1(log, arb_log)
+DEF_CDOUBLE_VEC_FUN_1(log, acb_log)
+DEF_DOUBLE_VEC_FUN_1(log1p, arb_log1p)
+DEF_CDOUBLE_VEC_FUN_1(log1p, acb_log1p)
+DEF_DOUBLE_VEC_FUN_2(pow, arb_pow)
+DEF_CDOUBLE_VEC_FUN_2(pow, acb_pow)
+DEF_DOUBLE_VEC_FUN_1(sqrt, arb_sqrt)
+DEF_CDOUBLE_VEC_FUN_1(sqrt, acb_sqrt)
+DEF_DOUBLE_VEC_FUN_1(rsqrt, arb_rsqrt)
+DEF_CDOUBLE_VEC_FUN_1(rsqrt, acb_rsqrt)
+DEF_DOUBLE_VEC_FUN_1(cbrt, _arb_cbrt)
+DEF_CDOUBLE_VEC_FUN_1(cbrt, _acb_cbrt)
+DEF_DOUBLE_VEC_FUN_1(sin, arb_sin)
+DEF_CDOUBLE_VEC_FUN_1(sin, acb_sin)
+DEF_DOUBLE_VEC_FUN_1(cos, arb_cos)
+DEF_CDOUBLE_VEC_FUN_1(cos, acb_cos)
+DEF_DOUBLE_VEC_FUN_1(tan, arb_tan)
+DEF_CDOUBLE_VEC_FUN_1(tan, acb_tan)
+DEF_DOUBLE_VEC_FUN_1(sin_pi, arb_sin_pi)
+DEF_CDOUBLE_VEC_FUN_1(sin_pi, acb_sin_pi)
+DEF_DOUBLE_VEC_FUN_1(cos_pi, arb_cos_pi)
+DEF_CDOUBLE_VEC_FUN_1(cos_pi, acb_cos_pi)
+DEF_DOUBLE_VEC_FUN_1(asin, arb_asin)
+DEF_CDOUBLE_VEC_FUN_1(asin, acb_asin)
+DEF_DOUBLE_VEC_FUN_1(acos, arb_acos)
+DEF_CDOUBLE_VEC_FUN_1(acos, acb_acos)
+DEF_DOUBLE_VEC_FUN_1(atan, arb_atan)
+DEF_CDOUBLE_VEC_FUN_1(atan, acb_atan)
+DEF_DOUBLE_VEC_FUN_2(atan2, arb_atan2)
+DEF_DOUBLE_VEC_FUN_1(asinh, arb_asinh)
+DEF_CDOUBLE_VEC_FUN_1(asinh, acb_asinh)
+DEF_DOUBLE_VEC_FUN_1(acosh, arb_acosh)
+DEF_CDOUBLE_VEC_FUN_1(acosh, acb_acosh)
+DEF_DOUBLE_VEC_FUN_1(atanh, arb_atanh)
+DEF_CDOUBLE_VEC_FUN_1(atanh, acb_atanh)
+DEF_DOUBLE_VEC_FUN_1(gamma, arb_gamma)
+DEF_CDOUBLE_VEC_FUN_1(gamma, acb_gamma)
+DEF_DOUBLE_VEC_FUN_1(rgamma, arb_rgamma)
+DEF_CDOUBLE_VEC_FUN_1(rgamma, acb_rgamma)
+DEF_DOUBLE_VEC_FUN_1(lgamma, arb_lgamma)
+DEF_CDOUBLE_VEC_FUN_1(lgamma, acb_lgamma)
+DEF_DOUBLE_VEC_FUN_1(digamma, arb_digamma)
+DEF_CDOUBLE_VEC_FUN_1(digamma, acb_digamma)
+DEF_DOUBLE_VEC_FUN_1(zeta, arb_zeta)
+DEF_CDOUBLE_VEC_FUN_1(zeta, acb_zeta)
+DEF_DOUBLE_VEC_FUN_1(erf, arb_hypgeom_erf)
+DEF_CDOUBLE_VEC_FUN_1(erf, acb_hypgeom_erf)
+DEF_DOUBLE_VEC_FUN_1(erfc, arb_hypgeom_erfc)
+DEF_CDOUBLE_VEC_FUN_1(erfc, acb_hypgeom_erfc)
+
 /* todo: functions with multiple outputs */
 /* todo: elliptic invariants, roots */
 /* todo: eisenstein series */
@@ -0,0 +1,168 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "double_extras.h"
+#include "arb_fpwrap.h"
+
+static int
+d_same(double a, double b)
+{
+    return (a == b) || (a != a && b != b);
+}
+
+static double
+random_input(flint_rand_t state)
+{
+    switch (n_randint(state, 8))
+    {
+        case 0:
+            return D_NAN;
+        case 1:
+            return -(double) n_randint(state, 5);
+        case 2:
+            return ldexp(d_randtest(state), (int) n_randint(state, 80) - 40);
+        default:
+            return (d_randtest(state) - 0.5) * 20.0;
+    }
+}
+
+int main(void)
+{
+    slong iter;
+    flint_rand_t state;
+    const slong max_threads = 5;
+
+    flint_printf("fpwrap_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        double * x, * y, * res;
+        complex_double * cx, * cy, * cres;
+        slong i, n;
+        int which, flags, status, status2, ok;
+
+        n = n_randint(state, 1000);
+        which = n_randint(state, 6);
+        flags = n_randint(state, 2) ? 0 : FPWRAP_CORRECT_ROUNDING;
+        if (n_randint(state, 4) == 0)
+            flags += 2 * FPWRAP_WORK_LIMIT;
+
+        flint_set_num_threads(1 + n_randint(state, max_threads));
+
+        x = flint_malloc(n * sizeof(double));
+        y = flint_malloc(n * sizeof(double));
+        res = flint_malloc(n * sizeof(double));
+        cx = flint_malloc(n * sizeof(complex_double));
+        cy = flint_malloc(n * sizeof(complex_double));
+        cres = flint_malloc(n * sizeof(complex_double));
+
+        for (i = 0; i < n; i++)
+        {
+            x[i] = random_input(state);
+            y[i] = random_input(state);
+            cx[i].real = random_input(state);
+            cx[i].imag = random_input(state);
+            cy[i].real = random_input(state);
+            cy[i].imag = random_input(state);
+        }
+
+        switch (which)
+        {
+            case 0:
+                status = arb_fpwrap_double_vec_log(res, x, n, flags);
+                break;
+            case 1:
+                status = arb_fpwrap_double_vec_lgamma(res, x, n, flags);
+                break;
+            case 2:
+                status = arb_fpwrap_double_vec_atan2(res, x, y, n, flags);
+                break;
+            case 3:
+                status = arb_fpwrap_cdouble_vec_sqrt(cres, cx, n, flags);
+                break;
+            case 4:
+                status = arb_fpwrap_cdouble_vec_pow(cres, cx, cy, n, flags);
+                break;
+            default:
+                status = arb_fpwrap_double_vec_sin_pi(res, x, n, flags);
+                break;
+        }
+
+        status2 = FPWRAP_SUCCESS;
+
+        for (i = 0; i < n; i++)
+        {
+            double t;
+            complex_double ct;
+            int s;
+
+            switch (which)
+            {
+                case 0:
+                    s = arb_fpwrap_double_log(&t, x[i], flags);
+                    ok = d_same(t, res[i]);
+                    break;
+                case 1:
+                    s = arb_fpwrap_double_lgamma(&t, x[i], flags);
+                    ok = d_same(t, res[i]);
+                    break;
+                case 2:
+                    s = arb_fpwrap_double_atan2(&t, x[i], y[i], flags);
+                    ok = d_same(t, res[i]);
+                    break;
+                case 3:
+                    s = arb_fpwrap_cdouble_sqrt(&ct, cx[i], flags);
+                    ok = d_same(ct.real, cres[i].real) && d_same(ct.imag, cres[i].imag);
+                    break;
+                case 4:
+                    s = arb_fpwrap_cdouble_pow(&ct, cx[i], cy[i], flags);
+                    ok = d_same(ct.real, cres[i].real) && d_same(ct.imag, cres[i].imag);
+                    break;
+                default:
+                    s = arb_fpwrap_double_sin_pi(&t, x[i], flags);
+                    ok = d_same(t, res[i]);
+                    break;
+            }
+
+            if (s != FPWRAP_SUCCESS)
+                status2 = FPWRAP_UNABLE;
+
+            if (!ok)
+            {
+                flint_printf("FAIL: value\n");
+                flint_printf("which = %d, flags = %d, n = %wd, i = %wd\n", which, flags, n, i);
+                flint_abort();
+            }
+        }
+
+        if (status != status2)
+        {
+            flint_printf("FAIL: status\n");
+            flint_printf("which = %d, flags = %d, n = %wd\n", which, flags, n);
+            flint_abort();
+        }
+
+        flint_free(x);
+        flint_free(y);
+        flint_free(res);
+        flint_free(cx);
+        flint_free(cy);
+        flint_free(cres);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -9,9 +9,11 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
 #include "fmpz_vec.h"
 #include "fmpz_poly.h"
 #include "arb_poly.h"
+#include "thread_support.h"
 
 #ifdef __GNUC__
 # define ldexp __builtin_ldexp
@@ -89,6 +91,10 @@ _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, slong xlen,
    numbers of size (2^(-DOUBLE_BLOCK_SHIFT))^2 must not underflow. */
 #define DOUBLE_BLOCK_SHIFT (DOUBLE_BLOCK_MAX_HEIGHT / 2)
 
+/* Use the threaded version when min(xlen, ylen) * prec is at least this
+   large (and more than one thread is available). */
+#define MULLOW_BLOCK_THREAD_CUTOFF 20000.0
+
 
 static void
 _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
@@ -462,6 +468,358 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
     fmpz_clear(zexp);
 }
 
+/* Adds the propagated error of the product to the radii of z. The fmpz
+   and block buffers must have room for max(xlen, ylen) entries (plus one
+   for the block arrays) and zz must have room for n entries. */
+static void
+_arb_poly_mullow_block_rad(arb_ptr z, fmpz * xz, fmpz * yz, fmpz * zz,
+    fmpz * xe, fmpz * ye, slong * xblocks, slong * yblocks,
+    const fmpz_t scale, arb_srcptr x, slong xlen, slong xmlen, slong xrlen,
+    arb_srcptr y, slong ylen, slong ymlen, slong yrlen, slong n, int squaring)
+{
+    mag_ptr tmp;
+    double *xdbl, *ydbl;
+    slong i;
+
+    /* (xm + xr)*(ym + yr) = (xm*ym) + (xr*ym + xm*yr + xr*yr)
+                           = (xm*ym) + (xm*yr + xr*(ym + yr))  */
+    tmp = _mag_vec_init(FLINT_MAX(xlen, ylen));
+    xdbl = flint_malloc(sizeof(double) * xlen);
+    ydbl = flint_malloc(sizeof(double) * ylen);
+
+    /* (xm + xr)^2 = (xm*ym) + (xr^2 + 2 xm xr)
+                   = (xm*ym) + xr*(2 xm + xr)    */
+    if (squaring)
+    {
+        _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+
+        for (i = 0; i < xlen; i++)
+        {
+            arf_get_mag(tmp + i, arb_midref(x + i));
+            mag_mul_2exp_si(tmp + i, tmp + i, 1);
+            mag_add(tmp + i, tmp + i, arb_radref(x + i));
+        }
+
+        _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, xlen);
+        _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, xlen, n);
+    }
+    else if (yrlen == 0)
+    {
+        /* xr * |ym| */
+        _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+
+        for (i = 0; i < ymlen; i++)
+            arf_get_mag(tmp + i, arb_midref(y + i));
+
+        _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ymlen);
+        _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ymlen, n);
+    }
+    else
+    {
+        /* |xm| * yr */
+        for (i = 0; i < xmlen; i++)
+            arf_get_mag(tmp + i, arb_midref(x + i));
+
+        _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, NULL, tmp, xmlen);
+        _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, y, NULL, yrlen);
+        _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xmlen, yz, ydbl, ye, yblocks, yrlen, n);
+
+        /* xr*(|ym| + yr) */
+        if (xrlen != 0)
+        {
+            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+
+            for (i = 0; i < ylen; i++)
+                arb_get_mag(tmp + i, y + i);
+
+            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ylen);
+            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ylen, n);
+        }
+    }
+
+    _mag_vec_clear(tmp, FLINT_MAX(xlen, ylen));
+    flint_free(xdbl);
+    flint_free(ydbl);
+}
+
+/* Threaded version: the block products, and the radius computation, are
+   independent and are computed concurrently into separate buffers. The
+   products are then added to z in the same order as in the serial code,
+   so the output does not depend on the number of threads. To bound the
+   memory usage, the block products are done in rounds of at most
+   num_threads products. */
+
+typedef struct
+{
+    slong xi;
+    slong yj;
+    slong xp;
+    slong yp;
+    slong xl;
+    slong yl;
+    slong bn;
+    int square;
+}
+block_pair_struct;
+
+static void
+_block_pairs_push(block_pair_struct ** pairs, slong * len, slong * alloc,
+    slong xi, slong yj, slong xp, slong yp, slong xl, slong yl, slong bn,
+    int square)
+{
+    block_pair_struct * pair;
+
+    if (*len == *alloc)
+    {
+        *alloc = FLINT_MAX(2 * (*alloc), 4);
+        *pairs = flint_realloc(*pairs, (*alloc) * sizeof(block_pair_struct));
+    }
+
+    pair = *pairs + *len;
+    pair->xi = xi;
+    pair->yj = yj;
+    pair->xp = xp;
+    pair->yp = yp;
+    pair->xl = xl;
+    pair->yl = yl;
+    pair->bn = bn;
+    pair->square = square;
+    (*len)++;
+}
+
+typedef struct
+{
+    /* block products of this round */
+    const block_pair_struct * pairs;
+    fmpz ** zzs;
+    const fmpz * xz;
+    const fmpz * yz;
+    /* radius computation (done by task 0 if rad is set) */
+    int rad;
+    arb_ptr zr;
+    fmpz * rxz;
+    fmpz * ryz;
+    fmpz * rzz;
+    fmpz * rxe;
+    fmpz * rye;
+    slong * rxblocks;
+    slong * ryblocks;
+    const fmpz * scale;
+    arb_srcptr x;
+    arb_srcptr y;
+    slong xlen, xmlen, xrlen, ylen, ymlen, yrlen, n;
+    int squaring;
+}
+mullow_block_work_t;
+
+static void
+_arb_poly_mullow_block_worker(slong k, mullow_block_work_t * w)
+{
+    const block_pair_struct * pair;
+
+    if (w->rad)
+    {
+        if (k == 0)
+        {
+            _arb_poly_mullow_block_rad(w->zr, w->rxz, w->ryz, w->rzz,
+                w->rxe, w->rye, w->rxblocks, w->ryblocks, w->scale,
+                w->x, w->xlen, w->xmlen, w->xrlen,
+                w->y, w->ylen, w->ymlen, w->yrlen, w->n, w->squaring);
+            return;
+        }
+
+        k--;
+    }
+
+    pair = w->pairs + k;
+
+    if (pair->square)
+        _fmpz_poly_sqrlow(w->zzs[k], w->xz + pair->xp, pair->xl, pair->bn);
+    else if (pair->xl >= pair->yl)
+        _fmpz_poly_mullow(w->zzs[k], w->xz + pair->xp, pair->xl,
+                                     w->yz + pair->yp, pair->yl, pair->bn);
+    else
+        _fmpz_poly_mullow(w->zzs[k], w->yz + pair->yp, pair->yl,
+                                     w->xz + pair->xp, pair->xl, pair->bn);
+}
+
+static void
+_arb_poly_mullow_block_threaded(arb_ptr z, arb_srcptr x, slong xlen,
+    slong xmlen, slong xrlen, arb_srcptr y, slong ylen, slong ymlen,
+    slong yrlen, const fmpz_t scale, slong n, slong prec, int squaring)
+{
+    mullow_block_work_t work;
+    block_pair_struct * pairs;
+    fmpz *xz, *yz, *xe, *ye;
+    slong *xblocks, *yblocks;
+    const slong * yb;
+    slong i, j, k, xp, yp, xl, yl, bn, num_pairs, alloc, round, round_len;
+    slong num_threads;
+    fmpz_t zexp;
+    int rad;
+
+    num_threads = flint_get_num_threads();
+    rad = (xrlen != 0 || yrlen != 0);
+
+    memset(&work, 0, sizeof(work));
+
+    xz = _fmpz_vec_init(xlen);
+    yz = _fmpz_vec_init(ylen);
+    xe = _fmpz_vec_init(xlen);
+    ye = _fmpz_vec_init(ylen);
+    xblocks = flint_malloc(sizeof(slong) * (xlen + 1));
+    yblocks = flint_malloc(sizeof(slong) * (ylen + 1));
+
+    num_pairs = 0;
+    pairs = NULL;
+
+    if (xmlen != 0 && ymlen != 0)
+    {
+        _arb_vec_get_fmpz_2exp_blocks(xz, xe, xblocks, scale, x, xmlen, prec);
+
+        if (!squaring)
+            _arb_vec_get_fmpz_2exp_blocks(yz, ye, yblocks, scale, y, ymlen, prec);
+
+        /* enumerate the block products in the order of
+           _arb_poly_addmullow_block */
+        alloc = 0;
+        yb = squaring ? xblocks : yblocks;
+
+        if (squaring)
+        {
+            for (i = 0; (xp = xblocks[i]) != xmlen; i++)
+            {
+                if (2 * xp >= n)
+                    continue;
+
+                xl = xblocks[i + 1] - xp;
+                bn = FLINT_MIN(2 * xl - 1, n - 2 * xp);
+                xl = FLINT_MIN(xl, bn);
+
+                _block_pairs_push(&pairs, &num_pairs, &alloc, i, i, xp, xp, xl, xl, bn, 1);
+            }
+        }
+
+        for (i = 0; (xp = xblocks[i]) != xmlen; i++)
+        {
+            for (j = squaring ? i + 1 : 0; (yp = yb[j]) != ymlen; j++)
+            {
+                if (xp + yp >= n)
+                    continue;
+
+                xl = xblocks[i + 1] - xp;
+                yl = yb[j + 1] - yp;
+                bn = FLINT_MIN(xl + yl - 1, n - xp - yp);
+                xl = FLINT_MIN(xl, bn);
+                yl = FLINT_MIN(yl, bn);
+
+                _block_pairs_push(&pairs, &num_pairs, &alloc, i, j, xp, yp, xl, yl, bn, 0);
+            }
+        }
+    }
+
+    work.xz = xz;
+    work.yz = squaring ? xz : yz;
+    work.zzs = flint_malloc(sizeof(fmpz *) * num_threads);
+
+    if (rad)
+    {
+        slong len = FLINT_MAX(xlen, ylen);
+
+        work.rad = 1;
+        work.zr = _arb_vec_init(n);
+        work.rxz = _fmpz_vec_init(len);
+        work.ryz = _fmpz_vec_init(len);
+        work.rzz = _fmpz_vec_init(n);
+        work.rxe = _fmpz_vec_init(len);
+        work.rye = _fmpz_vec_init(len);
+        work.rxblocks = flint_malloc(sizeof(slong) * (len + 1));
+        work.ryblocks = flint_malloc(sizeof(slong) * (len + 1));
+        work.scale = scale;
+        work.x = x;
+        work.y = y;
+        work.xlen = xlen;
+        work.xmlen = xmlen;
+        work.xrlen = xrlen;
+        work.ylen = ylen;
+        work.ymlen = ymlen;
+        work.yrlen = yrlen;
+        work.n = n;
+        work.squaring = squaring;
+    }
+
+    fmpz_init(zexp);
+
+    round = 0;
+
+    do
+    {
+        round_len = FLINT_MIN(num_threads, num_pairs - round);
+
+        work.pairs = pairs + round;
+        for (k = 0; k < round_len; k++)
+            work.zzs[k] = _fmpz_vec_init(pairs[round + k].bn);
+
+        flint_parallel_do((do_func_t) _arb_poly_mullow_block_worker, &work,
+            round_len + work.rad, -1, FLINT_PARALLEL_DYNAMIC);
+
+        /* the serial code computes the radii first, starting from zero */
+        if (work.rad)
+        {
+            for (i = 0; i < n; i++)
+                mag_swap(arb_radref(z + i), arb_radref(work.zr + i));
+
+            work.rad = 0;
+        }
+
+        for (k = 0; k < round_len; k++)
+        {
+            const block_pair_struct * pair = pairs + round + k;
+            const fmpz * zz = work.zzs[k];
+
+            if (pair->square)
+                _fmpz_add2_fast(zexp, xe + pair->xi, xe + pair->xi, 0);
+            else
+                _fmpz_add2_fast(zexp, xe + pair->xi,
+                    (squaring ? xe : ye) + pair->yj, squaring);
+
+            for (i = 0; i < pair->bn; i++)
+                arb_add_fmpz_2exp(z + pair->xp + pair->yp + i,
+                    z + pair->xp + pair->yp + i, zz + i, zexp, prec);
+
+            _fmpz_vec_clear(work.zzs[k], pair->bn);
+        }
+
+        round += round_len;
+    }
+    while (round < num_pairs);
+
+    fmpz_clear(zexp);
+
+    if (rad)
+    {
+        slong len = FLINT_MAX(xlen, ylen);
+
+        _arb_vec_clear(work.zr, n);
+        _fmpz_vec_clear(work.rxz, len);
+        _fmpz_vec_clear(work.ryz, len);
+        _fmpz_vec_clear(work.rzz, n);
+        _fmpz_vec_clear(work.rxe, len);
+        _fmpz_vec_clear(work.rye, len);
+        flint_free(work.rxblocks);
+        flint_free(work.ryblocks);
+    }
+
+    flint_free(work.zzs);
+    flint_free(pairs);
+    _fmpz_vec_clear(xz, xlen);
+    _fmpz_vec_clear(yz, ylen);
+    _fmpz_vec_clear(xe, xlen);
+    _fmpz_vec_clear(ye, ylen);
+    flint_free(xblocks);
+    flint_free(yblocks);
+}
+
 void
 _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
                                 arb_srcptr y, slong ylen, slong n, slong prec)
@@ -517,97 +875,54 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
 
     fmpz_init(scale);
     fmpz_init(t);
-    xz = _fmpz_vec_init(xlen);
-    yz = _fmpz_vec_init(ylen);
-    zz = _fmpz_vec_init(n);
-    xe = _fmpz_vec_init(xlen);
-    ye = _fmpz_vec_init(ylen);
-    xblocks = flint_malloc(sizeof(slong) * (xlen + 1));
-    yblocks = flint_malloc(sizeof(slong) * (ylen + 1));
 
     _arb_poly_get_scale(scale, x, xlen, y, ylen);
 
-    /* Error propagation */
-    /* (xm + xr)*(ym + yr) = (xm*ym) + (xr*ym + xm*yr + xr*yr)
-                           = (xm*ym) + (xm*yr + xr*(ym + yr))  */
-    if (xrlen != 0 || yrlen != 0)
+    if (flint_get_num_threads() > 1 &&
+        (double) FLINT_MIN(xlen, ylen) * FLINT_MIN(prec, WORD(1) << 20)
+            >= MULLOW_BLOCK_THREAD_CUTOFF)
     {
-        mag_ptr tmp;
-        double *xdbl, *ydbl;
-
-        tmp = _mag_vec_init(FLINT_MAX(xlen, ylen));
-        xdbl = flint_malloc(sizeof(double) * xlen);
-        ydbl = flint_malloc(sizeof(double) * ylen);
-
-        /* (xm + xr)^2 = (xm*ym) + (xr^2 + 2 xm xr)
-                       = (xm*ym) + xr*(2 xm + xr)    */
-        if (squaring)
+        _arb_poly_mullow_block_threaded(z, x, xlen, xmlen, xrlen,
+            y, ylen, ymlen, yrlen, scale, n, prec, squaring);
+    }
+    else
+    {
+        xz = _fmpz_vec_init(xlen);
+        yz = _fmpz_vec_init(ylen);
+        zz = _fmpz_vec_init(n);
+        xe = _fmpz_vec_init(xlen);
+        ye = _fmpz_vec_init(ylen);
+        xblocks = flint_malloc(sizeof(slong) * (xlen + 1));
+        yblocks = flint_malloc(sizeof(slong) * (ylen + 1));
+
+        /* Error propagation */
+        if (xrlen != 0 || yrlen != 0)
+            _arb_poly_mullow_block_rad(z, xz, yz, zz, xe, ye, xblocks, yblocks,
+                scale, x, xlen, xmlen, xrlen, y, ylen, ymlen, yrlen, n, squaring);
+
+        /* multiply midpoints */
+        if (xmlen != 0 && ymlen != 0)
         {
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+            _arb_vec_get_fmpz_2exp_blocks(xz, xe, xblocks, scale, x, xmlen, prec);
 
-            for (i = 0; i < xlen; i++)
+            if (squaring)
             {
-                arf_get_mag(tmp + i, arb_midref(x + i));
-                mag_mul_2exp_si(tmp + i, tmp + i, 1);
-                mag_add(tmp + i, tmp + i, arb_radref(x + i));
+                _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, xz, xe, xblocks, xmlen, n, prec, 1);
             }
-
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, xlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, xlen, n);
-        }
-        else if (yrlen == 0)
-        {
-            /* xr * |ym| */
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
-
-            for (i = 0; i < ymlen; i++)
-                arf_get_mag(tmp + i, arb_midref(y + i));
-
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ymlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ymlen, n);
-        }
-        else
-        {
-            /* |xm| * yr */
-            for (i = 0; i < xmlen; i++)
-                arf_get_mag(tmp + i, arb_midref(x + i));
-
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, NULL, tmp, xmlen);
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, y, NULL, yrlen);
-            _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xmlen, yz, ydbl, ye, yblocks, yrlen, n);
-
-            /* xr*(|ym| + yr) */
-            if (xrlen != 0)
+            else
             {
-                _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
-
-                for (i = 0; i < ylen; i++)
-                    arb_get_mag(tmp + i, y + i);
-
-                _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ylen);
-                _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ylen, n);
+                _arb_vec_get_fmpz_2exp_blocks(yz, ye, yblocks, scale, y, ymlen, prec);
+                _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, yz, ye, yblocks, ymlen, n, prec, 0);
             }
         }
 
-        _mag_vec_clear(tmp, FLINT_MAX(xlen, ylen));
-        flint_free(xdbl);
-        flint_free(ydbl);
-    }
-
-    /* multiply midpoints */
-    if (xmlen != 0 && ymlen != 0)
-    {
-        _arb_vec_get_fmpz_2exp_blocks(xz, xe, xblocks, scale, x, xmlen, prec);
-
-        if (squaring)
-        {
-            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, xz, xe, xblocks, xmlen, n, prec, 1);
-        }
-        else
-        {
-            _arb_vec_get_fmpz_2exp_blocks(yz, ye, yblocks, scale, y, ymlen, prec);
-            _arb_poly_addmullow_block(z, zz, xz, xe, xblocks, xmlen, yz, ye, yblocks, ymlen, n, prec, 0);
-        }
+        _fmpz_vec_clear(xz, xlen);
+        _fmpz_vec_clear(yz, ylen);
+        _fmpz_vec_clear(zz, n);
+        _fmpz_vec_clear(xe, xlen);
+        _fmpz_vec_clear(ye, ylen);
+        flint_free(xblocks);
+        flint_free(yblocks);
     }
 
     /* Unscale. */
@@ -621,13 +936,6 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
         }
     }
 
-    _fmpz_vec_clear(xz, xlen);
-    _fmpz_vec_clear(yz, ylen);
-    _fmpz_vec_clear(zz, n);
-    _fmpz_vec_clear(xe, xlen);
-    _fmpz_vec_clear(ye, ylen);
-    flint_free(xblocks);
-    flint_free(yblocks);
     fmpz_clear(scale);
     fmpz_clear(t);
 }
@@ -16,6 +16,7 @@ int main(void)
 {
     slong iter;
     flint_rand_t state;
+    const slong max_threads = 5;
 
     flint_printf("mullow_block....");
     fflush(stdout);
@@ -202,8 +203,68 @@ int main(void)
         arb_poly_clear(abc2);
     }
 
+    /* the threaded version must give the same result as the serial one */
+    for (iter = 0; iter < 500 * 0.1 * flint_test_multiplier(); iter++)
+    {
+        slong rbits1, rbits2, rbits3, trunc, i;
+        arb_poly_t a, b, c, d;
+
+        rbits1 = 2 + n_randint(state, 2000);
+        rbits2 = 2 + n_randint(state, 2000);
+        rbits3 = 2 + n_randint(state, 2000);
+        trunc = n_randint(state, 400);
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_randtest(a, state, 1 + n_randint(state, 300), rbits1, 1 + n_randint(state, 100));
+        arb_poly_randtest(b, state, 1 + n_randint(state, 300), rbits2, 1 + n_randint(state, 100));
+
+        if (n_randint(state, 2))
+            for (i = 0; i < a->length; i++)
+                mag_zero(arb_radref(a->coeffs + i));
+
+        if (n_randint(state, 4) == 0)
+            arb_poly_set(b, a);
+
+        flint_set_num_threads(1);
+        arb_poly_mullow_block(c, a, b, trunc, rbits3);
+
+        flint_set_num_threads(2 + n_randint(state, max_threads - 1));
+        arb_poly_mullow_block(d, a, b, trunc, rbits3);
+
+        if (!arb_poly_equal(c, d))
+        {
+            flint_printf("FAIL (threads)\n\n");
+            flint_printf("bits3 = %wd\n", rbits3);
+            flint_printf("trunc = %wd\n", trunc);
+            flint_abort();
+        }
+
+        flint_set_num_threads(1);
+        arb_poly_mullow_block(c, a, a, trunc, rbits3);
+
+        flint_set_num_threads(2 + n_randint(state, max_threads - 1));
+        arb_poly_mullow_block(d, a, a, trunc, rbits3);
+
+        if (!arb_poly_equal(c, d))
+        {
+            flint_printf("FAIL (threads, squaring)\n\n");
+            flint_printf("bits3 = %wd\n", rbits3);
+            flint_printf("trunc = %wd\n", trunc);
+            flint_abort();
+        }
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
     flint_randclear(state);
-    flint_cleanup();
+    flint_cleanup_master();
     flint_printf("PASS\n");
     return 0;
 }
@@ -18,6 +18,18 @@
 #define BLK_SZ 256
 #define BLK_SHIFT 10
 
+/*
+    If the library is compiled for AVX2 but not for AVX512F, an AVX512F version
+    of the transforms and of _convert_block is compiled in avx512.c and used
+    when FLINT_CPU_HAVE reports that the processor supports it.
+*/
+#if defined(__AVX2__) && !defined(__AVX512F__) && defined(__x86_64__) && \
+    defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 5
+# define FFT_SMALL_AVX512_DISPATCH 1
+#else
+# define FFT_SMALL_AVX512_DISPATCH 0
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -247,6 +259,12 @@ FLINT_DLL void sd_fft_trunc(const sd_fft_lctx_t Q, ulong I, ulong S, ulong k, ul
 /* sd_ifft.c */
 FLINT_DLL void sd_ifft_trunc(const sd_fft_lctx_t Q, ulong I, ulong S, ulong k, ulong j, ulong z, ulong n, int f);
 
+#if FFT_SMALL_AVX512_DISPATCH
+/* avx512.c */
+FLINT_DLL void _sd_fft_trunc_avx512(const sd_fft_lctx_t Q, ulong I, ulong S, ulong k, ulong j, ulong itrunc, ulong otrunc);
+FLINT_DLL void _sd_ifft_trunc_avx512(const sd_fft_lctx_t Q, ulong I, ulong S, ulong k, ulong j, ulong z, ulong n, int f);
+#endif
+
 /* sd_fft_ctx.c */
 FLINT_DLL void sd_fft_ctx_clear(sd_fft_ctx_t Q);
 FLINT_DLL void sd_fft_ctx_init_prime(sd_fft_ctx_t Q, ulong pp);
@@ -279,6 +297,13 @@ FLINT_INLINE void sd_fft_lctx_fft_trunc(sd_fft_lctx_t Q, double* d, ulong depth,
     FLINT_ASSERT(otrunc % BLK_SZ == 0);
     FLINT_ASSERT(Q->w2tab[depth - 1] != NULL);
     Q->data = d;
+#if FFT_SMALL_AVX512_DISPATCH
+    if (FLINT_CPU_HAVE(FLINT_CPU_X86_AVX512F))
+    {
+        _sd_fft_trunc_avx512(Q, 0, 1, depth - LG_BLK_SZ, 0, itrunc/BLK_SZ, otrunc/BLK_SZ);
+        return;
+    }
+#endif
     sd_fft_trunc(Q, 0, 1, depth - LG_BLK_SZ, 0, itrunc/BLK_SZ, otrunc/BLK_SZ);
 }
 
@@ -288,6 +313,13 @@ FLINT_INLINE void sd_fft_lctx_ifft_trunc(sd_fft_lctx_t Q, double* d, ulong depth
     FLINT_ASSERT(trunc % BLK_SZ == 0);
     FLINT_ASSERT(Q->w2tab[depth - 1] != NULL);
     Q->data = d;
+#if FFT_SMALL_AVX512_DISPATCH
+    if (FLINT_CPU_HAVE(FLINT_CPU_X86_AVX512F))
+    {
+        _sd_ifft_trunc_avx512(Q, 0, 1, depth - LG_BLK_SZ, 0, trunc/BLK_SZ, trunc/BLK_SZ, 0);
+        return;
+    }
+#endif
     sd_ifft_trunc(Q, 0, 1, depth - LG_BLK_SZ, 0, trunc/BLK_SZ, trunc/BLK_SZ, 0);
 }
 
@@ -429,6 +461,9 @@ typedef struct {
 typedef mpn_ctx_struct mpn_ctx_t[1];
 
 void _convert_block(ulong* Xs, sd_fft_ctx_struct* Rffts, double* d, ulong dstride, ulong np, ulong I);
+#if FFT_SMALL_AVX512_DISPATCH
+void _convert_block_avx512(ulong* Xs, sd_fft_ctx_struct* Rffts, double* d, ulong dstride, ulong np, ulong I);
+#endif
 ulong flint_mpn_nbits(const ulong* a, ulong an);
 int flint_mpn_cmp_ui_2exp(const ulong* a, ulong an, ulong b, ulong e);
 unsigned char flint_mpn_add_inplace_c(ulong* z, ulong zn, ulong* a, ulong an, unsigned char cf);
@@ -540,6 +575,35 @@ int _fmpz_poly_mul_mid_default_mpn_ctx(
     const fmpz * a, slong an,
     const fmpz * b, slong bn);
 
+typedef struct {
+    ulong depth;
+    ulong N;
+    ulong np;
+    ulong stride;
+    ulong bn;
+    ulong an_max;
+    flint_bitcnt_t abits_max;
+    double* bbuf;
+} fmpz_mul_precomp_struct;
+
+int _fmpz_mul_precomp_init(
+    fmpz_mul_precomp_struct* M,
+    const fmpz * b, ulong bn,
+    ulong an_max, flint_bitcnt_t abits_max,
+    mpn_ctx_t R);
+
+FLINT_INLINE void _fmpz_mul_precomp_clear(fmpz_mul_precomp_struct* M)
+{
+    if (M->bbuf != NULL)
+        flint_aligned_free(M->bbuf);
+}
+
+int _fmpz_poly_mul_mid_precomp(
+    fmpz * z, ulong zl, ulong zh,
+    const fmpz * a, ulong an,
+    const fmpz_mul_precomp_struct* M,
+    mpn_ctx_t R);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+/*
+    When the library is compiled for AVX2 only, the transforms of sd_fft.c and
+    sd_ifft.c and the conversion _convert_block are compiled a second time here
+    for AVX512F, where vec8d and vec8n are native 8-wide registers. The public
+    entry points select these versions at runtime if the processor supports
+    them. The condition must match FFT_SMALL_AVX512_DISPATCH in fft_small.h,
+    which cannot be included before the target is changed.
+*/
+
+#if defined(__AVX2__) && !defined(__AVX512F__) && defined(__x86_64__) && \
+    defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 5
+
+#pragma GCC target("avx512f")
+
+#define sd_fft_main_block _sd_fft_main_block_avx512
+#define sd_fft_main _sd_fft_main_avx512
+#define sd_fft_trunc_block _sd_fft_trunc_block_avx512
+#define sd_fft_trunc _sd_fft_trunc_avx512
+#define sd_ifft_main_block _sd_ifft_main_block_avx512
+#define sd_ifft_main _sd_ifft_main_avx512
+#define sd_ifft_trunc_block _sd_ifft_trunc_block_avx512
+#define sd_ifft_trunc _sd_ifft_trunc_avx512
+#define _convert_block _convert_block_avx512
+
+#include "sd_fft.c"
+#include "sd_ifft.c"
+#include "convert_block.c"
+
+#endif
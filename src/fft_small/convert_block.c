@@ -0,0 +1,48 @@
+/*
+    Copyright (C) 2022 Daniel Schultz
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fft_small.h"
+
+/* transpose a block */
+void _convert_block(
+    ulong* Xs,
+    sd_fft_ctx_struct* Rffts, double* d, ulong dstride,
+    ulong np,
+    ulong I)
+{
+#if FFT_SMALL_AVX512_DISPATCH
+    if (FLINT_CPU_HAVE(FLINT_CPU_X86_AVX512F))
+    {
+        _convert_block_avx512(Xs, Rffts, d, dstride, np, I);
+        return;
+    }
+#endif
+
+    for (ulong l = 0; l < np; l++)
+    {
+        vec8d p = vec8d_set_d(Rffts[l].p);
+        vec8d pinv = vec8d_set_d(Rffts[l].pinv);
+        double* x = sd_fft_ctx_blk_index(d + l*dstride, I);
+        ulong j = 0; do {
+            vec8d x0, x1;
+            vec8n y0, y1;
+            x0 = vec8d_load(x + j + 0);
+            x1 = vec8d_load(x + j + 8);
+            x0 = vec8d_reduce_to_0n(x0, p, pinv);
+            x1 = vec8d_reduce_to_0n(x1, p, pinv);
+            y0 = vec8d_convert_limited_vec8n(x0);
+            y1 = vec8d_convert_limited_vec8n(x1);
+            vec8n_store_unaligned(Xs + l*BLK_SZ + j + 0, y0);
+            vec8n_store_unaligned(Xs + l*BLK_SZ + j + 8, y1);
+        } while (j += 16, j < BLK_SZ);
+        FLINT_ASSERT(j == BLK_SZ);
+    }
+}
@@ -303,6 +303,22 @@ static void _crt_1(
     }
 }
 
+/*
+    The pointwise product for prime i also multiplies by the inverse of
+    2^depth times the i-th CRT cofactor, which the CRT stage expects.
+*/
+static ulong _point_mul_scale(
+    const sd_fft_ctx_struct* fft,
+    crt_data_struct* crt,
+    ulong np, ulong i, ulong depth)
+{
+    ulong cop, m;
+
+    cop = np == 1 ? 1 : *crt_data_co_prime_red(crt, i);
+    NMOD_RED2(m, cop >> (FLINT_BITS - depth), cop << depth, fft->mod);
+    return nmod_inv(m, fft->mod);
+}
+
 typedef struct {
     ulong np;
     ulong start_pi;
@@ -382,9 +398,7 @@ static void s1worker_func(void* varg)
                 thread_pool_wait(global_thread_pool, handles[0]);
         }
 
-        ulong cop = X->np == 1 ? 1 : *crt_data_co_prime_red(X->crts + X->np - 1, ioff);
-        NMOD_RED2(m, cop >> (FLINT_BITS - X->depth), cop << X->depth, X->ffts[ioff].mod);
-        m = nmod_inv(m, X->ffts[ioff].mod);
+        m = _point_mul_scale(X->ffts + ioff, X->crts + X->np - 1, X->np, ioff, X->depth);
 
         if (X->squaring)
             sd_fft_lctx_point_sqr(Q, abuf, m, X->depth);
@@ -424,6 +438,95 @@ static void s2worker_func(void* varg)
          X->stride, X->crts + X->offset);
 }
 
+/*
+    Restrict the output range [zl, zh) to the product of length zn, zeroing
+    the part beyond it. Return 1 if nothing is left to compute.
+*/
+static int _clip_output(fmpz * z, ulong zl, ulong * zh, ulong zn)
+{
+    if (zl >= *zh)
+        return 1;
+
+    if (*zh > zn)
+    {
+        if (zl >= zn)
+        {
+            _fmpz_vec_zero(z, *zh - zl);
+            return 1;
+        }
+
+        _fmpz_vec_zero(z + zn - zl, *zh - zn);
+        *zh = zn;
+    }
+
+    return 0;
+}
+
+/* threads wanted for the transforms, n being the length of the operand */
+static ulong _stage1_want_threads(ulong np, ulong n)
+{
+    if ((np >= 2 && n >= 1000) || (np >= 4 && n >= 300))
+        return np;
+    else
+        return 1;
+}
+
+/*
+    Recover z[0, zh - zl) from the np transformed images in buf by CRT.
+    Takes over the nworkers threads in handles and gives them back.
+*/
+static void _stage2(
+    fmpz * z, ulong zl, ulong zh, ulong zn,
+    ulong np, double* buf, ulong offset, ulong stride,
+    mpn_ctx_t R,
+    thread_pool_handle* handles, slong nworkers)
+{
+    s2worker_struct s2args[8];
+    ulong i, o, nthreads = nworkers + 1;
+
+    if (zn > 50000 || (np >= 2 && zn > 20000) || (np >= 4 && zn > 800))
+    {
+        flint_give_back_threads(handles, nworkers);
+        nworkers = flint_request_threads(&handles, 8);
+        nthreads = nworkers + 1;
+    }
+
+    FLINT_ASSERT(nthreads <= 8);
+
+    o = zl;
+    for (i = 0; i < nthreads; i++)
+    {
+        s2worker_struct* X = s2args + i;
+        X->z = z;
+        X->zl = zl;
+        X->start_zi = o;
+        ulong newo = n_round_down(zl + (i+1)*(zh-zl)/nthreads, BLK_SZ);
+        o = i+1 < nthreads ? FLINT_MAX(o, newo) : zh;
+        X->stop_zi = o;
+        X->buf = buf;
+        X->offset = offset;
+        X->stride = stride;
+        X->ffts = R->ffts;
+        X->crts = R->crts;
+        X->f =  np == 1 ? _crt_1 :
+                np == 2 ? _crt_2 :
+                np == 3 ? _crt_3 :
+                np == 4 ? _crt_4 :
+                np == 5 ? _crt_5 :
+                np == 6 ? _crt_6 :
+                np == 7 ? _crt_7 :
+                          _crt_8;
+    }
+
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wake(global_thread_pool, handles[i - 1], 0, s2worker_func, s2args + i);
+    s2worker_func(s2args + 0);
+    for (i = nworkers; i > 0; i--)
+        thread_pool_wait(global_thread_pool, handles[i - 1]);
+
+    flint_give_back_threads(handles, nworkers);
+}
+
 int _fmpz_poly_mul_mid_mpn_ctx(
     fmpz * z, ulong zl, ulong zh,
     const fmpz * a, ulong an,
@@ -443,21 +546,9 @@ int _fmpz_poly_mul_mid_mpn_ctx(
     FLINT_ASSERT(an > 0);
     FLINT_ASSERT(bn > 0);
 
-    if (zl >= zh)
+    if (_clip_output(z, zl, &zh, zn))
         return 1;
 
-    if (zh > zn)
-    {
-        if (zl >= zn)
-        {
-            _fmpz_vec_zero(z, zh - zl);
-            return 1;
-        }
-
-        _fmpz_vec_zero(z + zn - zl, zh - zn);
-        zh = zn;
-    }
-
     squaring = (a == b) && (an == bn);
 
     bits1 = _fmpz_vec_max_bits(a, an);
@@ -513,15 +604,9 @@ int _fmpz_poly_mul_mid_mpn_ctx(
 
     stride = n_round_up(sd_fft_ctx_data_size(depth), 128);
 
-    ulong want_threads;
-
-    if ((np >= 2 && bn >= 1000) || (np >= 4 && bn >= 300))
-        want_threads = np;
-    else
-        want_threads = 1;
-
     thread_pool_handle* handles;
-    slong nworkers = flint_request_threads(&handles, want_threads);
+    slong nworkers = flint_request_threads(&handles,
+                                           _stage1_want_threads(np, bn));
     ulong nthreads = nworkers + 1;
 
     buf = (double*) mpn_ctx_fit_buffer(R, (np+nthreads)*stride*sizeof(double));
@@ -560,48 +645,180 @@ int _fmpz_poly_mul_mid_mpn_ctx(
     for (i = nworkers; i > 0; i--)
         thread_pool_wait(global_thread_pool, handles[i - 1]);
 
-    if (zn > 50000 || (np >= 2 && zn > 20000) || (np >= 4 && zn > 800))
+    _stage2(z, zl, zh, zn, np, buf, offset, stride, R, handles, nworkers);
+
+    return 1;
+}
+
+
+typedef struct {
+    ulong np;
+    ulong start_pi;
+    ulong stop_pi;
+    double* abuf;
+    double* bbuf;
+    ulong depth;
+    ulong stride;
+    ulong atrunc;
+    ulong ztrunc;
+    const fmpz * a;
+    ulong an;
+    slong abits;
+    sd_fft_ctx_struct* ffts;
+    crt_data_struct* crts;
+} s1pworker_struct;
+
+static void s1pworker_func(void* varg)
+{
+    s1pworker_struct* X = (s1pworker_struct*) varg;
+    sd_fft_lctx_t Q;
+    ulong i, m;
+
+    for (i = X->start_pi; i < X->stop_pi; i++)
     {
-        flint_give_back_threads(handles, nworkers);
-        nworkers = flint_request_threads(&handles, 8);
-        nthreads = nworkers + 1;
+        double* abuf = X->abuf + X->stride*i;
+
+        sd_fft_lctx_init(Q, X->ffts + i, X->depth);
+
+        _mod(abuf, X->atrunc, X->a, X->an, X->abits, X->ffts + i);
+        sd_fft_lctx_fft_trunc(Q, abuf, X->depth, X->atrunc, X->ztrunc);
+
+        m = _point_mul_scale(X->ffts + i, X->crts + X->np - 1, X->np, i, X->depth);
+        sd_fft_lctx_point_mul(Q, abuf, X->bbuf + X->stride*i, m, X->depth);
+
+        sd_fft_lctx_ifft_trunc(Q, abuf, X->depth, X->ztrunc);
+
+        sd_fft_lctx_clear(Q, X->ffts + i);
     }
+}
 
-    s2worker_struct s2args[8];
-    FLINT_ASSERT(nthreads <= 8);
+int _fmpz_mul_precomp_init(
+    fmpz_mul_precomp_struct* M,
+    const fmpz * b, ulong bn,
+    ulong an_max, flint_bitcnt_t abits_max,
+    mpn_ctx_t R)
+{
+    ulong modbits, depth, N, stride, np, i;
+    slong bbits;
+    sd_fft_lctx_t Q;
+
+    FLINT_ASSERT(bn > 0);
+    FLINT_ASSERT(an_max > 0);
+
+    bbits = _fmpz_vec_max_bits(b, bn);
+    modbits = abits_max + FLINT_ABS(bbits) + 1;
+
+    /* need prod_of_primes >= min(an, bn) * 2^modbits */
+    for (np = 1; ; np++)
+    {
+        if (np > MPN_CTX_NCRTS)
+        {
+            M->bbuf = NULL;
+            return 0;
+        }
+
+        if (flint_mpn_cmp_ui_2exp(crt_data_prod_primes(R->crts + np - 1),
+              R->crts[np - 1].coeff_len, FLINT_MIN(an_max, bn), modbits) >= 0)
+        {
+            break;
+        }
+    }
+
+    depth = n_max(LG_BLK_SZ, n_clog2(n_round_up(an_max + bn - 1, BLK_SZ)));
+    N = n_pow2(depth);
+    stride = n_round_up(sd_fft_ctx_data_size(depth), 128);
+
+    M->depth = depth;
+    M->N = N;
+    M->np = np;
+    M->stride = stride;
+    M->bn = bn;
+    M->an_max = an_max;
+    M->abits_max = abits_max;
+    M->bbuf = flint_aligned_alloc(4096, n_round_up(np*stride*sizeof(double), 4096));
+
+    for (i = 0; i < np; i++)
+    {
+        double* bbuf = M->bbuf + stride*i;
+
+        sd_fft_lctx_init(Q, R->ffts + i, depth);
+
+        _mod(bbuf, N, b, bn, bbits, R->ffts + i);
+        sd_fft_lctx_fft_trunc(Q, bbuf, depth, N, N);
+
+        sd_fft_lctx_clear(Q, R->ffts + i);
+    }
+
+    return 1;
+}
+
+int _fmpz_poly_mul_mid_precomp(
+    fmpz * z, ulong zl, ulong zh,
+    const fmpz * a, ulong an,
+    const fmpz_mul_precomp_struct* M,
+    mpn_ctx_t R)
+{
+    ulong bn = M->bn;
+    ulong zn = an + bn - 1;
+    ulong depth = M->depth;
+    ulong np = M->np;
+    ulong atrunc, ztrunc, i;
+    slong abits;
+    double* buf;
+
+    FLINT_ASSERT(an > 0);
+
+    if (M->bbuf == NULL || an > M->an_max)
+        return 0;
+
+    abits = _fmpz_vec_max_bits(a, an);
+
+    if (FLINT_ABS(abits) > M->abits_max)
+        return 0;
+
+    if (_clip_output(z, zl, &zh, zn))
+        return 1;
 
-    ulong o = zl;
+    atrunc = n_round_up(an, BLK_SZ);
+    ztrunc = n_round_up(zn, BLK_SZ);
+
+    FLINT_ASSERT(ztrunc <= M->N);
+
+    thread_pool_handle* handles;
+    slong nworkers = flint_request_threads(&handles,
+                                           _stage1_want_threads(np, an));
+    ulong nthreads = nworkers + 1;
+
+    buf = (double*) mpn_ctx_fit_buffer(R, np*M->stride*sizeof(double));
+
+    s1pworker_struct s1pargs[8];
+    FLINT_ASSERT(nthreads <= 8);
     for (i = 0; i < nthreads; i++)
     {
-        s2worker_struct* X = s2args + i;
-        X->z = z;
-        X->zl = zl;
-        X->start_zi = o;
-        ulong newo = n_round_down(zl + (i+1)*(zh-zl)/nthreads, BLK_SZ);
-        o = i+1 < nthreads ? FLINT_MAX(o, newo) : zh;
-        X->stop_zi = o;
-        X->buf = buf;
-        X->offset = offset;
-        X->stride = stride;
+        s1pworker_struct* X = s1pargs + i;
+        X->np = np;
+        X->start_pi = (i+0)*np/nthreads;
+        X->stop_pi  = (i+1)*np/nthreads;
+        X->abuf = buf;
+        X->bbuf = M->bbuf;
+        X->depth = depth;
+        X->stride = M->stride;
+        X->atrunc = atrunc;
+        X->ztrunc = ztrunc;
+        X->a = a;
+        X->an = an;
+        X->abits = abits;
         X->ffts = R->ffts;
         X->crts = R->crts;
-        X->f =  np == 1 ? _crt_1 :
-                np == 2 ? _crt_2 :
-                np == 3 ? _crt_3 :
-                np == 4 ? _crt_4 :
-                np == 5 ? _crt_5 :
-                np == 6 ? _crt_6 :
-                np == 7 ? _crt_7 :
-                          _crt_8;
     }
 
     for (i = nworkers; i > 0; i--)
-        thread_pool_wake(global_thread_pool, handles[i - 1], 0, s2worker_func, s2args + i);
-    s2worker_func(s2args + 0);
+        thread_pool_wake(global_thread_pool, handles[i - 1], 0, s1pworker_func, s1pargs + i);
+    s1pworker_func(s1pargs + 0);
     for (i = nworkers; i > 0; i--)
         thread_pool_wait(global_thread_pool, handles[i - 1]);
 
-    flint_give_back_threads(handles, nworkers);
+    _stage2(z, zl, zh, zn, np, buf, 0, M->stride, R, handles, nworkers);
 
     return 1;
 }
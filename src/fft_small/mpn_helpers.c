@@ -12,42 +12,6 @@
 #include "fft_small.h"
 #include "crt_helpers.h"
 
-/* transpose a block */
-void _convert_block(
-    ulong* Xs,
-    sd_fft_ctx_struct* Rffts, double* d, ulong dstride,
-    ulong np,
-    ulong I)
-{
-    for (ulong l = 0; l < np; l++)
-    {
-        vec4d p = vec4d_set_d(Rffts[l].p);
-        vec4d pinv = vec4d_set_d(Rffts[l].pinv);
-        double* x = sd_fft_ctx_blk_index(d + l*dstride, I);
-        ulong j = 0; do {
-            vec4d x0, x1, x2, x3;
-            vec4n y0, y1, y2, y3;
-            x0 = vec4d_load(x + j + 0*VEC_SZ);
-            x1 = vec4d_load(x + j + 1*VEC_SZ);
-            x2 = vec4d_load(x + j + 2*VEC_SZ);
-            x3 = vec4d_load(x + j + 3*VEC_SZ);
-            x0 = vec4d_reduce_to_0n(x0, p, pinv);
-            x1 = vec4d_reduce_to_0n(x1, p, pinv);
-            x2 = vec4d_reduce_to_0n(x2, p, pinv);
-            x3 = vec4d_reduce_to_0n(x3, p, pinv);
-            y0 = vec4d_convert_limited_vec4n(x0);
-            y1 = vec4d_convert_limited_vec4n(x1);
-            y2 = vec4d_convert_limited_vec4n(x2);
-            y3 = vec4d_convert_limited_vec4n(x3);
-            vec4n_store_unaligned(Xs + l*BLK_SZ + j + 0*VEC_SZ, y0);
-            vec4n_store_unaligned(Xs + l*BLK_SZ + j + 1*VEC_SZ, y1);
-            vec4n_store_unaligned(Xs + l*BLK_SZ + j + 2*VEC_SZ, y2);
-            vec4n_store_unaligned(Xs + l*BLK_SZ + j + 3*VEC_SZ, y3);
-        } while (j += 4*VEC_SZ, j < BLK_SZ);
-        FLINT_ASSERT(j == BLK_SZ);
-    }
-}
-
 ulong flint_mpn_nbits(const ulong* a, ulong an)
 {
     while (an > 0 && a[an-1] == 0)
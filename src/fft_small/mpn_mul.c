@@ -217,14 +217,14 @@ void slow_mpn_to_fft_easy(
             X = vec8d_reduce_to_pm1n(X, p, pinv);
 
             /* _vec8i32_convert_vec8d make the Xs slightly out of order */
-            zI[ir+0*BLK_SZ/8] = X.e1[0];
-            zI[ir+1*BLK_SZ/8] = X.e1[1];
-            zI[ir+4*BLK_SZ/8] = X.e1[2];
-            zI[ir+5*BLK_SZ/8] = X.e1[3];
-            zI[ir+2*BLK_SZ/8] = X.e2[0];
-            zI[ir+3*BLK_SZ/8] = X.e2[1];
-            zI[ir+6*BLK_SZ/8] = X.e2[2];
-            zI[ir+7*BLK_SZ/8] = X.e2[3];
+            zI[ir+0*BLK_SZ/8] = vec8d_get_index(X, 0);
+            zI[ir+1*BLK_SZ/8] = vec8d_get_index(X, 1);
+            zI[ir+4*BLK_SZ/8] = vec8d_get_index(X, 2);
+            zI[ir+5*BLK_SZ/8] = vec8d_get_index(X, 3);
+            zI[ir+2*BLK_SZ/8] = vec8d_get_index(X, 4);
+            zI[ir+3*BLK_SZ/8] = vec8d_get_index(X, 5);
+            zI[ir+6*BLK_SZ/8] = vec8d_get_index(X, 6);
+            zI[ir+7*BLK_SZ/8] = vec8d_get_index(X, 7);
         }
     }
 }
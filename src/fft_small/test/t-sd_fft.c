@@ -151,6 +151,94 @@ void test_v2_fft(sd_fft_ctx_t Q, ulong minL, ulong maxL, ulong ireps, flint_rand
 }
 
 
+#if FFT_SMALL_AVX512_DISPATCH
+/* the AVX512F versions must agree exactly with the generic code */
+void test_avx512(sd_fft_ctx_t Q, ulong minL, ulong maxL, flint_rand_t state)
+{
+    ulong L, i, I, rep;
+    sd_fft_lctx_t QL;
+
+    if (!FLINT_CPU_HAVE(FLINT_CPU_X86_AVX512F))
+        return;
+
+    for (L = n_max(minL, LG_BLK_SZ); L <= maxL; L++)
+    {
+        ulong Xn = n_pow2(L);
+        ulong dsize = sd_fft_ctx_data_size(L);
+        double* d1 = (double*) flint_aligned_alloc(32, dsize*sizeof(double));
+        double* d2 = (double*) flint_aligned_alloc(32, dsize*sizeof(double));
+        ulong* X1 = FLINT_ARRAY_ALLOC(BLK_SZ, ulong);
+        ulong* X2 = FLINT_ARRAY_ALLOC(BLK_SZ, ulong);
+
+        sd_fft_lctx_init(QL, Q, L);
+
+        for (rep = 0; rep < 10; rep++)
+        {
+            ulong itrunc = n_round_up(1 + n_randint(state, Xn), BLK_SZ);
+            ulong otrunc = n_round_up(1 + n_randint(state, Xn), BLK_SZ);
+
+            for (i = 0; i < Xn; i++)
+            {
+                double x = n_randint(state, Q->p);
+                sd_fft_ctx_set_index(d1, i, x);
+                sd_fft_ctx_set_index(d2, i, x);
+            }
+
+            QL->data = d1;
+            sd_fft_trunc(QL, 0, 1, L - LG_BLK_SZ, 0, itrunc/BLK_SZ, otrunc/BLK_SZ);
+            QL->data = d2;
+            _sd_fft_trunc_avx512(QL, 0, 1, L - LG_BLK_SZ, 0, itrunc/BLK_SZ, otrunc/BLK_SZ);
+
+            for (i = 0; i < otrunc; i++)
+            {
+                if (sd_fft_ctx_get_index(d1, i) != sd_fft_ctx_get_index(d2, i))
+                {
+                    flint_printf("FAIL: avx512 fft mismatch at index %wu\n"
+                                 "itrunc: %wu\notrunc: %wu\n", i, itrunc, otrunc);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+
+            QL->data = d1;
+            sd_ifft_trunc(QL, 0, 1, L - LG_BLK_SZ, 0, otrunc/BLK_SZ, otrunc/BLK_SZ, 0);
+            QL->data = d2;
+            _sd_ifft_trunc_avx512(QL, 0, 1, L - LG_BLK_SZ, 0, otrunc/BLK_SZ, otrunc/BLK_SZ, 0);
+
+            for (i = 0; i < otrunc; i++)
+            {
+                if (sd_fft_ctx_get_index(d1, i) != sd_fft_ctx_get_index(d2, i))
+                {
+                    flint_printf("FAIL: avx512 ifft mismatch at index %wu\n"
+                                 "trunc: %wu\n", i, otrunc);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+
+            I = n_randint(state, otrunc/BLK_SZ);
+            _convert_block(X1, Q, d1, 0, 1, I);
+            _convert_block_avx512(X2, Q, d1, 0, 1, I);
+
+            for (i = 0; i < BLK_SZ; i++)
+            {
+                if (X1[i] != X2[i])
+                {
+                    flint_printf("FAIL: avx512 _convert_block mismatch\n");
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        flint_free(X1);
+        flint_free(X2);
+        flint_aligned_free(d1);
+        flint_aligned_free(d2);
+    }
+}
+#endif
+
 int main(void)
 {
     FLINT_TEST_INIT(state);
@@ -162,6 +250,9 @@ int main(void)
         sd_fft_ctx_t Q;
         sd_fft_ctx_init_prime(Q, UWORD(0x0003f00000000001));
         test_v2_fft(Q, 10, 19, 20, state);
+#if FFT_SMALL_AVX512_DISPATCH
+        test_avx512(Q, 8, 16, state);
+#endif
         sd_fft_ctx_clear(Q);
     }
 
@@ -785,6 +785,33 @@ int fmpq_mpoly_resultant(fmpq_mpoly_t R, const fmpq_mpoly_t A,
 int fmpq_mpoly_discriminant(fmpq_mpoly_t R, const fmpq_mpoly_t A,
                                         slong var, const fmpq_mpoly_ctx_t ctx);
 
+/* Vectors of multivariate polynomials */
+
+typedef struct
+{
+    fmpq_mpoly_struct * p;
+    slong alloc;
+    slong length;
+}
+fmpq_mpoly_vec_struct;
+
+typedef fmpq_mpoly_vec_struct fmpq_mpoly_vec_t[1];
+
+#define fmpq_mpoly_vec_entry(vec, i) ((vec)->p + (i))
+
+void fmpq_mpoly_vec_init(fmpq_mpoly_vec_t vec, slong len, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_print(const fmpq_mpoly_vec_t F, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_swap(fmpq_mpoly_vec_t x, fmpq_mpoly_vec_t y, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_fit_length(fmpq_mpoly_vec_t vec, slong len, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_clear(fmpq_mpoly_vec_t vec, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_set(fmpq_mpoly_vec_t dest, const fmpq_mpoly_vec_t src, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_append(fmpq_mpoly_vec_t vec, const fmpq_mpoly_t f, const fmpq_mpoly_ctx_t ctx);
+void fmpq_mpoly_vec_set_length(fmpq_mpoly_vec_t vec, slong len, const fmpq_mpoly_ctx_t ctx);
+
+/* Ideals and Groebner bases */
+
+void fmpq_mpoly_groebner_f4(fmpq_mpoly_vec_t G, const fmpq_mpoly_vec_t F, const fmpq_mpoly_ctx_t ctx);
+
 /******************************************************************************
 
    Internal functions (guaranteed to change without notice)
@@ -0,0 +1,295 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_mpoly.h"
+#include "fmpz_mpoly_factor.h"
+#include "fmpq_mpoly.h"
+
+/*
+    Multi-modular Groebner basis over Q.
+
+    The integral parts of the inputs are reduced modulo word size primes,
+    skipping the primes that divide a leading coefficient, and the reduced
+    bases modulo these primes are computed with nmod_mpoly_groebner_f4.
+    Only the images whose leading monomials agree with the majority of the
+    images seen so far are kept: a prime with a different set of leading
+    monomials casts a vote against the current images, and once these are
+    outvoted the images are discarded and the computation restarts from
+    the current prime. The kept images are combined by Chinese remaindering
+    and the coefficients are recovered by rational reconstruction.
+
+    A candidate is accepted once it no longer changes when another prime is
+    added and the test of fmpz_mpoly_vec_is_groebner passes on its integral
+    parts, so that the result is a Groebner basis of an ideal containing
+    the input. That this ideal is not larger than the one generated by the
+    input relies on the primes used being lucky.
+*/
+
+/* the leading monomials of A and B are the same */
+static int _same_shape(const fmpz_mpoly_vec_t A, const nmod_mpoly_vec_t B,
+                                                                      slong N)
+{
+    slong i;
+
+    if (A->length != B->length)
+        return 0;
+
+    for (i = 0; i < A->length; i++)
+        if (!mpoly_monomial_equal(A->p[i].exps, B->p[i].exps, N))
+            return 0;
+
+    return 1;
+}
+
+/*
+    Set A to the polynomial with coefficients in [0, m*p) that is A mod m
+    and B mod p. A missing term in either input is taken to be zero.
+*/
+static void _crt_merge(fmpz_mpoly_t A, fmpz_mpoly_t T, const fmpz_t m,
+                const nmod_mpoly_t B, slong N, const ulong * cmpmask,
+                        const fmpz_mpoly_ctx_t ctx, const nmod_mpoly_ctx_t ctxp)
+{
+    slong i, j, k;
+    int cmp;
+    fmpz_t zero;
+
+    fmpz_init(zero);
+
+    fmpz_mpoly_fit_length_reset_bits(T, A->length + B->length, A->bits, ctx);
+
+    i = j = k = 0;
+    while (i < A->length || j < B->length)
+    {
+        if (i >= A->length)
+            cmp = -1;
+        else if (j >= B->length)
+            cmp = 1;
+        else
+            cmp = mpoly_monomial_cmp(A->exps + N*i, B->exps + N*j, N, cmpmask);
+
+        if (cmp > 0)
+        {
+            mpoly_monomial_set(T->exps + N*k, A->exps + N*i, N);
+            fmpz_CRT_ui(T->coeffs + k, A->coeffs + i, m, 0, ctxp->mod.n, 0);
+            i++;
+        }
+        else if (cmp < 0)
+        {
+            mpoly_monomial_set(T->exps + N*k, B->exps + N*j, N);
+            fmpz_CRT_ui(T->coeffs + k, zero, m, B->coeffs[j], ctxp->mod.n, 0);
+            j++;
+        }
+        else
+        {
+            mpoly_monomial_set(T->exps + N*k, A->exps + N*i, N);
+            fmpz_CRT_ui(T->coeffs + k, A->coeffs + i, m, B->coeffs[j],
+                                                              ctxp->mod.n, 0);
+            i++;
+            j++;
+        }
+
+        k += !fmpz_is_zero(T->coeffs + k);
+    }
+
+    _fmpz_mpoly_set_length(T, k, ctx);
+    fmpz_mpoly_swap(A, T, ctx);
+
+    fmpz_clear(zero);
+}
+
+/* rational reconstruction of the coefficients of A mod m */
+static int _reconstruct(fmpq_mpoly_t Q, const fmpz_mpoly_t A, const fmpz_t m,
+                                                     const fmpq_mpoly_ctx_t ctx)
+{
+    slong i, N = mpoly_words_per_exp(A->bits, ctx->zctx->minfo);
+    fmpz * nums, * dens;
+    fmpz_t L;
+    int success = 1;
+
+    nums = _fmpz_vec_init(2*A->length);
+    dens = nums + A->length;
+    fmpz_init_set_ui(L, 1);
+
+    for (i = 0; i < A->length && success; i++)
+    {
+        success = _fmpq_reconstruct_fmpz(nums + i, dens + i, A->coeffs + i, m);
+        fmpz_lcm(L, L, dens + i);
+    }
+
+    if (success)
+    {
+        fmpz_mpoly_struct * Z = Q->zpoly;
+
+        fmpz_mpoly_fit_length_reset_bits(Z, A->length, A->bits, ctx->zctx);
+        mpoly_copy_monomials(Z->exps, A->exps, A->length, N);
+        for (i = 0; i < A->length; i++)
+        {
+            fmpz_divexact(Z->coeffs + i, L, dens + i);
+            fmpz_mul(Z->coeffs + i, Z->coeffs + i, nums + i);
+        }
+        _fmpz_mpoly_set_length(Z, A->length, ctx->zctx);
+        fmpq_one(Q->content);
+        fmpq_mpoly_reduce(Q, ctx);
+        fmpq_mpoly_make_monic(Q, Q, ctx);
+    }
+
+    _fmpz_vec_clear(nums, 2*A->length);
+    fmpz_clear(L);
+
+    return success;
+}
+
+void fmpq_mpoly_groebner_f4(fmpq_mpoly_vec_t G, const fmpq_mpoly_vec_t F,
+                                                     const fmpq_mpoly_ctx_t ctx)
+{
+    const fmpz_mpoly_ctx_struct * zctx = ctx->zctx;
+    slong i, j, N, votes = 0;
+    ulong * cmpmask;
+    mp_limb_t p;
+    int stable;
+    fmpz_t m;
+    fmpz_mpoly_t T;
+    fmpz_mpoly_vec_t Fz, H;
+    fmpq_mpoly_vec_t R;
+    nmod_mpoly_ctx_t ctxp;
+    nmod_mpoly_vec_t Fp, Gp;
+
+    fmpz_mpoly_vec_init(Fz, 0, zctx);
+    for (i = 0; i < F->length; i++)
+        if (!fmpq_mpoly_is_zero(F->p + i, ctx))
+            fmpz_mpoly_vec_append(Fz, F->p[i].zpoly, zctx);
+
+    if (Fz->length == 0)
+    {
+        fmpq_mpoly_vec_set_length(G, 0, ctx);
+        fmpz_mpoly_vec_clear(Fz, zctx);
+        return;
+    }
+
+    N = mpoly_words_per_exp_sp(FLINT_BITS, zctx->minfo);
+    cmpmask = FLINT_ARRAY_ALLOC(N, ulong);
+    mpoly_get_cmpmask(cmpmask, N, FLINT_BITS, zctx->minfo);
+
+    fmpz_init(m);
+    fmpz_mpoly_init(T, zctx);
+    fmpz_mpoly_vec_init(H, 0, zctx);
+    fmpq_mpoly_vec_init(R, 0, ctx);
+    fmpq_mpoly_vec_set_length(G, 0, ctx);
+    nmod_mpoly_ctx_init(ctxp, zctx->minfo->nvars, zctx->minfo->ord, 2);
+    nmod_mpoly_vec_init(Fp, Fz->length, ctxp);
+    nmod_mpoly_vec_init(Gp, 0, ctxp);
+
+    p = UWORD(1) << (FLINT_BITS - 1);
+
+    while (1)
+    {
+        p = n_nextprime(p, 1);
+
+        for (i = 0; i < Fz->length; i++)
+            if (fmpz_fdiv_ui(Fz->p[i].coeffs + 0, p) == 0)
+                break;
+
+        if (i < Fz->length)
+            continue;
+
+        nmod_mpoly_ctx_set_modulus(ctxp, p);
+
+        for (i = 0; i < Fz->length; i++)
+        {
+            nmod_mpoly_fit_length_reset_bits(Fp->p + i, Fz->p[i].length,
+                                                       Fz->p[i].bits, ctxp);
+            fmpz_mpoly_interp_reduce_p(Fp->p + i, ctxp, Fz->p + i, zctx);
+        }
+
+        nmod_mpoly_groebner_f4(Gp, Fp, ctxp);
+
+        for (i = 0; i < Gp->length; i++)
+            if (Gp->p[i].bits != FLINT_BITS)
+                nmod_mpoly_repack_bits_inplace(Gp->p + i, FLINT_BITS, ctxp);
+
+        if (votes == 0)
+        {
+            /* start again from this image */
+            fmpz_mpoly_vec_set_length(H, Gp->length, zctx);
+            for (i = 0; i < Gp->length; i++)
+            {
+                fmpz_mpoly_fit_length_reset_bits(H->p + i, Gp->p[i].length,
+                                                            FLINT_BITS, zctx);
+                mpoly_copy_monomials(H->p[i].exps, Gp->p[i].exps,
+                                                        Gp->p[i].length, N);
+                for (j = 0; j < Gp->p[i].length; j++)
+                    fmpz_set_ui(H->p[i].coeffs + j, Gp->p[i].coeffs[j]);
+                _fmpz_mpoly_set_length(H->p + i, Gp->p[i].length, zctx);
+            }
+            fmpz_set_ui(m, p);
+            fmpq_mpoly_vec_set_length(R, 0, ctx);
+            votes = 1;
+        }
+        else if (_same_shape(H, Gp, N))
+        {
+            for (i = 0; i < H->length; i++)
+                _crt_merge(H->p + i, T, m, Gp->p + i, N, cmpmask, zctx, ctxp);
+            fmpz_mul_ui(m, m, p);
+            votes++;
+        }
+        else
+        {
+            votes--;
+            continue;
+        }
+
+        /* reconstruct and compare with the previous candidate */
+        fmpq_mpoly_vec_set_length(G, H->length, ctx);
+        stable = (R->length == H->length);
+        for (i = 0; i < H->length; i++)
+        {
+            if (!_reconstruct(G->p + i, H->p + i, m, ctx))
+                break;
+
+            stable = stable && fmpq_mpoly_equal(G->p + i, R->p + i, ctx);
+        }
+
+        if (i < H->length)
+        {
+            fmpq_mpoly_vec_set_length(R, 0, ctx);
+            continue;
+        }
+
+        if (stable)
+        {
+            fmpz_mpoly_vec_t Gz;
+
+            fmpz_mpoly_vec_init(Gz, G->length, zctx);
+            for (i = 0; i < G->length; i++)
+                fmpz_mpoly_set(Gz->p + i, G->p[i].zpoly, zctx);
+
+            stable = fmpz_mpoly_vec_is_groebner(Gz, Fz, zctx);
+
+            fmpz_mpoly_vec_clear(Gz, zctx);
+
+            if (stable)
+                break;
+        }
+
+        fmpq_mpoly_vec_swap(R, G, ctx);
+    }
+
+    flint_free(cmpmask);
+    fmpz_clear(m);
+    fmpz_mpoly_clear(T, zctx);
+    fmpz_mpoly_vec_clear(Fz, zctx);
+    fmpz_mpoly_vec_clear(H, zctx);
+    fmpq_mpoly_vec_clear(R, ctx);
+    nmod_mpoly_vec_clear(Fp, ctxp);
+    nmod_mpoly_vec_clear(Gp, ctxp);
+    nmod_mpoly_ctx_clear(ctxp);
+}
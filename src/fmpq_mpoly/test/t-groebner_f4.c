@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpq_mpoly.h"
+
+static void
+_set_fmpz_mpoly(fmpq_mpoly_t A, const fmpz_mpoly_t B, const fmpq_mpoly_ctx_t ctx)
+{
+    fmpz_mpoly_set(A->zpoly, B, ctx->zctx);
+    fmpq_one(A->content);
+    fmpq_mpoly_reduce(A, ctx);
+}
+
+int
+main(void)
+{
+    slong i, j, k;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("groebner_f4....");
+    fflush(stdout);
+
+    /* Check against the reduced basis from Buchberger's algorithm */
+    for (i = 0; i < 50 * flint_test_multiplier(); i++)
+    {
+        fmpq_mpoly_ctx_t ctx;
+        fmpq_mpoly_vec_t F, G;
+        fmpq_mpoly_t h;
+        fmpz_mpoly_vec_t Fz, Gz, Hz;
+        slong nvars;
+
+        fmpq_mpoly_ctx_init_rand(ctx, state, 4);
+        nvars = ctx->zctx->minfo->nvars;
+
+        fmpq_mpoly_vec_init(F, 0, ctx);
+        fmpq_mpoly_vec_init(G, 0, ctx);
+        fmpq_mpoly_init(h, ctx);
+        fmpz_mpoly_vec_init(Fz, 0, ctx->zctx);
+        fmpz_mpoly_vec_init(Gz, 0, ctx->zctx);
+        fmpz_mpoly_vec_init(Hz, 0, ctx->zctx);
+
+        if (nvars == 4)
+            fmpz_mpoly_vec_randtest_not_zero(Fz, state, 1 + n_randint(state, 3),
+                     1 + n_randint(state, 3), 1 + n_randint(state, 3),
+                                              1 + n_randint(state, 2), ctx->zctx);
+        else if (nvars == 3)
+            fmpz_mpoly_vec_randtest_not_zero(Fz, state, 1 + n_randint(state, 4),
+                     1 + n_randint(state, 4), 1 + n_randint(state, 4),
+                                              1 + n_randint(state, 2), ctx->zctx);
+        else
+            fmpz_mpoly_vec_randtest_not_zero(Fz, state, 1 + n_randint(state, 5),
+                     1 + n_randint(state, 5), 1 + n_randint(state, 5),
+                                              1 + n_randint(state, 3), ctx->zctx);
+
+        fmpq_mpoly_vec_set_length(F, Fz->length, ctx);
+        for (j = 0; j < Fz->length; j++)
+        {
+            _set_fmpz_mpoly(F->p + j, Fz->p + j, ctx);
+            fmpq_mpoly_scalar_div_ui(F->p + j, F->p + j, 1 + n_randint(state, 100), ctx);
+        }
+
+        fmpq_mpoly_groebner_f4(G, F, ctx);
+
+        fmpz_mpoly_buchberger_naive(Gz, Fz, ctx->zctx);
+        fmpz_mpoly_vec_autoreduction_groebner(Hz, Gz, ctx->zctx);
+
+        if (G->length != Hz->length)
+        {
+            flint_printf("FAIL\ncheck length\ni = %wd\n", i);
+            flint_printf("F = "); fmpq_mpoly_vec_print(F, ctx); flint_printf("\n");
+            flint_printf("G = "); fmpq_mpoly_vec_print(G, ctx); flint_printf("\n");
+            flint_printf("H = "); fmpz_mpoly_vec_print(Hz, ctx->zctx); flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < Hz->length; j++)
+        {
+            _set_fmpz_mpoly(h, Hz->p + j, ctx);
+            fmpq_mpoly_make_monic(h, h, ctx);
+
+            for (k = 0; k < G->length; k++)
+                if (fmpq_mpoly_equal(h, G->p + k, ctx))
+                    break;
+
+            if (k >= G->length)
+            {
+                flint_printf("FAIL\ncheck basis\ni = %wd, j = %wd\n", i, j);
+                flint_printf("F = "); fmpq_mpoly_vec_print(F, ctx); flint_printf("\n");
+                flint_printf("G = "); fmpq_mpoly_vec_print(G, ctx); flint_printf("\n");
+                flint_printf("H = "); fmpz_mpoly_vec_print(Hz, ctx->zctx); flint_printf("\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpq_mpoly_vec_clear(F, ctx);
+        fmpq_mpoly_vec_clear(G, ctx);
+        fmpq_mpoly_clear(h, ctx);
+        fmpz_mpoly_vec_clear(Fz, ctx->zctx);
+        fmpz_mpoly_vec_clear(Gz, ctx->zctx);
+        fmpz_mpoly_vec_clear(Hz, ctx->zctx);
+        fmpq_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -51,6 +51,20 @@ void _fmpz_clear_mpz(fmpz f);
 void _fmpz_cleanup_mpz_content(void);
 void _fmpz_cleanup(void);
 
+typedef struct
+{
+    ulong promotions;
+    ulong demotions;
+    ulong slabs;
+    ulong remote_frees;
+}
+fmpz_alloc_stats_struct;
+
+typedef fmpz_alloc_stats_struct fmpz_alloc_stats_t[1];
+
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats);
+void fmpz_reset_alloc_stats(void);
+
 mpz_ptr _fmpz_promote(fmpz_t f);
 mpz_ptr _fmpz_promote_val(fmpz_t f);
 
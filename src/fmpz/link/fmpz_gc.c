@@ -34,6 +34,10 @@ ulong mpz_alloc = 0;
 ulong mpz_free_num = 0;
 ulong mpz_free_alloc = 0;
 
+/* protected by fmpz_lock */
+static ulong _fmpz_num_promotions = 0;
+static ulong _fmpz_num_demotions = 0;
+
 #if FLINT_USES_PTHREAD
 void fmpz_lock_init()
 {
@@ -66,6 +70,8 @@ __mpz_struct * _fmpz_new_mpz(void)
         mpz_init(z);
     }
 
+    _fmpz_num_promotions++;
+
 #if FLINT_USES_PTHREAD
     pthread_mutex_unlock(&fmpz_lock);
 #endif
@@ -92,6 +98,8 @@ void _fmpz_clear_mpz(fmpz f)
 
     mpz_free_arr[mpz_free_num++] = ptr;
 
+    _fmpz_num_demotions++;
+
 #if FLINT_USES_PTHREAD
     pthread_mutex_unlock(&fmpz_lock);
 #endif
@@ -126,6 +134,38 @@ void _fmpz_cleanup(void)
 #endif
 }
 
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&fmpz_initialised, fmpz_lock_init);
+    pthread_mutex_lock(&fmpz_lock);
+#endif
+
+    stats->promotions = _fmpz_num_promotions;
+    stats->demotions = _fmpz_num_demotions;
+    stats->slabs = 0;
+    stats->remote_frees = 0;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&fmpz_lock);
+#endif
+}
+
+void fmpz_reset_alloc_stats(void)
+{
+#if FLINT_USES_PTHREAD
+    pthread_once(&fmpz_initialised, fmpz_lock_init);
+    pthread_mutex_lock(&fmpz_lock);
+#endif
+
+    _fmpz_num_promotions = 0;
+    _fmpz_num_demotions = 0;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&fmpz_lock);
+#endif
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f)) /* f is small so promote it first */
@@ -13,15 +13,261 @@
 #include "gmpcompat.h"
 #include "fmpz.h"
 
+/*
+   When thread local storage and the GCC atomic builtins are available,
+   each thread keeps its own cache of __mpz_struct's, carved out of slabs
+   of FMPZ_SLAB_SLOTS entries. Each slot records the slab it belongs to
+   and each slab records the cache of the thread that allocated it.
+
+   An mpz cleared by the thread that owns it goes straight back on that
+   thread's local free list. An mpz cleared by any other thread is pushed
+   onto the owner's remote free list, a lock-free stack that the owner
+   takes over in one go when its local list runs dry. As the owner only
+   ever removes the whole stack, the push cannot suffer from ABA.
+
+   When a thread calls flint_cleanup its cache is marked as orphaned.
+   From then on mpz's belonging to it are cleared immediately by whichever
+   thread releases them, and each slab is freed once all its slots have
+   been cleared. The cache itself is reference counted by its live slabs
+   plus one for the owning thread.
+*/
+
+#if FLINT_USES_TLS && defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define FMPZ_SLAB_ALLOC 1
+#else
+#define FMPZ_SLAB_ALLOC 0
+#endif
+
+/*
+   The allocation counters are thread local when possible. Otherwise they
+   are shared, and with pthreads they are updated with relaxed atomics, or
+   not at all when the GCC atomic builtins are not available.
+*/
+#if FLINT_USES_TLS || !FLINT_USES_PTHREAD
+#define FMPZ_STAT_INC(x) ((x)++)
+#define FMPZ_STAT_GET(x) (x)
+#define FMPZ_STAT_SET(x, v) ((x) = (v))
+#elif (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define FMPZ_STAT_INC(x) __atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED)
+#define FMPZ_STAT_GET(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define FMPZ_STAT_SET(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define FMPZ_STAT_INC(x)
+#define FMPZ_STAT_GET(x) UWORD(0)
+#define FMPZ_STAT_SET(x, v)
+#endif
+
+static FLINT_TLS_PREFIX ulong _fmpz_num_promotions = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_demotions = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_slabs = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_remote_frees = 0;
+
+#if FMPZ_SLAB_ALLOC
+
+/* Always free larger mpz's to avoid wasting too much heap space */
+#define FLINT_MPZ_MAX_CACHE_LIMBS 64
+
+/* The number of new mpz's allocated at a time */
+#define FMPZ_SLAB_SLOTS 64
+
+typedef struct fmpz_mpz_slot_struct
+{
+    __mpz_struct mpz;   /* must come first */
+    struct fmpz_mpz_slab_struct * slab;
+    struct fmpz_mpz_slot_struct * next;
+}
+fmpz_mpz_slot_struct;
+
+typedef struct
+{
+    fmpz_mpz_slot_struct * local;
+    fmpz_mpz_slot_struct * remote;
+    slong refs;
+}
+fmpz_mpz_cache_struct;
+
+typedef struct fmpz_mpz_slab_struct
+{
+    fmpz_mpz_cache_struct * owner;
+    slong retired;
+    fmpz_mpz_slot_struct slots[FMPZ_SLAB_SLOTS];
+}
+fmpz_mpz_slab_struct;
+
+/* value of the remote list of a cache whose thread has cleaned up */
+#define FMPZ_CACHE_ORPHANED ((fmpz_mpz_slot_struct *) WORD(1))
+
+static FLINT_TLS_PREFIX fmpz_mpz_cache_struct * fmpz_mpz_cache = NULL;
+
+static void _fmpz_mpz_cache_release(fmpz_mpz_cache_struct * cache)
+{
+    if (__atomic_sub_fetch(&cache->refs, 1, __ATOMIC_ACQ_REL) == 0)
+        flint_free(cache);
+}
+
+/* clear the mpz for good and free its slab if it was the last one */
+static void _fmpz_mpz_slot_retire(fmpz_mpz_slot_struct * slot)
+{
+    fmpz_mpz_slab_struct * slab = slot->slab;
+
+    mpz_clear(&slot->mpz);
+
+    if (__atomic_add_fetch(&slab->retired, 1, __ATOMIC_ACQ_REL) == FMPZ_SLAB_SLOTS)
+    {
+        fmpz_mpz_cache_struct * cache = slab->owner;
+
+        flint_free(slab);
+        _fmpz_mpz_cache_release(cache);
+    }
+}
+
+static void _fmpz_mpz_slot_list_retire(fmpz_mpz_slot_struct * slot)
+{
+    while (slot != NULL)
+    {
+        fmpz_mpz_slot_struct * next = slot->next;
+        _fmpz_mpz_slot_retire(slot);
+        slot = next;
+    }
+}
+
+static void _fmpz_mpz_slab_new(fmpz_mpz_cache_struct * cache)
+{
+    fmpz_mpz_slab_struct * slab;
+    slong i;
+
+    slab = flint_malloc(sizeof(fmpz_mpz_slab_struct));
+    slab->owner = cache;
+    slab->retired = 0;
+
+    __atomic_add_fetch(&cache->refs, 1, __ATOMIC_RELAXED);
+
+    for (i = FMPZ_SLAB_SLOTS - 1; i >= 0; i--)
+    {
+        mpz_init2(&slab->slots[i].mpz, 2*FLINT_BITS);
+        slab->slots[i].slab = slab;
+        slab->slots[i].next = cache->local;
+        cache->local = slab->slots + i;
+    }
+
+    FMPZ_STAT_INC(_fmpz_num_slabs);
+}
+
+__mpz_struct * _fmpz_new_mpz(void)
+{
+    fmpz_mpz_cache_struct * cache = fmpz_mpz_cache;
+    fmpz_mpz_slot_struct * slot;
+
+    if (cache == NULL)
+    {
+        cache = flint_malloc(sizeof(fmpz_mpz_cache_struct));
+        cache->local = NULL;
+        cache->remote = NULL;
+        cache->refs = 1;
+        fmpz_mpz_cache = cache;
+    }
+
+    if (cache->local == NULL)
+    {
+        /* take over everything other threads have given back */
+        cache->local = __atomic_exchange_n(&cache->remote, NULL, __ATOMIC_ACQUIRE);
+
+        if (cache->local == NULL)
+            _fmpz_mpz_slab_new(cache);
+    }
+
+    slot = cache->local;
+    cache->local = slot->next;
+
+    FMPZ_STAT_INC(_fmpz_num_promotions);
+
+    return &slot->mpz;
+}
+
+void _fmpz_clear_mpz(fmpz f)
+{
+    fmpz_mpz_slot_struct * slot = (fmpz_mpz_slot_struct *) COEFF_TO_PTR(f);
+    fmpz_mpz_cache_struct * cache = slot->slab->owner;
+
+    FMPZ_STAT_INC(_fmpz_num_demotions);
+
+    if (slot->mpz._mp_alloc > FLINT_MPZ_MAX_CACHE_LIMBS)
+        mpz_realloc2(&slot->mpz, 2*FLINT_BITS);
+
+    if (cache == fmpz_mpz_cache)
+    {
+        slot->next = cache->local;
+        cache->local = slot;
+    }
+    else
+    {
+        /*
+           The cache cannot go away under us: the slab holding this slot is
+           still live, so it still holds a reference to its owner.
+        */
+        fmpz_mpz_slot_struct * head;
+
+        FMPZ_STAT_INC(_fmpz_num_remote_frees);
+
+        head = __atomic_load_n(&cache->remote, __ATOMIC_ACQUIRE);
+
+        do
+        {
+            if (head == FMPZ_CACHE_ORPHANED)
+            {
+                _fmpz_mpz_slot_retire(slot);
+                return;
+            }
+
+            slot->next = head;
+        } while (!__atomic_compare_exchange_n(&cache->remote, &head, slot,
+                            1, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+    }
+}
+
+void _fmpz_cleanup_mpz_content(void)
+{
+    fmpz_mpz_cache_struct * cache = fmpz_mpz_cache;
+
+    if (cache == NULL)
+        return;
+
+    _fmpz_mpz_slot_list_retire(cache->local);
+    cache->local = NULL;
+    _fmpz_mpz_slot_list_retire(
+        __atomic_exchange_n(&cache->remote, NULL, __ATOMIC_ACQUIRE));
+}
+
+void _fmpz_cleanup(void)
+{
+    fmpz_mpz_cache_struct * cache = fmpz_mpz_cache;
+
+    if (cache == NULL)
+        return;
+
+    fmpz_mpz_cache = NULL;
+
+    _fmpz_mpz_slot_list_retire(cache->local);
+    cache->local = NULL;
+    _fmpz_mpz_slot_list_retire(
+        __atomic_exchange_n(&cache->remote, FMPZ_CACHE_ORPHANED, __ATOMIC_ACQ_REL));
+
+    _fmpz_mpz_cache_release(cache);
+}
+
+#else
+
 __mpz_struct * _fmpz_new_mpz(void)
 {
     __mpz_struct * mf = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
     mpz_init2(mf, 2*FLINT_BITS);
+    FMPZ_STAT_INC(_fmpz_num_promotions);
     return mf;
 }
 
 void _fmpz_clear_mpz(fmpz f)
 {
+    FMPZ_STAT_INC(_fmpz_num_demotions);
     mpz_clear(COEFF_TO_PTR(f));
     flint_free(COEFF_TO_PTR(f));
 }
@@ -34,6 +280,24 @@ void _fmpz_cleanup(void)
 {
 }
 
+#endif
+
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats)
+{
+    stats->promotions = FMPZ_STAT_GET(_fmpz_num_promotions);
+    stats->demotions = FMPZ_STAT_GET(_fmpz_num_demotions);
+    stats->slabs = FMPZ_STAT_GET(_fmpz_num_slabs);
+    stats->remote_frees = FMPZ_STAT_GET(_fmpz_num_remote_frees);
+}
+
+void fmpz_reset_alloc_stats(void)
+{
+    FMPZ_STAT_SET(_fmpz_num_promotions, 0);
+    FMPZ_STAT_SET(_fmpz_num_demotions, 0);
+    FMPZ_STAT_SET(_fmpz_num_slabs, 0);
+    FMPZ_STAT_SET(_fmpz_num_remote_frees, 0);
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f))  /* f is small so promote it first */
@@ -86,9 +350,12 @@ void _fmpz_demote_val(fmpz_t f)
 
 void _fmpz_init_readonly_mpz(fmpz_t f, const mpz_t z)
 {
-   __mpz_struct * mf = (__mpz_struct *) flint_malloc(sizeof(__mpz_struct));
-    *f = PTR_TO_COEFF(mf);
-    *mf = *z;
+    __mpz_struct * ptr;
+    *f = WORD(0);
+    ptr = _fmpz_promote(f);
+
+    mpz_clear(ptr);
+    *ptr = *z;
 }
 
 void _fmpz_clear_readonly_mpz(mpz_t z)
@@ -46,6 +46,30 @@ FLINT_TLS_PREFIX __mpz_struct ** mpz_free_arr = NULL;
 FLINT_TLS_PREFIX ulong mpz_free_num = 0;
 FLINT_TLS_PREFIX ulong mpz_free_alloc = 0;
 
+/*
+   The allocation counters are thread local when possible. Otherwise they
+   are shared, and with pthreads they are updated with relaxed atomics, or
+   not at all when the GCC atomic builtins are not available.
+*/
+#if FLINT_USES_TLS || !FLINT_USES_PTHREAD
+#define FMPZ_STAT_INC(x) ((x)++)
+#define FMPZ_STAT_GET(x) (x)
+#define FMPZ_STAT_SET(x, v) ((x) = (v))
+#elif (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#define FMPZ_STAT_INC(x) __atomic_add_fetch(&(x), 1, __ATOMIC_RELAXED)
+#define FMPZ_STAT_GET(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define FMPZ_STAT_SET(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELAXED)
+#else
+#define FMPZ_STAT_INC(x)
+#define FMPZ_STAT_GET(x) UWORD(0)
+#define FMPZ_STAT_SET(x, v)
+#endif
+
+static FLINT_TLS_PREFIX ulong _fmpz_num_promotions = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_demotions = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_slabs = 0;
+static FLINT_TLS_PREFIX ulong _fmpz_num_remote_frees = 0;
+
 static slong flint_page_size;
 static slong flint_mpz_structs_per_block;
 static slong flint_page_mask;
@@ -101,6 +125,8 @@ __mpz_struct * _fmpz_new_mpz(void)
 
         flint_mpz_structs_per_block = PAGES_PER_BLOCK*(num - skip);
 
+        FMPZ_STAT_INC(_fmpz_num_slabs);
+
         for (i = 0; i < PAGES_PER_BLOCK; i++)
         {
             __mpz_struct * page_ptr = (__mpz_struct *)((slong) aligned_ptr + i*flint_page_size);
@@ -127,6 +153,8 @@ __mpz_struct * _fmpz_new_mpz(void)
         }
     }
 
+    FMPZ_STAT_INC(_fmpz_num_promotions);
+
     return mpz_free_arr[--mpz_free_num];
 }
 
@@ -139,6 +167,8 @@ void _fmpz_clear_mpz(fmpz f)
 
     header_ptr = (fmpz_block_header_s *) header_ptr->address;
 
+    FMPZ_STAT_INC(_fmpz_num_demotions);
+
     /* clean up if this is left over from another thread */
 #if FLINT_USES_PTHREAD
     if (header_ptr->count != 0 || !pthread_equal(header_ptr->thread, pthread_self()))
@@ -148,6 +178,8 @@ void _fmpz_clear_mpz(fmpz f)
     {
         int new_count;
 
+        FMPZ_STAT_INC(_fmpz_num_remote_frees);
+
         mpz_clear(ptr);
 
 #if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)) && FLINT_USES_PTHREAD
@@ -212,6 +244,22 @@ void _fmpz_cleanup(void)
     mpz_free_arr = NULL;
 }
 
+void fmpz_get_alloc_stats(fmpz_alloc_stats_t stats)
+{
+    stats->promotions = FMPZ_STAT_GET(_fmpz_num_promotions);
+    stats->demotions = FMPZ_STAT_GET(_fmpz_num_demotions);
+    stats->slabs = FMPZ_STAT_GET(_fmpz_num_slabs);
+    stats->remote_frees = FMPZ_STAT_GET(_fmpz_num_remote_frees);
+}
+
+void fmpz_reset_alloc_stats(void)
+{
+    FMPZ_STAT_SET(_fmpz_num_promotions, 0);
+    FMPZ_STAT_SET(_fmpz_num_demotions, 0);
+    FMPZ_STAT_SET(_fmpz_num_slabs, 0);
+    FMPZ_STAT_SET(_fmpz_num_remote_frees, 0);
+}
+
 __mpz_struct * _fmpz_promote(fmpz_t f)
 {
     if (!COEFF_IS_MPZ(*f)) /* f is small so promote it first */
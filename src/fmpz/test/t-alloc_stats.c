@@ -0,0 +1,146 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "flint.h"
+#include "thread_support.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+
+typedef struct
+{
+    fmpz * vec;
+    int set;
+}
+work_t;
+
+static void
+set_value(fmpz_t f, slong i)
+{
+    fmpz_one(f);
+    fmpz_mul_2exp(f, f, 70 + (i % 97));
+    fmpz_add_si(f, f, i);
+}
+
+static void
+worker(slong i, void * arg)
+{
+    work_t * w = (work_t *) arg;
+
+    if (w->set)
+        set_value(w->vec + i, i);
+    else
+        fmpz_zero(w->vec + i);
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("alloc_stats....");
+    fflush(stdout);
+
+    /* promotions and demotions in a single thread */
+    for (iter = 0; iter < 100 * flint_test_multiplier(); iter++)
+    {
+        fmpz_alloc_stats_t stats;
+        fmpz * vec;
+        slong i, n, num_mpz;
+
+        n = n_randint(state, 1000);
+        vec = _fmpz_vec_init(n);
+
+        fmpz_reset_alloc_stats();
+
+        for (i = 0; i < n; i++)
+            fmpz_randtest(vec + i, state, 2 * FLINT_BITS);
+
+        num_mpz = 0;
+        for (i = 0; i < n; i++)
+            num_mpz += COEFF_IS_MPZ(vec[i]);
+
+        fmpz_get_alloc_stats(stats);
+
+        if (stats->promotions < num_mpz ||
+            stats->promotions - stats->demotions != num_mpz)
+        {
+            flint_printf("FAIL (promotions)\n");
+            flint_printf("n = %wd, num_mpz = %wd, promotions = %wu, demotions = %wu\n",
+                n, num_mpz, stats->promotions, stats->demotions);
+            flint_abort();
+        }
+
+        _fmpz_vec_clear(vec, n);
+
+        fmpz_get_alloc_stats(stats);
+
+        if (stats->promotions != stats->demotions)
+        {
+            flint_printf("FAIL (demotions)\n");
+            flint_printf("promotions = %wu, demotions = %wu\n",
+                stats->promotions, stats->demotions);
+            flint_abort();
+        }
+    }
+
+    /* mpz's allocated and cleared by different threads */
+    for (iter = 0; iter < 20 * flint_test_multiplier(); iter++)
+    {
+        work_t w;
+        fmpz_t t;
+        slong i, n;
+
+        flint_set_num_threads(n_randint(state, 6) + 1);
+
+        n = n_randint(state, 2000);
+        w.vec = _fmpz_vec_init(n);
+        fmpz_init(t);
+
+        w.set = 1;
+        flint_parallel_do(worker, &w, n, 0, FLINT_PARALLEL_STRIDED);
+
+        for (i = 0; i < n; i++)
+        {
+            set_value(t, i);
+
+            if (!fmpz_equal(t, w.vec + i))
+            {
+                flint_printf("FAIL (cross-thread)\n");
+                flint_printf("num_threads = %wd, i = %wd/%wd\n",
+                    flint_get_num_threads(), i, n);
+                flint_abort();
+            }
+
+            if (n_randint(state, 2))
+                fmpz_zero(w.vec + i);
+        }
+
+        /* refill half here, clear everything in the workers */
+        for (i = 0; i < n; i += 2)
+            set_value(w.vec + i, i);
+
+        w.set = 0;
+        flint_parallel_do(worker, &w, n, 0, FLINT_PARALLEL_STRIDED);
+
+        for (i = 0; i < n; i++)
+            set_value(w.vec + i, i);
+
+        fmpz_clear(t);
+        _fmpz_vec_clear(w.vec, n);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -119,6 +119,8 @@ typedef struct ecm_s {
     mp_limb_t n_size;
     mp_limb_t normbits;
 
+    volatile int * cancel;  /* if set and nonzero, abandon the curve */
+
 } ecm_s;
 
 typedef ecm_s ecm_t[1];
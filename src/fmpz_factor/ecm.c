@@ -16,6 +16,7 @@
 #include "mpn_extras.h"
 #include "fmpz.h"
 #include "fmpz_factor.h"
+#include "thread_support.h"
 
 static
 ulong n_ecm_primorial[] =
@@ -43,16 +44,205 @@ ulong n_ecm_primorial[] =
 #define num_n_ecm_primorials 9
 #endif
 
+/*
+    Try the curve with parameter sig. If a factor is found, its normalised
+    limbs are written to f, the stage at which it was found (-1 while
+    selecting the curve) is written to stage and the number of limbs is
+    returned. Otherwise 0 is returned, in particular when select_curve
+    reports an unsuitable curve (v = 0 mod n). Before the curves were
+    split off into this function, that case fell through into the "factor
+    found" branch with a limb count of -1; it is now skipped like any other
+    curve which finds no factor.
+*/
+static mp_size_t
+_fmpz_factor_ecm_curve(mp_ptr f, int * stage, const fmpz_t sig, mp_ptr mpsig,
+                       const mp_limb_t * prime_array, mp_limb_t num,
+                       mp_limb_t B1, mp_limb_t B2, mp_limb_t P,
+                       mp_ptr n, ecm_t ecm_inf)
+{
+    __mpz_struct * mptr;
+    mp_limb_t cy;
+    int ret;
+
+    mpn_zero(mpsig, ecm_inf->n_size);
+
+    if ((!COEFF_IS_MPZ(*sig)))
+    {
+        mpsig[0] = fmpz_get_ui(sig);
+        if (ecm_inf->normbits)
+        {
+            cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
+            if (cy)
+               mpsig[1] = cy;
+        }
+    }
+    else
+    {
+        mptr = COEFF_TO_PTR(*sig);
+
+        if (ecm_inf->normbits)
+        {
+            cy = mpn_lshift(mpsig, mptr->_mp_d, mptr->_mp_size, ecm_inf->normbits);
+            if (cy)
+                mpsig[mptr->_mp_size] = cy;
+        } else
+        {
+            flint_mpn_copyi(mpsig, mptr->_mp_d, mptr->_mp_size);
+        }
+    }
+
+    /************************ SELECT CURVE ************************/
+
+    ret = fmpz_factor_ecm_select_curve(f, mpsig, n, ecm_inf);
+
+    if (ret)
+    {
+        /* Found factor while selecting curve,
+           very very lucky :) */
+
+        if (ret == -1)
+            return 0;
+
+        *stage = -1;
+        return ret;
+    }
+
+    /************************** STAGE I ***************************/
+
+    ret = fmpz_factor_ecm_stage_I(f, prime_array, num, B1, n, ecm_inf);
+
+    if (ret)
+    {
+        *stage = 1;
+        return ret;
+    }
+
+    if (ecm_inf->cancel != NULL && *ecm_inf->cancel)
+        return 0;
+
+    /************************** STAGE II ***************************/
+
+    ret = fmpz_factor_ecm_stage_II(f, B1, B2, P, n, ecm_inf);
+
+    if (ret)
+    {
+        *stage = 2;
+        return ret;
+    }
+
+    return 0;
+}
+
+/*
+    Curves are handed out one at a time to the threads; once a thread finds
+    a factor, the others abandon their current curve.
+*/
+typedef struct
+{
+    ecm_s * master;
+    const mp_limb_t * prime_array;
+    mp_limb_t num, B1, B2, P;
+    mp_ptr n;
+    flint_rand_s * state;
+    const fmpz * nm8;
+    mp_limb_t curves;
+    volatile mp_limb_t next_curve;
+    volatile int found;
+    mp_ptr f;
+    mp_size_t fsize;
+    int stage;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+}
+_ecm_shared_struct;
+
+static void
+_fmpz_factor_ecm_worker(void * varg)
+{
+    _ecm_shared_struct * S = (_ecm_shared_struct *) varg;
+    mp_limb_t n_size = S->master->n_size;
+    ecm_t ecm_inf;
+    fmpz_t sig;
+    mp_ptr f, mpsig;
+    mp_size_t fsize;
+    int stage = 0;
+
+    fmpz_factor_ecm_init(ecm_inf, n_size);
+    flint_mpn_copyi(ecm_inf->ninv, S->master->ninv, n_size);
+    flint_mpn_copyi(ecm_inf->one, S->master->one, n_size);
+    ecm_inf->normbits = S->master->normbits;
+    ecm_inf->GCD_table = S->master->GCD_table;
+    ecm_inf->prime_table = S->master->prime_table;
+    ecm_inf->cancel = &S->found;
+
+    fmpz_init(sig);
+    f = flint_malloc(n_size * sizeof(mp_limb_t));
+    mpsig = flint_malloc(n_size * sizeof(mp_limb_t));
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&S->mutex);
+#endif
+        if (S->found || S->next_curve >= S->curves)
+        {
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&S->mutex);
+#endif
+            break;
+        }
+
+        S->next_curve++;
+        fmpz_randm(sig, S->state, S->nm8);
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&S->mutex);
+#endif
+
+        fmpz_add_ui(sig, sig, 7);
+
+        fsize = _fmpz_factor_ecm_curve(f, &stage, sig, mpsig, S->prime_array,
+                                  S->num, S->B1, S->B2, S->P, S->n, ecm_inf);
+
+        if (fsize != 0)
+        {
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&S->mutex);
+#endif
+            if (!S->found)
+            {
+                flint_mpn_copyi(S->f, f, fsize);
+                S->fsize = fsize;
+                S->stage = stage;
+                S->found = 1;
+            }
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&S->mutex);
+#endif
+            break;
+        }
+    }
+
+    flint_free(mpsig);
+    flint_free(f);
+    fmpz_clear(sig);
+
+    fmpz_factor_ecm_clear(ecm_inf);
+}
+
 int
 fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
                 flint_rand_t state, const fmpz_t n_in)
 {
     fmpz_t sig, nm8;
-    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size, cy;
-    int i, j, ret;
+    mp_limb_t P, num, maxP, mmin, mmax, mdiff, prod, maxj, n_size;
+    mp_size_t fsize;
+    int i, j, ret, stage;
     ecm_t ecm_inf;
     __mpz_struct *fac, *mptr;
     mp_ptr n, mpsig;
+    thread_pool_handle * handles;
+    slong num_handles;
 
     TMP_INIT;
 
@@ -174,97 +364,80 @@ fmpz_factor_ecm(fmpz_t f, mp_limb_t curves, mp_limb_t B1, mp_limb_t B2,
 
     /****************************** TRY "CURVES" *****************************/
 
-    for (j = 0; j < curves; j++)
+    num_handles = 0;
+    handles = NULL;
+    if (curves > 1)
+        num_handles = flint_request_threads(&handles, FLINT_MIN(curves, WORD_MAX));
+
+    if (num_handles > 0)
     {
-        fmpz_randm(sig, state, nm8);
-        fmpz_add_ui(sig, sig, 7);
+        /* independent curves on separate threads */
+
+        _ecm_shared_struct S;
+
+        S.master = ecm_inf;
+        S.prime_array = prime_array;
+        S.num = num;
+        S.B1 = B1;
+        S.B2 = B2;
+        S.P = P;
+        S.n = n;
+        S.state = state;
+        S.nm8 = nm8;
+        S.curves = curves;
+        S.next_curve = 0;
+        S.found = 0;
+        S.f = fac->_mp_d;
+        S.fsize = 0;
+        S.stage = 0;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_init(&S.mutex, NULL);
+#endif
 
-        mpn_zero(mpsig, ecm_inf->n_size);
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                   _fmpz_factor_ecm_worker, &S);
 
-        if ((!COEFF_IS_MPZ(*sig)))
-        {
-            mpsig[0] = fmpz_get_ui(sig);
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mpsig, 1, ecm_inf->normbits);
-                if (cy)
-                   mpsig[1] = cy;
-            }
-        }
-        else
-        {
-            mptr = COEFF_TO_PTR(*sig);
+        _fmpz_factor_ecm_worker(&S);
 
-            if (ecm_inf->normbits)
-            {
-                cy = mpn_lshift(mpsig, mptr->_mp_d, mptr->_mp_size, ecm_inf->normbits);
-                if (cy)
-                    mpsig[mptr->_mp_size] = cy;
-            } else
-            {
-                flint_mpn_copyi(mpsig, mptr->_mp_d, mptr->_mp_size);
-            }
-        }
+        for (i = 0; i < num_handles; i++)
+            thread_pool_wait(global_thread_pool, handles[i]);
 
-        /************************ SELECT CURVE ************************/
+#if FLINT_USES_PTHREAD
+        pthread_mutex_destroy(&S.mutex);
+#endif
 
-        ret = fmpz_factor_ecm_select_curve(fac->_mp_d, mpsig, n, ecm_inf);
+        fsize = S.fsize;
+        stage = S.stage;
+    }
+    else
+    {
+        fsize = 0;
+        stage = 0;
 
-        if (ret)
+        for (j = 0; j < curves && fsize == 0; j++)
         {
-            /* Found factor while selecting curve,
-               very very lucky :) */
-
-            if (ecm_inf->normbits)
-               mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-            MPN_NORM(fac->_mp_d, ret);
+            fmpz_randm(sig, state, nm8);
+            fmpz_add_ui(sig, sig, 7);
 
-            fac->_mp_size = ret;
-            _fmpz_demote_val(f);
-            ret = -1;
-            goto cleanup;
+            fsize = _fmpz_factor_ecm_curve(fac->_mp_d, &stage, sig, mpsig,
+                                      prime_array, num, B1, B2, P, n, ecm_inf);
         }
+    }
 
-        if (ret != -1)
-        {
-
-            /************************** STAGE I ***************************/
-
-            ret = fmpz_factor_ecm_stage_I(fac->_mp_d, prime_array, num, B1, n, ecm_inf);
+    flint_give_back_threads(handles, num_handles);
 
-            if (ret)
-            {
-                /* Found factor after stage I */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);
-                ret = 1;
-                goto cleanup;
-            }
-            /************************** STAGE II ***************************/
-
-            ret = fmpz_factor_ecm_stage_II(fac->_mp_d, B1, B2, P, n, ecm_inf);
+    if (fsize != 0)
+    {
+        if (ecm_inf->normbits)
+           mpn_rshift(fac->_mp_d, fac->_mp_d, fsize, ecm_inf->normbits);
+        MPN_NORM(fac->_mp_d, fsize);
 
-            if (ret)
-            {
-                /* Found factor after stage II */
-                if (ecm_inf->normbits)
-                   mpn_rshift(fac->_mp_d, fac->_mp_d, ret, ecm_inf->normbits);
-                MPN_NORM(fac->_mp_d, ret);
-                fac->_mp_size = ret;
-                _fmpz_demote_val(f);
-                ret = 2;
-                goto cleanup;
-            }
-        }
+        fac->_mp_size = fsize;
+        _fmpz_demote_val(f);
+        ret = stage;
     }
 
-    cleanup:
-
-
     flint_free(ecm_inf->GCD_table);
     for (i = 0; i < mdiff; i++)
         flint_free(ecm_inf->prime_table[i]);
@@ -97,6 +97,12 @@ fmpz_factor_ecm_stage_II(mp_ptr f, mp_limb_t B1, mp_limb_t B2, mp_limb_t P,
 
     for (i = mmin; i <= mmax; i ++)
     {
+        if (ecm_inf->cancel != NULL && *ecm_inf->cancel)
+        {
+            ret = 0;
+            goto cleanup;
+        }
+
         for (j = 1; j <= maxj; j += 2)
         {
             if (ecm_inf->prime_table[i - mmin][j] == 1)
@@ -10,8 +10,10 @@
 */
 
 #include "ulong_extras.h"
+#include "thread_support.h"
 #include "fmpz.h"
 #include "fmpz_factor.h"
+#include "mpn_extras.h"
 
 int main(void)
 {
@@ -40,6 +42,8 @@ int main(void)
 
             fmpz_mul(primeprod, prime1, prime2);
 
+            flint_set_num_threads(n_randint(state, 4) + 1);
+
             k = fmpz_factor_ecm(fac, i << 2, 2000, 50000, state, primeprod);
 
             if (k == 0)
@@ -62,6 +66,8 @@ int main(void)
         }
     }
 
+    flint_set_num_threads(1);
+
     if (fails > flint_test_multiplier())
     {
         printf("FAIL : ECM failed too many times (%d times)\n", fails);
@@ -69,6 +75,80 @@ int main(void)
         flint_abort();
     }
 
+    /* A curve with v = 0 mod n is unsuitable. With sigma = 2^40 + 1 and n
+       the odd part of sigma*(sigma^2 - 5), the Suyama parameterisation gives
+       v = 1024*(sigma^2 - 5)^3*sigma^4 = 0 mod n. fmpz_factor_ecm skips such
+       curves, so whatever it returns must still be a proper result. */
+#if FLINT64
+    {
+        ecm_t ecm_inf;
+        fmpz_t sig;
+        mp_ptr n, mpsig, f;
+        mp_size_t n_size;
+        __mpz_struct * mptr;
+
+        fmpz_init(sig);
+        fmpz_one(sig);
+        fmpz_mul_2exp(sig, sig, 40);
+        fmpz_add_ui(sig, sig, 1);
+
+        fmpz_mul(primeprod, sig, sig);
+        fmpz_sub_ui(primeprod, primeprod, 5);
+        fmpz_tdiv_q_2exp(primeprod, primeprod, fmpz_val2(primeprod));
+        fmpz_mul(primeprod, primeprod, sig);
+
+        n_size = fmpz_size(primeprod);
+        n = flint_malloc(n_size * sizeof(mp_limb_t));
+        mpsig = flint_calloc(n_size, sizeof(mp_limb_t));
+        f = flint_malloc(n_size * sizeof(mp_limb_t));
+
+        fmpz_factor_ecm_init(ecm_inf, n_size);
+
+        mptr = COEFF_TO_PTR(*primeprod);
+        ecm_inf->normbits = flint_clz(mptr->_mp_d[n_size - 1]);
+        mpn_lshift(n, mptr->_mp_d, n_size, ecm_inf->normbits);
+        flint_mpn_preinvn(ecm_inf->ninv, n, n_size);
+        ecm_inf->one[0] = UWORD(1) << ecm_inf->normbits;
+
+        mpsig[0] = fmpz_get_ui(sig) << ecm_inf->normbits;
+        mpsig[1] = fmpz_get_ui(sig) >> (FLINT_BITS - ecm_inf->normbits);
+
+        k = fmpz_factor_ecm_select_curve(f, mpsig, n, ecm_inf);
+
+        if (k != -1)
+        {
+            flint_printf("FAIL : unsuitable curve not detected (%d)\n", k);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_factor_ecm_clear(ecm_inf);
+        flint_free(n);
+        flint_free(mpsig);
+        flint_free(f);
+        fmpz_clear(sig);
+
+        for (j = 1; j <= 3; j++)
+        {
+            flint_set_num_threads(j);
+
+            k = fmpz_factor_ecm(fac, 20, 100, 1000, state, primeprod);
+
+            if (k != 0 && (fmpz_is_one(fac) || fmpz_equal(fac, primeprod) ||
+                           !fmpz_divisible(primeprod, fac)))
+            {
+                flint_printf("FAIL : wrong factor calculated (%d)\n", k);
+                fmpz_print(primeprod); flint_printf("\n");
+                fmpz_print(fac); flint_printf("\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_set_num_threads(1);
+    }
+#endif
+
     /* Tests for hangs and crashes, don't care about result */
 
 #if FLINT64
@@ -37,6 +37,10 @@
 
 #define SIZE_RED_FAILURE_THRESH 5
 
+#define FMPZ_LLL_SIZE_RED_BLOCK 32
+#define FMPZ_LLL_SIZE_RED_THREAD_CUTOFF 20000
+#define FMPZ_LLL_GRAM_THREAD_CUTOFF 20000
+
 typedef enum
 {
     GRAM,
@@ -94,6 +98,15 @@ int fmpz_lll_check_babai_heuristic_d(int kappa, fmpz_mat_t B, fmpz_mat_t U, d_ma
 
 int fmpz_lll_shift(const fmpz_mat_t B);
 
+void _fmpz_lll_size_reduce_row(fmpz * v, fmpz * const * rows,
+   const int * idx, const slong * x, const ulong * e, slong num, slong len);
+
+void _fmpz_lll_gram_row_d(d_mat_t G, const d_mat_t appB, const fmpz_mat_t B,
+       const int * expo, int kappa, int a, int b, int n, int heuristic);
+
+void _fmpz_lll_gram_update_exact(fmpz_mat_t GM, const fmpz * x, int kappa,
+                                                                    int zeros);
+
 int fmpz_lll_d(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
 
 int fmpz_lll_d_heuristic(fmpz_mat_t B, fmpz_mat_t U, const fmpz_lll_t fl);
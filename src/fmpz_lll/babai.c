@@ -24,12 +24,23 @@ FUNC_HEAD
     if (fl->rt == Z_BASIS && fl->gt == APPROX)
     {
         int i, j, k, test, aa, exponent, max_expo = INT_MAX;
-        slong xx;
+        slong xx, num_red;
         double tmp, rtmp, halfplus, onedothalfplus;
         ulong loops;
+        int * red_idx;
+        slong * red_x;
+        ulong * red_e;
+        TMP_INIT;
 
         aa = (a > zeros) ? a : zeros + 1;
 
+        /* the row operations of one size reduction pass are recorded and
+           applied together, as the rows B[j], j < kappa, do not change */
+        TMP_START;
+        red_x = TMP_ALLOC(3 * FLINT_MAX(LIMIT, 1) * sizeof(slong));
+        red_e = (ulong *) (red_x + FLINT_MAX(LIMIT, 1));
+        red_idx = (int *) (red_e + FLINT_MAX(LIMIT, 1));
+
         halfplus = (fl->eta + 0.5) / 2;
         onedothalfplus = 1.0 + halfplus;
 
@@ -38,11 +49,15 @@ FUNC_HEAD
         do
         {
             test = 0;
+            num_red = 0;
 
             /* ************************************** */
             /* Step2: compute the GSO for stage kappa */
             /* ************************************** */
 
+            _fmpz_lll_gram_row_d(A->appSP, appB, B, expo, kappa, aa, LIMIT, n,
+                                                               HEURISTIC_DOT);
+
             for (j = aa; j < LIMIT; j++)
             {
                 if (d_is_nan(d_mat_entry(A->appSP, kappa, j)))
@@ -97,6 +112,7 @@ FUNC_HEAD
                 }
                 if (new_max_expo > max_expo - SIZE_RED_FAILURE_THRESH)
                 {
+                    TMP_END;
                     return -1;
                 }
                 max_expo = new_max_expo;
@@ -128,14 +144,10 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) - tmp;
                             }
-                            _fmpz_vec_sub(B->rows[kappa], B->rows[kappa],
-                                          B->rows[j], n);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_sub(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = 1;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                         else    /* otherwise X is -1 */
                         {
@@ -145,14 +157,10 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) + tmp;
                             }
-                            _fmpz_vec_add(B->rows[kappa], B->rows[kappa],
-                                          B->rows[j], n);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_add(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = -1;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                     }
                     else        /* we must have |X| >= 2 */
@@ -175,14 +183,10 @@ FUNC_HEAD
                             }
 
                             xx = (slong) tmp;
-                            _fmpz_vec_scalar_submul_si(B->rows[kappa],
-                                                       B->rows[j], n, xx);
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_scalar_submul_si(U->rows[kappa],
-                                                           U->rows[j],
-                                                           U->c, xx);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = xx;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                         else
                         {
@@ -200,15 +204,10 @@ FUNC_HEAD
                                 xx = xx << -exponent;
                                 exponent = 0;
 
-                                _fmpz_vec_scalar_submul_si(B->rows[kappa],
-                                                           B->rows[j], n, xx);
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si(U->rows
-                                                               [kappa],
-                                                               U->rows[j],
-                                                               U->c, xx);
-                                }
+                                red_idx[num_red] = j;
+                                red_x[num_red] = xx;
+                                red_e[num_red] = 0;
+                                num_red++;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -221,21 +220,10 @@ FUNC_HEAD
                             }
                             else
                             {
-                                _fmpz_vec_scalar_submul_si_2exp(B->rows
-                                                                [kappa],
-                                                                B->rows[j],
-                                                                n, xx,
-                                                                exponent);
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si_2exp(U->rows
-                                                                    [kappa],
-                                                                    U->rows
-                                                                    [j],
-                                                                    U->c,
-                                                                    xx,
-                                                                    exponent);
-                                }
+                                red_idx[num_red] = j;
+                                red_x[num_red] = xx;
+                                red_e[num_red] = exponent;
+                                num_red++;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -254,6 +242,12 @@ FUNC_HEAD
                 }
             }
 
+            _fmpz_lll_size_reduce_row(B->rows[kappa], B->rows,
+                                        red_idx, red_x, red_e, num_red, n);
+            if (U != NULL)
+                _fmpz_lll_size_reduce_row(U->rows[kappa], U->rows,
+                                     red_idx, red_x, red_e, num_red, U->c);
+
             if (test)           /* Anything happened? */
             {
                 expo[kappa] =
@@ -277,6 +271,8 @@ FUNC_HEAD
             loops++;
         } while (test);
 
+        TMP_END;
+
 #if TYPE == 1
         if (d_is_nan(d_mat_entry(A->appSP, kappa, kappa)))
         {
@@ -296,14 +292,22 @@ FUNC_HEAD
     {
         int i, j, k, test, aa, exponent, max_expo = INT_MAX;
         slong exp;
-        slong xx;
+        slong xx, num_red;
         double tmp, rtmp, halfplus, onedothalfplus;
         fmpz_t t;
         ulong loops;
+        int * red_idx;
+        slong * red_x;
+        ulong * red_e;
+        TMP_INIT;
 
         aa = (a > zeros) ? a : zeros + 1;
 
         fmpz_init(t);
+        TMP_START;
+        red_x = TMP_ALLOC(3 * FLINT_MAX(kappa, 1) * sizeof(slong));
+        red_e = (ulong *) (red_x + FLINT_MAX(kappa, 1));
+        red_idx = (int *) (red_e + FLINT_MAX(kappa, 1));
 
         halfplus = (fl->eta + 0.5) / 2;
         onedothalfplus = 1.0 + halfplus;
@@ -315,6 +319,7 @@ FUNC_HEAD
             fmpz *x;
 
             test = 0;
+            num_red = 0;
 
             /* ************************************** */
             /* Step2: compute the GSO for stage kappa */
@@ -387,6 +392,7 @@ FUNC_HEAD
                 if (new_max_expo > max_expo - SIZE_RED_FAILURE_THRESH)
                 {
                     fmpz_clear(t);
+                    TMP_END;
                     return -1;
                 }
                 max_expo = new_max_expo;
@@ -420,17 +426,10 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) - tmp;
                             }
-                            if (fl->rt == Z_BASIS && B != NULL)
-                            {
-                                _fmpz_vec_sub(B->rows[kappa],
-                                              B->rows[kappa], B->rows[j], n);
-                            }
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_sub(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = 1;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                         else    /* otherwise X is -1 */
                         {
@@ -441,17 +440,10 @@ FUNC_HEAD
                                 d_mat_entry(mu, kappa, k) =
                                     d_mat_entry(mu, kappa, k) + tmp;
                             }
-                            if (fl->rt == Z_BASIS && B != NULL)
-                            {
-                                _fmpz_vec_add(B->rows[kappa],
-                                              B->rows[kappa], B->rows[j], n);
-                            }
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_add(U->rows[kappa],
-                                              U->rows[kappa], U->rows[j],
-                                              U->c);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = -1;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                     }
                     else        /* we must have |X| >= 2 */
@@ -475,17 +467,10 @@ FUNC_HEAD
 
                             xx = (slong) tmp;
                             fmpz_set_si(x + j - zeros - 1, xx);
-                            if (fl->rt == Z_BASIS && B != NULL)
-                            {
-                                _fmpz_vec_scalar_submul_si(B->rows[kappa],
-                                                           B->rows[j], n, xx);
-                            }
-                            if (U != NULL)
-                            {
-                                _fmpz_vec_scalar_submul_si(U->rows[kappa],
-                                                           U->rows[j],
-                                                           U->c, xx);
-                            }
+                            red_idx[num_red] = j;
+                            red_x[num_red] = xx;
+                            red_e[num_red] = 0;
+                            num_red++;
                         }
                         else
                         {
@@ -504,20 +489,10 @@ FUNC_HEAD
                                 exponent = 0;
 
                                 fmpz_set_si(x + j - zeros - 1, xx);
-                                if (fl->rt == Z_BASIS && B != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si(B->rows
-                                                               [kappa],
-                                                               B->rows[j],
-                                                               n, xx);
-                                }
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si(U->rows
-                                                               [kappa],
-                                                               U->rows[j],
-                                                               U->c, xx);
-                                }
+                                red_idx[num_red] = j;
+                                red_x[num_red] = xx;
+                                red_e[num_red] = 0;
+                                num_red++;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -532,25 +507,10 @@ FUNC_HEAD
                             {
                                 fmpz_set_si(x + j - zeros - 1, xx);
                                 fmpz_mul_2exp(x + j - zeros - 1, x + j - zeros - 1, exponent);
-                                if (fl->rt == Z_BASIS && B != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si_2exp(B->rows
-                                                                    [kappa],
-                                                                    B->rows
-                                                                    [j], n,
-                                                                    xx,
-                                                                    exponent);
-                                }
-                                if (U != NULL)
-                                {
-                                    _fmpz_vec_scalar_submul_si_2exp(U->rows
-                                                                    [kappa],
-                                                                    U->rows
-                                                                    [j],
-                                                                    U->c,
-                                                                    xx,
-                                                                    exponent);
-                                }
+                                red_idx[num_red] = j;
+                                red_x[num_red] = xx;
+                                red_e[num_red] = exponent;
+                                num_red++;
 
                                 for (k = zeros + 1; k < j; k++)
                                 {
@@ -569,6 +529,13 @@ FUNC_HEAD
                 }
             }
 
+            if (fl->rt == Z_BASIS && B != NULL)
+                _fmpz_lll_size_reduce_row(B->rows[kappa], B->rows,
+                                        red_idx, red_x, red_e, num_red, n);
+            if (U != NULL)
+                _fmpz_lll_size_reduce_row(U->rows[kappa], U->rows,
+                                     red_idx, red_x, red_e, num_red, U->c);
+
             if (test)           /* Anything happened? */
             {
                 aa = zeros + 1;
@@ -597,22 +564,7 @@ FUNC_HEAD
                 fmpz_get_d_2exp(&exp, fmpz_mat_entry(GM, kappa, kappa));
                 expo[kappa] = exp;
 
-                for (i = zeros + 1; i < kappa; i++)
-                {
-                    for (j = zeros + 1; j <= i; j++)
-                        fmpz_submul(fmpz_mat_entry(GM, kappa, i),
-                                    x + j - zeros - 1, fmpz_mat_entry(GM, i, j));
-                    for (j = i + 1; j < kappa; j++)
-                        fmpz_submul(fmpz_mat_entry(GM, kappa, i),
-                                    x + j - zeros - 1, fmpz_mat_entry(GM, j, i));
-                }
-
-                for (i = kappa + 1; i < GM->r; i++)
-                {
-                    for (j = zeros + 1; j < kappa; j++)
-                        fmpz_submul(fmpz_mat_entry(GM, i, kappa),
-                                    x + j - zeros - 1, fmpz_mat_entry(GM, i, j));
-                }
+                _fmpz_lll_gram_update_exact(GM, x, kappa, zeros);
             }
 
             _fmpz_vec_clear(x, kappa - 1 - zeros);
@@ -631,6 +583,7 @@ FUNC_HEAD
         }
 
         fmpz_clear(t);
+        TMP_END;
     }
     return 0;
 }
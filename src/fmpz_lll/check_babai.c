@@ -34,6 +34,10 @@
 #undef TYPE
 #endif
 
+#ifdef HEURISTIC_DOT
+#undef HEURISTIC_DOT
+#endif
+
 #define FUNC_HEAD int fmpz_lll_check_babai(int kappa, fmpz_mat_t B, fmpz_mat_t U, d_mat_t mu, d_mat_t r, double *s, \
        d_mat_t appB, int *expo, fmpz_gram_t A, \
        int a, int zeros, int kappamax, int n, const fmpz_lll_t fl)
@@ -46,9 +50,11 @@ do {                                                                \
     else                                                            \
         d_mat_entry(G, I, J) = _d_vec_norm(appB->rows[I], C);       \
 } while (0)
+#define HEURISTIC_DOT 0
 #define TYPE 1
 #include "babai.c"
 #undef FUNC_HEAD
 #undef LIMIT
 #undef COMPUTE
 #undef TYPE
+#undef HEURISTIC_DOT
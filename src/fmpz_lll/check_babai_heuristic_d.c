@@ -33,6 +33,10 @@
 #undef TYPE
 #endif
 
+#ifdef HEURISTIC_DOT
+#undef HEURISTIC_DOT
+#endif
+
 #define FUNC_HEAD int fmpz_lll_check_babai_heuristic_d(int kappa, fmpz_mat_t B, fmpz_mat_t U, d_mat_t mu, d_mat_t r, double *s, \
        d_mat_t appB, int *expo, fmpz_gram_t A, \
        int a, int zeros, int kappamax, int n, const fmpz_lll_t fl)
@@ -43,9 +47,11 @@ do {                                                                \
             fmpz_lll_heuristic_dot(appB->rows[I], appB->rows[J], C, \
                                    B, I, J, expo[I] + expo[J]);     \
 } while (0)
+#define HEURISTIC_DOT 1
 #define TYPE 1
 #include "babai.c"
 #undef FUNC_HEAD
 #undef LIMIT
 #undef COMPUTE
 #undef TYPE
+#undef HEURISTIC_DOT
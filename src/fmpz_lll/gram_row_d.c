@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "thread_support.h"
+#include "double_extras.h"
+#include "d_vec.h"
+#include "fmpz_lll.h"
+
+typedef struct
+{
+    d_mat_struct * G;
+    const d_mat_struct * appB;
+    const fmpz_mat_struct * B;
+    const int * expo;
+    int kappa;
+    int a;
+    int n;
+    int heuristic;
+}
+work_t;
+
+static void
+_gram_entry(d_mat_t G, const d_mat_t appB, const fmpz_mat_t B,
+                const int * expo, int kappa, int j, int n, int heuristic)
+{
+    if (!d_is_nan(d_mat_entry(G, kappa, j)))
+        return;
+
+    if (heuristic)
+        d_mat_entry(G, kappa, j) = fmpz_lll_heuristic_dot(appB->rows[kappa],
+                           appB->rows[j], n, B, kappa, j, expo[kappa] + expo[j]);
+    else if (j != kappa)
+        d_mat_entry(G, kappa, j) = _d_vec_dot(appB->rows[kappa],
+                                                           appB->rows[j], n);
+    else
+        d_mat_entry(G, kappa, j) = _d_vec_norm(appB->rows[kappa], n);
+}
+
+static void
+worker(slong i, void * args)
+{
+    work_t * w = (work_t *) args;
+
+    _gram_entry(w->G, w->appB, w->B, w->expo, w->kappa, w->a + i, w->n,
+                                                                 w->heuristic);
+}
+
+void
+_fmpz_lll_gram_row_d(d_mat_t G, const d_mat_t appB, const fmpz_mat_t B,
+       const int * expo, int kappa, int a, int b, int n, int heuristic)
+{
+    int j;
+
+    if (b <= a)
+        return;
+
+    if ((slong) (b - a) * n >= FMPZ_LLL_GRAM_THREAD_CUTOFF &&
+        flint_get_num_threads() >= 2)
+    {
+        work_t work[1];
+
+        work->G = G;
+        work->appB = appB;
+        work->B = B;
+        work->expo = expo;
+        work->kappa = kappa;
+        work->a = a;
+        work->n = n;
+        work->heuristic = heuristic;
+
+        flint_parallel_do(worker, work, b - a, 0, FLINT_PARALLEL_UNIFORM);
+    }
+    else
+    {
+        for (j = a; j < b; j++)
+            _gram_entry(G, appB, B, expo, kappa, j, n, heuristic);
+    }
+}
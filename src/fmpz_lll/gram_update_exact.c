@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "thread_support.h"
+#include "fmpz.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+
+typedef struct
+{
+    fmpz_mat_struct * GM;
+    const fmpz * x;
+    int kappa;
+    int zeros;
+}
+work_t;
+
+static void
+_gram_update_row(fmpz_mat_t GM, const fmpz * x, int kappa, int zeros, int i)
+{
+    int j;
+
+    if (i < kappa)
+    {
+        for (j = zeros + 1; j <= i; j++)
+            fmpz_submul(fmpz_mat_entry(GM, kappa, i),
+                        x + j - zeros - 1, fmpz_mat_entry(GM, i, j));
+        for (j = i + 1; j < kappa; j++)
+            fmpz_submul(fmpz_mat_entry(GM, kappa, i),
+                        x + j - zeros - 1, fmpz_mat_entry(GM, j, i));
+    }
+    else
+    {
+        for (j = zeros + 1; j < kappa; j++)
+            fmpz_submul(fmpz_mat_entry(GM, i, kappa),
+                        x + j - zeros - 1, fmpz_mat_entry(GM, i, j));
+    }
+}
+
+static void
+worker(slong i, void * args)
+{
+    work_t * w = (work_t *) args;
+    int row = w->zeros + 1 + i;
+
+    /* skip the diagonal entry, which is updated by the caller */
+    if (row >= w->kappa)
+        row++;
+
+    _gram_update_row(w->GM, w->x, w->kappa, w->zeros, row);
+}
+
+void
+_fmpz_lll_gram_update_exact(fmpz_mat_t GM, const fmpz * x, int kappa,
+                                                                     int zeros)
+{
+    slong i, num = GM->r - zeros - 2;
+
+    if (num <= 0)
+        return;
+
+    if (num * (kappa - zeros - 1) >= FMPZ_LLL_GRAM_THREAD_CUTOFF &&
+        flint_get_num_threads() >= 2)
+    {
+        work_t work[1];
+
+        work->GM = GM;
+        work->x = x;
+        work->kappa = kappa;
+        work->zeros = zeros;
+
+        flint_parallel_do(worker, work, num, 0, FLINT_PARALLEL_DYNAMIC);
+    }
+    else
+    {
+        for (i = zeros + 1; i < GM->r; i++)
+        {
+            if (i != kappa)
+                _gram_update_row(GM, x, kappa, zeros, i);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "thread_support.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_lll.h"
+
+typedef struct
+{
+    fmpz * v;
+    fmpz * const * rows;
+    const int * idx;
+    const slong * x;
+    const ulong * e;
+    slong num;
+    slong len;
+    slong block;
+}
+work_t;
+
+static void
+_size_reduce_columns(fmpz * v, fmpz * const * rows, const int * idx,
+           const slong * x, const ulong * e, slong num, slong start, slong len)
+{
+    slong i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (x[i] == 1 && e[i] == 0)
+            _fmpz_vec_sub(v + start, v + start, rows[idx[i]] + start, len);
+        else if (x[i] == -1 && e[i] == 0)
+            _fmpz_vec_add(v + start, v + start, rows[idx[i]] + start, len);
+        else
+            _fmpz_vec_scalar_submul_si_2exp(v + start, rows[idx[i]] + start,
+                                                             len, x[i], e[i]);
+    }
+}
+
+static void
+worker(slong i, void * args)
+{
+    work_t * w = (work_t *) args;
+    slong start = i * w->block;
+    slong len = FLINT_MIN(w->block, w->len - start);
+
+    _size_reduce_columns(w->v, w->rows, w->idx, w->x, w->e,
+                                                          w->num, start, len);
+}
+
+void
+_fmpz_lll_size_reduce_row(fmpz * v, fmpz * const * rows, const int * idx,
+                  const slong * x, const ulong * e, slong num, slong len)
+{
+    slong num_threads;
+
+    if (num == 0)
+        return;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads >= 2 && len >= 2 * FMPZ_LLL_SIZE_RED_BLOCK &&
+        num * len >= FMPZ_LLL_SIZE_RED_THREAD_CUTOFF)
+    {
+        work_t work[1];
+
+        work->v = v;
+        work->rows = rows;
+        work->idx = idx;
+        work->x = x;
+        work->e = e;
+        work->num = num;
+        work->len = len;
+        work->block = FLINT_MAX(FMPZ_LLL_SIZE_RED_BLOCK,
+                                (len + 4 * num_threads - 1) / (4 * num_threads));
+
+        flint_parallel_do(worker, work, (len + work->block - 1) / work->block,
+                                                 0, FLINT_PARALLEL_DYNAMIC);
+    }
+    else
+    {
+        _size_reduce_columns(v, rows, idx, x, e, num, 0, len);
+    }
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "thread_support.h"
+#include "fmpz_mat.h"
+#include "fmpz_lll.h"
+
+int
+main(void)
+{
+    int i;
+    fmpz_mat_t mat, mat2, U, U2;
+    fmpz_lll_t fl;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("lll_d_threaded....");
+    fflush(stdout);
+
+    /* the threaded code must give exactly the same reduction */
+    for (i = 0; i < 2 * flint_test_multiplier(); i++)
+    {
+        ulong q;
+        slong r, threads;
+        flint_bitcnt_t bits;
+
+        r = 2 * (n_randint(state, 20) + 60);
+        threads = n_randint(state, 4) + 2;
+
+        fmpz_mat_init(mat, r, r);
+        fmpz_mat_init(mat2, r, r);
+        fmpz_mat_init(U, r, r);
+        fmpz_mat_init(U2, r, r);
+
+        fmpz_lll_context_init(fl, 0.99, 0.51, Z_BASIS,
+                                        n_randint(state, 2) ? APPROX : EXACT);
+
+        bits = n_randint(state, 10) + 1;
+        q = n_randint(state, 200) + 1;
+
+        fmpz_mat_randntrulike(mat, state, bits, q);
+        fmpz_mat_set(mat2, mat);
+        fmpz_mat_one(U);
+        fmpz_mat_one(U2);
+
+        flint_set_num_threads(1);
+        fmpz_lll_d(mat, U, fl);
+
+        flint_set_num_threads(threads);
+        fmpz_lll_d(mat2, U2, fl);
+
+        if (!fmpz_mat_equal(mat, mat2) || !fmpz_mat_equal(U, U2)
+                          || !fmpz_mat_is_reduced(mat2, fl->delta, fl->eta))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("r = %wd, bits = %wu, threads = %wd\n",
+                                                           r, bits, threads);
+            flint_printf("gram_type = %d\n", fl->gt);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mat_clear(mat);
+        fmpz_mat_clear(mat2);
+        fmpz_mat_clear(U);
+        fmpz_mat_clear(U2);
+    }
+
+    flint_set_num_threads(1);
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
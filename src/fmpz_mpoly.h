@@ -664,6 +664,35 @@ void fmpz_mpoly_evaluate_all_fmpz_mod(fmpz_t ev,
                         const fmpz_mpoly_t A, const fmpz * alphas,
                        const fmpz_mpoly_ctx_t ctx, const fmpz_mod_ctx_t fpctx);
 
+typedef struct
+{
+    nmod_t mod;
+    slong nvars;            /* number of variables of the context */
+    slong length;           /* number of terms nonzero mod n */
+    slong nused;            /* number of variables that occur */
+    slong * vars;           /* the variables that occur */
+    slong * offsets;        /* offsets[j] .. offsets[j+1] index exps */
+    ulong * exps;           /* sorted distinct exponents of each variable */
+    slong * idx;            /* idx[nused*i + j] indexes exps */
+    mp_limb_t * coeffs;
+    mp_limb_t * coeffs_shoup;
+}
+fmpz_mpoly_evaluate_nmod_struct;
+
+typedef fmpz_mpoly_evaluate_nmod_struct fmpz_mpoly_evaluate_nmod_t[1];
+
+void fmpz_mpoly_evaluate_nmod_init(fmpz_mpoly_evaluate_nmod_t E,
+           const fmpz_mpoly_t A, const fmpz_mpoly_ctx_t ctx, nmod_t fpctx);
+
+void fmpz_mpoly_evaluate_nmod_clear(fmpz_mpoly_evaluate_nmod_t E);
+
+void fmpz_mpoly_evaluate_nmod_vec(mp_limb_t * evals,
+    const fmpz_mpoly_evaluate_nmod_t E, const mp_limb_t * alphas, slong num);
+
+void fmpz_mpoly_evaluate_all_nmod_vec(mp_limb_t * evals,
+                      const fmpz_mpoly_t A, const mp_limb_t * alphas, slong num,
+                                      const fmpz_mpoly_ctx_t ctx, nmod_t fpctx);
+
 int fmpz_mpoly_evaluate_one_fmpz(fmpz_mpoly_t A,
                            const fmpz_mpoly_t B, slong var, const fmpz_t val,
                                                    const fmpz_mpoly_ctx_t ctx);
@@ -688,6 +717,11 @@ int fmpz_mpoly_compose_fmpz_mpoly(fmpz_mpoly_t A,
                    const fmpz_mpoly_t B, fmpz_mpoly_struct * const * C,
                     const fmpz_mpoly_ctx_t ctxB, const fmpz_mpoly_ctx_t ctxAC);
 
+int _fmpz_mpoly_compose_fmpz_mpoly_threaded_pool(fmpz_mpoly_t A,
+                     const fmpz_mpoly_t B, fmpz_mpoly_struct * const * C,
+                     const fmpz_mpoly_ctx_t ctxB, const fmpz_mpoly_ctx_t ctxAC,
+                        const thread_pool_handle * handles, slong num_handles);
+
 void fmpz_mpoly_compose_fmpz_mpoly_gen(fmpz_mpoly_t A,
                              const fmpz_mpoly_t B, const slong * c,
                     const fmpz_mpoly_ctx_t ctxB, const fmpz_mpoly_ctx_t ctxAC);
@@ -704,6 +738,10 @@ void fmpz_mpoly_mul_monomial(fmpz_mpoly_t A, const fmpz_mpoly_t B,
 void fmpz_mpoly_mul_johnson(fmpz_mpoly_t A,
        const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx);
 
+void fmpz_mpoly_mul_johnson_workspace(fmpz_mpoly_t A,
+       const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx,
+                                                        mpoly_workspace_t W);
+
 void fmpz_mpoly_mul_heap_threaded(fmpz_mpoly_t A,
        const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx);
 
@@ -716,15 +754,34 @@ int fmpz_mpoly_mul_array_threaded(fmpz_mpoly_t A,
 int fmpz_mpoly_mul_dense(fmpz_mpoly_t A,
        const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx);
 
+void fmpz_mpoly_mul_multi_mod(fmpz_mpoly_t A,
+       const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx);
+
+int fmpz_mpoly_mul_sparse_interp(fmpz_mpoly_t A,
+       const fmpz_mpoly_t B, const fmpz_mpoly_t C, const fmpz_mpoly_ctx_t ctx);
+
+/*
+    Give up on sparse interpolation if the prime needs more bits than this.
+    The prime exceeds prod_i p_i^deg_i, so the method is meant for products
+    of low total degree; the exponents are not split over several primes.
+*/
+#define FMPZ_MPOLY_SPARSE_INTERP_MAX_BITS 8192
+
+int _fmpz_mpoly_sparse_interp_decode(fmpz * coeffs, ulong * exps,
+                 const fmpz_mod_poly_t V, const fmpz * seq, slong n,
+                 const fmpz * cands, slong ncands, const ulong * primes,
+                 const ulong * degbounds, slong nvars, const fmpz_mod_ctx_t fctx);
+
 slong _fmpz_mpoly_mul_johnson(fmpz ** poly1, ulong ** exp1, slong * alloc,
                  const fmpz * poly2, const ulong * exp2, slong len2,
                  const fmpz * poly3, const ulong * exp3, slong len3,
-                             flint_bitcnt_t bits, slong N, const ulong * cmpmask);
+                             flint_bitcnt_t bits, slong N, const ulong * cmpmask,
+                                                    mpoly_workspace_struct * W);
 
 void _fmpz_mpoly_mul_johnson_maxfields(fmpz_mpoly_t A,
                                  const fmpz_mpoly_t B, fmpz * maxBfields,
                                  const fmpz_mpoly_t C, fmpz * maxCfields,
-                                                   const fmpz_mpoly_ctx_t ctx);
+                        const fmpz_mpoly_ctx_t ctx, mpoly_workspace_struct * W);
 
 void _fmpz_mpoly_mul_heap_threaded_pool_maxfields(fmpz_mpoly_t A,
            const fmpz_mpoly_t B, fmpz * maxBfields,
@@ -756,6 +813,11 @@ int _fmpz_mpoly_mul_dense(fmpz_mpoly_t P,
                                  const fmpz_mpoly_t B, fmpz * maxBfields,
                                                    const fmpz_mpoly_ctx_t ctx);
 
+void _fmpz_mpoly_mul_multi_mod_maxfields(fmpz_mpoly_t A,
+           const fmpz_mpoly_t B, fmpz * maxBfields,
+           const fmpz_mpoly_t C, fmpz * maxCfields, const fmpz_mpoly_ctx_t ctx,
+                        const thread_pool_handle * handles, slong num_handles);
+
 /* Powering ******************************************************************/
 
 int fmpz_mpoly_pow_fmpz(fmpz_mpoly_t A, const fmpz_mpoly_t B,
@@ -772,6 +834,10 @@ int fmpz_mpoly_divides(fmpz_mpoly_t Q,
 int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t Q,
        const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
 
+int fmpz_mpoly_divides_monagan_pearce_workspace(fmpz_mpoly_t Q,
+       const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx,
+                                                        mpoly_workspace_t W);
+
 int fmpz_mpoly_divides_heap_threaded(fmpz_mpoly_t Q,
        const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
 
@@ -797,7 +863,7 @@ slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1,
                       ulong ** exp1, slong * alloc, const fmpz * poly2,
                     const ulong * exp2, slong len2, const fmpz * poly3,
                     const ulong * exp3, slong len3, flint_bitcnt_t bits, slong N,
-                                                        const ulong * cmpmask);
+                                const ulong * cmpmask, mpoly_workspace_struct * W);
 
 void fmpz_mpoly_divrem(fmpz_mpoly_t Q, fmpz_mpoly_t R,
        const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
@@ -955,6 +1021,9 @@ int fmpz_mpoly_gcd_zippel(fmpz_mpoly_t G,
 int fmpz_mpoly_gcd_zippel2(fmpz_mpoly_t G,
        const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
 
+int fmpz_mpoly_gcd_sparse_interp(fmpz_mpoly_t G,
+       const fmpz_mpoly_t A, const fmpz_mpoly_t B, const fmpz_mpoly_ctx_t ctx);
+
 /* Univariates ***************************************************************/
 
 void fmpz_mpoly_univar_init(fmpz_mpoly_univar_t A,
@@ -1109,6 +1178,13 @@ void mpoly_void_ring_init_fmpz_mpoly_ctx(mpoly_void_ring_t R,
 void fmpz_mpoly_pow_fps(fmpz_mpoly_t A, const fmpz_mpoly_t B,
                                           ulong k, const fmpz_mpoly_ctx_t ctx);
 
+void fmpz_mpoly_pow_fps_threaded(fmpz_mpoly_t A, const fmpz_mpoly_t B,
+                                          ulong k, const fmpz_mpoly_ctx_t ctx);
+
+void _fmpz_mpoly_pow_fps_threaded_pool(fmpz_mpoly_t A, const fmpz_mpoly_t B,
+                                          ulong k, const fmpz_mpoly_ctx_t ctx,
+                        const thread_pool_handle * handles, slong num_handles);
+
 void fmpz_mpolyl_lead_coeff(fmpz_mpoly_t c, const fmpz_mpoly_t A,
                                    slong num_vars, const fmpz_mpoly_ctx_t ctx);
 
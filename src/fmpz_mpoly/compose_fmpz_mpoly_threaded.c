@@ -0,0 +1,159 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "fmpz_mpoly.h"
+
+/*
+    The terms of B are cut into contiguous chunks, each of which is composed
+    with the Horner or geobucket method by whichever thread takes it first.
+    Consecutive terms of B share many leading powers, so the chunks keep most
+    of the benefit of the Horner form. The images of the chunks are summed.
+*/
+
+typedef struct
+{
+    fmpz_mpoly_struct * T;          /* image of each chunk */
+    const fmpz_mpoly_struct * B;
+    fmpz_mpoly_struct * const * C;
+    const fmpz_mpoly_ctx_struct * ctxB;
+    const fmpz_mpoly_ctx_struct * ctxAC;
+    slong num_chunks;
+    volatile slong idx;
+    volatile int success;
+    int horner;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+} _compose_base_struct;
+
+typedef _compose_base_struct _compose_base_t[1];
+
+static void _compose_worker(void * varg)
+{
+    _compose_base_struct * base = (_compose_base_struct *) varg;
+    const fmpz_mpoly_struct * B = base->B;
+    slong N = mpoly_words_per_exp(B->bits, base->ctxB->minfo);
+    slong i, start, stop;
+    fmpz_mpoly_struct Bi[1];
+    int success;
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&base->mutex);
+#endif
+        i = base->idx++;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&base->mutex);
+#endif
+        if (i >= base->num_chunks)
+            return;
+
+        start = i*B->length/base->num_chunks;
+        stop = (i + 1)*B->length/base->num_chunks;
+
+        /* shallow copy of the terms [start, stop) */
+        Bi->coeffs = B->coeffs + start;
+        Bi->exps = B->exps + N*start;
+        Bi->length = stop - start;
+        Bi->alloc = stop - start;
+        Bi->bits = B->bits;
+
+        if (base->horner)
+            success = fmpz_mpoly_compose_fmpz_mpoly_horner(base->T + i, Bi,
+                                          base->C, base->ctxB, base->ctxAC);
+        else
+            success = fmpz_mpoly_compose_fmpz_mpoly_geobucket(base->T + i, Bi,
+                                          base->C, base->ctxB, base->ctxAC);
+        if (!success)
+        {
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&base->mutex);
+#endif
+            base->success = 0;
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&base->mutex);
+#endif
+        }
+    }
+}
+
+/* evaluate B(xbar) at xbar = C */
+int _fmpz_mpoly_compose_fmpz_mpoly_threaded_pool(fmpz_mpoly_t A,
+                     const fmpz_mpoly_t B, fmpz_mpoly_struct * const * C,
+                     const fmpz_mpoly_ctx_t ctxB, const fmpz_mpoly_ctx_t ctxAC,
+                         const thread_pool_handle * handles, slong num_handles)
+{
+    slong i;
+    int success;
+    _compose_base_t base;
+    fmpz_mpoly_geobucket_t S;
+
+    FLINT_ASSERT(A != B);
+
+    base->num_chunks = FLINT_MIN(2*(num_handles + 1), B->length);
+
+    if (num_handles < 1 || base->num_chunks < 2)
+    {
+        for (i = 0; i < ctxB->minfo->nvars; i++)
+        {
+            if (C[i]->length > 1)
+                return fmpz_mpoly_compose_fmpz_mpoly_horner(A, B, C,
+                                                                ctxB, ctxAC);
+        }
+
+        return fmpz_mpoly_compose_fmpz_mpoly_geobucket(A, B, C, ctxB, ctxAC);
+    }
+
+    base->horner = 0;
+    for (i = 0; i < ctxB->minfo->nvars; i++)
+        base->horner |= (C[i]->length > 1);
+
+    base->T = FLINT_ARRAY_ALLOC(base->num_chunks, fmpz_mpoly_struct);
+    for (i = 0; i < base->num_chunks; i++)
+        fmpz_mpoly_init(base->T + i, ctxAC);
+    base->B = B;
+    base->C = C;
+    base->ctxB = ctxB;
+    base->ctxAC = ctxAC;
+    base->idx = 0;
+    base->success = 1;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&base->mutex, NULL);
+#endif
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                      _compose_worker, base);
+    _compose_worker(base);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&base->mutex);
+#endif
+
+    success = base->success;
+    if (success)
+    {
+        fmpz_mpoly_geobucket_init(S, ctxAC);
+        for (i = 0; i < base->num_chunks; i++)
+            fmpz_mpoly_geobucket_add(S, base->T + i, ctxAC);
+        fmpz_mpoly_geobucket_empty(A, S, ctxAC);
+        fmpz_mpoly_geobucket_clear(S, ctxAC);
+    }
+
+    for (i = 0; i < base->num_chunks; i++)
+        fmpz_mpoly_clear(base->T + i, ctxAC);
+    flint_free(base->T);
+
+    return success;
+}
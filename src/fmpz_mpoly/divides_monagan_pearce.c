@@ -26,7 +26,7 @@
 slong _fmpz_mpoly_divides_monagan_pearce1(fmpz ** poly1, ulong ** exp1,
          slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
                 const fmpz * poly3, const ulong * exp3, slong len3, slong bits,
-                                                                  ulong maskhi)
+                                       ulong maskhi, mpoly_workspace_struct * W)
 {
     slong i, j, k, s;
     slong next_loc, heap_len = 2;
@@ -43,9 +43,11 @@ slong _fmpz_mpoly_divides_monagan_pearce1(fmpz ** poly1, ulong ** exp1,
     int lt_divides, small;
     slong bits2, bits3;
     ulong lc_norm = 0, lc_abs = 0, lc_sign = 0, lc_n = 0, lc_i = 0;
+    slong W_mark;
     TMP_INIT;
 
     TMP_START;
+    W_mark = mpoly_workspace_start(W);
 
     fmpz_init(acc_lg);
     fmpz_init(r);
@@ -59,12 +61,15 @@ slong _fmpz_mpoly_divides_monagan_pearce1(fmpz ** poly1, ulong ** exp1,
 
     /* alloc array of heap nodes which can be chained together */
     next_loc = len3 + 4;   /* something bigger than heap can ever be */
-    heap = (mpoly_heap1_s *) TMP_ALLOC((len3 + 1)*sizeof(mpoly_heap1_s));
-    chain = (mpoly_heap_t *) TMP_ALLOC(len3*sizeof(mpoly_heap_t));
-    store = store_base = (slong *) TMP_ALLOC(2*len3*sizeof(slong));
+    heap = (mpoly_heap1_s *) MPOLY_WORKSPACE_ALLOC(W,
+                                        (len3 + 1)*sizeof(mpoly_heap1_s));
+    chain = (mpoly_heap_t *) MPOLY_WORKSPACE_ALLOC(W,
+                                                 len3*sizeof(mpoly_heap_t));
+    store = store_base = (slong *) MPOLY_WORKSPACE_ALLOC(W,
+                                                      2*len3*sizeof(slong));
 
     /* space for flagged heap indices */
-    hind = (slong *) TMP_ALLOC(len3*sizeof(slong));
+    hind = (slong *) MPOLY_WORKSPACE_ALLOC(W, len3*sizeof(slong));
     for (i = 0; i < len3; i++)
         hind[i] = 1;
 
@@ -281,6 +286,7 @@ cleanup:
     (*poly1) = p1;
     (*exp1) = e1;
 
+    mpoly_workspace_end(W, W_mark);
     TMP_END;
 
     return k;
@@ -296,7 +302,7 @@ not_exact_division:
 slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1, ulong ** exp1,
          slong * alloc, const fmpz * poly2, const ulong * exp2, slong len2,
        const fmpz * poly3, const ulong * exp3, slong len3, flint_bitcnt_t bits, slong N,
-                                                         const ulong * cmpmask)
+                                 const ulong * cmpmask, mpoly_workspace_struct * W)
 {
     slong i, j, k, s;
     slong next_loc;
@@ -317,14 +323,16 @@ slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1, ulong ** exp1,
     int lt_divides, small;
     slong bits2, bits3;
     ulong lc_norm = 0, lc_abs = 0, lc_sign = 0, lc_n = 0, lc_i = 0;
+    slong W_mark;
     TMP_INIT;
 
     /* if exponent vectors are all one word, call specialised version */
     if (N == 1)
         return _fmpz_mpoly_divides_monagan_pearce1(poly1, exp1, alloc,
-                       poly2, exp2, len2, poly3, exp3, len3, bits, cmpmask[0]);
+                   poly2, exp2, len2, poly3, exp3, len3, bits, cmpmask[0], W);
 
     TMP_START;
+    W_mark = mpoly_workspace_start(W);
 
     fmpz_init(acc_lg);
     fmpz_init(r);
@@ -338,23 +346,26 @@ slong _fmpz_mpoly_divides_monagan_pearce(fmpz ** poly1, ulong ** exp1,
 
     /* alloc array of heap nodes which can be chained together */
     next_loc = len3 + 4;   /* something bigger than heap can ever be */
-    heap = (mpoly_heap_s *) TMP_ALLOC((len3 + 1)*sizeof(mpoly_heap_s));
-    chain = (mpoly_heap_t *) TMP_ALLOC(len3*sizeof(mpoly_heap_t));
-    store = store_base = (slong *) TMP_ALLOC(2*len3*sizeof(slong));
+    heap = (mpoly_heap_s *) MPOLY_WORKSPACE_ALLOC(W,
+                                         (len3 + 1)*sizeof(mpoly_heap_s));
+    chain = (mpoly_heap_t *) MPOLY_WORKSPACE_ALLOC(W,
+                                                 len3*sizeof(mpoly_heap_t));
+    store = store_base = (slong *) MPOLY_WORKSPACE_ALLOC(W,
+                                                      2*len3*sizeof(slong));
 
     /* array of exponent vectors, each of "N" words */
-    exps = (ulong *) TMP_ALLOC(len3*N*sizeof(ulong));
+    exps = (ulong *) MPOLY_WORKSPACE_ALLOC(W, len3*N*sizeof(ulong));
     /* list of pointers to available exponent vectors */
-    exp_list = (ulong **) TMP_ALLOC(len3*sizeof(ulong *));
+    exp_list = (ulong **) MPOLY_WORKSPACE_ALLOC(W, len3*sizeof(ulong *));
     /* space to save copy of current exponent vector */
-    exp = (ulong *) TMP_ALLOC(N*sizeof(ulong));
+    exp = (ulong *) MPOLY_WORKSPACE_ALLOC(W, N*sizeof(ulong));
     /* set up list of available exponent vectors */
     exp_next = 0;
     for (i = 0; i < len3; i++)
         exp_list[i] = exps + i*N;
 
     /* space for flagged heap indices */
-    hind = (slong *) TMP_ALLOC(len3*sizeof(slong));
+    hind = (slong *) MPOLY_WORKSPACE_ALLOC(W, len3*sizeof(slong));
     for (i = 0; i < len3; i++)
         hind[i] = 1;
 
@@ -610,6 +621,7 @@ cleanup:
     (*poly1) = p1;
     (*exp1) = e1;
 
+    mpoly_workspace_end(W, W_mark);
     TMP_END;
 
     return k;
@@ -622,17 +634,18 @@ not_exact_division:
 }
 
 /* return 1 if quotient is exact */
-int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
+int fmpz_mpoly_divides_monagan_pearce_workspace(fmpz_mpoly_t poly1,
                   const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
-                                                    const fmpz_mpoly_ctx_t ctx)
+                             const fmpz_mpoly_ctx_t ctx, mpoly_workspace_t W)
 {
     slong i, N, len = 0;
     flint_bitcnt_t exp_bits;
     fmpz * max_fields2, * max_fields3;
     ulong * cmpmask;
     ulong * exp2 = poly2->exps, * exp3 = poly3->exps, * expq;
-    int easy_exit, free2 = 0, free3 = 0;
+    int easy_exit;
     ulong mask = 0;
+    slong W_mark;
     TMP_INIT;
 
    /* check divisor is nonzero */
@@ -648,6 +661,7 @@ int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
    }
 
    TMP_START;
+   W_mark = mpoly_workspace_start(W);
 
     max_fields2 = (fmpz *) TMP_ALLOC(ctx->minfo->nfields*sizeof(fmpz));
     max_fields3 = (fmpz *) TMP_ALLOC(ctx->minfo->nfields*sizeof(fmpz));
@@ -708,16 +722,16 @@ int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
    /* ensure input exponents packed to same size as output exponents */
    if (exp_bits > poly2->bits)
    {
-      free2 = 1;
-      exp2 = (ulong *) flint_malloc(N*poly2->length*sizeof(ulong));
+      exp2 = (ulong *) MPOLY_WORKSPACE_ALLOC(W,
+                                           N*poly2->length*sizeof(ulong));
       mpoly_repack_monomials(exp2, exp_bits, poly2->exps, poly2->bits,
                                                     poly2->length, ctx->minfo);
    }
 
    if (exp_bits > poly3->bits)
    {
-      free3 = 1;
-      exp3 = (ulong *) flint_malloc(N*poly3->length*sizeof(ulong));
+      exp3 = (ulong *) MPOLY_WORKSPACE_ALLOC(W,
+                                           N*poly3->length*sizeof(ulong));
       mpoly_repack_monomials(exp3, exp_bits, poly3->exps, poly3->bits,
                                                     poly3->length, ctx->minfo);
    }
@@ -756,7 +770,7 @@ int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
       len = _fmpz_mpoly_divides_monagan_pearce(&temp->coeffs, &temp->exps,
                             &temp->alloc, poly2->coeffs, exp2, poly2->length,
                               poly3->coeffs, exp3, poly3->length, exp_bits, N,
-                                                              cmpmask);
+                                                           cmpmask, W);
 
       fmpz_mpoly_swap(temp, poly1, ctx);
 
@@ -770,21 +784,24 @@ int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
       len = _fmpz_mpoly_divides_monagan_pearce(&poly1->coeffs, &poly1->exps,
                             &poly1->alloc, poly2->coeffs, exp2, poly2->length,
                               poly3->coeffs, exp3, poly3->length, exp_bits, N,
-                                                               cmpmask);
+                                                            cmpmask, W);
    }
 
 cleanup:
 
    _fmpz_mpoly_set_length(poly1, len, ctx);
 
-   if (free2)
-      flint_free(exp2);
-
-   if (free3)
-      flint_free(exp3);
-
+   mpoly_workspace_end(W, W_mark);
    TMP_END;
 
    /* division is exact if len is nonzero */
    return (len != 0);
 }
+
+int fmpz_mpoly_divides_monagan_pearce(fmpz_mpoly_t poly1,
+                  const fmpz_mpoly_t poly2, const fmpz_mpoly_t poly3,
+                                                    const fmpz_mpoly_ctx_t ctx)
+{
+    return fmpz_mpoly_divides_monagan_pearce_workspace(poly1, poly2, poly3,
+                                                                   ctx, NULL);
+}
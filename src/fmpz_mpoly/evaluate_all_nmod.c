@@ -32,3 +32,18 @@ mp_limb_t fmpz_mpoly_evaluate_all_nmod(
     return eval;
 }
 
+
+void fmpz_mpoly_evaluate_all_nmod_vec(
+    mp_limb_t * evals,
+    const fmpz_mpoly_t A,
+    const mp_limb_t * alphas,
+    slong num,
+    const fmpz_mpoly_ctx_t ctx,
+    nmod_t fpctx)
+{
+    fmpz_mpoly_evaluate_nmod_t E;
+
+    fmpz_mpoly_evaluate_nmod_init(E, A, ctx, fpctx);
+    fmpz_mpoly_evaluate_nmod_vec(evals, E, alphas, num);
+    fmpz_mpoly_evaluate_nmod_clear(E);
+}
@@ -0,0 +1,334 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdlib.h>
+#include "thread_support.h"
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "fmpz_mpoly.h"
+
+/*
+    Points are evaluated in batches of EVAL_BATCH so that every term is
+    read once per batch and the products for the points of a batch are
+    independent of each other.
+*/
+#define EVAL_BATCH 8
+
+static int _ulong_cmp(const void * a, const void * b)
+{
+    ulong x = *(const ulong *) a;
+    ulong y = *(const ulong *) b;
+    return (x > y) - (x < y);
+}
+
+void fmpz_mpoly_evaluate_nmod_init(
+    fmpz_mpoly_evaluate_nmod_t E,
+    const fmpz_mpoly_t A,
+    const fmpz_mpoly_ctx_t ctx,
+    nmod_t fpctx)
+{
+    slong i, j, k, len, nused;
+    slong nvars = ctx->minfo->nvars;
+    flint_bitcnt_t bits = A->bits;
+    slong N = mpoly_words_per_exp(bits, ctx->minfo);
+    ulong mask = (bits <= FLINT_BITS) ? (-UWORD(1)) >> (FLINT_BITS - bits) : 0;
+    slong off, shift;
+    slong * terms;
+    ulong * e, * s;
+    fmpz_t t;
+
+    E->mod = fpctx;
+    E->nvars = nvars;
+
+    /* keep only the terms that do not vanish mod n */
+    E->coeffs = FLINT_ARRAY_ALLOC(A->length, mp_limb_t);
+    terms = FLINT_ARRAY_ALLOC(A->length, slong);
+    _fmpz_vec_get_nmod_vec(E->coeffs, A->coeffs, A->length, fpctx);
+    len = 0;
+    for (i = 0; i < A->length; i++)
+    {
+        if (E->coeffs[i] != 0)
+        {
+            E->coeffs[len] = E->coeffs[i];
+            terms[len] = i;
+            len++;
+        }
+    }
+    E->length = len;
+
+    E->coeffs_shoup = NULL;
+    if (fpctx.norm > 0)
+    {
+        E->coeffs_shoup = FLINT_ARRAY_ALLOC(len, mp_limb_t);
+        for (i = 0; i < len; i++)
+            E->coeffs_shoup[i] = n_mulmod_precomp_shoup(E->coeffs[i], fpctx.n);
+    }
+
+    E->vars = FLINT_ARRAY_ALLOC(nvars, slong);
+    E->offsets = FLINT_ARRAY_ALLOC(nvars + 1, slong);
+    E->exps = FLINT_ARRAY_ALLOC(nvars*len, ulong);
+    E->idx = FLINT_ARRAY_ALLOC(nvars*len, slong);
+    e = FLINT_ARRAY_ALLOC(2*len, ulong);
+    s = e + len;
+    fmpz_init(t);
+
+    nused = 0;
+    E->offsets[0] = 0;
+    for (j = 0; j < nvars; j++)
+    {
+        /*
+            Exponents that do not fit a word are reduced using
+            a^e = a^((e - 1) mod (n - 1) + 1) for e > 0, which holds for
+            every a when n is prime.
+        */
+        if (bits <= FLINT_BITS)
+        {
+            mpoly_gen_offset_shift_sp(&off, &shift, j, bits, ctx->minfo);
+            for (i = 0; i < len; i++)
+                e[i] = (A->exps[N*terms[i] + off] >> shift) & mask;
+        }
+        else
+        {
+            off = mpoly_gen_offset_mp(j, bits, ctx->minfo);
+            for (i = 0; i < len; i++)
+            {
+                fmpz_set_ui_array(t, A->exps + N*terms[i] + off, bits/FLINT_BITS);
+                if (fmpz_is_zero(t))
+                {
+                    e[i] = 0;
+                }
+                else
+                {
+                    fmpz_sub_ui(t, t, 1);
+                    e[i] = fmpz_fdiv_ui(t, fpctx.n - 1) + 1;
+                }
+            }
+        }
+
+        for (i = 0; i < len; i++)
+            s[i] = e[i];
+        qsort(s, len, sizeof(ulong), _ulong_cmp);
+
+        if (len < 1 || s[len - 1] == 0)
+            continue;
+
+        k = E->offsets[nused];
+        for (i = 0; i < len; i++)
+            if (i == 0 || s[i] != s[i - 1])
+                E->exps[k++] = s[i];
+
+        for (i = 0; i < len; i++)
+        {
+            slong lo = E->offsets[nused], hi = k - 1;
+            while (lo < hi)
+            {
+                slong mid = lo + (hi - lo)/2;
+                if (E->exps[mid] < e[i])
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            E->idx[nvars*i + nused] = lo;
+        }
+
+        E->vars[nused] = j;
+        nused++;
+        E->offsets[nused] = k;
+    }
+
+    /* compact the rows of idx to nused entries */
+    for (i = 0; i < len; i++)
+        for (j = 0; j < nused; j++)
+            E->idx[nused*i + j] = E->idx[nvars*i + j];
+
+    E->nused = nused;
+
+    fmpz_clear(t);
+    flint_free(e);
+    flint_free(terms);
+}
+
+void fmpz_mpoly_evaluate_nmod_clear(fmpz_mpoly_evaluate_nmod_t E)
+{
+    flint_free(E->coeffs);
+    flint_free(E->coeffs_shoup);
+    flint_free(E->vars);
+    flint_free(E->offsets);
+    flint_free(E->exps);
+    flint_free(E->idx);
+}
+
+/* evaluate the nb <= EVAL_BATCH points starting at alphas */
+static void _eval_batch(
+    mp_limb_t * evals,
+    const fmpz_mpoly_evaluate_nmod_struct * E,
+    const mp_limb_t * alphas,
+    slong nb,
+    mp_limb_t * P)
+{
+    nmod_t mod = E->mod;
+    slong nused = E->nused;
+    const slong * idx = E->idx;
+    const ulong * exps = E->exps;
+    mp_limb_t a[EVAL_BATCH], t[EVAL_BATCH], hi[EVAL_BATCH], lo[EVAL_BATCH];
+    slong i, j, k, b;
+
+    /* P[EVAL_BATCH*k + b] = alpha_b^exps[k] */
+    for (j = 0; j < nused; j++)
+    {
+        slong start = E->offsets[j];
+        slong stop = E->offsets[j + 1];
+
+        for (b = 0; b < nb; b++)
+        {
+            a[b] = alphas[E->nvars*b + E->vars[j]];
+            if (a[b] >= mod.n)
+                a[b] = n_mod2_preinv(a[b], mod.n, mod.ninv);
+            P[EVAL_BATCH*start + b] = nmod_pow_ui(a[b], exps[start], mod);
+        }
+
+        for (k = start + 1; k < stop; k++)
+        {
+            ulong d = exps[k] - exps[k - 1];
+
+            if (d == 1)
+            {
+                for (b = 0; b < nb; b++)
+                    P[EVAL_BATCH*k + b] = nmod_mul(P[EVAL_BATCH*(k - 1) + b],
+                                                                   a[b], mod);
+            }
+            else
+            {
+                for (b = 0; b < nb; b++)
+                    P[EVAL_BATCH*k + b] = nmod_mul(P[EVAL_BATCH*(k - 1) + b],
+                                               nmod_pow_ui(a[b], d, mod), mod);
+            }
+        }
+    }
+
+    for (b = 0; b < nb; b++)
+        hi[b] = lo[b] = 0;
+
+    for (i = 0; i < E->length; i++)
+    {
+        const slong * row = idx + nused*i;
+        mp_limb_t c = E->coeffs[i];
+
+        if (nused < 1)
+        {
+            for (b = 0; b < nb; b++)
+                t[b] = c;
+        }
+        else if (E->coeffs_shoup != NULL)
+        {
+            mp_limb_t cs = E->coeffs_shoup[i];
+            const mp_limb_t * p = P + EVAL_BATCH*row[0];
+            for (b = 0; b < nb; b++)
+                t[b] = n_mulmod_shoup(c, p[b], cs, mod.n);
+        }
+        else
+        {
+            const mp_limb_t * p = P + EVAL_BATCH*row[0];
+            for (b = 0; b < nb; b++)
+                t[b] = nmod_mul(c, p[b], mod);
+        }
+
+        for (j = 1; j < nused; j++)
+        {
+            const mp_limb_t * p = P + EVAL_BATCH*row[j];
+            for (b = 0; b < nb; b++)
+                t[b] = nmod_mul(t[b], p[b], mod);
+        }
+
+        for (b = 0; b < nb; b++)
+            add_ssaaaa(hi[b], lo[b], hi[b], lo[b], 0, t[b]);
+    }
+
+    for (b = 0; b < nb; b++)
+        evals[b] = n_ll_mod_preinv(hi[b], lo[b], mod.n, mod.ninv);
+}
+
+typedef struct
+{
+    mp_limb_t * evals;
+    const fmpz_mpoly_evaluate_nmod_struct * E;
+    const mp_limb_t * alphas;
+    slong start, stop;
+}
+_eval_vec_arg_struct;
+
+static void _eval_vec_worker(void * varg)
+{
+    _eval_vec_arg_struct * arg = (_eval_vec_arg_struct *) varg;
+    const fmpz_mpoly_evaluate_nmod_struct * E = arg->E;
+    slong i, nb;
+    mp_limb_t * P;
+
+    P = FLINT_ARRAY_ALLOC(EVAL_BATCH*(E->offsets[E->nused] + 1), mp_limb_t);
+
+    for (i = arg->start; i < arg->stop; i += nb)
+    {
+        nb = FLINT_MIN(EVAL_BATCH, arg->stop - i);
+        _eval_batch(arg->evals + i, E, arg->alphas + E->nvars*i, nb, P);
+    }
+
+    flint_free(P);
+}
+
+void fmpz_mpoly_evaluate_nmod_vec(
+    mp_limb_t * evals,
+    const fmpz_mpoly_evaluate_nmod_t E,
+    const mp_limb_t * alphas,
+    slong num)
+{
+    thread_pool_handle * handles;
+    slong i, num_handles, num_workers, nbatches;
+    ulong work;
+    _eval_vec_arg_struct * args;
+
+    if (num < 1)
+        return;
+
+    if (E->length < 1)
+    {
+        _nmod_vec_zero(evals, num);
+        return;
+    }
+
+    nbatches = (num + EVAL_BATCH - 1)/EVAL_BATCH;
+    work = (ulong) num * (ulong) (E->length*(E->nused + 1));
+    num_handles = flint_request_threads(&handles,
+                                         FLINT_MIN(nbatches, work/32768));
+    num_workers = num_handles + 1;
+
+    /* contiguous blocks of whole batches */
+    args = FLINT_ARRAY_ALLOC(num_workers, _eval_vec_arg_struct);
+    for (i = 0; i < num_workers; i++)
+    {
+        args[i].evals = evals;
+        args[i].E = E;
+        args[i].alphas = alphas;
+        args[i].start = FLINT_MIN(num, EVAL_BATCH*(i*nbatches/num_workers));
+        args[i].stop = FLINT_MIN(num, EVAL_BATCH*((i + 1)*nbatches/num_workers));
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                               _eval_vec_worker, args + i + 1);
+    _eval_vec_worker(args + 0);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+    flint_free(args);
+}
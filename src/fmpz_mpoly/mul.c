@@ -109,6 +109,21 @@ static int _try_array_DEG(slong Btotaldeg, slong Ctotaldeg,
            dense_size/Blen/Clen < WORD(10);
 }
 
+/*
+    The images modulo word-sized primes are independent, so with enough
+    primes to keep every thread busy the multi-modular method parallelises
+    better than splitting the array into chunks of fmpz accumulators.
+*/
+static int _try_multi_mod(const fmpz_mpoly_t B, const fmpz_mpoly_t C,
+                                                            slong num_handles)
+{
+    slong Bbits = FLINT_ABS(_fmpz_vec_max_bits(B->coeffs, B->length));
+    slong Cbits = FLINT_ABS(_fmpz_vec_max_bits(C->coeffs, C->length));
+    slong num_primes = 1 + (Bbits + Cbits)/(FLINT_BITS - 1);
+
+    return Bbits + Cbits > 4*FLINT_BITS && num_primes >= 2*(num_handles + 1);
+}
+
 /* !!! this function DOES need to change with new orderings */
 static int _try_dense_univar(
     fmpz_mpoly_t A,
@@ -258,7 +273,8 @@ void fmpz_mpoly_mul(
     */
     if (min_length < 20 || max_length < 50)
     {
-        _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields, ctx);
+        _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields,
+                                                                 ctx, NULL);
         goto cleanup;
     }
 
@@ -319,6 +335,13 @@ void fmpz_mpoly_mul(
         goto do_heap;
     }
 
+    if (num_handles > 0 && _try_multi_mod(B, C, num_handles))
+    {
+        _fmpz_mpoly_mul_multi_mod_maxfields(A, B, maxBfields, C, maxCfields,
+                                                   ctx, handles, num_handles);
+        goto cleanup_threads;
+    }
+
     if (ctx->minfo->ord == ORD_LEX)
     {
         success = (num_handles > 0)
@@ -352,7 +375,8 @@ do_heap:
     }
     else
     {
-        _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields, ctx);
+        _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields,
+                                                                 ctx, NULL);
     }
 
 cleanup_threads:
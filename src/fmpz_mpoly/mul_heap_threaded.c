@@ -464,12 +464,18 @@ static void _fmpz_mpoly_mul_heap_threaded_worker(void * varg)
     ulong *exp;
     slong score;
     slong *start, *end, *t1, *t2, *t3, *t4, *tt;
+    /* the pool threads persist, so their scratch space can too */
+    mpoly_workspace_struct * W = mpoly_workspace_default();
+    slong W_mark = mpoly_workspace_start(W);
+    TMP_INIT;
+
+    TMP_START;
 
-    exp = (ulong *) flint_malloc(N*sizeof(ulong));
-    t1 = (slong *) flint_malloc(Blen*sizeof(slong));
-    t2 = (slong *) flint_malloc(Blen*sizeof(slong));
-    t3 = (slong *) flint_malloc(Blen*sizeof(slong));
-    t4 = (slong *) flint_malloc(Blen*sizeof(slong));
+    exp = (ulong *) MPOLY_WORKSPACE_ALLOC(W, N*sizeof(ulong));
+    t1 = (slong *) MPOLY_WORKSPACE_ALLOC(W, Blen*sizeof(slong));
+    t2 = (slong *) MPOLY_WORKSPACE_ALLOC(W, Blen*sizeof(slong));
+    t3 = (slong *) MPOLY_WORKSPACE_ALLOC(W, Blen*sizeof(slong));
+    t4 = (slong *) MPOLY_WORKSPACE_ALLOC(W, Blen*sizeof(slong));
 
     S->N = N;
     S->bits = base->bits;
@@ -491,7 +497,7 @@ static void _fmpz_mpoly_mul_heap_threaded_worker(void * varg)
         S->big_mem_alloc += Blen*S->N*sizeof(ulong);
         S->big_mem_alloc += Blen*sizeof(ulong *);
     }
-    S->big_mem = (char *) flint_malloc(S->big_mem_alloc);
+    S->big_mem = (char *) MPOLY_WORKSPACE_ALLOC(W, S->big_mem_alloc);
 
     /* get index to start working on */
     if (arg->idx + 1 < base->nthreads)
@@ -596,12 +602,8 @@ static void _fmpz_mpoly_mul_heap_threaded_worker(void * varg)
 #endif
     }
 
-    flint_free(S->big_mem);
-    flint_free(t4);
-    flint_free(t3);
-    flint_free(t2);
-    flint_free(t1);
-    flint_free(exp);
+    mpoly_workspace_end(W, W_mark);
+    TMP_END;
 }
 
 static void _join_worker(void * varg)
@@ -659,7 +661,7 @@ void _fmpz_mpoly_mul_heap_threaded(
     {
         Alen = _fmpz_mpoly_mul_johnson(&A->coeffs, &A->exps, &A->alloc,
                                          Bcoeff, Bexp, Blen,
-                                         Ccoeff, Cexp, Clen, bits, N, cmpmask);
+                                   Ccoeff, Cexp, Clen, bits, N, cmpmask, NULL);
         _fmpz_mpoly_set_length(A, Alen, NULL);
         return;
 
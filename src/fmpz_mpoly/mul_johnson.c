@@ -21,7 +21,8 @@
 */
 slong _fmpz_mpoly_mul_johnson1(fmpz ** poly1, ulong ** exp1, slong * alloc,
               const fmpz * poly2, const ulong * exp2, slong len2,
-              const fmpz * poly3, const ulong * exp3, slong len3, ulong maskhi)
+              const fmpz * poly3, const ulong * exp3, slong len3, ulong maskhi,
+                                                     mpoly_workspace_struct * W)
 {
    slong i, j, k;
    slong next_loc;
@@ -36,23 +37,25 @@ slong _fmpz_mpoly_mul_johnson1(fmpz ** poly1, ulong ** exp1, slong * alloc,
    ulong exp, cy;
    ulong c[3], p[2]; /* for accumulating coefficients */
    int first, small;
+   slong W_mark;
    TMP_INIT;
 
    TMP_START;
+   W_mark = mpoly_workspace_start(W);
 
    /* whether input coeffs are small, thus output coeffs fit in three words */
    small = _fmpz_mpoly_fits_small(poly2, len2) &&
                                            _fmpz_mpoly_fits_small(poly3, len3);
 
    next_loc = len2 + 4;   /* something bigger than heap can ever be */
-   heap = (mpoly_heap1_s *) TMP_ALLOC((len2 + 1)*sizeof(mpoly_heap1_s));
+   heap = (mpoly_heap1_s *) MPOLY_WORKSPACE_ALLOC(W, (len2 + 1)*sizeof(mpoly_heap1_s));
    /* alloc array of heap nodes which can be chained together */
-   chain = (mpoly_heap_t *) TMP_ALLOC(len2*sizeof(mpoly_heap_t));
+   chain = (mpoly_heap_t *) MPOLY_WORKSPACE_ALLOC(W, len2*sizeof(mpoly_heap_t));
    /* space for temporary storage of pointers to heap nodes */
-   Q = (slong *) TMP_ALLOC(2*len2*sizeof(slong));
+   Q = (slong *) MPOLY_WORKSPACE_ALLOC(W, 2*len2*sizeof(slong));
 
     /* space for heap indices */
-    hind = (slong *) TMP_ALLOC(len2*sizeof(slong));
+    hind = (slong *) MPOLY_WORKSPACE_ALLOC(W, len2*sizeof(slong));
     for (i = 0; i < len2; i++)
         hind[i] = 1;
 
@@ -209,6 +212,7 @@ slong _fmpz_mpoly_mul_johnson1(fmpz ** poly1, ulong ** exp1, slong * alloc,
    (*poly1) = p1;
    (*exp1) = e1;
 
+   mpoly_workspace_end(W, W_mark);
    TMP_END;
 
    return k;
@@ -222,7 +226,8 @@ slong _fmpz_mpoly_mul_johnson1(fmpz ** poly1, ulong ** exp1, slong * alloc,
 slong _fmpz_mpoly_mul_johnson(fmpz ** poly1, ulong ** exp1, slong * alloc,
                  const fmpz * poly2, const ulong * exp2, slong len2,
                  const fmpz * poly3, const ulong * exp3, slong len3,
-                              flint_bitcnt_t bits, slong N, const ulong * cmpmask)
+                              flint_bitcnt_t bits, slong N, const ulong * cmpmask,
+                                                     mpoly_workspace_struct * W)
 {
    slong i, j, k;
    slong next_loc;
@@ -240,34 +245,36 @@ slong _fmpz_mpoly_mul_johnson(fmpz ** poly1, ulong ** exp1, slong * alloc,
    slong exp_next;
    slong * hind;
    int first, small;
+   slong W_mark;
    TMP_INIT;
 
    /* if exponent vectors fit in single word, call special version */
    if (N == 1)
       return _fmpz_mpoly_mul_johnson1(poly1, exp1, alloc,
-                             poly2, exp2, len2, poly3, exp3, len3, cmpmask[0]);
+                          poly2, exp2, len2, poly3, exp3, len3, cmpmask[0], W);
 
    TMP_START;
+   W_mark = mpoly_workspace_start(W);
 
    /* whether input coeffs are small, thus output coeffs fit in three words */
    small = _fmpz_mpoly_fits_small(poly2, len2) &&
                                            _fmpz_mpoly_fits_small(poly3, len3);
 
    next_loc = len2 + 4;   /* something bigger than heap can ever be */
-   heap = (mpoly_heap_s *) TMP_ALLOC((len2 + 1)*sizeof(mpoly_heap_s));
+   heap = (mpoly_heap_s *) MPOLY_WORKSPACE_ALLOC(W, (len2 + 1)*sizeof(mpoly_heap_s));
    /* alloc array of heap nodes which can be chained together */
-   chain = (mpoly_heap_t *) TMP_ALLOC(len2*sizeof(mpoly_heap_t));
+   chain = (mpoly_heap_t *) MPOLY_WORKSPACE_ALLOC(W, len2*sizeof(mpoly_heap_t));
    /* space for temporary storage of pointers to heap nodes */
-   Q = (slong *) TMP_ALLOC(2*len2*sizeof(slong));
+   Q = (slong *) MPOLY_WORKSPACE_ALLOC(W, 2*len2*sizeof(slong));
    /* allocate space for exponent vectors of N words */
-   exps = (ulong *) TMP_ALLOC(len2*N*sizeof(ulong));
+   exps = (ulong *) MPOLY_WORKSPACE_ALLOC(W, len2*N*sizeof(ulong));
    /* list of pointers to allocated exponent vectors */
-   exp_list = (ulong **) TMP_ALLOC(len2*sizeof(ulong *));
+   exp_list = (ulong **) MPOLY_WORKSPACE_ALLOC(W, len2*sizeof(ulong *));
    for (i = 0; i < len2; i++)
       exp_list[i] = exps + i*N;
 
    /* space for heap indices */
-   hind = (slong *) TMP_ALLOC(len2*sizeof(slong));
+   hind = (slong *) MPOLY_WORKSPACE_ALLOC(W, len2*sizeof(slong));
    for (i = 0; i < len2; i++)
        hind[i] = 1;
 
@@ -453,6 +460,7 @@ slong _fmpz_mpoly_mul_johnson(fmpz ** poly1, ulong ** exp1, slong * alloc,
    (*poly1) = p1;
    (*exp1) = e1;
 
+   mpoly_workspace_end(W, W_mark);
    TMP_END;
 
    return k;
@@ -463,16 +471,17 @@ void _fmpz_mpoly_mul_johnson_maxfields(
     fmpz_mpoly_t A,
     const fmpz_mpoly_t B, fmpz * maxBfields,
     const fmpz_mpoly_t C, fmpz * maxCfields,
-    const fmpz_mpoly_ctx_t ctx)
+    const fmpz_mpoly_ctx_t ctx,
+    mpoly_workspace_struct * W)
 {
-    slong N, Alen;
+    slong N, Alen, W_mark;
     flint_bitcnt_t Abits;
     ulong * cmpmask;
     ulong * Bexp, * Cexp;
-    int freeBexp, freeCexp;
     TMP_INIT;
 
     TMP_START;
+    W_mark = mpoly_workspace_start(W);
 
     _fmpz_vec_add(maxBfields, maxBfields, maxCfields, ctx->minfo->nfields);
 
@@ -487,22 +496,18 @@ void _fmpz_mpoly_mul_johnson_maxfields(
     mpoly_get_cmpmask(cmpmask, N, Abits, ctx->minfo);
 
     /* ensure input exponents are packed into same sized fields as output */
-    freeBexp = 0;
     Bexp = B->exps;
     if (Abits > B->bits)
     {
-        freeBexp = 1;
-        Bexp = (ulong *) flint_malloc(N*B->length*sizeof(ulong));
+        Bexp = (ulong *) MPOLY_WORKSPACE_ALLOC(W, N*B->length*sizeof(ulong));
         mpoly_repack_monomials(Bexp, Abits, B->exps, B->bits,
                                                         B->length, ctx->minfo);
     }
 
-    freeCexp = 0;
     Cexp = C->exps;
     if (Abits > C->bits)
     {
-        freeCexp = 1;
-        Cexp = (ulong *) flint_malloc(N*C->length*sizeof(ulong));
+        Cexp = (ulong *) MPOLY_WORKSPACE_ALLOC(W, N*C->length*sizeof(ulong));
         mpoly_repack_monomials(Cexp, Abits, C->exps, C->bits,
                                                         C->length, ctx->minfo);
     }
@@ -519,14 +524,14 @@ void _fmpz_mpoly_mul_johnson_maxfields(
             Alen = _fmpz_mpoly_mul_johnson(&T->coeffs, &T->exps, &T->alloc,
                                                   C->coeffs, Cexp, C->length,
                                                   B->coeffs, Bexp, B->length,
-                                                         Abits, N, cmpmask);
+                                                      Abits, N, cmpmask, W);
         }
         else
         {
             Alen = _fmpz_mpoly_mul_johnson(&T->coeffs, &T->exps, &T->alloc,
                                                   B->coeffs, Bexp, B->length,
                                                   C->coeffs, Cexp, C->length,
-                                                         Abits, N, cmpmask);
+                                                      Abits, N, cmpmask, W);
         }
 
         fmpz_mpoly_swap(T, A, ctx);
@@ -542,35 +547,29 @@ void _fmpz_mpoly_mul_johnson_maxfields(
             Alen = _fmpz_mpoly_mul_johnson(&A->coeffs, &A->exps, &A->alloc,
                                                   C->coeffs, Cexp, C->length,
                                                   B->coeffs, Bexp, B->length,
-                                                         Abits, N, cmpmask);
+                                                      Abits, N, cmpmask, W);
         }
         else
         {
             Alen = _fmpz_mpoly_mul_johnson(&A->coeffs, &A->exps, &A->alloc,
                                                   B->coeffs, Bexp, B->length,
                                                   C->coeffs, Cexp, C->length,
-                                                         Abits, N, cmpmask);
+                                                      Abits, N, cmpmask, W);
         }
     }
 
-    if (freeBexp)
-        flint_free(Bexp);
-
-    if (freeCexp)
-        flint_free(Cexp);
-
     _fmpz_mpoly_set_length(A, Alen, ctx);
 
+    mpoly_workspace_end(W, W_mark);
     TMP_END;
 }
 
-
-
-void fmpz_mpoly_mul_johnson(
+void fmpz_mpoly_mul_johnson_workspace(
     fmpz_mpoly_t A,
     const fmpz_mpoly_t B,
     const fmpz_mpoly_t C,
-    const fmpz_mpoly_ctx_t ctx)
+    const fmpz_mpoly_ctx_t ctx,
+    mpoly_workspace_t W)
 {
     slong i;
     fmpz * maxBfields, * maxCfields;
@@ -594,7 +593,7 @@ void fmpz_mpoly_mul_johnson(
     mpoly_max_fields_fmpz(maxBfields, B->exps, B->length, B->bits, ctx->minfo);
     mpoly_max_fields_fmpz(maxCfields, C->exps, C->length, C->bits, ctx->minfo);
 
-    _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields, ctx);
+    _fmpz_mpoly_mul_johnson_maxfields(A, B, maxBfields, C, maxCfields, ctx, W);
 
     for (i = 0; i < ctx->minfo->nfields; i++)
     {
@@ -604,3 +603,12 @@ void fmpz_mpoly_mul_johnson(
 
     TMP_END;
 }
+
+void fmpz_mpoly_mul_johnson(
+    fmpz_mpoly_t A,
+    const fmpz_mpoly_t B,
+    const fmpz_mpoly_t C,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    fmpz_mpoly_mul_johnson_workspace(A, B, C, ctx, NULL);
+}
@@ -0,0 +1,350 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "nmod_mpoly.h"
+#include "fmpz_mpoly.h"
+#include "fmpz_mpoly_factor.h"
+
+typedef struct
+{
+    volatile slong idx;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    slong num_primes;
+    const mp_limb_t * primes;
+    nmod_mpoly_ctx_struct * pctxs;
+    nmod_mpoly_struct * Aps;
+    const fmpz_mpoly_struct * B;
+    const fmpz_mpoly_struct * C;
+    const fmpz_mpoly_ctx_struct * ctx;
+    flint_bitcnt_t Abits;
+    const fmpz_comb_struct * comb;
+    const mp_limb_t * residues;
+    fmpz * Acoeffs;
+}
+_base_struct;
+
+typedef _base_struct _base_t[1];
+
+typedef struct
+{
+    _base_struct * base;
+    slong start;
+    slong stop;
+}
+_worker_arg_struct;
+
+/* compute the images A mod p for the primes p not yet taken */
+static void _image_worker(void * varg)
+{
+    _worker_arg_struct * arg = (_worker_arg_struct *) varg;
+    _base_struct * base = arg->base;
+    slong l;
+    nmod_mpoly_t Bp, Cp;
+
+get_next_index:
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&base->mutex);
+#endif
+    l = base->idx;
+    base->idx = l + 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&base->mutex);
+#endif
+
+    if (l >= base->num_primes)
+        return;
+
+    nmod_mpoly_init3(Bp, base->B->length, base->B->bits, base->pctxs + l);
+    nmod_mpoly_init3(Cp, base->C->length, base->C->bits, base->pctxs + l);
+    fmpz_mpoly_interp_reduce_p(Bp, base->pctxs + l, base->B, base->ctx);
+    fmpz_mpoly_interp_reduce_p(Cp, base->pctxs + l, base->C, base->ctx);
+
+    nmod_mpoly_mul(base->Aps + l, Bp, Cp, base->pctxs + l);
+
+    /* the image can only have smaller fields than the true product */
+    FLINT_ASSERT(base->Aps[l].bits <= base->Abits);
+    if (base->Aps[l].bits < base->Abits)
+        nmod_mpoly_repack_bits_inplace(base->Aps + l, base->Abits,
+                                                            base->pctxs + l);
+
+    nmod_mpoly_clear(Bp, base->pctxs + l);
+    nmod_mpoly_clear(Cp, base->pctxs + l);
+
+    goto get_next_index;
+}
+
+/* reconstruct the coefficients in [start, stop) */
+static void _crt_worker(void * varg)
+{
+    _worker_arg_struct * arg = (_worker_arg_struct *) varg;
+    _base_struct * base = arg->base;
+    slong i, num_primes = base->num_primes;
+    fmpz_comb_temp_t comb_temp;
+
+    fmpz_comb_temp_init(comb_temp, base->comb);
+
+    for (i = arg->start; i < arg->stop; i++)
+        fmpz_multi_CRT_ui(base->Acoeffs + i, base->residues + num_primes*i,
+                                                 base->comb, comb_temp, 1);
+
+    fmpz_comb_temp_clear(comb_temp);
+}
+
+/*
+    Multiply B and C modulo enough word-sized primes to determine the
+    coefficients of the product and recombine by the chinese remainder
+    theorem. The images are computed in parallel by nmod_mpoly_mul, one
+    prime at a time per thread, and the recombination is split into
+    contiguous ranges of terms. The maxfields are clobbered.
+*/
+void _fmpz_mpoly_mul_multi_mod_maxfields(
+    fmpz_mpoly_t A,
+    const fmpz_mpoly_t B, fmpz * maxBfields,
+    const fmpz_mpoly_t C, fmpz * maxCfields,
+    const fmpz_mpoly_ctx_t ctx,
+    const thread_pool_handle * handles,
+    slong num_handles)
+{
+    slong i, l, N, Alen, num_primes;
+    flint_bitcnt_t Abits, coeff_bits;
+    slong Bcoeffbits, Ccoeffbits;
+    mp_limb_t * primes, * residues;
+    slong residues_alloc;
+    slong * pos;
+    ulong * cmpmask;
+    fmpz_comb_t comb;
+    _base_t base;
+    _worker_arg_struct * args;
+    TMP_INIT;
+
+    FLINT_ASSERT(B->length > 0 && C->length > 0);
+
+    TMP_START;
+
+    _fmpz_vec_add(maxBfields, maxBfields, maxCfields, ctx->minfo->nfields);
+
+    Abits = _fmpz_vec_max_bits(maxBfields, ctx->minfo->nfields);
+    Abits = FLINT_MAX(MPOLY_MIN_BITS, Abits + 1);
+    Abits = FLINT_MAX(Abits, B->bits);
+    Abits = FLINT_MAX(Abits, C->bits);
+    Abits = mpoly_fix_bits(Abits, ctx->minfo);
+
+    N = mpoly_words_per_exp(Abits, ctx->minfo);
+    cmpmask = (ulong *) TMP_ALLOC(N*sizeof(ulong));
+    mpoly_get_cmpmask(cmpmask, N, Abits, ctx->minfo);
+
+    /* one extra bit for the sign */
+    Bcoeffbits = FLINT_ABS(_fmpz_vec_max_bits(B->coeffs, B->length));
+    Ccoeffbits = FLINT_ABS(_fmpz_vec_max_bits(C->coeffs, C->length));
+    coeff_bits = Bcoeffbits + Ccoeffbits + 1 +
+                         FLINT_BIT_COUNT(FLINT_MIN(B->length, C->length));
+
+    /* each prime is at least 2^(FLINT_BITS - 1) */
+    num_primes = 1 + coeff_bits/(FLINT_BITS - 1);
+    primes = FLINT_ARRAY_ALLOC(num_primes, mp_limb_t);
+    primes[0] = n_nextprime(UWORD(1) << (FLINT_BITS - 1), 1);
+    for (l = 1; l < num_primes; l++)
+        primes[l] = n_nextprime(primes[l - 1], 1);
+
+    fmpz_comb_init(comb, primes, num_primes);
+
+    base->idx = 0;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&base->mutex, NULL);
+#endif
+    base->num_primes = num_primes;
+    base->primes = primes;
+    base->pctxs = FLINT_ARRAY_ALLOC(num_primes, nmod_mpoly_ctx_struct);
+    base->Aps = FLINT_ARRAY_ALLOC(num_primes, nmod_mpoly_struct);
+    for (l = 0; l < num_primes; l++)
+    {
+        nmod_mpoly_ctx_init(base->pctxs + l, ctx->minfo->nvars,
+                                                ctx->minfo->ord, primes[l]);
+        nmod_mpoly_init3(base->Aps + l, 0, Abits, base->pctxs + l);
+    }
+    base->B = B;
+    base->C = C;
+    base->ctx = ctx;
+    base->Abits = Abits;
+    base->comb = comb;
+
+    num_handles = FLINT_MIN(num_handles, num_primes - 1);
+    num_handles = FLINT_MAX(num_handles, 0);
+    args = FLINT_ARRAY_ALLOC(num_handles + 1, _worker_arg_struct);
+    for (i = 0; i <= num_handles; i++)
+        args[i].base = base;
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                    _image_worker, args + i);
+    _image_worker(args + num_handles);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    /*
+        Merge the images. A term of the product is present in the union
+        iff its coefficient is nonzero, and its residues modulo the primes
+        for which it is absent are zero. B and C are not read anymore, so
+        A may be reset even when aliased.
+    */
+    pos = (slong *) TMP_ALLOC(num_primes*sizeof(slong));
+    for (l = 0; l < num_primes; l++)
+        pos[l] = 0;
+
+    residues_alloc = 0;
+    for (l = 0; l < num_primes; l++)
+        residues_alloc = FLINT_MAX(residues_alloc, base->Aps[l].length);
+    residues = FLINT_ARRAY_ALLOC(num_primes*residues_alloc, mp_limb_t);
+
+    fmpz_mpoly_fit_length_reset_bits(A, residues_alloc, Abits, ctx);
+
+    Alen = 0;
+    while (1)
+    {
+        const ulong * top = NULL;
+
+        for (l = 0; l < num_primes; l++)
+        {
+            const nmod_mpoly_struct * Ap = base->Aps + l;
+
+            if (pos[l] >= Ap->length)
+                continue;
+
+            if (top == NULL || mpoly_monomial_gt(Ap->exps + N*pos[l],
+                                                          top, N, cmpmask))
+            {
+                top = Ap->exps + N*pos[l];
+            }
+        }
+
+        if (top == NULL)
+            break;
+
+        if (Alen >= residues_alloc)
+        {
+            residues_alloc = FLINT_MAX(Alen + 1, 2*residues_alloc);
+            residues = FLINT_ARRAY_REALLOC(residues, num_primes*residues_alloc,
+                                                                    mp_limb_t);
+        }
+
+        fmpz_mpoly_fit_length(A, Alen + 1, ctx);
+        mpoly_monomial_set(A->exps + N*Alen, top, N);
+
+        for (l = 0; l < num_primes; l++)
+        {
+            nmod_mpoly_struct * Ap = base->Aps + l;
+
+            if (pos[l] < Ap->length &&
+                mpoly_monomial_equal(Ap->exps + N*pos[l], A->exps + N*Alen, N))
+            {
+                residues[num_primes*Alen + l] = Ap->coeffs[pos[l]];
+                pos[l]++;
+            }
+            else
+            {
+                residues[num_primes*Alen + l] = 0;
+            }
+        }
+
+        Alen++;
+    }
+
+    for (l = 0; l < num_primes; l++)
+    {
+        nmod_mpoly_clear(base->Aps + l, base->pctxs + l);
+        nmod_mpoly_ctx_clear(base->pctxs + l);
+    }
+
+    base->residues = residues;
+    base->Acoeffs = A->coeffs;
+
+    num_handles = FLINT_MIN(num_handles, Alen/64);
+    for (i = 0; i <= num_handles; i++)
+    {
+        args[i].start = i*Alen/(num_handles + 1);
+        args[i].stop = (i + 1)*Alen/(num_handles + 1);
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                      _crt_worker, args + i);
+    _crt_worker(args + num_handles);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    _fmpz_mpoly_set_length(A, Alen, ctx);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&base->mutex);
+#endif
+
+    fmpz_comb_clear(comb);
+    flint_free(base->pctxs);
+    flint_free(base->Aps);
+    flint_free(residues);
+    flint_free(primes);
+    flint_free(args);
+
+    TMP_END;
+}
+
+void fmpz_mpoly_mul_multi_mod(
+    fmpz_mpoly_t A,
+    const fmpz_mpoly_t B,
+    const fmpz_mpoly_t C,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    slong i;
+    fmpz * maxBfields, * maxCfields;
+    thread_pool_handle * handles;
+    slong num_handles;
+    TMP_INIT;
+
+    if (B->length < 1 || C->length < 1)
+    {
+        fmpz_mpoly_zero(A, ctx);
+        return;
+    }
+
+    TMP_START;
+
+    maxBfields = (fmpz *) TMP_ALLOC(ctx->minfo->nfields*sizeof(fmpz));
+    maxCfields = (fmpz *) TMP_ALLOC(ctx->minfo->nfields*sizeof(fmpz));
+    for (i = 0; i < ctx->minfo->nfields; i++)
+    {
+        fmpz_init(maxBfields + i);
+        fmpz_init(maxCfields + i);
+    }
+    mpoly_max_fields_fmpz(maxBfields, B->exps, B->length, B->bits, ctx->minfo);
+    mpoly_max_fields_fmpz(maxCfields, C->exps, C->length, C->bits, ctx->minfo);
+
+    num_handles = flint_request_threads(&handles, FLINT_MIN(B->length,
+                                                           C->length)/16);
+
+    _fmpz_mpoly_mul_multi_mod_maxfields(A, B, maxBfields, C, maxCfields, ctx,
+                                                        handles, num_handles);
+
+    flint_give_back_threads(handles, num_handles);
+
+    for (i = 0; i < ctx->minfo->nfields; i++)
+    {
+        fmpz_clear(maxBfields + i);
+        fmpz_clear(maxCfields + i);
+    }
+
+    TMP_END;
+}
@@ -0,0 +1,346 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <math.h>
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mod.h"
+#include "fmpz_mod_poly.h"
+#include "fmpz_mpoly.h"
+
+/*
+    Set N/D = sum_{j < len} c[j]/(1 - m[j]*z) with D = prod_j (1 - m[j]*z).
+    The power series expansion of N/D is sum_k (sum_j c[j]*m[j]^k) z^k, i.e.
+    the values of the polynomial with coefficients c[j] and monomials m[j] on
+    the geometric sequence of points, so this is the transposed form of
+    multipoint evaluation.
+*/
+static void _sum_fractions(
+    fmpz_mod_poly_t N,
+    fmpz_mod_poly_t D,
+    const fmpz * c,
+    const fmpz * m,
+    slong len,
+    const fmpz_mod_ctx_t fctx)
+{
+    fmpz_mod_poly_t N2, D2, t;
+
+    FLINT_ASSERT(len > 0);
+
+    if (len == 1)
+    {
+        fmpz_mod_poly_set_fmpz(N, c + 0, fctx);
+        fmpz_mod_poly_fit_length(D, 2, fctx);
+        fmpz_one(D->coeffs + 0);
+        fmpz_mod_neg(D->coeffs + 1, m + 0, fctx);
+        _fmpz_mod_poly_set_length(D, 2);
+        _fmpz_mod_poly_normalise(D);
+        return;
+    }
+
+    fmpz_mod_poly_init(N2, fctx);
+    fmpz_mod_poly_init(D2, fctx);
+    fmpz_mod_poly_init(t, fctx);
+
+    _sum_fractions(N, D, c, m, len/2, fctx);
+    _sum_fractions(N2, D2, c + len/2, m + len/2, len - len/2, fctx);
+
+    fmpz_mod_poly_mul(t, N2, D, fctx);
+    fmpz_mod_poly_mul(N, N, D2, fctx);
+    fmpz_mod_poly_add(N, N, t, fctx);
+    fmpz_mod_poly_mul(D, D, D2, fctx);
+
+    fmpz_mod_poly_clear(N2, fctx);
+    fmpz_mod_poly_clear(D2, fctx);
+    fmpz_mod_poly_clear(t, fctx);
+}
+
+/* coefficients mod p and monomials p_0^e_0*...*p_{n-1}^e_{n-1} of B */
+static void _prime_monomials(
+    fmpz * c,
+    fmpz * m,
+    const fmpz_mpoly_t B,
+    const ulong * primes,
+    const fmpz_mpoly_ctx_t ctx,
+    const fmpz_mod_ctx_t fctx)
+{
+    slong i, j, nvars = ctx->minfo->nvars;
+    slong N = mpoly_words_per_exp(B->bits, ctx->minfo);
+    ulong * exps;
+    fmpz_t t;
+    TMP_INIT;
+
+    TMP_START;
+    exps = (ulong *) TMP_ALLOC(nvars*sizeof(ulong));
+    fmpz_init(t);
+
+    for (i = 0; i < B->length; i++)
+    {
+        fmpz_mod_set_fmpz(c + i, B->coeffs + i, fctx);
+        mpoly_get_monomial_ui(exps, B->exps + N*i, B->bits, ctx->minfo);
+        fmpz_one(m + i);
+        for (j = 0; j < nvars; j++)
+        {
+            fmpz_ui_pow_ui(t, primes[j], exps[j]);
+            fmpz_mul(m + i, m + i, t);
+        }
+    }
+
+    fmpz_clear(t);
+    TMP_END;
+}
+
+int fmpz_mpoly_mul_sparse_interp(
+    fmpz_mpoly_t A,
+    const fmpz_mpoly_t B,
+    const fmpz_mpoly_t C,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    int success = 0;
+    slong i, j, T, L, n, nvars = ctx->minfo->nvars;
+    slong Blen = B->length, Clen = C->length;
+    ulong * primes, * degs, * texps;
+    slong * degB, * degC;
+    slong Tbound, nprods;
+    ulong hi, lo;
+    double bits_est;
+    flint_bitcnt_t qbits;
+    fmpz * Bc, * Bm, * Cc, * Cm, * tcoeffs, * alphas, * cands;
+    slong ncands;
+    fmpz_t q, Mbound, t, ev1, ev2;
+    fmpz_mod_ctx_t fctx;
+    fmpz_mod_poly_t NB, DB, NC, DC, SB, SC;
+    fmpz_mod_berlekamp_massey_t bma;
+    fmpz_mpoly_t R;
+    flint_rand_t state;
+
+    if (B->length == 0 || C->length == 0)
+    {
+        fmpz_mpoly_zero(A, ctx);
+        return 1;
+    }
+
+    if (B->bits > FLINT_BITS || C->bits > FLINT_BITS || nvars < 1)
+        return 0;
+
+    primes = FLINT_ARRAY_ALLOC(2*nvars, ulong);
+    degs = primes + nvars;
+    degB = FLINT_ARRAY_ALLOC(2*nvars, slong);
+    degC = degB + nvars;
+
+    fmpz_mpoly_degrees_si(degB, B, ctx);
+    fmpz_mpoly_degrees_si(degC, C, ctx);
+
+    /*
+        The product is recovered from its values at the points
+        (p_0^k, ..., p_{n-1}^k) modulo a prime q exceeding the largest
+        possible monomial p_0^deg_0*...*p_{n-1}^deg_{n-1} as well as twice the
+        coefficient bound. Give up if this prime would be too large.
+    */
+    bits_est = 0;
+    for (i = 0; i < nvars; i++)
+    {
+        primes[i] = n_nth_prime(i + 1);
+        degs[i] = (ulong) degB[i] + (ulong) degC[i];
+        bits_est += degs[i]*log2(primes[i]);
+    }
+
+    if (bits_est > FMPZ_MPOLY_SPARSE_INTERP_MAX_BITS)
+    {
+        flint_free(primes);
+        flint_free(degB);
+        return 0;
+    }
+
+    fmpz_init(q);
+    fmpz_init(Mbound);
+    fmpz_init(t);
+    fmpz_init(ev1);
+    fmpz_init(ev2);
+
+    fmpz_one(Mbound);
+    for (i = 0; i < nvars; i++)
+    {
+        fmpz_ui_pow_ui(t, primes[i], degs[i]);
+        fmpz_mul(Mbound, Mbound, t);
+    }
+
+    qbits = fmpz_mpoly_max_bits(B);
+    qbits = FLINT_ABS(qbits) + FLINT_ABS(fmpz_mpoly_max_bits(C));
+    qbits += FLINT_BIT_COUNT(FLINT_MIN(Blen, Clen)) + 1;
+    qbits = FLINT_MAX(qbits, fmpz_bits(Mbound)) + 1;
+
+    flint_randinit(state);
+    fmpz_randprime(q, state, qbits, 0);
+    fmpz_mod_ctx_init(fctx, q);
+
+    Bc = _fmpz_vec_init(2*Blen);
+    Bm = Bc + Blen;
+    Cc = _fmpz_vec_init(2*Clen);
+    Cm = Cc + Clen;
+    _prime_monomials(Bc, Bm, B, primes, ctx, fctx);
+    _prime_monomials(Cc, Cm, C, primes, ctx, fctx);
+
+    fmpz_mod_poly_init(NB, fctx);
+    fmpz_mod_poly_init(DB, fctx);
+    fmpz_mod_poly_init(NC, fctx);
+    fmpz_mod_poly_init(DC, fctx);
+    fmpz_mod_poly_init(SB, fctx);
+    fmpz_mod_poly_init(SC, fctx);
+    fmpz_mod_berlekamp_massey_init(bma, fctx);
+    fmpz_mpoly_init(R, ctx);
+
+    _sum_fractions(NB, DB, Bc, Bm, Blen, fctx);
+    _sum_fractions(NC, DC, Cc, Cm, Clen, fctx);
+
+    /* the product has at most Blen*Clen terms */
+    umul_ppmm(hi, lo, Blen, Clen);
+    if (hi != 0 || lo > WORD_MAX/4)
+        flint_throw(FLINT_ERROR, "Exception in fmpz_mpoly_mul_sparse_interp: "
+                                                              "overflow");
+    Tbound = nprods = lo;
+
+    cands = NULL;
+    ncands = 0;
+
+    alphas = _fmpz_vec_init(nvars);
+
+    /*
+        Early termination: start with a small term count and double it until
+        the Berlekamp-Massey generator stabilises and the decoded candidate
+        agrees with B*C at a random point. Once T reaches the bound on the
+        number of terms the generator is exact and no check is needed.
+    */
+    for (T = FLINT_MIN(16, Tbound); ; T = FLINT_MIN(2*T, Tbound))
+    {
+        n = 2*T;
+
+        /* the first values are unchanged, only feed the new ones to bma */
+        fmpz_mod_poly_div_series(SB, NB, DB, n, fctx);
+        fmpz_mod_poly_div_series(SC, NC, DC, n, fctx);
+        for (i = fmpz_mod_berlekamp_massey_point_count(bma); i < n; i++)
+        {
+            if (i < SB->length && i < SC->length)
+                fmpz_mod_mul(t, SB->coeffs + i, SC->coeffs + i, fctx);
+            else
+                fmpz_zero(t);
+            fmpz_mod_berlekamp_massey_add_point(bma, t, fctx);
+        }
+
+        fmpz_mod_berlekamp_massey_reduce(bma, fctx);
+        L = fmpz_mod_poly_degree(fmpz_mod_berlekamp_massey_V_poly(bma), fctx);
+
+        if (T < Tbound && 2*L + 4 > n)
+            continue;
+
+        /*
+            The monomials of the product are among the Blen*Clen products of
+            the monomials of B and C. Testing these as roots of the generator
+            costs about Blen*Clen/L multipoint evaluations of degree L, while
+            root finding modulo q costs about qbits of the corresponding
+            modular powerings, each some 30 times more expensive. The
+            candidates are only formed when they are the cheaper option;
+            otherwise the roots are found modulo q and factored over the
+            small primes.
+        */
+        if (cands == NULL && (double) Blen * (double) Clen <=
+                               32 * (double) qbits * (double) FLINT_MAX(L, 1))
+        {
+            cands = _fmpz_vec_init(nprods);
+            for (i = 0; i < Blen; i++)
+                for (j = 0; j < Clen; j++)
+                    fmpz_mul(cands + Clen*i + j, Bm + i, Cm + j);
+            _fmpz_vec_sort(cands, nprods);
+            for (i = ncands = 0; i < nprods; i++)
+                if (ncands == 0 || !fmpz_equal(cands + ncands - 1, cands + i))
+                    fmpz_swap(cands + ncands++, cands + i);
+
+            /* the product has at most this many terms */
+            Tbound = ncands;
+        }
+
+        tcoeffs = _fmpz_vec_init(L);
+        texps = FLINT_ARRAY_ALLOC(nvars*L, ulong);
+
+        if (!_fmpz_mpoly_sparse_interp_decode(tcoeffs, texps,
+                    fmpz_mod_berlekamp_massey_V_poly(bma),
+                    fmpz_mod_berlekamp_massey_points(bma), n,
+                               cands, ncands, primes, degs, nvars, fctx))
+        {
+            FLINT_ASSERT(T < Tbound);
+            goto next;
+        }
+
+        fmpz_mpoly_zero(R, ctx);
+        for (j = 0; j < L; j++)
+        {
+            fmpz_smod(tcoeffs + j, tcoeffs + j, q);
+            fmpz_mpoly_push_term_fmpz_ui(R, tcoeffs + j, texps + nvars*j, ctx);
+        }
+        fmpz_mpoly_sort_terms(R, ctx);
+
+        if (T < Tbound)
+        {
+            for (i = 0; i < nvars; i++)
+                fmpz_randm(alphas + i, state, q);
+
+            fmpz_mpoly_evaluate_all_fmpz_mod(ev1, B, alphas, ctx, fctx);
+            fmpz_mpoly_evaluate_all_fmpz_mod(t, C, alphas, ctx, fctx);
+            fmpz_mod_mul(ev1, ev1, t, fctx);
+            fmpz_mpoly_evaluate_all_fmpz_mod(ev2, R, alphas, ctx, fctx);
+            if (!fmpz_equal(ev1, ev2))
+                goto next;
+        }
+
+        fmpz_mpoly_swap(A, R, ctx);
+        success = 1;
+
+    next:
+
+        _fmpz_vec_clear(tcoeffs, L);
+        flint_free(texps);
+
+        if (success || T >= Tbound)
+            break;
+    }
+
+    /* the generator is exact once T reaches Tbound, so failure means that
+       q was composite; A is left untouched in this case */
+
+    if (cands != NULL)
+        _fmpz_vec_clear(cands, nprods);
+    _fmpz_vec_clear(alphas, nvars);
+    _fmpz_vec_clear(Bc, 2*Blen);
+    _fmpz_vec_clear(Cc, 2*Clen);
+    fmpz_mod_poly_clear(NB, fctx);
+    fmpz_mod_poly_clear(DB, fctx);
+    fmpz_mod_poly_clear(NC, fctx);
+    fmpz_mod_poly_clear(DC, fctx);
+    fmpz_mod_poly_clear(SB, fctx);
+    fmpz_mod_poly_clear(SC, fctx);
+    fmpz_mod_berlekamp_massey_clear(bma, fctx);
+    fmpz_mpoly_clear(R, ctx);
+    fmpz_mod_ctx_clear(fctx);
+    flint_randclear(state);
+
+    fmpz_clear(q);
+    fmpz_clear(Mbound);
+    fmpz_clear(t);
+    fmpz_clear(ev1);
+    fmpz_clear(ev2);
+
+    flint_free(primes);
+    flint_free(degB);
+
+    return success;
+}
@@ -0,0 +1,822 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "thread_support.h"
+#include "fmpz_mpoly.h"
+
+/*
+    Threaded version of the sparse FPS recurrence in pow_fps.c.
+
+    The rows F[1], ..., F[Flen - 1] of the recurrence are split into
+    contiguous blocks [lo, hi). The main thread owns the first block and is
+    the only one producing terms of G = F^(k - 1) and A = F^k. Every other
+    block runs its own heap over the products F[i]*G[j], lo <= i < hi, and
+    sends the partial sums S = sum F[i]*G[j] and C = sum F[i]*G[j]*(fik[i] - g[j])
+    for each exponent to the main thread through a queue.
+
+    Since G is produced in descending order, once all exponents of A greater
+    than E are final, every term of G still unknown satisfies g + F[0] <= E.
+    Such a term only contributes to the block [lo, hi) at exponents less than
+    E + F[lo] - F[0]. Hence a worker may send its sums for the exponent e as
+    soon as e + F[0] > E + F[lo]. The blocks further down run ahead of the
+    main thread by about F[0] - F[lo].
+*/
+
+#define POW_FPS_QUEUE_LEN 128
+
+/* heap over the rows [lo, hi) */
+typedef struct
+{
+    slong lo, hi;
+    slong heap_len, next_loc;
+    mpoly_heap_s * heap;
+    mpoly_heap_t * chain;
+    slong * hind;
+    slong * Q;
+    ulong * exps;
+    ulong ** exp_list;
+    slong exp_next;
+    ulong * temp;
+    fmpz_t t1, t2;
+    /* the part of G known to this block */
+    const fmpz * Gcoeffs;
+    const ulong * Gexps;
+    slong Glen;
+} _pow_block_struct;
+
+typedef struct _pow_fps_base_struct _pow_fps_base_struct;
+
+typedef struct
+{
+    _pow_fps_base_struct * base;
+    _pow_block_struct block[1];
+    /* queue of sums: entries [start, end) modulo POW_FPS_QUEUE_LEN */
+    fmpz * qS;
+    fmpz * qC;
+    ulong * qexps;
+    volatile slong start, end;
+    /* state at the last report: end of queue, length of G, top of heap */
+    volatile slong report_end;
+    volatile slong report_Glen;
+    volatile int report_has_top;
+    ulong * report_top;
+#if FLINT_USES_PTHREAD
+    pthread_cond_t cond;
+#endif
+} _pow_worker_struct;
+
+struct _pow_fps_base_struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+#endif
+    volatile slong version;
+    volatile int done;
+    /* published part of G and exponent E such that A is final above E */
+    const fmpz * volatile Gcoeffs;
+    const ulong * volatile Gexps;
+    volatile slong Glen;
+    ulong * E;
+    const fmpz * Fcoeffs;
+    const ulong * Fexps;
+    const ulong * fik;
+    slong N;
+    flint_bitcnt_t bits;
+    ulong ofmask;
+    const ulong * cmpmask;
+};
+
+static void _pow_block_init(_pow_block_struct * B, slong lo, slong hi, slong N)
+{
+    slong i, n = hi - lo;
+
+    B->lo = lo;
+    B->hi = hi;
+    B->heap_len = 1;
+    B->next_loc = n + 4;   /* something bigger than heap can ever be */
+    B->heap = FLINT_ARRAY_ALLOC(n + 1, mpoly_heap_s);
+    B->chain = FLINT_ARRAY_ALLOC(n, mpoly_heap_t);
+    B->hind = FLINT_ARRAY_ALLOC(3*n, slong);
+    B->Q = B->hind + n;
+    B->exps = FLINT_ARRAY_ALLOC(N*(n + 1) + N, ulong);
+    B->temp = B->exps + N*(n + 1);
+    B->exp_list = FLINT_ARRAY_ALLOC(n + 1, ulong *);
+    for (i = 0; i < n + 1; i++)
+        B->exp_list[i] = B->exps + N*i;
+    B->exp_next = 0;
+    for (i = 0; i < n; i++)
+        B->hind[i] = 1;
+    fmpz_init(B->t1);
+    fmpz_init(B->t2);
+    B->Gcoeffs = NULL;
+    B->Gexps = NULL;
+    B->Glen = 0;
+}
+
+static void _pow_block_clear(_pow_block_struct * B)
+{
+    flint_free(B->heap);
+    flint_free(B->chain);
+    flint_free(B->hind);
+    flint_free(B->exps);
+    flint_free(B->exp_list);
+    fmpz_clear(B->t1);
+    fmpz_clear(B->t2);
+}
+
+static void _pow_block_insert(_pow_block_struct * B, slong i, slong j,
+               const ulong * Fexps, slong N, const ulong * cmpmask)
+{
+    mpoly_heap_t * x = B->chain + (i - B->lo);
+
+    FLINT_ASSERT(j < B->Glen);
+
+    x->i = i;
+    x->j = j;
+    x->next = NULL;
+
+    B->hind[i - B->lo] = 2*(j + 1) + 0;
+
+    mpoly_monomial_add_mp(B->exp_list[B->exp_next], Fexps + N*i,
+                                                      B->Gexps + N*j, N);
+
+    B->exp_next += _mpoly_heap_insert(B->heap, B->exp_list[B->exp_next], x,
+                                       &B->next_loc, &B->heap_len, N, cmpmask);
+}
+
+/*
+    Make G[0], ..., G[Glen - 1] known to the block. The first row of the
+    block has no row above it to move it to the right, so it is restarted
+    here as soon as the term of G it is waiting for exists.
+*/
+static void _pow_block_set_G(_pow_block_struct * B, const fmpz * Gcoeffs,
+                    const ulong * Gexps, slong Glen,
+                    const ulong * Fexps, slong N, const ulong * cmpmask)
+{
+    slong j = B->hind[0]/2;
+
+    B->Gcoeffs = Gcoeffs;
+    B->Gexps = Gexps;
+    B->Glen = Glen;
+
+    if ((B->hind[0] & 1) != 0 && j < Glen)
+        _pow_block_insert(B, B->lo, j, Fexps, N, cmpmask);
+}
+
+/* pop all products with exponent e from the heap into S and C */
+static void _pow_block_pop(_pow_block_struct * B, fmpz_t S, fmpz_t C,
+            int divides, const ulong * e, const fmpz * Fcoeffs,
+            const ulong * Fexps, const ulong * fik, slong N,
+                                                      const ulong * cmpmask)
+{
+    slong i, j, Qlen = 0;
+    mpoly_heap_t * x;
+
+    fmpz_zero(S);
+    fmpz_zero(C);
+
+    while (B->heap_len > 1 && mpoly_monomial_equal(B->heap[1].exp, e, N))
+    {
+        B->exp_list[--B->exp_next] = B->heap[1].exp;
+        x = _mpoly_heap_pop(B->heap, &B->heap_len, N, cmpmask);
+
+        do {
+            B->Q[Qlen++] = i = x->i;
+            B->Q[Qlen++] = j = x->j;
+            B->hind[i - B->lo] |= 1;
+
+            fmpz_mul(B->t1, Fcoeffs + i, B->Gcoeffs + j);
+            fmpz_add(S, S, B->t1);
+            if (divides)
+            {
+                mpn_sub_n(B->temp, fik + N*i, B->Gexps + N*j, N);
+                fmpz_set_signed_ui_array(B->t2, B->temp, N);
+                fmpz_addmul(C, B->t1, B->t2);
+            }
+        } while ((x = x->next) != NULL);
+    }
+
+    while (Qlen > 0)
+    {
+        j = B->Q[--Qlen];
+        i = B->Q[--Qlen];
+
+        /* should we go right? */
+        if (i + 1 < B->hi && B->hind[i + 1 - B->lo] == 2*j + 1)
+            _pow_block_insert(B, i + 1, j, Fexps, N, cmpmask);
+
+        /* should we go up? */
+        if (j + 1 < B->Glen && B->hind[i - B->lo] < 2*j + 4)
+            _pow_block_insert(B, i, j + 1, Fexps, N, cmpmask);
+    }
+}
+
+/* does F[0] divide the monomial e? t receives e - F[0] */
+static int _pow_divides(ulong * t, const ulong * e, const ulong * F0,
+                              slong N, flint_bitcnt_t bits, ulong ofmask)
+{
+    mpoly_monomial_sub_mp(t, e, F0, N);
+
+    if (bits > FLINT_BITS)
+        return !mpoly_monomial_overflows_mp(t, N, bits);
+    else
+        return !mpoly_monomial_overflows(t, N, ofmask);
+}
+
+/* publish the state of the worker: the mutex must be held */
+static void _pow_worker_report(_pow_worker_struct * W, slong Glen, slong N)
+{
+    _pow_block_struct * B = W->block;
+
+    W->report_end = W->end;
+    W->report_Glen = Glen;
+    W->report_has_top = B->heap_len > 1;
+    if (B->heap_len > 1)
+        mpoly_monomial_set(W->report_top, B->heap[1].exp, N);
+#if FLINT_USES_PTHREAD
+    pthread_cond_signal(&W->base->cond);
+#endif
+}
+
+static void _pow_fps_worker(void * varg)
+{
+    _pow_worker_struct * W = (_pow_worker_struct *) varg;
+    _pow_fps_base_struct * H = W->base;
+    _pow_block_struct * B = W->block;
+    slong N = H->N;
+    slong version, s;
+    slong Glen;
+    const fmpz * Gcoeffs;
+    const ulong * Gexps;
+    ulong * bound, * t, * e;
+    int divides;
+
+    bound = FLINT_ARRAY_ALLOC(2*N, ulong);
+    t = bound + N;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&H->mutex);
+#endif
+
+    while (!H->done)
+    {
+        version = H->version;
+        Gcoeffs = H->Gcoeffs;
+        Gexps = H->Gexps;
+        Glen = H->Glen;
+        mpoly_monomial_add_mp(bound, H->E, H->Fexps + N*B->lo, N);
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&H->mutex);
+#endif
+
+        _pow_block_set_G(B, Gcoeffs, Gexps, Glen, H->Fexps, N, H->cmpmask);
+
+        while (B->heap_len > 1)
+        {
+            mpoly_monomial_add_mp(t, B->heap[1].exp, H->Fexps + 0, N);
+            if (!mpoly_monomial_gt(t, bound, N, H->cmpmask))
+                break;
+
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&H->mutex);
+            while (W->end - W->start >= POW_FPS_QUEUE_LEN)
+                pthread_cond_wait(&W->cond, &H->mutex);
+            pthread_mutex_unlock(&H->mutex);
+#endif
+            s = W->end % POW_FPS_QUEUE_LEN;
+            e = W->qexps + N*s;
+            mpoly_monomial_set(e, B->heap[1].exp, N);
+            divides = _pow_divides(t, e, H->Fexps + 0, N, H->bits, H->ofmask);
+            _pow_block_pop(B, W->qS + s, W->qC + s, divides, e, H->Fcoeffs,
+                                          H->Fexps, H->fik, N, H->cmpmask);
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&H->mutex);
+#endif
+            W->end++;
+            _pow_worker_report(W, Glen, N);
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&H->mutex);
+#endif
+        }
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&H->mutex);
+#endif
+        _pow_worker_report(W, Glen, N);
+#if FLINT_USES_PTHREAD
+        while (H->version == version && !H->done)
+            pthread_cond_wait(&W->cond, &H->mutex);
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&H->mutex);
+#endif
+
+    flint_free(bound);
+}
+
+/* what the main thread knows about the next exponent of a worker */
+#define POW_FPS_NONE    0   /* nothing left at the current length of G */
+#define POW_FPS_QUEUE   1   /* the head of the queue */
+#define POW_FPS_TOP     2   /* the top of the heap at the last report */
+#define POW_FPS_STALE   3   /* the worker has to report first */
+
+static slong _fmpz_mpoly_pow_fps_threaded(
+    fmpz_mpoly_t A,
+    const fmpz * Fcoeffs, const ulong * Fexps, slong Flen,
+    ulong k,
+    slong N,
+    const ulong * cmpmask,
+    const thread_pool_handle * handles,
+    slong num_workers)
+{
+    flint_bitcnt_t bits = A->bits;
+    _pow_fps_base_struct H[1];
+    _pow_worker_struct * W;
+    _pow_block_struct M[1];
+    fmpz * Acoeffs = A->coeffs;
+    ulong * Aexps = A->exps;
+    slong Alen;
+    fmpz * Gcoeffs;
+    ulong * Gexps;
+    slong Galloc, Glen;
+    fmpz ** Gcoeffs_old;
+    ulong ** Gexps_old;
+    slong Gold_len = 0;
+    ulong * fik, * Enext, * temp, * bound;
+    const ulong * cand;
+    int * wstate, * wneed;
+    fmpz_t t1, t2, C;
+    slong i, w, s, lo, rows, main_rows;
+    int have_E, need_wait, divides;
+
+    fik = FLINT_ARRAY_ALLOC(N*Flen + 4*N, ulong);
+    Enext = fik + N*Flen;
+    temp = Enext + N;
+    bound = temp + N;
+    H->E = bound + N;
+
+    for (i = 0; i < Flen; i++)
+        mpoly_monomial_mul_ui_mp(fik + N*i, Fexps + N*i, N, k - 1);
+
+    fmpz_init(t1);
+    fmpz_init(t2);
+    fmpz_init(C);
+
+    _fmpz_mpoly_fit_length(&Acoeffs, &Aexps, &A->alloc, 2, N);
+
+    Galloc = (k - 1)*Flen + 2;
+    Gexps = FLINT_ARRAY_ALLOC(N*Galloc, ulong);
+    Gcoeffs = (fmpz *) flint_calloc(Galloc, sizeof(fmpz));
+    Gexps_old = FLINT_ARRAY_ALLOC(FLINT_BITS, ulong *);
+    Gcoeffs_old = FLINT_ARRAY_ALLOC(FLINT_BITS, fmpz *);
+
+    mpoly_monomial_mul_ui_mp(Gexps + 0, Fexps + 0, N, k - 1);
+    mpoly_monomial_mul_ui_mp(Aexps + 0, Fexps + 0, N, k);
+    fmpz_pow_ui(Gcoeffs + 0, Fcoeffs + 0, k - 1);
+    fmpz_mul(Acoeffs + 0, Gcoeffs + 0, Fcoeffs + 0);
+    Glen = 1;
+    Alen = 1;
+
+    /* the main block gets half as many rows as a worker */
+    rows = Flen - 1;
+    num_workers = FLINT_MIN(num_workers, (rows - 1)/2);
+    num_workers = FLINT_MAX(num_workers, 0);
+    main_rows = rows/(2*num_workers + 1);
+
+    _pow_block_init(M, 1, 1 + main_rows, N);
+    _pow_block_set_G(M, Gcoeffs, Gexps, Glen, Fexps, N, cmpmask);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&H->mutex, NULL);
+    pthread_cond_init(&H->cond, NULL);
+#endif
+    H->version = 0;
+    H->done = 0;
+    H->Gcoeffs = Gcoeffs;
+    H->Gexps = Gexps;
+    H->Glen = Glen;
+    mpoly_monomial_set(H->E, Aexps + 0, N);
+    H->Fcoeffs = Fcoeffs;
+    H->Fexps = Fexps;
+    H->fik = fik;
+    H->N = N;
+    H->bits = bits;
+    H->ofmask = (bits > FLINT_BITS) ? 0 : mpoly_overflow_mask_sp(bits);
+    H->cmpmask = cmpmask;
+
+    W = FLINT_ARRAY_ALLOC(num_workers, _pow_worker_struct);
+    wstate = FLINT_ARRAY_ALLOC(2*num_workers, int);
+    wneed = wstate + num_workers;
+
+    lo = 1 + main_rows;
+    for (w = 0; w < num_workers; w++)
+    {
+        slong hi = lo + (rows - main_rows)/num_workers +
+                        (w < (rows - main_rows) % num_workers);
+
+        W[w].base = H;
+        _pow_block_init(W[w].block, lo, hi, N);
+        W[w].qS = _fmpz_vec_init(POW_FPS_QUEUE_LEN);
+        W[w].qC = _fmpz_vec_init(POW_FPS_QUEUE_LEN);
+        W[w].qexps = FLINT_ARRAY_ALLOC(N*(POW_FPS_QUEUE_LEN + 1), ulong);
+        W[w].report_top = W[w].qexps + N*POW_FPS_QUEUE_LEN;
+        W[w].start = 0;
+        W[w].end = 0;
+        W[w].report_end = -1;
+        W[w].report_Glen = 0;
+        W[w].report_has_top = 0;
+#if FLINT_USES_PTHREAD
+        pthread_cond_init(&W[w].cond, NULL);
+#endif
+        lo = hi;
+    }
+
+    FLINT_ASSERT(lo == Flen);
+
+    for (w = 0; w < num_workers; w++)
+        thread_pool_wake(global_thread_pool, handles[w], 0,
+                                                   _pow_fps_worker, &W[w]);
+
+    while (1)
+    {
+        fmpz * const S = Acoeffs + Alen;
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&H->mutex);
+#endif
+        /* find the next exponent E of A */
+        while (1)
+        {
+            have_E = M->heap_len > 1;
+            if (have_E)
+                mpoly_monomial_set(Enext, M->heap[1].exp, N);
+
+            for (w = 0; w < num_workers; w++)
+            {
+                if (W[w].end > W[w].start)
+                {
+                    wstate[w] = POW_FPS_QUEUE;
+                    cand = W[w].qexps + N*(W[w].start % POW_FPS_QUEUE_LEN);
+                }
+                else if (W[w].report_end != W[w].start ||
+                         W[w].report_Glen != Glen)
+                {
+                    wstate[w] = POW_FPS_STALE;
+                    continue;
+                }
+                else if (W[w].report_has_top)
+                {
+                    wstate[w] = POW_FPS_TOP;
+                    cand = W[w].report_top;
+                }
+                else
+                {
+                    wstate[w] = POW_FPS_NONE;
+                    continue;
+                }
+
+                if (!have_E || mpoly_monomial_gt(cand, Enext, N, cmpmask))
+                {
+                    mpoly_monomial_set(Enext, cand, N);
+                    have_E = 1;
+                }
+            }
+
+            /*
+                A stale worker only matters if it could have something at
+                or above Enext. Any product it has not seen yet comes from
+                the first row of its block and a term of G past the length
+                at its last report.
+            */
+            need_wait = 0;
+            for (w = 0; w < num_workers; w++)
+            {
+                if (wstate[w] != POW_FPS_STALE)
+                    continue;
+
+                if (have_E && W[w].report_end == W[w].start)
+                {
+                    mpoly_monomial_add_mp(temp, Fexps + N*W[w].block->lo,
+                                            Gexps + N*W[w].report_Glen, N);
+                    if (mpoly_monomial_gt(Enext, temp, N, cmpmask) &&
+                        (!W[w].report_has_top ||
+                         mpoly_monomial_gt(Enext, W[w].report_top, N, cmpmask)))
+                    {
+                        continue;
+                    }
+                }
+
+                need_wait = 1;
+#if FLINT_USES_PTHREAD
+                pthread_cond_signal(&W[w].cond);
+#endif
+            }
+
+            if (!need_wait)
+                break;
+
+#if FLINT_USES_PTHREAD
+            pthread_cond_wait(&H->cond, &H->mutex);
+#endif
+        }
+
+        if (!have_E)
+        {
+            H->done = 1;
+#if FLINT_USES_PTHREAD
+            for (w = 0; w < num_workers; w++)
+                pthread_cond_signal(&W[w].cond);
+            pthread_mutex_unlock(&H->mutex);
+#endif
+            break;
+        }
+
+        /*
+            Publish E. The workers whose next exponent is E must send their
+            sums. The others are only woken when their queue runs low and
+            they have something to send.
+        */
+        mpoly_monomial_set(H->E, Enext, N);
+        H->version++;
+        for (w = 0; w < num_workers; w++)
+        {
+            if (wstate[w] == POW_FPS_QUEUE)
+            {
+                s = W[w].start % POW_FPS_QUEUE_LEN;
+                wneed[w] = mpoly_monomial_equal(W[w].qexps + N*s, Enext, N);
+            }
+            else if (wstate[w] == POW_FPS_TOP)
+            {
+                wneed[w] = mpoly_monomial_equal(W[w].report_top, Enext, N);
+            }
+            else
+            {
+                wneed[w] = 0;
+            }
+
+            if (wstate[w] == POW_FPS_STALE || !W[w].report_has_top ||
+                W[w].end - W[w].start >= POW_FPS_QUEUE_LEN/4)
+            {
+                continue;
+            }
+
+            mpoly_monomial_add_mp(temp, Enext, Fexps + N*W[w].block->lo, N);
+            mpoly_monomial_add_mp(bound, W[w].report_top, Fexps + N*0, N);
+#if FLINT_USES_PTHREAD
+            if (mpoly_monomial_gt(bound, temp, N, cmpmask))
+                pthread_cond_signal(&W[w].cond);
+#endif
+        }
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&H->mutex);
+#endif
+
+        mpoly_monomial_set(Aexps + N*Alen, Enext, N);
+        divides = _pow_divides(Gexps + N*Glen, Enext, Fexps + 0, N,
+                                                            bits, H->ofmask);
+
+        if (M->heap_len > 1 && mpoly_monomial_equal(M->heap[1].exp, Enext, N))
+        {
+            _pow_block_pop(M, S, C, divides, Enext, Fcoeffs, Fexps, fik,
+                                                                 N, cmpmask);
+        }
+        else
+        {
+            fmpz_zero(S);
+            fmpz_zero(C);
+        }
+
+        for (w = 0; w < num_workers; w++)
+        {
+            if (!wneed[w])
+                continue;
+
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&H->mutex);
+            while (W[w].end <= W[w].start)
+                pthread_cond_wait(&H->cond, &H->mutex);
+            pthread_mutex_unlock(&H->mutex);
+#endif
+            s = W[w].start % POW_FPS_QUEUE_LEN;
+            FLINT_ASSERT(mpoly_monomial_equal(W[w].qexps + N*s, Enext, N));
+
+            fmpz_add(S, S, W[w].qS + s);
+            fmpz_add(C, C, W[w].qC + s);
+
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&H->mutex);
+#endif
+            W[w].start++;
+#if FLINT_USES_PTHREAD
+            if (W[w].end - W[w].start == POW_FPS_QUEUE_LEN/2)
+                pthread_cond_signal(&W[w].cond);
+            pthread_mutex_unlock(&H->mutex);
+#endif
+        }
+
+        if (!fmpz_is_zero(C))
+        {
+            mpoly_monomial_mul_ui_mp(temp, Fexps + 0, N, k);
+            mpn_sub_n(temp, Aexps + N*Alen, temp, N);
+            fmpz_set_signed_ui_array(t2, temp, N);
+
+            if (fmpz_is_one(Fcoeffs + 0))
+            {
+                fmpz_divexact(Gcoeffs + Glen, C, t2);
+                fmpz_add(S, S, Gcoeffs + Glen);
+            }
+            else
+            {
+                fmpz_divexact(t1, C, t2);
+                fmpz_add(S, S, t1);
+                fmpz_divexact(Gcoeffs + Glen, t1, Fcoeffs + 0);
+            }
+
+            Glen++;
+
+            /* the workers may still read the old arrays */
+            if (Glen >= Galloc)
+            {
+                Gexps_old[Gold_len] = Gexps;
+                Gcoeffs_old[Gold_len] = Gcoeffs;
+                Gold_len++;
+                Gexps = FLINT_ARRAY_ALLOC(2*N*Galloc, ulong);
+                Gcoeffs = (fmpz *) flint_calloc(2*Galloc, sizeof(fmpz));
+                memcpy(Gexps, Gexps_old[Gold_len - 1], N*Glen*sizeof(ulong));
+                memcpy(Gcoeffs, Gcoeffs_old[Gold_len - 1], Glen*sizeof(fmpz));
+                Galloc *= 2;
+            }
+
+            _pow_block_set_G(M, Gcoeffs, Gexps, Glen, Fexps, N, cmpmask);
+
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&H->mutex);
+#endif
+            H->Gcoeffs = Gcoeffs;
+            H->Gexps = Gexps;
+            H->Glen = Glen;
+            H->version++;
+#if FLINT_USES_PTHREAD
+            for (w = 0; w < num_workers; w++)
+                pthread_cond_signal(&W[w].cond);
+            pthread_mutex_unlock(&H->mutex);
+#endif
+        }
+
+        Alen += !fmpz_is_zero(Acoeffs + Alen);
+        _fmpz_mpoly_fit_length(&Acoeffs, &Aexps, &A->alloc, Alen + 1, N);
+    }
+
+    for (w = 0; w < num_workers; w++)
+        thread_pool_wait(global_thread_pool, handles[w]);
+
+    A->coeffs = Acoeffs;
+    A->exps = Aexps;
+
+    for (w = 0; w < num_workers; w++)
+    {
+        _pow_block_clear(W[w].block);
+        _fmpz_vec_clear(W[w].qS, POW_FPS_QUEUE_LEN);
+        _fmpz_vec_clear(W[w].qC, POW_FPS_QUEUE_LEN);
+        flint_free(W[w].qexps);
+#if FLINT_USES_PTHREAD
+        pthread_cond_destroy(&W[w].cond);
+#endif
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_cond_destroy(&H->cond);
+    pthread_mutex_destroy(&H->mutex);
+#endif
+
+    _pow_block_clear(M);
+
+    /* the old arrays share their coefficients with the current one */
+    for (i = 0; i < Gold_len; i++)
+    {
+        flint_free(Gexps_old[i]);
+        flint_free(Gcoeffs_old[i]);
+    }
+    _fmpz_vec_clear(Gcoeffs, Galloc);
+    flint_free(Gexps);
+    flint_free(Gexps_old);
+    flint_free(Gcoeffs_old);
+
+    fmpz_clear(t1);
+    fmpz_clear(t2);
+    fmpz_clear(C);
+
+    flint_free(W);
+    flint_free(wstate);
+    flint_free(fik);
+
+    return Alen;
+}
+
+void _fmpz_mpoly_pow_fps_threaded_pool(
+    fmpz_mpoly_t A,
+    const fmpz_mpoly_t B,
+    ulong k,
+    const fmpz_mpoly_ctx_t ctx,
+    const thread_pool_handle * handles,
+    slong num_handles)
+{
+    slong i, N, len;
+    fmpz * maxBfields;
+    flint_bitcnt_t Abits;
+    ulong * cmpmask;
+    ulong * Bexps;
+    int freeBexps;
+    TMP_INIT;
+
+    FLINT_ASSERT(k >= 2);
+    FLINT_ASSERT(B->length > 0);
+
+    if (num_handles < 1 || B->length < 8)
+    {
+        fmpz_mpoly_pow_fps(A, B, k, ctx);
+        return;
+    }
+
+    TMP_START;
+
+    maxBfields = (fmpz *) TMP_ALLOC(ctx->minfo->nfields*sizeof(fmpz));
+    for (i = 0; i < ctx->minfo->nfields; i++)
+        fmpz_init(maxBfields + i);
+
+    mpoly_max_fields_fmpz(maxBfields, B->exps, B->length, B->bits, ctx->minfo);
+    _fmpz_vec_scalar_mul_ui(maxBfields, maxBfields, ctx->minfo->nfields, k);
+
+    Abits = _fmpz_vec_max_bits(maxBfields, ctx->minfo->nfields);
+    Abits = FLINT_MAX(MPOLY_MIN_BITS, Abits + 1);
+    Abits = FLINT_MAX(Abits, B->bits);
+    Abits = mpoly_fix_bits(Abits, ctx->minfo);
+    N = mpoly_words_per_exp(Abits, ctx->minfo);
+
+    freeBexps = 0;
+    Bexps = B->exps;
+    if (Abits > B->bits)
+    {
+       freeBexps = 1;
+       Bexps = (ulong *) flint_malloc(N*B->length*sizeof(ulong));
+       mpoly_repack_monomials(Bexps, Abits, B->exps, B->bits,
+                                                        B->length, ctx->minfo);
+    }
+
+    cmpmask = (ulong*) TMP_ALLOC(N*sizeof(ulong));
+    mpoly_get_cmpmask(cmpmask, N, Abits, ctx->minfo);
+
+    if (A == B)
+    {
+        fmpz_mpoly_t T;
+        fmpz_mpoly_init3(T, k*(B->length - 1) + 1, Abits, ctx);
+        len = _fmpz_mpoly_pow_fps_threaded(T, B->coeffs, Bexps, B->length,
+                                     k, N, cmpmask, handles, num_handles);
+        fmpz_mpoly_swap(T, A, ctx);
+        fmpz_mpoly_clear(T, ctx);
+    }
+    else
+    {
+        fmpz_mpoly_fit_length_reset_bits(A, k*(B->length - 1) + 1, Abits, ctx);
+        len = _fmpz_mpoly_pow_fps_threaded(A, B->coeffs, Bexps, B->length,
+                                     k, N, cmpmask, handles, num_handles);
+    }
+
+    if (freeBexps)
+        flint_free(Bexps);
+
+    for (i = 0; i < ctx->minfo->nfields; i++)
+        fmpz_clear(maxBfields + i);
+
+    _fmpz_mpoly_set_length(A, len, ctx);
+
+    TMP_END;
+}
+
+void fmpz_mpoly_pow_fps_threaded(fmpz_mpoly_t A, const fmpz_mpoly_t B,
+                                           ulong k, const fmpz_mpoly_ctx_t ctx)
+{
+    thread_pool_handle * handles;
+    slong num_handles;
+    slong thread_limit = B->length/32;
+
+    num_handles = flint_request_threads(&handles, thread_limit);
+
+    _fmpz_mpoly_pow_fps_threaded_pool(A, B, k, ctx, handles, num_handles);
+
+    flint_give_back_threads(handles, num_handles);
+}
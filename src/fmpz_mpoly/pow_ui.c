@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_mpoly.h"
 
 int fmpz_mpoly_pow_ui(fmpz_mpoly_t A, const fmpz_mpoly_t B,
@@ -42,7 +43,21 @@ int fmpz_mpoly_pow_ui(fmpz_mpoly_t A, const fmpz_mpoly_t B,
         if (B->length > 1 && k > limit/(ulong)(B->length - 1))
             return 0;
 
-        fmpz_mpoly_pow_fps(A, B, k, ctx);
+        if (B->length >= 512)
+        {
+            thread_pool_handle * handles;
+            slong num_handles;
+
+            num_handles = flint_request_threads(&handles, B->length/256);
+            _fmpz_mpoly_pow_fps_threaded_pool(A, B, k, ctx,
+                                                        handles, num_handles);
+            flint_give_back_threads(handles, num_handles);
+        }
+        else
+        {
+            fmpz_mpoly_pow_fps(A, B, k, ctx);
+        }
+
         return 1;
     }
 }
@@ -0,0 +1,208 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+/* usage:
+make profile MOD=fmpz_mpoly && ./build/fmpz_mpoly/profile/p-monomial_cmp
+
+p-monomial_cmp [lex]:
+    For 10, 20 and 30 variables and exponent vectors of several words, heap
+    sort the monomials of a product with mpoly_monomial_gt and with a
+    version that uses SSE2 to find the first differing word two words at a
+    time, then time the heap multiplication and division that the
+    comparison is used in.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "profiler.h"
+#include "fmpz_mpoly.h"
+
+#if defined(__SSE2__) && FLINT64
+# include <emmintrin.h>
+#endif
+
+static int _monomial_gt_sse2(const ulong * exp3, const ulong * exp2,
+                                                slong N, const ulong * cmpmask)
+{
+    slong i = N - 1;
+#if defined(__SSE2__) && FLINT64
+    for ( ; i > 0; i -= 2)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *) (exp2 + i - 1));
+        __m128i b = _mm_loadu_si128((const __m128i *) (exp3 + i - 1));
+        unsigned int ne = 0xffff ^ _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (ne != 0)
+        {
+            i = (ne >> 8) != 0 ? i : i - 1;
+            return (exp3[i]^cmpmask[i]) > (exp2[i]^cmpmask[i]);
+        }
+    }
+#endif
+    for ( ; i >= 0; i--)
+    {
+        if (exp2[i] != exp3[i])
+            return (exp3[i]^cmpmask[i]) > (exp2[i]^cmpmask[i]);
+    }
+    return 0;
+}
+
+#define HEAP_SORT(NAME, GT)                                                  \
+static void NAME(slong * heap, slong * out, const ulong * exps, slong len,    \
+                                                slong N, const ulong * cmpmask)\
+{                                                                             \
+    slong i, j, n = 0, k;                                                     \
+    for (k = 0; k < len; k++)                                                 \
+    {                                                                         \
+        i = ++n;                                                              \
+        while ((j = i/2) >= 1 && GT(exps + N*k, exps + N*heap[j], N, cmpmask))\
+        {                                                                     \
+            heap[i] = heap[j];                                                \
+            i = j;                                                            \
+        }                                                                     \
+        heap[i] = k;                                                          \
+    }                                                                         \
+    for (k = 0; k < len; k++)                                                 \
+    {                                                                         \
+        slong x = heap[n--];                                                  \
+        out[k] = heap[1];                                                     \
+        i = 1;                                                                \
+        while ((j = 2*i) <= n)                                                \
+        {                                                                     \
+            if (j < n && GT(exps + N*heap[j + 1], exps + N*heap[j], N, cmpmask))\
+                j++;                                                          \
+            if (!GT(exps + N*heap[j], exps + N*x, N, cmpmask))                \
+                break;                                                        \
+            heap[i] = heap[j];                                                \
+            i = j;                                                            \
+        }                                                                     \
+        heap[i] = x;                                                          \
+    }                                                                         \
+}
+
+HEAP_SORT(heap_sort_scalar, mpoly_monomial_gt)
+HEAP_SORT(heap_sort_sse2, _monomial_gt_sse2)
+
+static void profile(slong nvars, flint_bitcnt_t bits, const ordering_t ord,
+                                                         flint_rand_t state)
+{
+    fmpz_mpoly_ctx_t ctx;
+    fmpz_mpoly_t A, B, C, Q;
+    timeit_t timer;
+    slong i, j, N, len, reps;
+    slong * heap, * out1, * out2;
+    ulong * exps, * cmpmask;
+
+    fmpz_mpoly_ctx_init(ctx, nvars, ord);
+    fmpz_mpoly_init(A, ctx);
+    fmpz_mpoly_init(B, ctx);
+    fmpz_mpoly_init(C, ctx);
+    fmpz_mpoly_init(Q, ctx);
+
+    fmpz_mpoly_randtest_bound(B, state, 800, 10, 3, ctx);
+    fmpz_mpoly_randtest_bound(C, state, 800, 10, 3, ctx);
+    fmpz_mpoly_repack_bits(B, B, bits, ctx);
+    fmpz_mpoly_repack_bits(C, C, bits, ctx);
+    fmpz_mpoly_mul_johnson(A, B, C, ctx);
+
+    N = mpoly_words_per_exp(A->bits, ctx->minfo);
+    len = A->length;
+    flint_printf("%2wd vars, %wd words, %wd terms:\n", nvars, N, len);
+
+    cmpmask = (ulong *) flint_malloc(N*sizeof(ulong));
+    mpoly_get_cmpmask(cmpmask, N, A->bits, ctx->minfo);
+
+    /* the monomials of A in random order */
+    exps = (ulong *) flint_malloc(N*len*sizeof(ulong));
+    heap = (slong *) flint_malloc((len + 1)*sizeof(slong));
+    out1 = (slong *) flint_malloc(len*sizeof(slong));
+    out2 = (slong *) flint_malloc(len*sizeof(slong));
+    for (i = 0; i < len; i++)
+        out1[i] = i;
+    for (i = len - 1; i > 0; i--)
+    {
+        slong t;
+        j = n_randint(state, i + 1);
+        t = out1[i]; out1[i] = out1[j]; out1[j] = t;
+    }
+    for (i = 0; i < len; i++)
+        mpoly_monomial_set(exps + N*i, A->exps + N*out1[i], N);
+
+    reps = 3;
+
+    timeit_start(timer);
+    for (i = 0; i < reps; i++)
+        heap_sort_scalar(heap, out1, exps, len, N, cmpmask);
+    timeit_stop(timer);
+    flint_printf("    heap sort, mpoly_monomial_gt: %wd ms\n", timer->cpu/reps);
+
+    timeit_start(timer);
+    for (i = 0; i < reps; i++)
+        heap_sort_sse2(heap, out2, exps, len, N, cmpmask);
+    timeit_stop(timer);
+    flint_printf("    heap sort, sse2: %wd ms\n", timer->cpu/reps);
+
+    for (i = 0; i < len; i++)
+    {
+        if (!mpoly_monomial_equal(exps + N*out1[i], exps + N*out2[i], N))
+        {
+            flint_printf("orders differ\n");
+            flint_abort();
+        }
+    }
+
+    timeit_start(timer);
+    fmpz_mpoly_mul_johnson(A, B, C, ctx);
+    timeit_stop(timer);
+    flint_printf("    mul_johnson: %wd ms\n", timer->cpu);
+
+    timeit_start(timer);
+    if (!fmpz_mpoly_divides_monagan_pearce(Q, A, B, ctx) ||
+        !fmpz_mpoly_equal(Q, C, ctx))
+    {
+        flint_printf("quotient wrong\n");
+        flint_abort();
+    }
+    timeit_stop(timer);
+    flint_printf("    divides_monagan_pearce: %wd ms\n", timer->cpu);
+
+    flint_free(cmpmask);
+    flint_free(exps);
+    flint_free(heap);
+    flint_free(out1);
+    flint_free(out2);
+    fmpz_mpoly_clear(A, ctx);
+    fmpz_mpoly_clear(B, ctx);
+    fmpz_mpoly_clear(C, ctx);
+    fmpz_mpoly_clear(Q, ctx);
+    fmpz_mpoly_ctx_clear(ctx);
+}
+
+int main(int argc, char * argv[])
+{
+    slong nvars;
+    flint_rand_t state;
+    ordering_t ord = ORD_DEGREVLEX;
+
+    if (argc > 1 && strcmp(argv[1], "lex") == 0)
+        ord = ORD_LEX;
+
+    flint_randinit(state);
+
+    for (nvars = 10; nvars <= 30; nvars += 10)
+    {
+        profile(nvars, 16, ord, state);
+        profile(nvars, 32, ord, state);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz.h"
+#include "fmpz_mod.h"
+#include "fmpz_mod_poly.h"
+#include "fmpz_mod_poly_factor.h"
+#include "fmpz_mpoly.h"
+
+/*
+    The sequence a_0, ..., a_{n-1} is assumed to be of the form
+
+        a_k = sum_{j < L} c_j*m_j^k,
+
+    where the m_j = p_0^e_{j,0} * ... * p_{nvars-1}^e_{j,nvars-1} are distinct
+    integers less than the modulus and V is a minimal generator for the
+    sequence (as returned by the Berlekamp-Massey algorithm). Recover the
+    monomials m_j from the roots of V and the coefficients c_j by a transposed
+    Vandermonde solve: with V = prod_j (x - m_j) monic and
+
+        S = a_0*x^(n-1) + a_1*x^(n-2) + ... + a_{n-1},
+
+    the polynomial part P of S*V/x^n is sum_j c_j*prod_{i != j} (x - m_i) so
+    that c_j = P(m_j)/V'(m_j).
+
+    If cands is not NULL, the m_j are known to lie among the ncands distinct
+    values in cands, and these are tested as roots of V directly, which is
+    much cheaper than root finding modulo a large prime.
+
+    The exponents e_{j,i} are written to exps[nvars*j + i], and the c_j to
+    coeffs[j]. Return 0 if V does not split into distinct roots or a root does
+    not factor over the p_i with e_{j,i} <= degbounds[i], 1 otherwise.
+*/
+int _fmpz_mpoly_sparse_interp_decode(
+    fmpz * coeffs,
+    ulong * exps,
+    const fmpz_mod_poly_t V,
+    const fmpz * seq,
+    slong n,
+    const fmpz * cands,
+    slong ncands,
+    const ulong * primes,
+    const ulong * degbounds,
+    slong nvars,
+    const fmpz_mod_ctx_t fctx)
+{
+    int success = 0;
+    slong i, j, L = fmpz_mod_poly_degree(V, fctx);
+    fmpz * roots, * vals;
+    fmpz_t t;
+    fmpz_mod_poly_t M, S, P;
+    fmpz_mod_poly_factor_t r;
+
+    if (L < 1)
+        return L == 0;
+
+    if (n < L)
+        return 0;
+
+    fmpz_init(t);
+    roots = _fmpz_vec_init(2*L);
+    vals = roots + L;
+    fmpz_mod_poly_init(M, fctx);
+    fmpz_mod_poly_init(S, fctx);
+    fmpz_mod_poly_init(P, fctx);
+    fmpz_mod_poly_factor_init(r, fctx);
+
+    fmpz_mod_poly_make_monic(M, V, fctx);
+
+    if (cands != NULL)
+    {
+        fmpz * cvals = _fmpz_vec_init(ncands);
+
+        fmpz_mod_poly_evaluate_fmpz_vec(cvals, M, cands, ncands, fctx);
+        for (i = 0, j = 0; i < ncands && j < L; i++)
+        {
+            if (fmpz_is_zero(cvals + i))
+                fmpz_set(roots + j++, cands + i);
+        }
+
+        _fmpz_vec_clear(cvals, ncands);
+
+        if (j != L)
+            goto cleanup;
+    }
+    else
+    {
+        fmpz_mod_poly_roots(r, M, 0, fctx);
+        if (r->num != L)
+            goto cleanup;
+
+        for (j = 0; j < L; j++)
+        {
+            FLINT_ASSERT(fmpz_mod_poly_degree(r->poly + j, fctx) == 1);
+            fmpz_mod_neg(roots + j, r->poly[j].coeffs + 0, fctx);
+            if (!fmpz_is_one(r->poly[j].coeffs + 1) &&
+                !fmpz_mod_divides(roots + j, roots + j,
+                                                 r->poly[j].coeffs + 1, fctx))
+            {
+                goto cleanup;
+            }
+        }
+    }
+
+    for (j = 0; j < L; j++)
+    {
+        if (fmpz_is_zero(roots + j))
+            goto cleanup;
+
+        fmpz_set(t, roots + j);
+        for (i = 0; i < nvars; i++)
+        {
+            ulong e = 0;
+            while (fmpz_divisible_si(t, primes[i]))
+            {
+                if (++e > degbounds[i])
+                    goto cleanup;
+                fmpz_divexact_ui(t, t, primes[i]);
+            }
+            exps[nvars*j + i] = e;
+        }
+
+        if (!fmpz_is_one(t))
+            goto cleanup;
+    }
+
+    fmpz_mod_poly_fit_length(S, n, fctx);
+    for (i = 0; i < n; i++)
+        fmpz_set(S->coeffs + n - 1 - i, seq + i);
+    _fmpz_mod_poly_set_length(S, n);
+    _fmpz_mod_poly_normalise(S);
+
+    fmpz_mod_poly_mul(P, S, M, fctx);
+    fmpz_mod_poly_shift_right(P, P, n, fctx);
+    fmpz_mod_poly_evaluate_fmpz_vec(coeffs, P, roots, L, fctx);
+
+    fmpz_mod_poly_derivative(S, M, fctx);
+    fmpz_mod_poly_evaluate_fmpz_vec(vals, S, roots, L, fctx);
+
+    for (j = 0; j < L; j++)
+    {
+        if (fmpz_is_zero(vals + j) || fmpz_is_zero(coeffs + j))
+            goto cleanup;
+        fmpz_mod_inv(t, vals + j, fctx);
+        fmpz_mod_mul(coeffs + j, coeffs + j, t, fctx);
+    }
+
+    success = 1;
+
+cleanup:
+
+    fmpz_clear(t);
+    _fmpz_vec_clear(roots, 2*L);
+    fmpz_mod_poly_clear(M, fctx);
+    fmpz_mod_poly_clear(S, fctx);
+    fmpz_mod_poly_clear(P, fctx);
+    fmpz_mod_poly_factor_clear(r, fctx);
+
+    return success;
+}
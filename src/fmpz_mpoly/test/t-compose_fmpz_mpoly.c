@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_mpoly.h"
 
 int
@@ -265,11 +266,15 @@ main(void)
         fmpz_mpoly_struct ** vals1;
         fmpz_t fe, ge;
         fmpz ** vals2, ** vals3;
+        thread_pool_handle * handles;
+        slong num_handles;
         slong nvars1, nvars2;
         slong len1, len2;
         slong exp_bound1, exp_bound2;
         slong coeff_bits1, coeff_bits2;
 
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
         fmpz_mpoly_ctx_init_rand(ctx1, state, 6);
         fmpz_mpoly_ctx_init_rand(ctx2, state, 6);
 
@@ -341,6 +346,18 @@ main(void)
         fmpz_mpoly_assert_canonical(g1, ctx2);
         fmpz_mpoly_assert_canonical(g2, ctx2);
 
+        num_handles = flint_request_threads(&handles, WORD_MAX);
+        if (!_fmpz_mpoly_compose_fmpz_mpoly_threaded_pool(g1, f, vals1,
+                                      ctx1, ctx2, handles, num_handles) ||
+            !fmpz_mpoly_equal(g, g1, ctx2))
+        {
+            printf("FAIL\n");
+            flint_printf("Check threaded composition\ni: %wd\n", i);
+            fflush(stdout);
+            flint_abort();
+        }
+        flint_give_back_threads(handles, num_handles);
+
         if (!fmpz_mpoly_evaluate_all_fmpz(fe, f, vals3, ctx1) ||
             !fmpz_mpoly_evaluate_all_fmpz(ge, g, vals2, ctx2))
         {
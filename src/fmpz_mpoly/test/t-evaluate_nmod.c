@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "fmpz_mpoly.h"
+
+int
+main(void)
+{
+    slong i, j, k;
+    const slong max_threads = 5;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("evaluate_nmod....");
+    fflush(stdout);
+
+    for (i = 0; i < 200 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t A;
+        fmpz_mpoly_evaluate_nmod_t E;
+        mp_limb_t * alphas, * evals, * evals2;
+        slong nvars, len, num;
+        flint_bitcnt_t coeff_bits, exp_bits;
+        nmod_t mod;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+        fmpz_mpoly_init(A, ctx);
+        nvars = ctx->minfo->nvars;
+
+        nmod_init(&mod, n_randprime(state, n_randint(state, FLINT_BITS - 1) + 2, 1));
+
+        len = n_randint(state, 100);
+        coeff_bits = n_randint(state, 200) + 1;
+        exp_bits = n_randint(state, 2) ? n_randint(state, 10) + 1
+                                       : n_randint(state, 200) + 1;
+        fmpz_mpoly_randtest_bits(A, state, len, coeff_bits, exp_bits, ctx);
+
+        num = n_randint(state, 300);
+        alphas = FLINT_ARRAY_ALLOC(nvars*num + 1, mp_limb_t);
+        evals = FLINT_ARRAY_ALLOC(num + 1, mp_limb_t);
+        evals2 = FLINT_ARRAY_ALLOC(num + 1, mp_limb_t);
+
+        for (j = 0; j < nvars*num; j++)
+        {
+            switch (n_randint(state, 8))
+            {
+                case 0: alphas[j] = 0; break;
+                case 1: alphas[j] = n_randtest(state); break;
+                default: alphas[j] = n_randint(state, mod.n);
+            }
+        }
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        if (n_randint(state, 2))
+        {
+            fmpz_mpoly_evaluate_all_nmod_vec(evals, A, alphas, num, ctx, mod);
+        }
+        else
+        {
+            fmpz_mpoly_evaluate_nmod_init(E, A, ctx, mod);
+            fmpz_mpoly_evaluate_nmod_vec(evals, E, alphas, num);
+            k = n_randint(state, num + 1);
+            fmpz_mpoly_evaluate_nmod_vec(evals2, E, alphas + nvars*k, num - k);
+            fmpz_mpoly_evaluate_nmod_clear(E);
+
+            for (j = k; j < num; j++)
+            {
+                if (evals2[j - k] != evals[j])
+                {
+                    flint_printf("FAIL: check reuse\n");
+                    flint_printf("i = %wd, j = %wd\n", i, j);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        for (j = 0; j < num; j++)
+        {
+            if (evals[j] != fmpz_mpoly_evaluate_all_nmod(A, alphas + nvars*j, ctx, mod))
+            {
+                flint_printf("FAIL: check evaluation\n");
+                flint_printf("i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_free(alphas);
+        flint_free(evals);
+        flint_free(evals2);
+        fmpz_mpoly_clear(A, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    flint_printf("PASS\n");
+    FLINT_TEST_CLEANUP(state);
+    return 0;
+}
@@ -0,0 +1,229 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz_mpoly.h"
+
+void gcd_check(
+    fmpz_mpoly_t g,
+    fmpz_mpoly_t a,
+    fmpz_mpoly_t b,
+    const fmpz_mpoly_t gdiv,
+    fmpz_mpoly_ctx_t ctx,
+    slong i,
+    slong j,
+    const char * name)
+{
+    int res;
+    fmpz_mpoly_t ca, cb, cg;
+
+    fmpz_mpoly_init(ca, ctx);
+    fmpz_mpoly_init(cb, ctx);
+    fmpz_mpoly_init(cg, ctx);
+
+    res = fmpz_mpoly_gcd_sparse_interp(g, a, b, ctx);
+
+    fmpz_mpoly_assert_canonical(g, ctx);
+
+    if (!res)
+    {
+        flint_printf("FAIL: Check gcd can be computed\n");
+        flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    if (!fmpz_mpoly_is_zero(gdiv, ctx))
+    {
+        if (!fmpz_mpoly_divides(ca, g, gdiv, ctx))
+        {
+            flint_printf("FAIL: Check divisor of gcd\n");
+            flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    if (fmpz_mpoly_is_zero(g, ctx))
+    {
+        if (!fmpz_mpoly_is_zero(a, ctx) || !fmpz_mpoly_is_zero(b, ctx))
+        {
+            flint_printf("FAIL: Check zero gcd\n");
+            flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+            fflush(stdout);
+            flint_abort();
+        }
+        goto cleanup;
+    }
+
+    if (fmpz_sgn(g->coeffs + 0) <= 0)
+    {
+        flint_printf("FAIL: Check gcd has positive lc\n");
+        flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    res = 1;
+    res = res && fmpz_mpoly_divides(ca, a, g, ctx);
+    res = res && fmpz_mpoly_divides(cb, b, g, ctx);
+    if (!res)
+    {
+        flint_printf("FAIL: Check divisibility\n");
+        flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    res = fmpz_mpoly_gcd_sparse_interp(cg, ca, cb, ctx);
+    fmpz_mpoly_assert_canonical(cg, ctx);
+
+    if (!res)
+    {
+        flint_printf("FAIL: Check gcd of cofactors can be computed\n");
+        flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    if (!fmpz_mpoly_is_one(cg, ctx))
+    {
+        flint_printf("FAIL: Check gcd of cofactors is one\n");
+        flint_printf("i = %wd, j = %wd, %s\n", i, j, name);
+        fflush(stdout);
+        flint_abort();
+    }
+
+cleanup:
+
+    fmpz_mpoly_clear(ca, ctx);
+    fmpz_mpoly_clear(cb, ctx);
+    fmpz_mpoly_clear(cg, ctx);
+}
+
+
+int
+main(void)
+{
+    slong i, j, tmul = 20;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("gcd_sparse_interp....");
+    fflush(stdout);
+
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t g, a, b, t;
+        const char* vars[] = {"y", "t", "x", "z"};
+
+        fmpz_mpoly_ctx_init(ctx, 4, ORD_DEGLEX);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(a, ctx);
+        fmpz_mpoly_init(b, ctx);
+        fmpz_mpoly_init(t, ctx);
+
+        fmpz_mpoly_set_str_pretty(t, "x+y+z+t", vars, ctx);
+        fmpz_mpoly_set_str_pretty(a, "x^2+y^2+z^2+t^2", vars, ctx);
+        fmpz_mpoly_set_str_pretty(b, "x^3+y^3+z^3+t^3", vars, ctx);
+        fmpz_mpoly_mul(a, a, t, ctx);
+        fmpz_mpoly_mul(b, b, t, ctx);
+        gcd_check(g, a, b, t, ctx, -1, 0, "example");
+
+        fmpz_mpoly_set_str_pretty(t, "y + t^2 + x^3 + z^4", vars, ctx);
+        fmpz_mpoly_set_str_pretty(a, "y*t + 1 + (x - z^5)*(y + t)", vars, ctx);
+        fmpz_mpoly_set_str_pretty(b, "y*t + 1 + (x - z^5)*(y - t + x)", vars, ctx);
+        fmpz_mpoly_mul(a, a, t, ctx);
+        fmpz_mpoly_mul(b, b, t, ctx);
+        gcd_check(g, a, b, t, ctx, -1, 1, "example");
+
+        fmpz_mpoly_set_str_pretty(t, "(1 + x^10)*t*y + t + x + z", vars, ctx);
+        fmpz_mpoly_set_str_pretty(a, "(1 + x + t)*(x - 33857*x^2 + 35153*z^4)*y*t + z + x*y", vars, ctx);
+        fmpz_mpoly_set_str_pretty(b, "(2*x - t^2)*(x - 33857*x^2 + 35153*z^4)*y^2*t + t*z + y", vars, ctx);
+        fmpz_mpoly_mul(a, a, t, ctx);
+        fmpz_mpoly_mul(b, b, t, ctx);
+        gcd_check(g, a, b, t, ctx, -1, 2, "non-monic leading coefficient");
+
+        fmpz_mpoly_set_str_pretty(t, "123456789012345678901234567890*y*x + 987654321098765432109876543210*t*z^2 - 1", vars, ctx);
+        fmpz_mpoly_set_str_pretty(a, "(y - 1)*(z + t + 1)*(x + 3)", vars, ctx);
+        fmpz_mpoly_set_str_pretty(b, "(y + 1)*(z - t)*(x^2 - 5)", vars, ctx);
+        fmpz_mpoly_mul(a, a, t, ctx);
+        fmpz_mpoly_mul(b, b, t, ctx);
+        gcd_check(g, a, b, t, ctx, -1, 3, "big coefficients");
+
+        fmpz_mpoly_set_str_pretty(t, "(y^2 + t)*(z - 1) + 7", vars, ctx);
+        fmpz_mpoly_set_str_pretty(a, "x*y + z", vars, ctx);
+        fmpz_mpoly_set_str_pretty(b, "x*t + z*y", vars, ctx);
+        fmpz_mpoly_mul(a, a, t, ctx);
+        fmpz_mpoly_mul(b, b, t, ctx);
+        gcd_check(g, a, b, t, ctx, -1, 4, "content");
+
+        fmpz_mpoly_clear(a, ctx);
+        fmpz_mpoly_clear(b, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(t, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t a, b, g, t;
+        flint_bitcnt_t coeff_bits;
+        slong len, len1, len2;
+        slong degbound;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 8);
+        if (ctx->minfo->nvars < 2)
+        {
+            fmpz_mpoly_ctx_clear(ctx);
+            continue;
+        }
+
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(a, ctx);
+        fmpz_mpoly_init(b, ctx);
+        fmpz_mpoly_init(t, ctx);
+
+        len = n_randint(state, 20) + 1;
+        len1 = n_randint(state, 20) + 1;
+        len2 = n_randint(state, 20) + 1;
+
+        degbound = 2 + 40/(2*ctx->minfo->nvars - 1);
+
+        coeff_bits = n_randint(state, 100);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_randtest_bound(a, state, len1, coeff_bits, degbound, ctx);
+            fmpz_mpoly_randtest_bound(b, state, len2, coeff_bits, degbound, ctx);
+            fmpz_mpoly_randtest_bound(t, state, len, coeff_bits + 1, degbound, ctx);
+            if (fmpz_mpoly_is_zero(t, ctx))
+                fmpz_mpoly_one(t, ctx);
+
+            fmpz_mpoly_mul(a, a, t, ctx);
+            fmpz_mpoly_mul(b, b, t, ctx);
+            fmpz_mpoly_randtest_bits(g, state, len, coeff_bits, FLINT_BITS, ctx);
+            gcd_check(g, a, b, t, ctx, i, j, "sparse");
+        }
+
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(a, ctx);
+        fmpz_mpoly_clear(b, ctx);
+        fmpz_mpoly_clear(t, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    flint_printf("PASS\n");
+    FLINT_TEST_CLEANUP(state);
+
+    return 0;
+}
+
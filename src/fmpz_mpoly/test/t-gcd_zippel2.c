@@ -113,6 +113,7 @@ int
 main(void)
 {
     slong i, j, tmul = 20;
+    const slong max_threads = 5;
     FLINT_TEST_INIT(state);
 
     flint_printf("gcd_zippel2....");
@@ -240,6 +241,7 @@ main(void)
             fmpz_mpoly_mul(a, a, t, ctx);
             fmpz_mpoly_mul(b, b, t, ctx);
             fmpz_mpoly_randtest_bits(g, state, len, coeff_bits, FLINT_BITS, ctx);
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
             gcd_check(g, a, b, t, ctx, i, j, "sparse");
         }
 
@@ -250,6 +252,49 @@ main(void)
         fmpz_mpoly_ctx_clear(ctx);
     }
 
+    /* larger gcds so that the images and the solves use several threads */
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t a, b, g, t;
+        flint_bitcnt_t coeff_bits;
+        slong len, len1, len2;
+
+        fmpz_mpoly_ctx_init(ctx, 3 + n_randint(state, 3), ORD_LEX);
+
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(a, ctx);
+        fmpz_mpoly_init(b, ctx);
+        fmpz_mpoly_init(t, ctx);
+
+        len = n_randint(state, 100) + 50;
+        len1 = n_randint(state, 20) + 1;
+        len2 = n_randint(state, 20) + 1;
+
+        coeff_bits = n_randint(state, 50);
+
+        for (j = 0; j < 2; j++)
+        {
+            fmpz_mpoly_randtest_bound(a, state, len1, coeff_bits, 8, ctx);
+            fmpz_mpoly_randtest_bound(b, state, len2, coeff_bits, 8, ctx);
+            fmpz_mpoly_randtest_bound(t, state, len, coeff_bits + 1, 8, ctx);
+            if (fmpz_mpoly_is_zero(t, ctx))
+                fmpz_mpoly_one(t, ctx);
+
+            fmpz_mpoly_mul(a, a, t, ctx);
+            fmpz_mpoly_mul(b, b, t, ctx);
+            fmpz_mpoly_randtest_bits(g, state, len, coeff_bits, FLINT_BITS, ctx);
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+            gcd_check(g, a, b, t, ctx, i, j, "threaded");
+        }
+
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(a, ctx);
+        fmpz_mpoly_clear(b, ctx);
+        fmpz_mpoly_clear(t, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
     flint_printf("PASS\n");
     FLINT_TEST_CLEANUP(state);
 
@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz_mpoly.h"
+
+int
+main(void)
+{
+    slong i, j;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_divides_workspace....");
+    fflush(stdout);
+
+    /* Check workspace versions match and reach a steady state */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h, k, q;
+        mpoly_workspace_t W;
+        slong len1, len2, alloc;
+        flint_bitcnt_t coeff_bits, exp_bits1, exp_bits2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 20);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+        fmpz_mpoly_init(k, ctx);
+        fmpz_mpoly_init(q, ctx);
+        mpoly_workspace_init(W);
+
+        for (j = 0; j < 4; j++)
+        {
+            len1 = n_randint(state, 100);
+            len2 = n_randint(state, 100) + 1;
+            exp_bits1 = n_randint(state, 200) + 2;
+            exp_bits2 = n_randint(state, 200) + 2;
+            coeff_bits = n_randint(state, 200);
+
+            fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            do {
+                fmpz_mpoly_randtest_bits(g, state, len2, coeff_bits + 1,
+                                                              exp_bits2, ctx);
+            } while (fmpz_mpoly_is_zero(g, ctx));
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_mul_johnson_workspace(k, f, g, ctx, W);
+            fmpz_mpoly_assert_canonical(k, ctx);
+
+            if (!fmpz_mpoly_equal(h, k, ctx))
+            {
+                flint_printf("FAIL\nCheck mul\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            if (!fmpz_mpoly_divides_monagan_pearce_workspace(q, k, g, ctx, W)
+                || !fmpz_mpoly_equal(q, f, ctx))
+            {
+                flint_printf("FAIL\nCheck divides\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            /* aliasing */
+            fmpz_mpoly_divides_monagan_pearce_workspace(k, k, g, ctx, W);
+            fmpz_mpoly_mul_johnson_workspace(k, k, g, ctx, W);
+            if (!fmpz_mpoly_equal(h, k, ctx))
+            {
+                flint_printf("FAIL\nCheck aliasing\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            /* the same computations again must fit in the workspace */
+            alloc = W->alloc;
+            fmpz_mpoly_mul_johnson_workspace(k, f, g, ctx, W);
+            fmpz_mpoly_divides_monagan_pearce_workspace(q, k, g, ctx, W);
+            if (W->alloc != alloc || W->extra != NULL ||
+                W->used != 0 || W->depth != 0)
+            {
+                flint_printf("FAIL\nCheck steady state\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        mpoly_workspace_clear(W);
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_clear(k, ctx);
+        fmpz_mpoly_clear(q, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check that the main block does not grow beyond the cap */
+    {
+        mpoly_workspace_t W;
+        slong mark;
+        char * p;
+
+        mpoly_workspace_init(W);
+
+        for (j = 0; j < 2; j++)
+        {
+            mark = mpoly_workspace_start(W);
+            p = (char *) mpoly_workspace_alloc(W, 1000);
+            p[999] = 1;
+            p = (char *) mpoly_workspace_alloc(W, MPOLY_WORKSPACE_MAX_ALLOC);
+            p[MPOLY_WORKSPACE_MAX_ALLOC - 1] = 1;
+            mpoly_workspace_end(W, mark);
+
+            if (W->alloc > MPOLY_WORKSPACE_MAX_ALLOC || W->extra != NULL ||
+                W->used != 0 || W->depth != 0 || W->overflow != 0)
+            {
+                flint_printf("FAIL\nCheck cap\nj = %wd\n", j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        mpoly_workspace_clear(W);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
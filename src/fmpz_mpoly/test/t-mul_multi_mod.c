@@ -0,0 +1,183 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "fmpz_mpoly.h"
+
+int
+main(void)
+{
+    slong i, j, max_threads = 5;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_multi_mod....");
+    fflush(stdout);
+
+    /* Check mul_multi_mod matches mul_johnson */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h, k;
+        slong len, len1, len2;
+        flint_bitcnt_t coeff_bits, exp_bits, exp_bits1, exp_bits2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+        fmpz_mpoly_init(k, ctx);
+
+        len = n_randint(state, 50);
+        len1 = n_randint(state, 50);
+        len2 = n_randint(state, 50);
+
+        exp_bits = n_randint(state, 200) + 2;
+        exp_bits1 = n_randint(state, 200) + 2;
+        exp_bits2 = n_randint(state, 200) + 2;
+
+        coeff_bits = n_randint(state, 400);
+
+        for (j = 0; j < 4; j++)
+        {
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+            fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            fmpz_mpoly_randtest_bits(g, state, len2, coeff_bits, exp_bits2, ctx);
+            fmpz_mpoly_randtest_bits(h, state, len, coeff_bits, exp_bits, ctx);
+            fmpz_mpoly_randtest_bits(k, state, len, coeff_bits, exp_bits, ctx);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_assert_canonical(h, ctx);
+            fmpz_mpoly_mul_multi_mod(k, f, g, ctx);
+            fmpz_mpoly_assert_canonical(k, ctx);
+
+            if (!fmpz_mpoly_equal(h, k, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check mul_multi_mod matches mul_johnson\n"
+                                                  "i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_clear(k, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check aliasing first argument */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h;
+        slong len1, len2;
+        flint_bitcnt_t coeff_bits, exp_bits1, exp_bits2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+
+        len1 = n_randint(state, 50);
+        len2 = n_randint(state, 50);
+
+        exp_bits1 = n_randint(state, 200) + 2;
+        exp_bits2 = n_randint(state, 200) + 2;
+
+        coeff_bits = n_randint(state, 400);
+
+        for (j = 0; j < 4; j++)
+        {
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+            fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            fmpz_mpoly_randtest_bits(g, state, len2, coeff_bits, exp_bits2, ctx);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_assert_canonical(h, ctx);
+            fmpz_mpoly_mul_multi_mod(f, f, g, ctx);
+            fmpz_mpoly_assert_canonical(f, ctx);
+
+            if (!fmpz_mpoly_equal(h, f, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check aliasing first argument\n"
+                                                  "i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check aliasing second argument */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h;
+        slong len1, len2;
+        flint_bitcnt_t coeff_bits, exp_bits1, exp_bits2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+
+        len1 = n_randint(state, 50);
+        len2 = n_randint(state, 50);
+
+        exp_bits1 = n_randint(state, 200) + 2;
+        exp_bits2 = n_randint(state, 200) + 2;
+
+        coeff_bits = n_randint(state, 400);
+
+        for (j = 0; j < 4; j++)
+        {
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+            fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            fmpz_mpoly_randtest_bits(g, state, len2, coeff_bits, exp_bits2, ctx);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_assert_canonical(h, ctx);
+            fmpz_mpoly_mul_multi_mod(g, f, g, ctx);
+            fmpz_mpoly_assert_canonical(g, ctx);
+
+            if (!fmpz_mpoly_equal(h, g, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check aliasing second argument\n"
+                                                  "i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz_mpoly.h"
+
+int
+main(void)
+{
+    int i, j, result, success;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_sparse_interp....");
+    fflush(stdout);
+
+    /* Check mul_sparse_interp matches mul_johnson */
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h, k;
+        slong len, len1, len2;
+        flint_bitcnt_t coeff_bits;
+        slong exp_bound, exp_bound1, exp_bound2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 5);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+        fmpz_mpoly_init(k, ctx);
+
+        len = n_randint(state, 50);
+        len1 = n_randint(state, 30);
+        len2 = n_randint(state, 30);
+
+        exp_bound = UWORD(1) << (FLINT_BITS - 1);
+        exp_bound1 = n_randint(state, 30) + 1;
+        exp_bound2 = n_randint(state, 30) + 1;
+
+        coeff_bits = n_randint(state, 100);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_randtest_bound(f, state, len1, coeff_bits, exp_bound1, ctx);
+            fmpz_mpoly_randtest_bound(g, state, len2, coeff_bits, exp_bound2, ctx);
+            fmpz_mpoly_randtest_bound(h, state, len, coeff_bits, exp_bound, ctx);
+            fmpz_mpoly_randtest_bound(k, state, len, coeff_bits, exp_bound, ctx);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_assert_canonical(h, ctx);
+            success = fmpz_mpoly_mul_sparse_interp(k, f, g, ctx);
+            if (!success)
+                continue;
+            fmpz_mpoly_assert_canonical(k, ctx);
+            result = fmpz_mpoly_equal(h, k, ctx);
+
+            if (!result)
+            {
+                printf("FAIL\n");
+                flint_printf("Check mul_sparse_interp matches mul_johnson\ni = %wd, j = %wd\n", i ,j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_clear(k, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check aliasing */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h;
+        slong len1, len2;
+        flint_bitcnt_t coeff_bits;
+        slong exp_bound1, exp_bound2;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 5);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+
+        len1 = n_randint(state, 30);
+        len2 = n_randint(state, 30);
+
+        exp_bound1 = n_randint(state, 30) + 1;
+        exp_bound2 = n_randint(state, 30) + 1;
+
+        coeff_bits = n_randint(state, 100);
+
+        for (j = 0; j < 4; j++)
+        {
+            fmpz_mpoly_randtest_bound(f, state, len1, coeff_bits, exp_bound1, ctx);
+            fmpz_mpoly_randtest_bound(g, state, len2, coeff_bits, exp_bound2, ctx);
+
+            fmpz_mpoly_mul_johnson(h, f, g, ctx);
+            fmpz_mpoly_assert_canonical(h, ctx);
+            if (j & 1)
+                success = fmpz_mpoly_mul_sparse_interp(f, f, g, ctx);
+            else
+                success = fmpz_mpoly_mul_sparse_interp(g, f, g, ctx);
+            if (!success)
+                continue;
+            result = fmpz_mpoly_equal(h, (j & 1) ? f : g, ctx);
+
+            if (!result)
+            {
+                printf("FAIL\n");
+                flint_printf("Check aliasing\ni = %wd, j = %wd\n", i ,j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
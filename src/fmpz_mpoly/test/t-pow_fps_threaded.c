@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "fmpz_mpoly.h"
+
+int
+main(void)
+{
+    slong i, j, max_threads = 5;
+    slong tmul = 10;
+    FLINT_TEST_INIT(state);
+#ifdef _WIN32
+    tmul = 2;
+#endif
+
+    flint_printf("pow_fps_threaded....");
+    fflush(stdout);
+
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, h1, h2;
+        const char * vars[] = {"x", "y" ,"z", "t", "u"};
+
+        fmpz_mpoly_ctx_init(ctx, 5, ORD_DEGREVLEX);
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(h1, ctx);
+        fmpz_mpoly_init(h2, ctx);
+        fmpz_mpoly_set_str_pretty(f, "(1+x+y+2*z^2+3*t^3+5*u^5)^3", vars, ctx);
+
+        flint_set_num_threads(1);
+        fmpz_mpoly_pow_fps(h1, f, 4, ctx);
+        flint_set_num_threads(3);
+        fmpz_mpoly_pow_fps_threaded(h2, f, 4, ctx);
+
+        if (!fmpz_mpoly_equal(h1, h2, ctx))
+        {
+            printf("FAIL\n");
+            flint_printf("Check example\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(h1, ctx);
+        fmpz_mpoly_clear(h2, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check pow_fps_threaded matches pow_fps */
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g, h;
+        slong len, len1;
+        ulong pow;
+        flint_bitcnt_t coeff_bits, exp_bits, exp_bits1;
+        thread_pool_handle * handles;
+        slong num_handles;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+        fmpz_mpoly_init(h, ctx);
+
+        len = n_randint(state, 100);
+        len1 = n_randint(state, 60) + 1;
+
+        pow = 2 + n_randint(state, 1 + 60/(len1 + 20));
+
+        exp_bits = n_randint(state, 200) + 2;
+        exp_bits1 = n_randint(state, 200) + 2;
+        exp_bits1 = n_randint(state, exp_bits1) + 2;
+
+        coeff_bits = n_randint(state, 100) + 1;
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        for (j = 0; j < 4; j++)
+        {
+            do {
+                fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            } while (f->length < 1);
+            fmpz_mpoly_randtest_bits(g, state, len, coeff_bits, exp_bits, ctx);
+            fmpz_mpoly_randtest_bits(h, state, len, coeff_bits, exp_bits, ctx);
+
+            fmpz_mpoly_pow_fps(g, f, pow, ctx);
+            fmpz_mpoly_assert_canonical(g, ctx);
+
+            num_handles = flint_request_threads(&handles, WORD_MAX);
+            _fmpz_mpoly_pow_fps_threaded_pool(h, f, pow, ctx, handles, num_handles);
+            flint_give_back_threads(handles, num_handles);
+            fmpz_mpoly_assert_canonical(h, ctx);
+
+            if (!fmpz_mpoly_equal(g, h, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check pow_fps_threaded matches pow_fps\n");
+                flint_printf("i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_clear(h, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check aliasing */
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t f, g;
+        slong len1;
+        ulong pow;
+        flint_bitcnt_t coeff_bits, exp_bits1;
+        thread_pool_handle * handles;
+        slong num_handles;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 10);
+
+        fmpz_mpoly_init(f, ctx);
+        fmpz_mpoly_init(g, ctx);
+
+        len1 = n_randint(state, 40) + 1;
+        pow = 2 + n_randint(state, 2);
+        exp_bits1 = n_randint(state, 100) + 2;
+        coeff_bits = n_randint(state, 100) + 1;
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        for (j = 0; j < 4; j++)
+        {
+            do {
+                fmpz_mpoly_randtest_bits(f, state, len1, coeff_bits, exp_bits1, ctx);
+            } while (f->length < 1);
+
+            fmpz_mpoly_pow_fps(g, f, pow, ctx);
+
+            num_handles = flint_request_threads(&handles, WORD_MAX);
+            _fmpz_mpoly_pow_fps_threaded_pool(f, f, pow, ctx, handles, num_handles);
+            flint_give_back_threads(handles, num_handles);
+            fmpz_mpoly_assert_canonical(f, ctx);
+
+            if (!fmpz_mpoly_equal(f, g, ctx))
+            {
+                printf("FAIL\n");
+                flint_printf("Check aliasing\n");
+                flint_printf("i = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_mpoly_clear(f, ctx);
+        fmpz_mpoly_clear(g, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,437 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <math.h>
+#include "ulong_extras.h"
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_mod.h"
+#include "fmpz_mod_poly.h"
+#include "fmpz_mpoly.h"
+#include "fmpz_mpoly_factor.h"
+
+/*
+    Terms of an mpolyl prepared for evaluation on the geometric sequence
+    x_i = beta_i*p_i^k (i >= 1) modulo q: the value of term j at the k-th
+    point is cur[j]*mult[j]^k, which is stepped by one multiplication.
+*/
+typedef struct {
+    slong length;
+    ulong * x0exps;
+    fmpz * mons;    /* prod_{i>=1} p_i^e_i as integers */
+    fmpz * cur;
+    fmpz * mult;
+} _geom_terms_struct;
+
+typedef _geom_terms_struct _geom_terms_t[1];
+
+static void _geom_terms_init(
+    _geom_terms_t E,
+    const fmpz_mpoly_t A,
+    const ulong * primes,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    slong i, j, nvars = ctx->minfo->nvars;
+    slong N = mpoly_words_per_exp(A->bits, ctx->minfo);
+    ulong * exps = FLINT_ARRAY_ALLOC(nvars, ulong);
+    fmpz_t t;
+
+    fmpz_init(t);
+
+    E->length = A->length;
+    E->x0exps = FLINT_ARRAY_ALLOC(A->length, ulong);
+    E->mons = _fmpz_vec_init(3*A->length);
+    E->cur = E->mons + A->length;
+    E->mult = E->cur + A->length;
+
+    for (i = 0; i < A->length; i++)
+    {
+        mpoly_get_monomial_ui(exps, A->exps + N*i, A->bits, ctx->minfo);
+        E->x0exps[i] = exps[0];
+        fmpz_one(E->mons + i);
+        for (j = 1; j < nvars; j++)
+        {
+            fmpz_ui_pow_ui(t, primes[j - 1], exps[j]);
+            fmpz_mul(E->mons + i, E->mons + i, t);
+        }
+    }
+
+    fmpz_clear(t);
+    flint_free(exps);
+}
+
+static void _geom_terms_clear(_geom_terms_t E)
+{
+    flint_free(E->x0exps);
+    _fmpz_vec_clear(E->mons, 3*E->length);
+}
+
+/* start over at k = 0 with new betas and modulus */
+static void _geom_terms_start(
+    _geom_terms_t E,
+    const fmpz_mpoly_t A,
+    const fmpz * betas,
+    const fmpz_mpoly_ctx_t ctx,
+    const fmpz_mod_ctx_t fctx)
+{
+    slong i, j, nvars = ctx->minfo->nvars;
+    slong N = mpoly_words_per_exp(A->bits, ctx->minfo);
+    ulong * exps = FLINT_ARRAY_ALLOC(nvars, ulong);
+    fmpz_t t;
+
+    fmpz_init(t);
+
+    for (i = 0; i < A->length; i++)
+    {
+        mpoly_get_monomial_ui(exps, A->exps + N*i, A->bits, ctx->minfo);
+        fmpz_mod_set_fmpz(E->cur + i, A->coeffs + i, fctx);
+        for (j = 1; j < nvars; j++)
+        {
+            fmpz_mod_pow_ui(t, betas + j - 1, exps[j], fctx);
+            fmpz_mod_mul(E->cur + i, E->cur + i, t, fctx);
+        }
+        fmpz_mod_set_fmpz(E->mult + i, E->mons + i, fctx);
+    }
+
+    fmpz_clear(t);
+    flint_free(exps);
+}
+
+/* E(x0) at the current point, then move to the next point */
+static void _geom_terms_eval_step(
+    fmpz_mod_poly_t e,
+    _geom_terms_t E,
+    const fmpz_mod_ctx_t fctx)
+{
+    slong i;
+
+    fmpz_mod_poly_zero(e, fctx);
+    for (i = 0; i < E->length; i++)
+    {
+        slong d = E->x0exps[i];
+
+        fmpz_mod_poly_fit_length(e, d + 1, fctx);
+        while (e->length <= d)
+            fmpz_zero(e->coeffs + e->length++);
+        fmpz_mod_add(e->coeffs + d, e->coeffs + d, E->cur + i, fctx);
+        fmpz_mod_mul(E->cur + i, E->cur + i, E->mult + i, fctx);
+    }
+
+    _fmpz_mod_poly_normalise(e);
+}
+
+/*
+    Ben-Or/Tiwari sparse interpolation gcd.
+
+    A and B are primitive with respect to x0 and Gamma is the gcd of their
+    leading coefficients in x0. H = Gamma/lc(G)*G is recovered by evaluating
+    x1, ..., x_{n-1} on the geometric sequence (beta_i*p_i^k) modulo a large
+    prime q, where the p_i are the first primes and the beta_i are random: the
+    values of each x0-coefficient of H on this sequence are a linear recurrent
+    sequence whose generator, found by the Berlekamp-Massey algorithm, has the
+    integers prod_i p_i^e_i of the monomials of the coefficient as roots.
+    The number of terms is found by early termination. The prime is chosen
+    larger than any monomial of H so that no CRT is needed for the exponents,
+    and the coefficient bound is doubled on failure.
+
+    The final answer is checked by division: pp(H) has x0-degree at least
+    deg_x0(G), so if it divides both A and B it is the gcd.
+*/
+int fmpz_mpolyl_gcd_sparse_interp(
+    fmpz_mpoly_t G,
+    fmpz_mpoly_t Abar,
+    fmpz_mpoly_t Bbar,
+    const fmpz_mpoly_t A,
+    const fmpz_mpoly_t B,
+    const fmpz_mpoly_t Gamma,
+    const fmpz_mpoly_ctx_t ctx)
+{
+    int success = 0;
+    slong i, j, k, d, n, L, T, Tbound, npoints, attempt;
+    slong nvars = ctx->minfo->nvars;
+    slong * Adegs, * Bdegs, * Gammadegs;
+    ulong * primes, * degbounds, * texps, * hexps;
+    double bits_est;
+    flint_bitcnt_t cbits;
+    fmpz * betas, * tcoeffs;
+    fmpz_t q, Mbound, t;
+    fmpz_mod_ctx_t fctx;
+    fmpz_mod_poly_t Aev, Bev, Gev, Gammaev;
+    fmpz_mod_berlekamp_massey_struct * bmas;
+    _geom_terms_t AE, BE, GammaE;
+    fmpz_mpoly_t H, c;
+    flint_rand_t state;
+
+    FLINT_ASSERT(nvars >= 2);
+    FLINT_ASSERT(A->length > 0 && B->length > 0);
+    FLINT_ASSERT(A->bits <= FLINT_BITS && B->bits <= FLINT_BITS);
+    FLINT_ASSERT(Gamma->bits <= FLINT_BITS);
+
+    n = nvars - 1;
+
+    Adegs = FLINT_ARRAY_ALLOC(3*nvars, slong);
+    Bdegs = Adegs + nvars;
+    Gammadegs = Bdegs + nvars;
+    primes = FLINT_ARRAY_ALLOC(2*n + nvars, ulong);
+    degbounds = primes + n;
+    hexps = degbounds + n;
+
+    fmpz_mpoly_degrees_si(Adegs, A, ctx);
+    fmpz_mpoly_degrees_si(Bdegs, B, ctx);
+    fmpz_mpoly_degrees_si(Gammadegs, Gamma, ctx);
+
+    /* degree bounds for H in x1, ..., x_{n-1} and the number of its terms */
+    bits_est = 0;
+    Tbound = 1;
+    for (i = 0; i < n; i++)
+    {
+        primes[i] = n_nth_prime(i + 1);
+        degbounds[i] = FLINT_MIN(Adegs[i + 1], Bdegs[i + 1]) +
+                                                  FLINT_MAX(Gammadegs[i + 1], 0);
+        bits_est += degbounds[i]*log2(primes[i]);
+        if (Tbound <= WORD_MAX/4/(slong)(degbounds[i] + 1))
+            Tbound *= (slong)(degbounds[i] + 1);
+        else
+            Tbound = WORD_MAX/4;
+    }
+
+    if (bits_est > FMPZ_MPOLY_SPARSE_INTERP_MAX_BITS)
+    {
+        flint_free(Adegs);
+        flint_free(primes);
+        return 0;
+    }
+
+    fmpz_init(q);
+    fmpz_init(Mbound);
+    fmpz_init(t);
+
+    fmpz_one(Mbound);
+    for (i = 0; i < n; i++)
+    {
+        fmpz_ui_pow_ui(t, primes[i], degbounds[i]);
+        fmpz_mul(Mbound, Mbound, t);
+    }
+
+    cbits = FLINT_MAX(FLINT_ABS(fmpz_mpoly_max_bits(A)),
+                      FLINT_ABS(fmpz_mpoly_max_bits(B)));
+    cbits += FLINT_ABS(fmpz_mpoly_max_bits(Gamma)) + FLINT_BITS;
+
+    flint_randinit(state);
+    fmpz_set_ui(q, 2);
+    fmpz_mod_ctx_init(fctx, q);
+    fmpz_mpoly_init(H, ctx);
+    fmpz_mpoly_init(c, ctx);
+    betas = _fmpz_vec_init(n);
+
+    _geom_terms_init(AE, A, primes, ctx);
+    _geom_terms_init(BE, B, primes, ctx);
+    _geom_terms_init(GammaE, Gamma, primes, ctx);
+
+    T = 8;
+
+    for (attempt = 0; attempt < 8 && !success; attempt++)
+    {
+        fmpz_randprime(q, state, FLINT_MAX(cbits, fmpz_bits(Mbound)) + 2, 0);
+        fmpz_mod_ctx_set_modulus(fctx, q);
+
+        for (i = 0; i < n; i++)
+        {
+            fmpz_sub_ui(t, q, 1);
+            fmpz_randm(betas + i, state, t);
+            fmpz_add_ui(betas + i, betas + i, 1);
+        }
+
+        _geom_terms_start(AE, A, betas, ctx, fctx);
+        _geom_terms_start(BE, B, betas, ctx, fctx);
+        _geom_terms_start(GammaE, Gamma, betas, ctx, fctx);
+
+        fmpz_mod_poly_init(Aev, fctx);
+        fmpz_mod_poly_init(Bev, fctx);
+        fmpz_mod_poly_init(Gev, fctx);
+        fmpz_mod_poly_init(Gammaev, fctx);
+
+        d = -1;
+        bmas = NULL;
+        npoints = 0;
+
+        while (1)
+        {
+            for ( ; npoints < 2*T; npoints++)
+            {
+                _geom_terms_eval_step(Aev, AE, fctx);
+                _geom_terms_eval_step(Bev, BE, fctx);
+                _geom_terms_eval_step(Gammaev, GammaE, fctx);
+
+                /* unlucky if a leading coefficient vanishes */
+                if (fmpz_mod_poly_degree(Aev, fctx) != Adegs[0] ||
+                    fmpz_mod_poly_degree(Bev, fctx) != Bdegs[0])
+                {
+                    goto attempt_done;
+                }
+
+                fmpz_mod_poly_gcd(Gev, Aev, Bev, fctx);
+
+                if (fmpz_mod_poly_degree(Gev, fctx) == 0)
+                {
+                    /* A and B are primitive: the gcd is one */
+                    fmpz_mpoly_one(G, ctx);
+                    fmpz_mpoly_set(Abar, A, ctx);
+                    fmpz_mpoly_set(Bbar, B, ctx);
+                    success = 1;
+                    goto attempt_done;
+                }
+
+                if (d < 0)
+                {
+                    d = fmpz_mod_poly_degree(Gev, fctx);
+                    bmas = FLINT_ARRAY_ALLOC(d + 1, fmpz_mod_berlekamp_massey_struct);
+                    for (k = 0; k <= d; k++)
+                        fmpz_mod_berlekamp_massey_init(bmas + k, fctx);
+                }
+                else if (d != fmpz_mod_poly_degree(Gev, fctx))
+                {
+                    goto attempt_done;
+                }
+
+                /* Gamma divides the leading coefficients and is constant in x0 */
+                FLINT_ASSERT(Gammaev->length == 1);
+                fmpz_mod_poly_scalar_mul_fmpz(Gev, Gev, Gammaev->coeffs + 0, fctx);
+                for (k = 0; k <= d; k++)
+                    fmpz_mod_berlekamp_massey_add_point(bmas + k,
+                                                        Gev->coeffs + k, fctx);
+            }
+
+            L = 0;
+            for (k = 0; k <= d; k++)
+            {
+                fmpz_mod_berlekamp_massey_reduce(bmas + k, fctx);
+                L = FLINT_MAX(L, fmpz_mod_poly_degree(
+                                fmpz_mod_berlekamp_massey_V_poly(bmas + k), fctx));
+            }
+
+            if (T < Tbound && 2*L + 4 > npoints)
+            {
+                T = FLINT_MIN(2*T, Tbound);
+                continue;
+            }
+
+            /* decode H */
+            fmpz_mpoly_zero(H, ctx);
+            tcoeffs = _fmpz_vec_init(L);
+            texps = FLINT_ARRAY_ALLOC(n*L + 1, ulong);
+
+            for (k = d; k >= 0; k--)
+            {
+                const fmpz_mod_poly_struct * V =
+                                    fmpz_mod_berlekamp_massey_V_poly(bmas + k);
+
+                if (!_fmpz_mpoly_sparse_interp_decode(tcoeffs, texps, V,
+                        fmpz_mod_berlekamp_massey_points(bmas + k), npoints,
+                                   NULL, 0, primes, degbounds, n, fctx))
+                {
+                    break;
+                }
+
+                hexps[0] = k;
+                for (j = 0; j < fmpz_mod_poly_degree(V, fctx); j++)
+                {
+                    /* undo the scaling by the betas */
+                    for (i = 0; i < n; i++)
+                    {
+                        hexps[i + 1] = texps[n*j + i];
+                        fmpz_mod_pow_ui(t, betas + i, hexps[i + 1], fctx);
+                        fmpz_mod_inv(t, t, fctx);
+                        fmpz_mod_mul(tcoeffs + j, tcoeffs + j, t, fctx);
+                    }
+                    fmpz_smod(tcoeffs + j, tcoeffs + j, q);
+                    fmpz_mpoly_push_term_fmpz_ui(H, tcoeffs + j, hexps, ctx);
+                }
+            }
+
+            _fmpz_vec_clear(tcoeffs, L);
+            flint_free(texps);
+
+            if (k >= 0)
+            {
+                /* wrong term count, or the generator is exact and q small */
+                if (T < Tbound)
+                {
+                    T = FLINT_MIN(2*T, Tbound);
+                    continue;
+                }
+
+                cbits *= 2;
+                goto attempt_done;
+            }
+
+            fmpz_mpoly_sort_terms(H, ctx);
+
+            if (fmpz_mpoly_is_zero(H, ctx) ||
+                !fmpz_mpolyl_content(c, H, 1, ctx) ||
+                !fmpz_mpoly_divides(G, H, c, ctx))
+            {
+                cbits *= 2;
+                goto attempt_done;
+            }
+
+            if (fmpz_sgn(G->coeffs + 0) < 0)
+                fmpz_mpoly_neg(G, G, ctx);
+
+            if (fmpz_mpoly_degree_si(G, 0, ctx) == d &&
+                fmpz_mpoly_divides(Abar, A, G, ctx) &&
+                fmpz_mpoly_divides(Bbar, B, G, ctx))
+            {
+                success = 1;
+                goto attempt_done;
+            }
+
+            /* either the term count or the coefficient bound was too small */
+            T = FLINT_MIN(2*T, Tbound);
+            cbits *= 2;
+            goto attempt_done;
+        }
+
+attempt_done:
+
+        if (bmas != NULL)
+        {
+            for (k = 0; k <= d; k++)
+                fmpz_mod_berlekamp_massey_clear(bmas + k, fctx);
+            flint_free(bmas);
+        }
+
+        fmpz_mod_poly_clear(Aev, fctx);
+        fmpz_mod_poly_clear(Bev, fctx);
+        fmpz_mod_poly_clear(Gev, fctx);
+        fmpz_mod_poly_clear(Gammaev, fctx);
+    }
+
+    _geom_terms_clear(AE);
+    _geom_terms_clear(BE);
+    _geom_terms_clear(GammaE);
+
+    _fmpz_vec_clear(betas, n);
+    fmpz_mpoly_clear(H, ctx);
+    fmpz_mpoly_clear(c, ctx);
+    fmpz_mod_ctx_clear(fctx);
+    flint_randclear(state);
+
+    fmpz_clear(q);
+    fmpz_clear(Mbound);
+    fmpz_clear(t);
+
+    flint_free(Adegs);
+    flint_free(primes);
+
+    return success;
+}
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_mpoly_factor.h"
 #include "fmpz_mod_mpoly_factor.h"
 #include "fmpz_mod_vec.h"
@@ -1458,6 +1459,282 @@ static int zip_solve(
 }
 
 
+/*
+    The zip images at alpha^1, alpha^2, ... are independent of each other.
+    They are computed in parallel in contiguous blocks, each block starting
+    from its own power of the monomial evaluations, and are then fed to the
+    interpolation in order. A block stops at its first image that does not
+    have the expected bidegree, since the images after it are not needed.
+*/
+typedef struct
+{
+    const n_polyun_struct * Ainc, * Acoeff;
+    const n_polyun_struct * Binc, * Bcoeff;
+    const n_poly_struct * Gammainc, * Gammacoeff;
+    nmod_t ctx;
+    ulong Abidegree, Bbidegree, GdegboundXY;
+    int which_check;
+    n_polyun_struct * images;
+    ulong * degs;   /* UWORD_MAX for an unusable image */
+}
+_zip_images_base_struct;
+
+typedef struct
+{
+    _zip_images_base_struct * base;
+    slong start, stop;
+}
+_zip_images_arg_struct;
+
+/* A = B^e coefficientwise */
+static void n_polyun_mod_pow_ui(n_polyun_t A, const n_polyun_t B, ulong e,
+                                                                   nmod_t ctx)
+{
+    slong i, j;
+
+    n_polyun_set(A, B);
+    for (i = 0; i < A->length; i++)
+        for (j = 0; j < A->coeffs[i].length; j++)
+            A->coeffs[i].coeffs[j] = nmod_pow_ui(A->coeffs[i].coeffs[j], e, ctx);
+}
+
+static void _zip_images_worker(void * varg)
+{
+    _zip_images_arg_struct * arg = (_zip_images_arg_struct *) varg;
+    _zip_images_base_struct * base = arg->base;
+    nmod_t ctx = base->ctx;
+    n_poly_polyun_stack_t St;
+    n_polyun_t Acur, Bcur, Aeval, Beval, Geval, Abareval, Bbareval;
+    n_poly_t Gammacur, Gammainc, Gammacoeff;
+    mp_limb_t Gammaeval;
+    slong i, k;
+
+    n_poly_stack_init(St->poly_stack);
+    n_polyun_stack_init(St->polyun_stack);
+    n_polyun_init(Acur);
+    n_polyun_init(Bcur);
+    n_polyun_init(Aeval);
+    n_polyun_init(Beval);
+    n_polyun_init(Geval);
+    n_polyun_init(Abareval);
+    n_polyun_init(Bbareval);
+    n_poly_init(Gammacur);
+    n_poly_init(Gammainc);
+    n_poly_init(Gammacoeff);
+
+    n_polyun_mod_pow_ui(Acur, base->Ainc, arg->start + 1, ctx);
+    n_polyun_mod_pow_ui(Bcur, base->Binc, arg->start + 1, ctx);
+    n_poly_set(Gammainc, base->Gammainc);
+    n_poly_set(Gammacoeff, base->Gammacoeff);
+    n_poly_set(Gammacur, Gammainc);
+    for (i = 0; i < Gammacur->length; i++)
+        Gammacur->coeffs[i] = nmod_pow_ui(Gammacur->coeffs[i], arg->start + 1, ctx);
+
+    for (k = arg->start; k < arg->stop; k++)
+    {
+        base->degs[k] = UWORD_MAX;
+
+        n_polyun_mod_zip_eval_cur_inc_coeff(Aeval, Acur, base->Ainc, base->Acoeff, ctx);
+        n_polyun_mod_zip_eval_cur_inc_coeff(Beval, Bcur, base->Binc, base->Bcoeff, ctx);
+        Gammaeval = n_poly_mod_zip_eval_cur_inc_coeff(Gammacur, Gammainc, Gammacoeff, ctx);
+
+        if (Aeval->length < 1 || Beval->length < 1 ||
+            n_polyu1n_bidegree(Aeval) != base->Abidegree ||
+            n_polyu1n_bidegree(Beval) != base->Bbidegree)
+        {
+            break;
+        }
+
+        FLINT_ASSERT(Gammaeval != 0);
+
+        if (!n_polyu1n_mod_gcd_brown_smprime(Geval, Abareval, Bbareval,
+                                                       Aeval, Beval, ctx, St))
+        {
+            break;
+        }
+
+        FLINT_ASSERT(Geval->length > 0);
+        base->degs[k] = n_polyu1n_bidegree(Geval);
+        if (base->degs[k] != base->GdegboundXY)
+            break;
+
+        _n_poly_vec_mul_nmod_intertible(Geval->coeffs, Geval->length,
+                                                               Gammaeval, ctx);
+
+        n_polyun_swap(base->images + k, base->which_check == 1 ? Abareval :
+                                base->which_check == 2 ? Bbareval : Geval);
+    }
+
+    n_poly_stack_clear(St->poly_stack);
+    n_polyun_stack_clear(St->polyun_stack);
+    n_polyun_clear(Acur);
+    n_polyun_clear(Bcur);
+    n_polyun_clear(Aeval);
+    n_polyun_clear(Beval);
+    n_polyun_clear(Geval);
+    n_polyun_clear(Abareval);
+    n_polyun_clear(Bbareval);
+    n_poly_clear(Gammacur);
+    n_poly_clear(Gammainc);
+    n_poly_clear(Gammacoeff);
+}
+
+static void _zip_images(_zip_images_base_struct * base, slong num_images)
+{
+    thread_pool_handle * handles;
+    slong i, num_handles, num_workers;
+    _zip_images_arg_struct * args;
+
+    num_handles = flint_request_threads(&handles, num_images/2);
+    num_workers = num_handles + 1;
+
+    args = FLINT_ARRAY_ALLOC(num_workers, _zip_images_arg_struct);
+    for (i = 0; i < num_workers; i++)
+    {
+        args[i].base = base;
+        args[i].start = i*num_images/num_workers;
+        args[i].stop = (i + 1)*num_images/num_workers;
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                             _zip_images_worker, args + i + 1);
+    _zip_images_worker(args + 0);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+    flint_free(args);
+}
+
+/*
+    The systems of zip_solve are independent of each other too. The first
+    failure in the order of the systems is reported.
+*/
+typedef struct
+{
+    volatile slong idx;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    mp_limb_t * Acoeffs;
+    const slong * offsets;
+    const n_polyun_struct * Z, * H, * M;
+    nmod_t ctx;
+    slong fail_idx;
+    int fail;
+}
+_zip_solve_base_struct;
+
+static void _zip_solve_worker(void * varg)
+{
+    _zip_solve_base_struct * base = (_zip_solve_base_struct *) varg;
+    slong i, n;
+    int success;
+    n_poly_t t;
+
+    n_poly_init(t);
+
+get_next_index:
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&base->mutex);
+#endif
+    i = base->idx;
+    base->idx = i + 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&base->mutex);
+#endif
+
+    if (i < base->H->length)
+    {
+        n = base->H->coeffs[i].length;
+        n_poly_fit_length(t, n);
+
+        success = _nmod_zip_vand_solve(base->Acoeffs + base->offsets[i],
+                base->H->coeffs[i].coeffs, n,
+                base->Z->coeffs[i].coeffs, base->Z->coeffs[i].length,
+                base->M->coeffs[i].coeffs, t->coeffs, base->ctx);
+
+        if (success < 1)
+        {
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&base->mutex);
+#endif
+            if (i < base->fail_idx)
+            {
+                base->fail_idx = i;
+                base->fail = success;
+            }
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&base->mutex);
+#endif
+        }
+
+        goto get_next_index;
+    }
+
+    n_poly_clear(t);
+}
+
+static int zip_solve_threaded(
+    mp_limb_t * Acoeffs,
+    n_polyun_t Z,
+    n_polyun_t H,
+    n_polyun_t M,
+    const nmod_t fpctx)
+{
+    thread_pool_handle * handles;
+    slong i, num_handles;
+    _zip_solve_base_struct base[1];
+    slong * offsets;
+
+    num_handles = flint_request_threads(&handles, H->length/8);
+    if (num_handles < 1)
+    {
+        flint_give_back_threads(handles, num_handles);
+        return zip_solve(Acoeffs, Z, H, M, fpctx);
+    }
+
+    FLINT_ASSERT(Z->length == H->length);
+    FLINT_ASSERT(Z->length == M->length);
+
+    offsets = FLINT_ARRAY_ALLOC(H->length, slong);
+    for (i = 0; i < H->length; i++)
+        offsets[i] = (i == 0) ? 0 : offsets[i - 1] + H->coeffs[i - 1].length;
+
+    base->idx = 0;
+    base->Acoeffs = Acoeffs;
+    base->offsets = offsets;
+    base->Z = Z;
+    base->H = H;
+    base->M = M;
+    base->ctx = fpctx;
+    base->fail_idx = H->length;
+    base->fail = 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&base->mutex, NULL);
+#endif
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                      _zip_solve_worker, base);
+    _zip_solve_worker(base);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&base->mutex);
+#endif
+
+    flint_free(offsets);
+
+    return base->fail;
+}
+
+
 int _fmpz_vec_crt_nmod(
     flint_bitcnt_t * maxbits_,
     fmpz * a,
@@ -1544,6 +1821,10 @@ int fmpz_mpolyl_gcd_zippel2(
     slong cur_zip_image, req_zip_images;
     ulong ABtotal_length;
     ulong Abidegree, Bbidegree;
+    _zip_images_base_struct zip_base[1];
+    n_polyun_struct * zip_images = NULL;
+    ulong * zip_degs = NULL;
+    slong zip_images_alloc = 0;
 
     FLINT_ASSERT(bits == A->bits);
     FLINT_ASSERT(bits == B->bits);
@@ -2233,35 +2514,36 @@ pick_zip_prime:
 
     fmpz_mpoly_nmod_coeffs(Gammacoeff_sp, Gamma->coeffs, Gamma->length, ctx_sp);
 
-    n_polyun_set(Acur_sp, Ainc_sp);
-    n_polyun_set(Bcur_sp, Binc_sp);
-    n_poly_set(Gammacur_sp, Gammainc_sp);
-
     n_polyun_zip_start(ZH, HH, req_zip_images);
 
-    for (cur_zip_image = 0; cur_zip_image < req_zip_images; cur_zip_image++)
+    if (req_zip_images > zip_images_alloc)
     {
-        n_polyun_mod_zip_eval_cur_inc_coeff(Aeval_sp, Acur_sp, Ainc_sp, Acoeff_sp, ctx_sp);
-        n_polyun_mod_zip_eval_cur_inc_coeff(Beval_sp, Bcur_sp, Binc_sp, Bcoeff_sp, ctx_sp);
-        Gammaeval_sp = n_poly_mod_zip_eval_cur_inc_coeff(Gammacur_sp, Gammainc_sp, Gammacoeff_sp, ctx_sp);
-
-        if (Aeval_sp->length < 1 || Beval_sp->length < 1 ||
-            n_polyu1n_bidegree(Aeval_sp) != Abidegree ||
-            n_polyu1n_bidegree(Beval_sp) != Bbidegree)
-        {
-            goto pick_zip_prime;
-        }
-
-        FLINT_ASSERT(Gammaeval_sp != 0);
-
-        success = n_polyu1n_mod_gcd_brown_smprime(Geval_sp, Abareval_sp,
-                               Bbareval_sp, Aeval_sp, Beval_sp, ctx_sp, St_sp);
-        if (!success)
-            goto pick_zip_prime;
+        zip_images = FLINT_ARRAY_REALLOC(zip_images, req_zip_images, n_polyun_struct);
+        zip_degs = FLINT_ARRAY_REALLOC(zip_degs, req_zip_images, ulong);
+        for (i = zip_images_alloc; i < req_zip_images; i++)
+            n_polyun_init(zip_images + i);
+        zip_images_alloc = req_zip_images;
+    }
 
-        FLINT_ASSERT(Geval_sp->length > 0);
-        GevaldegXY = n_polyu1n_bidegree(Geval_sp);
+    zip_base->Ainc = Ainc_sp;
+    zip_base->Acoeff = Acoeff_sp;
+    zip_base->Binc = Binc_sp;
+    zip_base->Bcoeff = Bcoeff_sp;
+    zip_base->Gammainc = Gammainc_sp;
+    zip_base->Gammacoeff = Gammacoeff_sp;
+    zip_base->ctx = ctx_sp;
+    zip_base->Abidegree = Abidegree;
+    zip_base->Bbidegree = Bbidegree;
+    zip_base->GdegboundXY = GdegboundXY;
+    zip_base->which_check = which_check;
+    zip_base->images = zip_images;
+    zip_base->degs = zip_degs;
+    _zip_images(zip_base, req_zip_images);
 
+    for (cur_zip_image = 0; cur_zip_image < req_zip_images; cur_zip_image++)
+    {
+        /* also covers the images that failed */
+        GevaldegXY = zip_degs[cur_zip_image];
         if (GevaldegXY > GdegboundXY)
             goto pick_zip_prime;
 
@@ -2273,12 +2555,7 @@ pick_zip_prime:
             goto pick_bma_prime;
         }
 
-        _n_poly_vec_mul_nmod_intertible(Geval_sp->coeffs, Geval_sp->length,
-                                                         Gammaeval_sp, ctx_sp);
-
-        success = n_polyu2n_add_zipun_must_match(ZH,
-                                which_check == 1 ? Abareval_sp :
-                                which_check == 2 ? Bbareval_sp : Geval_sp,
+        success = n_polyu2n_add_zipun_must_match(ZH, zip_images + cur_zip_image,
                                                                 cur_zip_image);
         if (!success)
             goto pick_bma_prime;
@@ -2287,7 +2564,7 @@ pick_zip_prime:
     FLINT_ASSERT(H->length == Hmarks->coeffs[Hmarks->length]);
     n_poly_fit_length(Hn, H->length);
 
-    success = zip_solve(Hn->coeffs, ZH, HH, MH, ctx_sp);
+    success = zip_solve_threaded(Hn->coeffs, ZH, HH, MH, ctx_sp);
     if (success < 0)
         goto pick_zip_prime; /* singular */
     if (success == 0)
@@ -2352,6 +2629,11 @@ cleanup:
     n_polyun_clear(ZH);
     n_poly_clear(Hn);
 
+    for (i = 0; i < zip_images_alloc; i++)
+        n_polyun_clear(zip_images + i);
+    flint_free(zip_images);
+    flint_free(zip_degs);
+
     /* machine precision workspace */
     flint_free(alphas_sp);
 
@@ -9,9 +9,36 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_poly.h"
 #include "fmpz_mpoly_factor.h"
 
+typedef struct
+{
+    fmpz_mpoly_struct * new_lcs;
+    const fmpz * alpha;
+    slong n;
+    slong r;
+    const fmpz_mpoly_ctx_struct * ctx;
+}
+_new_lcs_arg_struct;
+
+/* evaluate the j-th leading coefficient at all of alpha, one variable at
+   a time; the chains for different j are independent */
+static void _new_lcs_worker(slong j, void * varg)
+{
+    _new_lcs_arg_struct * arg = (_new_lcs_arg_struct *) varg;
+    fmpz_mpoly_struct * new_lcs = arg->new_lcs;
+    slong i, r = arg->r;
+
+    for (i = arg->n - 1; i >= 0; i--)
+    {
+        fmpz_mpoly_evaluate_one_fmpz(new_lcs + i*r + j,
+                          new_lcs + (i + 1)*r + j, i + 1, arg->alpha + i,
+                                                                    arg->ctx);
+    }
+}
+
 int fmpz_mpoly_factor_irred_wang(
     fmpz_mpolyv_t fac,
     const fmpz_mpoly_t A,
@@ -217,13 +244,16 @@ got_alpha:
     {
         fmpz_mpoly_mul(new_lcs->coeffs + i*r + j, lc_divs->coeffs + j, m, ctx);
     }
-    for (i = n - 1; i >= 0; i--)
     {
-        for (j = 0; j < r; j++)
-        {
-            fmpz_mpoly_evaluate_one_fmpz(new_lcs->coeffs + i*r + j,
-                       new_lcs->coeffs + (i + 1)*r + j, i + 1, alpha + i, ctx);
-        }
+        _new_lcs_arg_struct args[1];
+
+        args->new_lcs = new_lcs->coeffs;
+        args->alpha = alpha;
+        args->n = n;
+        args->r = r;
+        args->ctx = ctx;
+
+        flint_parallel_do(_new_lcs_worker, args, r, 0, FLINT_PARALLEL_DYNAMIC);
     }
 
     fmpz_mpolyv_fit_length(fac, r, ctx);
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_poly.h"
 #include "fmpz_mpoly_factor.h"
 #include "n_poly.h"
@@ -580,6 +581,62 @@ cleanup:
            0: lcc is incomplete
           -1: alphas are definitely bad
 */
+/*
+    The bivariate images A(x, alpha_1, ..., y_v, ..., alpha_n) and their
+    factorizations do not depend on the divisors found so far, so they can
+    all be computed up front and in parallel. code[v] is 1 if bfacs[v] holds
+    the ordered factors, 0 if the factorization failed for good and -1 if
+    this variable is to be skipped.
+*/
+typedef struct
+{
+    const fmpz_mpoly_struct * A;
+    const fmpz * alphas;
+    const slong * degs;
+    const fmpz_poly_factor_struct * uf;
+    const fmpz_mpoly_ctx_struct * ctx;
+    fmpz_tpoly_struct * bfacs;
+    int * code;
+}
+_lcc_kaltofen_image_arg_struct;
+
+static void _lcc_kaltofen_image_worker(slong i, void * varg)
+{
+    _lcc_kaltofen_image_arg_struct * arg = (_lcc_kaltofen_image_arg_struct *) varg;
+    slong v = i + 1;
+    int success;
+    fmpz_bpoly_t beval;
+    fmpz_poly_t bcont;
+
+    fmpz_bpoly_init(beval);
+    fmpz_poly_init(bcont);
+
+    fmpz_mpoly_evaluate_except_two(beval, arg->A, arg->alphas, v, arg->ctx);
+    FLINT_ASSERT(fmpz_bpoly_degree0(beval) == arg->degs[0]);
+    if (fmpz_bpoly_degree1(beval) != arg->degs[v])
+    {
+        arg->bfacs[v].length = 0;
+        arg->code[v] = -1;
+    }
+    else
+    {
+        success = fmpz_bpoly_factor_ordered(bcont, arg->bfacs + v, beval,
+                                                 arg->alphas + v - 1, arg->uf);
+        if (success < 1)
+        {
+            arg->bfacs[v].length = 0;
+            arg->code[v] = (success == 0) ? 0 : -1;
+        }
+        else
+        {
+            arg->code[v] = 1;
+        }
+    }
+
+    fmpz_bpoly_clear(beval);
+    fmpz_poly_clear(bcont);
+}
+
 int fmpz_mpoly_factor_lcc_kaltofen(
     fmpz_mpoly_struct * divs,
     const fmpz_mpoly_factor_t lcAf_,
@@ -595,10 +652,12 @@ int fmpz_mpoly_factor_lcc_kaltofen(
     fmpz_mpoly_factor_t lcAf;
     fmpz_poly_struct * ulcs;
     fmpz_tpoly_struct * bfacs;
-    fmpz_bpoly_t beval;
-    fmpz_poly_t bcont, ut2;
+    fmpz_poly_t ut2;
     fmpz_t g1, g2, g3;
     fmpz * content_divs;
+    int * code;
+    int images_done;
+    _lcc_kaltofen_image_arg_struct args[1];
 
     FLINT_ASSERT(r > 1);
 
@@ -612,11 +671,24 @@ int fmpz_mpoly_factor_lcc_kaltofen(
     content_divs = _fmpz_vec_init(r);
 
     fmpz_poly_init(ut2);
-    fmpz_poly_init(bcont);
-    fmpz_bpoly_init(beval);
     bfacs = FLINT_ARRAY_ALLOC(nvars, fmpz_tpoly_struct);
     for (i = 0; i < nvars; i++)
         fmpz_tpoly_init(bfacs + i);
+    code = FLINT_ARRAY_ALLOC(nvars, int);
+
+    args->A = A;
+    args->alphas = alphas;
+    args->degs = degs;
+    args->uf = uf;
+    args->ctx = ctx;
+    args->bfacs = bfacs;
+    args->code = code;
+
+    /* with one thread the images are computed as they are needed */
+    images_done = flint_get_num_threads() > 1 && nvars > 2;
+    if (images_done)
+        flint_parallel_do(_lcc_kaltofen_image_worker, args, nvars - 1, 0,
+                                                       FLINT_PARALLEL_DYNAMIC);
 
     ulcs = FLINT_ARRAY_ALLOC(r, fmpz_poly_struct);
     for (i = 0; i < r; i++)
@@ -627,25 +699,17 @@ int fmpz_mpoly_factor_lcc_kaltofen(
 
     for (v = 1; v < nvars; v++)
     {
-        fmpz_mpoly_evaluate_except_two(beval, A, alphas, v, ctx);
-        FLINT_ASSERT(fmpz_bpoly_degree0(beval) == degs[0]);
-        if (fmpz_bpoly_degree1(beval) != degs[v])
-        {
-            bfacs[v].length = 0;
-            goto continue_outer;
-        }
+        if (!images_done)
+            _lcc_kaltofen_image_worker(v - 1, args);
 
-        success = fmpz_bpoly_factor_ordered(bcont, bfacs + v, beval,
-                                                           alphas + v - 1, uf);
-        if (success < 1)
+        if (code[v] < 1)
         {
-            if (success == 0)
+            if (code[v] == 0)
             {
                 success = -1;
                 goto cleanup;
             }
 
-            bfacs[v].length = 0;
             goto continue_outer;
         }
 
@@ -718,11 +782,10 @@ cleanup:
     _fmpz_vec_clear(content_divs, r);
 
     fmpz_poly_clear(ut2);
-    fmpz_poly_clear(bcont);
-    fmpz_bpoly_clear(beval);
     for (i = 0; i < nvars; i++)
         fmpz_tpoly_clear(bfacs + i);
     flint_free(bfacs);
+    flint_free(code);
 
     for (i = 0; i < r; i++)
         fmpz_poly_clear(ulcs + i);
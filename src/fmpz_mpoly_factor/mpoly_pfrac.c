@@ -9,9 +9,69 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_poly.h"
 #include "fmpz_mpoly_factor.h"
 
+/*
+    The images of the betas and the products of all but one of them are
+    independent across factors and are computed in parallel once the betas
+    have this many terms in total. The same cutoff on the products decides
+    when fmpz_mpoly_pfrac accumulates its correction terms factor by factor
+    in parallel.
+*/
+#define FMPZ_MPOLY_PFRAC_THREAD_CUTOFF 200
+
+typedef struct
+{
+    fmpz_mpoly_pfrac_struct * I;
+    const fmpz_mpoly_struct * betas;
+    const fmpz * alpha;
+    const fmpz_mpoly_ctx_struct * ctx;
+}
+_pfrac_init_arg_struct;
+
+static void _pfrac_init_mbetas_worker(slong j, void * varg)
+{
+    _pfrac_init_arg_struct * arg = (_pfrac_init_arg_struct *) varg;
+    fmpz_mpoly_pfrac_struct * I = arg->I;
+    slong i, r = I->r;
+
+    i = I->w;
+    fmpz_mpoly_init(I->mbetas + i*r + j, arg->ctx);
+    fmpz_mpoly_set(I->mbetas + i*r + j, arg->betas + j, arg->ctx);
+    for (i--; i >= 0; i--)
+    {
+        fmpz_mpoly_init(I->mbetas + i*r + j, arg->ctx);
+        fmpz_mpoly_evaluate_one_fmpz(I->mbetas + i*r + j,
+                  I->mbetas + (i + 1)*r + j, i + 1, arg->alpha + i, arg->ctx);
+    }
+}
+
+static void _pfrac_init_prod_worker(slong ij, void * varg)
+{
+    _pfrac_init_arg_struct * arg = (_pfrac_init_arg_struct *) varg;
+    fmpz_mpoly_pfrac_struct * I = arg->I;
+    slong k, r = I->r;
+    slong i = ij / r, j = ij % r;
+
+    fmpz_mpoly_init(I->prod_mbetas + i*r + j, arg->ctx);
+    fmpz_mpoly_one(I->prod_mbetas + i*r + j, arg->ctx);
+    for (k = 0; k < r; k++)
+    {
+        if (k == j)
+            continue;
+        fmpz_mpoly_mul(I->prod_mbetas + i*r + j,
+                      I->prod_mbetas + i*r + j, I->mbetas + i*r + k, arg->ctx);
+    }
+    fmpz_mpolyv_init(I->prod_mbetas_coeffs + i*r + j, arg->ctx);
+    if (i > 0)
+    {
+        fmpz_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*r + j,
+                            I->prod_mbetas + i*r + j, I->xalpha + i, arg->ctx);
+    }
+}
+
 int fmpz_mpoly_pfrac_init(
     fmpz_mpoly_pfrac_t I,
     flint_bitcnt_t bits,
@@ -22,7 +82,8 @@ int fmpz_mpoly_pfrac_init(
     const fmpz_mpoly_ctx_t ctx)
 {
     slong success = 1;
-    slong i, j, k;
+    slong i, j, len;
+    _pfrac_init_arg_struct args[1];
 
     FLINT_ASSERT(bits <= FLINT_BITS);
 
@@ -64,44 +125,29 @@ int fmpz_mpoly_pfrac_init(
         fmpz_mpoly_repack_bits_inplace(I->xalpha + i, I->bits, ctx);
     }
 
-    /* set betas */
-    i = w;
+    /* set betas and the products of betas */
+    args->I = I;
+    args->betas = betas;
+    args->alpha = alpha;
+    args->ctx = ctx;
+
+    len = 0;
     for (j = 0; j < r; j++)
+        len += betas[j].length;
+
+    if (len >= FMPZ_MPOLY_PFRAC_THREAD_CUTOFF && flint_get_num_threads() > 1)
     {
-        fmpz_mpoly_init(I->mbetas + i*r + j, ctx);
-        fmpz_mpoly_set(I->mbetas + i*r + j, betas + j, ctx);
+        flint_parallel_do(_pfrac_init_mbetas_worker, args, r, 0,
+                                                       FLINT_PARALLEL_DYNAMIC);
+        flint_parallel_do(_pfrac_init_prod_worker, args, (w + 1)*r, 0,
+                                                       FLINT_PARALLEL_DYNAMIC);
     }
-    for (i--; i >= 0; i--)
+    else
     {
         for (j = 0; j < r; j++)
-        {
-            fmpz_mpoly_init(I->mbetas + i*r + j, ctx);
-            fmpz_mpoly_evaluate_one_fmpz(I->mbetas + i*r + j,
-                             I->mbetas + (i + 1)*r + j, i + 1, alpha + i, ctx);
-        }
-    }
-
-    /* set product of betas */
-    for (i = w; i >= 0; i--)
-    {
-        for (j = 0; j < r; j++)
-        {
-            fmpz_mpoly_init(I->prod_mbetas + i*r + j, ctx);
-            fmpz_mpoly_one(I->prod_mbetas + i*r + j, ctx);
-            for (k = 0; k < r; k++)
-            {
-                if (k == j)
-                    continue;
-                fmpz_mpoly_mul(I->prod_mbetas + i*r + j,
-                           I->prod_mbetas + i*r + j, I->mbetas + i*r + k, ctx);
-            }
-            fmpz_mpolyv_init(I->prod_mbetas_coeffs + i*r + j, ctx);
-            if (i > 0)
-            {
-                fmpz_mpoly_to_mpolyv(I->prod_mbetas_coeffs + i*r + j,
-                                 I->prod_mbetas + i*r + j, I->xalpha + i, ctx);
-            }
-        }
+            _pfrac_init_mbetas_worker(j, args);
+        for (i = 0; i < (w + 1)*r; i++)
+            _pfrac_init_prod_worker(i, args);
     }
 
     fmpz_poly_pfrac_init(I->uni_pfrac);
@@ -174,6 +220,49 @@ void fmpz_mpoly_pfrac_clear(
 }
 
 
+typedef struct
+{
+    const fmpz_mpoly_pfrac_struct * I;
+    slong l;
+    slong k;
+    fmpz_mpoly_struct * sums;
+    const fmpz_mpoly_ctx_struct * ctx;
+}
+_pfrac_sum_arg_struct;
+
+/* sums[i] = sum_{j < k} delta_coeffs[i][j]*prod_mbetas_coeffs[i][k - j] */
+static void _pfrac_sum_worker(slong i, void * varg)
+{
+    _pfrac_sum_arg_struct * arg = (_pfrac_sum_arg_struct *) varg;
+    const fmpz_mpoly_pfrac_struct * I = arg->I;
+    const fmpz_mpoly_ctx_struct * ctx = arg->ctx;
+    slong j, l = arg->l, k = arg->k;
+    const fmpz_mpolyv_struct * delta_coeffs = I->delta_coeffs + l*I->r + i;
+    const fmpz_mpolyv_struct * prod_coeffs = I->prod_mbetas_coeffs + l*I->r + i;
+    fmpz_mpoly_geobucket_t G;
+    fmpz_mpoly_t qt;
+
+    fmpz_mpoly_geobucket_init(G, ctx);
+    fmpz_mpoly_init(qt, ctx);
+
+    for (j = 0; j < k; j++)
+    {
+        if (j >= delta_coeffs->length)
+            continue;
+        if (k - j >= prod_coeffs->length)
+            continue;
+
+        fmpz_mpoly_mul(qt, delta_coeffs->coeffs + j,
+                                             prod_coeffs->coeffs + k - j, ctx);
+        fmpz_mpoly_geobucket_add(G, qt, ctx);
+    }
+
+    fmpz_mpoly_geobucket_empty(arg->sums + i, G, ctx);
+
+    fmpz_mpoly_geobucket_clear(G, ctx);
+    fmpz_mpoly_clear(qt, ctx);
+}
+
 int fmpz_mpoly_pfrac(
     slong l,
     fmpz_mpoly_t t,
@@ -191,6 +280,8 @@ int fmpz_mpoly_pfrac(
     fmpz_mpolyv_struct * delta_coeffs = I->delta_coeffs + l*I->r;
     fmpz_mpoly_geobucket_struct * G = I->G + l;
     fmpz_mpoly_univar_struct * U = I->U + l;
+    fmpz_mpoly_struct * sums = NULL;
+    _pfrac_sum_arg_struct args[1];
 
     FLINT_ASSERT(l >= 0);
 
@@ -213,6 +304,26 @@ int fmpz_mpoly_pfrac(
     for (i = 0; i < I->r; i++)
         delta_coeffs[i].length = 0;
 
+    if (flint_get_num_threads() > 1)
+    {
+        slong len = 0;
+
+        for (i = 0; i < I->r; i++)
+            len += I->prod_mbetas[l*I->r + i].length;
+
+        if (len >= FMPZ_MPOLY_PFRAC_THREAD_CUTOFF)
+        {
+            sums = FLINT_ARRAY_ALLOC(I->r, fmpz_mpoly_struct);
+            for (i = 0; i < I->r; i++)
+                fmpz_mpoly_init(sums + i, ctx);
+
+            args->I = I;
+            args->l = l;
+            args->sums = sums;
+            args->ctx = ctx;
+        }
+    }
+
     use_U = I->xalpha[l].length == 1;
     if (use_U)
         fmpz_mpoly_to_univar(U, t, l, ctx);
@@ -239,17 +350,28 @@ int fmpz_mpoly_pfrac(
             fmpz_mpoly_geobucket_set(G, newt, ctx);
         }
 
-        for (j = 0; j < k; j++)
-        for (i = 0; i < I->r; i++)
+        if (sums != NULL)
         {
-            if (j >= delta_coeffs[i].length)
-                continue;
-            if (k - j >= I->prod_mbetas_coeffs[l*I->r + i].length)
-                continue;
+            args->k = k;
+            flint_parallel_do(_pfrac_sum_worker, args, I->r, 0,
+                                                       FLINT_PARALLEL_DYNAMIC);
+            for (i = 0; i < I->r; i++)
+                fmpz_mpoly_geobucket_sub(G, sums + i, ctx);
+        }
+        else
+        {
+            for (j = 0; j < k; j++)
+            for (i = 0; i < I->r; i++)
+            {
+                if (j >= delta_coeffs[i].length)
+                    continue;
+                if (k - j >= I->prod_mbetas_coeffs[l*I->r + i].length)
+                    continue;
 
-            fmpz_mpoly_mul(qt, delta_coeffs[i].coeffs + j,
+                fmpz_mpoly_mul(qt, delta_coeffs[i].coeffs + j,
                         I->prod_mbetas_coeffs[l*I->r + i].coeffs + k - j, ctx);
-            fmpz_mpoly_geobucket_sub(G, qt, ctx);
+                fmpz_mpoly_geobucket_sub(G, qt, ctx);
+            }
         }
 
         fmpz_mpoly_geobucket_empty(newt, G, ctx);
@@ -259,7 +381,7 @@ int fmpz_mpoly_pfrac(
 
         success = fmpz_mpoly_pfrac(l - 1, newt, degs, I, ctx);
         if (success < 1)
-            return success;
+            goto cleanup;
 
         for (i = 0; i < I->r; i++)
         {
@@ -267,7 +389,10 @@ int fmpz_mpoly_pfrac(
                 continue;
 
             if (k + I->prod_mbetas_coeffs[l*I->r + i].length - 1 > degs[l])
-                return 0;
+            {
+                success = 0;
+                goto cleanup;
+            }
 
             fmpz_mpolyv_set_coeff(delta_coeffs + i, k, newdeltas + i, ctx);
         }
@@ -277,6 +402,17 @@ int fmpz_mpoly_pfrac(
         fmpz_mpoly_from_mpolyv(deltas + i, I->bits,
                                          delta_coeffs + i, I->xalpha + l, ctx);
 
-    return 1;
+    success = 1;
+
+cleanup:
+
+    if (sums != NULL)
+    {
+        for (i = 0; i < I->r; i++)
+            fmpz_mpoly_clear(sums + i, ctx);
+        flint_free(sums);
+    }
+
+    return success;
 }
 
@@ -0,0 +1,118 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "fmpz_mpoly_factor.h"
+
+/* factor with one and with several threads and compare */
+void check_threaded(const fmpz_mpoly_t p, slong num_threads, int algo,
+                                                   const fmpz_mpoly_ctx_t ctx)
+{
+    int success1, success2;
+    fmpz_mpoly_t q;
+    fmpz_mpoly_factor_t g, h;
+
+    fmpz_mpoly_factor_init(g, ctx);
+    fmpz_mpoly_factor_init(h, ctx);
+    fmpz_mpoly_init(q, ctx);
+
+    flint_set_num_threads(1);
+    success1 = (algo == 0) ? fmpz_mpoly_factor_wang(g, p, ctx) :
+                             fmpz_mpoly_factor_zippel(g, p, ctx);
+
+    flint_set_num_threads(num_threads);
+    success2 = (algo == 0) ? fmpz_mpoly_factor_wang(h, p, ctx) :
+                             fmpz_mpoly_factor_zippel(h, p, ctx);
+
+    if (!success1 || !success2)
+    {
+        flint_printf("FAIL:\ncheck factorization could be computed\n");
+        flint_printf("algo = %d, threads = %wd\n", algo, num_threads);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    fmpz_mpoly_factor_expand(q, h, ctx);
+    if (!fmpz_mpoly_equal(q, p, ctx))
+    {
+        flint_printf("FAIL:\nfactorization does not match original polynomial\n");
+        flint_printf("algo = %d, threads = %wd\n", algo, num_threads);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    fmpz_mpoly_factor_sort(g, ctx);
+    fmpz_mpoly_factor_sort(h, ctx);
+    if (fmpz_mpoly_factor_cmp(g, h, ctx) != 0)
+    {
+        flint_printf("FAIL:\nfactorizations do not match\n");
+        flint_printf("algo = %d, threads = %wd\n", algo, num_threads);
+        fflush(stdout);
+        flint_abort();
+    }
+
+    fmpz_mpoly_clear(q, ctx);
+    fmpz_mpoly_factor_clear(g, ctx);
+    fmpz_mpoly_factor_clear(h, ctx);
+}
+
+int
+main(void)
+{
+    slong i, j, tmul = 40, max_threads = 5;
+
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_threaded....");
+    fflush(stdout);
+
+    for (i = 0; i < tmul * flint_test_multiplier(); i++)
+    {
+        fmpz_mpoly_ctx_t ctx;
+        fmpz_mpoly_t a, t;
+        flint_bitcnt_t coeff_bits;
+        slong n, nfacs, len;
+        ulong expbound;
+
+        fmpz_mpoly_ctx_init_rand(ctx, state, 6);
+
+        fmpz_mpoly_init(a, ctx);
+        fmpz_mpoly_init(t, ctx);
+
+        n = FLINT_MAX(WORD(1), ctx->minfo->nvars);
+        nfacs = 2 + n_randint(state, 3);
+        expbound = 2 + 12/nfacs/n;
+
+        fmpz_mpoly_one(a, ctx);
+        for (j = 0; j < nfacs; j++)
+        {
+            do {
+                len = 2 + n_randint(state, 20);
+                coeff_bits = 10 + n_randint(state, 30);
+                fmpz_mpoly_randtest_bound(t, state, len, coeff_bits, expbound, ctx);
+            } while (t->length == 0);
+
+            fmpz_mpoly_mul(a, a, t, ctx);
+        }
+
+        check_threaded(a, n_randint(state, max_threads) + 2,
+                                                    n_randint(state, 2), ctx);
+
+        fmpz_mpoly_clear(t, ctx);
+        fmpz_mpoly_clear(a, ctx);
+        fmpz_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
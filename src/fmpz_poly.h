@@ -55,6 +55,17 @@ typedef struct
 
 typedef fmpz_poly_mul_precache_struct fmpz_poly_mul_precache_t[1];
 
+typedef struct
+{
+    fmpz_poly_t poly;
+    slong len1;
+    flint_bitcnt_t bits1;
+    void * fft;
+}
+fmpz_poly_mul_precomp_struct;
+
+typedef fmpz_poly_mul_precomp_struct fmpz_poly_mul_precomp_t[1];
+
 /*  Memory management ********************************************************/
 
 void fmpz_poly_init(fmpz_poly_t poly);
@@ -460,6 +471,17 @@ FMPZ_POLY_INLINE void fmpz_poly_mul_SS_precache(fmpz_poly_t res,
 		                  FLINT_MAX(poly1->length + pre->len2 - 1, 0));
 }
 
+void fmpz_poly_mul_precomp_init(fmpz_poly_mul_precomp_t M,
+                  const fmpz_poly_t poly2, slong len1, flint_bitcnt_t bits1);
+
+void fmpz_poly_mul_precomp_clear(fmpz_poly_mul_precomp_t M);
+
+void _fmpz_poly_mul_precomp(fmpz * res, const fmpz * poly1, slong len1,
+                                          const fmpz_poly_mul_precomp_t M);
+
+void fmpz_poly_mul_precomp(fmpz_poly_t res, const fmpz_poly_t poly1,
+                                          const fmpz_poly_mul_precomp_t M);
+
 /* Squaring ******************************************************************/
 
 void _fmpz_poly_sqr_KS(fmpz * rop, const fmpz * op, slong len);
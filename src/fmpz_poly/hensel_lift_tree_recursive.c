@@ -10,30 +10,101 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_pool.h"
+#include "thread_support.h"
 #include "fmpz_poly.h"
 
-void fmpz_poly_hensel_lift_tree_recursive(slong *link,
-    fmpz_poly_t *v, fmpz_poly_t *w, fmpz_poly_t f, slong j, slong inv,
-    const fmpz_t p0, const fmpz_t p1)
+/*
+    The two subtrees below a node share no entries of v and w, so once the
+    node itself has been lifted they can be lifted in parallel. Only nodes
+    whose polynomial is at least this long are split across threads.
+*/
+#define FMPZ_POLY_HENSEL_TREE_THREAD_CUTOFF 16
+
+typedef struct
+{
+    slong * link;
+    fmpz_poly_t * v;
+    fmpz_poly_t * w;
+    fmpz_poly_struct * f;
+    slong j;
+    slong inv;
+    const fmpz * p0;
+    const fmpz * p1;
+    slong thread_limit;
+}
+_hensel_tree_arg_struct;
+
+static void _hensel_lift_tree(slong * link, fmpz_poly_t * v, fmpz_poly_t * w,
+                  fmpz_poly_t f, slong j, slong inv, const fmpz_t p0,
+                                          const fmpz_t p1, slong thread_limit);
+
+static void _hensel_lift_tree_worker(void * varg)
+{
+    _hensel_tree_arg_struct * arg = (_hensel_tree_arg_struct *) varg;
+
+    _hensel_lift_tree(arg->link, arg->v, arg->w, arg->f, arg->j, arg->inv,
+                                          arg->p0, arg->p1, arg->thread_limit);
+}
+
+static void _hensel_lift_tree(slong * link, fmpz_poly_t * v, fmpz_poly_t * w,
+                  fmpz_poly_t f, slong j, slong inv, const fmpz_t p0,
+                                           const fmpz_t p1, slong thread_limit)
 {
-    if (j >= 0)
+    if (j < 0)
+        return;
+
+    if (inv == 1)
+        fmpz_poly_hensel_lift(v[j], v[j + 1], w[j], w[j + 1], f,
+                              v[j], v[j + 1], w[j], w[j + 1],
+                              p0, p1);
+    else if (inv == -1)
+        fmpz_poly_hensel_lift_only_inverse(w[j], w[j+1],
+                             v[j], v[j+1], w[j], w[j+1], p0, p1);
+    else
+        fmpz_poly_hensel_lift_without_inverse(v[j], v[j+1], f,
+                                              v[j], v[j+1], w[j], w[j+1],
+                                              p0, p1);
+
+    if (thread_limit > 1 && global_thread_pool_initialized &&
+        link[j] >= 0 && link[j + 1] >= 0 &&
+        FLINT_MIN(v[j]->length, v[j + 1]->length) >=
+                                           FMPZ_POLY_HENSEL_TREE_THREAD_CUTOFF)
     {
-        if (inv == 1)
-            fmpz_poly_hensel_lift(v[j], v[j + 1], w[j], w[j + 1], f,
-                                  v[j], v[j + 1], w[j], w[j + 1],
-                                  p0, p1);
-        else if (inv == -1)
-            fmpz_poly_hensel_lift_only_inverse(w[j], w[j+1],
-                                 v[j], v[j+1], w[j], w[j+1], p0, p1);
-        else
-            fmpz_poly_hensel_lift_without_inverse(v[j], v[j+1], f,
-                                                  v[j], v[j+1], w[j], w[j+1],
-                                                  p0, p1);
-
-        fmpz_poly_hensel_lift_tree_recursive(link, v, w, v[j], link[j],
-            inv, p0, p1);
-        fmpz_poly_hensel_lift_tree_recursive(link, v, w, v[j+1], link[j+1],
-            inv, p0, p1);
+        _hensel_tree_arg_struct right;
+        thread_pool_task_t task;
+
+        right.link = link;
+        right.v = v;
+        right.w = w;
+        right.f = v[j + 1];
+        right.j = link[j + 1];
+        right.inv = inv;
+        right.p0 = p0;
+        right.p1 = p1;
+        right.thread_limit = thread_limit / 2;
+
+        thread_pool_spawn(global_thread_pool, task,
+                                             _hensel_lift_tree_worker, &right);
+
+        _hensel_lift_tree(link, v, w, v[j], link[j], inv, p0, p1,
+                                              thread_limit - thread_limit / 2);
+
+        thread_pool_join(global_thread_pool, task);
+    }
+    else
+    {
+        _hensel_lift_tree(link, v, w, v[j], link[j], inv, p0, p1,
+                                                                 thread_limit);
+        _hensel_lift_tree(link, v, w, v[j + 1], link[j + 1], inv, p0, p1,
+                                                                 thread_limit);
     }
 }
 
+void fmpz_poly_hensel_lift_tree_recursive(slong *link,
+    fmpz_poly_t *v, fmpz_poly_t *w, fmpz_poly_t f, slong j, slong inv,
+    const fmpz_t p0, const fmpz_t p1)
+{
+    _hensel_lift_tree(link, v, w, f, j, inv, p0, p1,
+                                                     flint_get_num_threads());
+}
@@ -0,0 +1,127 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz.h"
+#include "fmpz_vec.h"
+#include "fmpz_poly.h"
+
+#ifdef FLINT_HAVE_FFT_SMALL
+#include "fft_small.h"
+
+/* below this length the fixed operand is not transformed */
+#define FMPZ_POLY_MUL_PRECOMP_CUTOFF 80
+#endif
+
+void
+fmpz_poly_mul_precomp_init(fmpz_poly_mul_precomp_t M,
+                   const fmpz_poly_t poly2, slong len1, flint_bitcnt_t bits1)
+{
+    fmpz_poly_init(M->poly);
+    fmpz_poly_set(M->poly, poly2);
+    M->len1 = len1;
+    M->bits1 = bits1;
+    M->fft = NULL;
+
+#ifdef FLINT_HAVE_FFT_SMALL
+    {
+        slong len2 = poly2->length;
+
+        if (len1 > 0 && FLINT_MIN(len1, len2) >= FMPZ_POLY_MUL_PRECOMP_CUTOFF)
+        {
+            fmpz_mul_precomp_struct * F;
+
+            F = flint_malloc(sizeof(fmpz_mul_precomp_struct));
+
+            if (_fmpz_mul_precomp_init(F, poly2->coeffs, len2, len1, bits1,
+                                                       get_default_mpn_ctx()))
+            {
+                M->fft = F;
+            }
+            else
+            {
+                _fmpz_mul_precomp_clear(F);
+                flint_free(F);
+            }
+        }
+    }
+#endif
+}
+
+void
+fmpz_poly_mul_precomp_clear(fmpz_poly_mul_precomp_t M)
+{
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL)
+    {
+        _fmpz_mul_precomp_clear((fmpz_mul_precomp_struct *) M->fft);
+        flint_free(M->fft);
+    }
+#endif
+
+    fmpz_poly_clear(M->poly);
+}
+
+void
+_fmpz_poly_mul_precomp(fmpz * res, const fmpz * poly1, slong len1,
+                                            const fmpz_poly_mul_precomp_t M)
+{
+    const fmpz * poly2 = M->poly->coeffs;
+    slong len2 = M->poly->length;
+
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL && FLINT_MIN(len1, len2) >= FMPZ_POLY_MUL_PRECOMP_CUTOFF)
+    {
+        if (_fmpz_poly_mul_mid_precomp(res, 0, len1 + len2 - 1, poly1, len1,
+                   (fmpz_mul_precomp_struct *) M->fft, get_default_mpn_ctx()))
+            return;
+    }
+#endif
+
+    if (len1 >= len2)
+        _fmpz_poly_mul(res, poly1, len1, poly2, len2);
+    else
+        _fmpz_poly_mul(res, poly2, len2, poly1, len1);
+}
+
+void
+fmpz_poly_mul_precomp(fmpz_poly_t res, const fmpz_poly_t poly1,
+                                            const fmpz_poly_mul_precomp_t M)
+{
+    slong len1 = poly1->length;
+    slong len2 = M->poly->length;
+    slong len_out;
+
+    if (len1 == 0 || len2 == 0)
+    {
+        fmpz_poly_zero(res);
+        return;
+    }
+
+    len_out = len1 + len2 - 1;
+
+    if (res == poly1 || res == M->poly)
+    {
+        fmpz_poly_t t;
+        fmpz_poly_init2(t, len_out);
+        _fmpz_poly_mul_precomp(t->coeffs, poly1->coeffs, len1, M);
+        fmpz_poly_swap(res, t);
+        fmpz_poly_clear(t);
+    }
+    else
+    {
+        fmpz_poly_fit_length(res, len_out);
+        _fmpz_poly_mul_precomp(res->coeffs, poly1->coeffs, len1, M);
+    }
+
+    _fmpz_poly_set_length(res, len_out);
+    _fmpz_poly_normalise(res);
+}
@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "fmpz.h"
+#include "fmpz_poly.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_precomp....");
+    fflush(stdout);
+
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t a, b, c, d;
+        fmpz_poly_mul_precomp_t M;
+        slong len1;
+        flint_bitcnt_t bits1, bits2;
+
+        fmpz_poly_init(a);
+        fmpz_poly_init(b);
+        fmpz_poly_init(c);
+        fmpz_poly_init(d);
+
+        if (n_randint(state, 2))
+            len1 = n_randint(state, 50) + 1;
+        else
+            len1 = n_randint(state, 2000) + 1;
+
+        bits1 = n_randint(state, 300) + 1;
+        bits2 = n_randint(state, 300) + 1;
+
+        fmpz_poly_randtest(b, state, n_randint(state, len1 + 100), bits2);
+
+        fmpz_poly_mul_precomp_init(M, b, len1, bits1);
+
+        for (j = 0; j < 4; j++)
+        {
+            /* the last product may exceed the announced length and size */
+            if (j < 3)
+                fmpz_poly_randtest(a, state, n_randint(state, len1 + 1), bits1);
+            else
+                fmpz_poly_randtest(a, state, n_randint(state, len1 + 10), bits1 + 10);
+
+            fmpz_poly_mul(c, a, b);
+
+            if (n_randint(state, 2))
+            {
+                fmpz_poly_mul_precomp(d, a, M);
+            }
+            else
+            {
+                fmpz_poly_set(d, a);
+                fmpz_poly_mul_precomp(d, d, M);
+            }
+
+            result = (fmpz_poly_equal(c, d));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("len1 = %wd, bits1 = %wu, j = %d\n", len1, bits1, j);
+                fmpz_poly_print(a), flint_printf("\n\n");
+                fmpz_poly_print(b), flint_printf("\n\n");
+                fmpz_poly_print(c), flint_printf("\n\n");
+                fmpz_poly_print(d), flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_poly_mul_precomp_clear(M);
+
+        fmpz_poly_clear(a);
+        fmpz_poly_clear(b);
+        fmpz_poly_clear(c);
+        fmpz_poly_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -12,9 +12,18 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "fmpz_poly.h"
 #include "fmpz_poly_factor.h"
 
+/*
+    The subset search is split across threads once there are this many
+    modular factors. Candidates are handed out in batches of
+    ZASSENHAUS_BATCH_PER_THREAD per thread.
+*/
+#define ZASSENHAUS_THREAD_CUTOFF 8
+#define ZASSENHAUS_BATCH_PER_THREAD 16
+
 static void _fmpz_poly_product(
     fmpz_poly_t res,
     const fmpz_poly_struct * lifted_fac,
@@ -78,6 +87,205 @@ static void _fmpz_poly_product(
 }
 
 
+/*
+    Threaded recombination. The main thread enumerates candidate subsets of
+    the current size into a batch, in exactly the order the serial loop would
+    visit them, and the workers test the batch for divisibility. The smallest
+    index that yields a factor wins: a worker stops fetching candidates
+    once the next index lies beyond a factor already found, and every
+    smaller index is still tested. The factors found, and hence the output,
+    are therefore identical to the serial code.
+*/
+typedef struct
+{
+    const fmpz_poly_struct * lifted_fac;
+    const fmpz_poly_struct * f;
+    const fmpz * P;
+    const slong * subsets;
+    slong len;
+    slong num;
+    slong next;
+    slong found;
+    fmpz_poly_struct * factor;
+    fmpz_poly_struct * quotient;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+}
+_recombination_base_struct;
+
+static void _recombination_worker(slong FLINT_UNUSED(w), void * varg)
+{
+    _recombination_base_struct * base = (_recombination_base_struct *) varg;
+    const slong len = base->len;
+    slong i, j;
+    fmpz_poly_t Q, tryme;
+    fmpz_poly_struct * tmp;
+    fmpz_poly_struct ** stack;
+
+    stack = (fmpz_poly_struct **) flint_malloc(len*sizeof(fmpz_poly_struct *));
+    tmp = (fmpz_poly_struct *) flint_malloc(len*sizeof(fmpz_poly_struct));
+    for (i = 0; i < len; i++)
+        fmpz_poly_init(tmp + i);
+    fmpz_poly_init(Q);
+    fmpz_poly_init(tryme);
+
+    while (1)
+    {
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&base->mutex);
+#endif
+        j = base->next;
+        if (j < base->found)
+            base->next = j + 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&base->mutex);
+#endif
+
+        if (j >= base->found)
+            break;
+
+        _fmpz_poly_product(tryme, base->lifted_fac, base->subsets + j*len,
+                           len, base->P, fmpz_poly_lead(base->f), stack, tmp);
+        fmpz_poly_primitive_part(tryme, tryme);
+
+        if (!fmpz_poly_divides(Q, base->f, tryme))
+            continue;
+
+#if FLINT_USES_PTHREAD
+        pthread_mutex_lock(&base->mutex);
+#endif
+        if (j < base->found)
+        {
+            base->found = j;
+            fmpz_poly_swap(base->factor, tryme);
+            fmpz_poly_swap(base->quotient, Q);
+        }
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&base->mutex);
+#endif
+    }
+
+    fmpz_poly_clear(tryme);
+    fmpz_poly_clear(Q);
+    for (i = 0; i < len; i++)
+        fmpz_poly_clear(tmp + i);
+    flint_free(tmp);
+    flint_free(stack);
+}
+
+static void _fmpz_poly_factor_zassenhaus_recombination_threaded(
+    fmpz_poly_factor_t final_fac,
+    const fmpz_poly_factor_t lifted_fac,
+    const fmpz_poly_t F,
+    const fmpz_t P,
+    slong exp,
+    const zassenhaus_prune_struct * Z,
+    slong num_threads)
+{
+    const slong r = lifted_fac->num;
+    const slong batch = ZASSENHAUS_BATCH_PER_THREAD*num_threads;
+    _recombination_base_struct base[1];
+    slong * subset, * subsets;
+    slong i, k, len, total, num;
+    int more;
+    fmpz_poly_t Fcopy, Q, tryme;
+    fmpz_poly_struct * f;
+
+    subset = (slong *) flint_malloc(r*sizeof(slong));
+    for (k = 0; k < r; k++)
+        subset[k] = k;
+
+    subsets = (slong *) flint_malloc(batch*r*sizeof(slong));
+
+    fmpz_poly_init(Q);
+    fmpz_poly_init(tryme);
+    fmpz_poly_init(Fcopy);
+
+    f = (fmpz_poly_struct *) F;
+
+    base->lifted_fac = lifted_fac->p;
+    base->P = P;
+    base->subsets = subsets;
+    base->factor = tryme;
+    base->quotient = Q;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&base->mutex, NULL);
+#endif
+
+    len = r;
+    for (k = 1; k <= len/2; k++)
+    {
+        zassenhaus_subset_first(subset, len, k);
+        more = 1;
+        while (more)
+        {
+            num = 0;
+            while (more && num < batch)
+            {
+                total = 0;
+                if (Z != NULL)
+                    for (i = 0; i < len; i++)
+                        if (subset[i] >= 0)
+                            total += fmpz_poly_degree(lifted_fac->p + subset[i]);
+
+                if (Z == NULL || zassenhaus_prune_degree_is_possible(Z, total))
+                {
+                    for (i = 0; i < len; i++)
+                        subsets[num*len + i] = subset[i];
+                    num++;
+                }
+
+                more = zassenhaus_subset_next(subset, len);
+            }
+
+            if (num == 0)
+                break;
+
+            base->f = f;
+            base->len = len;
+            base->num = num;
+            base->next = 0;
+            base->found = num;
+
+            flint_parallel_do(_recombination_worker, base, num_threads,
+                                               num_threads, FLINT_PARALLEL_UNIFORM);
+
+            if (base->found < num)
+            {
+                fmpz_poly_factor_insert(final_fac, tryme, exp);
+                f = Fcopy;  /* make sure f is writeable */
+                fmpz_poly_swap(f, Q);
+                for (i = 0; i < len; i++)
+                    subset[i] = subsets[base->found*len + i];
+                len -= k;
+                more = zassenhaus_subset_next_disjoint(subset, len + k);
+            }
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&base->mutex);
+#endif
+
+    if (fmpz_poly_degree(f) > 0)
+    {
+        fmpz_poly_factor_insert(final_fac, f, exp);
+    }
+    else
+    {
+        FLINT_ASSERT(fmpz_poly_is_one(f));
+    }
+
+    fmpz_poly_clear(Fcopy);
+    fmpz_poly_clear(tryme);
+    fmpz_poly_clear(Q);
+
+    flint_free(subsets);
+    flint_free(subset);
+}
+
+
 void fmpz_poly_factor_zassenhaus_recombination(
     fmpz_poly_factor_t final_fac,
 	const fmpz_poly_factor_t lifted_fac,
@@ -93,6 +301,14 @@ void fmpz_poly_factor_zassenhaus_recombination(
     fmpz_poly_struct ** stack;
     fmpz_poly_struct * f;
 
+    if (r >= ZASSENHAUS_THREAD_CUTOFF && flint_get_num_threads() > 1)
+    {
+        _fmpz_poly_factor_zassenhaus_recombination_threaded(final_fac,
+                           lifted_fac, F, P, exp, NULL,
+                                                     flint_get_num_threads());
+        return;
+    }
+
     subset = (slong *) flint_malloc(r*sizeof(slong));
     for (k = 0; k < r; k++)
         subset[k] = k;
@@ -174,6 +390,14 @@ void fmpz_poly_factor_zassenhaus_recombination_with_prune(
     fmpz_poly_struct ** stack;
     fmpz_poly_struct * f;
 
+    if (r >= ZASSENHAUS_THREAD_CUTOFF && flint_get_num_threads() > 1)
+    {
+        _fmpz_poly_factor_zassenhaus_recombination_threaded(final_fac,
+                           lifted_fac, F, P, exp, Z,
+                                                     flint_get_num_threads());
+        return;
+    }
+
     subset = (slong *) flint_malloc(r*sizeof(slong));
     for (k = 0; k < r; k++)
         subset[k] = k;
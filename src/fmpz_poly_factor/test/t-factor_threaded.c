@@ -0,0 +1,115 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_support.h"
+#include "fmpz.h"
+#include "fmpz_poly.h"
+#include "fmpz_poly_factor.h"
+
+/* the threaded code must return exactly the factors of the serial code */
+int
+main(void)
+{
+    slong i, max_threads = 5;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("factor_threaded....");
+    fflush(stdout);
+
+    for (i = 0; i < 40 * flint_test_multiplier(); i++)
+    {
+        fmpz_poly_t f, g, h;
+        fmpz_poly_factor_t fac1, fac2;
+        slong j, n;
+        int van_hoeij = n_randint(state, 2);
+
+        fmpz_poly_init(f);
+        fmpz_poly_init(g);
+        fmpz_poly_init(h);
+        fmpz_poly_factor_init(fac1);
+        fmpz_poly_factor_init(fac2);
+
+        /* many small factors give many modular factors */
+        n = n_randint(state, 12) + 6;
+        fmpz_poly_one(f);
+        for (j = 0; j < n; j++)
+        {
+            do {
+                fmpz_poly_randtest(g, state, n_randint(state, 5) + 2,
+                                                      n_randint(state, 20) + 1);
+            } while (g->length < 2 || fmpz_is_zero(g->coeffs + 0));
+            fmpz_poly_mul(f, f, g);
+        }
+
+        flint_set_num_threads(1);
+        if (van_hoeij)
+            fmpz_poly_factor(fac1, f);
+        else
+            fmpz_poly_factor_zassenhaus(fac1, f);
+
+        flint_set_num_threads(n_randint(state, max_threads) + 2);
+        if (van_hoeij)
+            fmpz_poly_factor(fac2, f);
+        else
+            fmpz_poly_factor_zassenhaus(fac2, f);
+
+        fmpz_poly_set_fmpz(h, &fac2->c);
+        for (j = 0; j < fac2->num; j++)
+        {
+            fmpz_poly_pow(g, fac2->p + j, fac2->exp[j]);
+            fmpz_poly_mul(h, h, g);
+        }
+
+        if (!fmpz_poly_equal(f, h))
+        {
+            flint_printf("FAIL (product):\n");
+            flint_printf("f = "), fmpz_poly_print(f), flint_printf("\n\n");
+            flint_printf("fac2 = "), fmpz_poly_factor_print(fac2), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (fac1->num != fac2->num || !fmpz_equal(&fac1->c, &fac2->c))
+        {
+            flint_printf("FAIL (number of factors):\n");
+            flint_printf("f = "), fmpz_poly_print(f), flint_printf("\n\n");
+            flint_printf("fac1 = "), fmpz_poly_factor_print(fac1), flint_printf("\n\n");
+            flint_printf("fac2 = "), fmpz_poly_factor_print(fac2), flint_printf("\n\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < fac1->num; j++)
+        {
+            if (!fmpz_poly_equal(fac1->p + j, fac2->p + j) ||
+                fac1->exp[j] != fac2->exp[j])
+            {
+                flint_printf("FAIL (factors differ):\n");
+                flint_printf("f = "), fmpz_poly_print(f), flint_printf("\n\n");
+                flint_printf("fac1 = "), fmpz_poly_factor_print(fac1), flint_printf("\n\n");
+                flint_printf("fac2 = "), fmpz_poly_factor_print(fac2), flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        fmpz_poly_clear(f);
+        fmpz_poly_clear(g);
+        fmpz_poly_clear(h);
+        fmpz_poly_factor_clear(fac1);
+        fmpz_poly_factor_clear(fac2);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -13,8 +13,78 @@
 #ifdef T
 
 #include "templates.h"
+#include "thread_support.h"
 #include "fmpz_mat.h"
 
+typedef struct
+{
+    TEMPLATE(T, struct) ** rows;
+    fmpz ** frows;
+    slong c;
+    flint_bitcnt_t bits;
+    const TEMPLATE(T, ctx_struct) * ctx;
+}
+TEMPLATE(T, mat_mul_KS_arg_t);
+
+static void
+TEMPLATE(T, mat_mul_KS_pack_worker) (slong i, void * varg)
+{
+    TEMPLATE(T, mat_mul_KS_arg_t) * arg = varg;
+    slong j;
+
+    for (j = 0; j < arg->c; j++)
+        TEMPLATE(T, bit_pack) (arg->frows[i] + j, arg->rows[i] + j,
+                                                         arg->bits, arg->ctx);
+}
+
+static void
+TEMPLATE(T, mat_mul_KS_unpack_worker) (slong i, void * varg)
+{
+    TEMPLATE(T, mat_mul_KS_arg_t) * arg = varg;
+    slong j;
+
+    for (j = 0; j < arg->c; j++)
+        TEMPLATE(T, bit_unpack) (arg->rows[i] + j, arg->frows[i] + j,
+                                                         arg->bits, arg->ctx);
+}
+
+/*
+    Packing and unpacking are done row by row in parallel when this is
+    worthwhile; the integer product is threaded by fmpz_mat_mul itself.
+*/
+static void
+TEMPLATE(T, mat_mul_KS_convert) (TEMPLATE(T, struct) ** rows, fmpz ** frows,
+                        slong r, slong c, flint_bitcnt_t bits, int unpack,
+                        const TEMPLATE(T, ctx_t) ctx)
+{
+    TEMPLATE(T, mat_mul_KS_arg_t) arg;
+    slong i;
+
+    arg.rows = rows;
+    arg.frows = frows;
+    arg.c = c;
+    arg.bits = bits;
+    arg.ctx = ctx;
+
+    if (r >= 2 && flint_get_num_threads() >= 2 &&
+        (double) r * c * TEMPLATE(T, ctx_degree) (ctx) >= 4000.0)
+    {
+        flint_parallel_do(unpack ? TEMPLATE(T, mat_mul_KS_unpack_worker)
+                                 : TEMPLATE(T, mat_mul_KS_pack_worker),
+                                  &arg, r, 0, FLINT_PARALLEL_UNIFORM);
+    }
+    else
+    {
+        for (i = 0; i < r; i++)
+        {
+            if (unpack)
+                TEMPLATE(T, mat_mul_KS_unpack_worker) (i, &arg);
+            else
+                TEMPLATE(T, mat_mul_KS_pack_worker) (i, &arg);
+        }
+    }
+}
+
 void
 TEMPLATE(T, mat_mul_KS) (TEMPLATE(T, mat_t) C,
                          const TEMPLATE(T, mat_t) A,
@@ -23,7 +93,6 @@ TEMPLATE(T, mat_mul_KS) (TEMPLATE(T, mat_t) C,
 {
     slong bits;
     slong ar, bc, br;
-    slong i, j;
     fmpz_mat_t fa, fb, fc;
     fmpz_t beta;
 
@@ -53,28 +122,14 @@ TEMPLATE(T, mat_mul_KS) (TEMPLATE(T, mat_t) C,
     fmpz_mat_init(fb, B->r, B->c);
     fmpz_mat_init(fc, A->r, B->c);
 
-    for (i = 0; i < A->r; i++)
-        for (j = 0; j < A->c; j++)
-            TEMPLATE(T, bit_pack) (fmpz_mat_entry(fa, i, j),
-                                   TEMPLATE(T, mat_entry) (A, i, j), bits,
-                                   ctx);
-
-    for (i = 0; i < B->r; i++)
-        for (j = 0; j < B->c; j++)
-            TEMPLATE(T, bit_pack) (fmpz_mat_entry(fb, i, j),
-                                   TEMPLATE(T, mat_entry) (B, i, j), bits,
-                                   ctx);
+    TEMPLATE(T, mat_mul_KS_convert) (A->rows, fa->rows, A->r, A->c,
+                                                             bits, 0, ctx);
+    TEMPLATE(T, mat_mul_KS_convert) (B->rows, fb->rows, B->r, B->c,
+                                                             bits, 0, ctx);
 
     fmpz_mat_mul(fc, fa, fb);
 
-    for (i = 0; i < ar; i++)
-    {
-        for (j = 0; j < bc; j++)
-        {
-            TEMPLATE(T, bit_unpack) (TEMPLATE(T, mat_entry) (C, i, j),
-                                     fmpz_mat_entry(fc, i, j), bits, ctx);
-        }
-    }
+    TEMPLATE(T, mat_mul_KS_convert) (C->rows, fc->rows, ar, bc, bits, 1, ctx);
 
     fmpz_mat_clear(fa);
     fmpz_mat_clear(fb);
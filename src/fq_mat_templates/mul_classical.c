@@ -13,6 +13,29 @@
 #ifdef T
 
 #include "templates.h"
+#include "thread_support.h"
+
+typedef struct
+{
+    TEMPLATE(T, struct) ** Crows;
+    TEMPLATE(T, struct) * const * Arows;
+    const TEMPLATE(T, struct) * trB;
+    slong br;
+    slong bc;
+    const TEMPLATE(T, ctx_struct) * ctx;
+}
+TEMPLATE(T, mat_mul_classical_arg_t);
+
+static void
+TEMPLATE(T, mat_mul_classical_worker) (slong i, void * varg)
+{
+    TEMPLATE(T, mat_mul_classical_arg_t) * arg = varg;
+    slong j;
+
+    for (j = 0; j < arg->bc; j++)
+        _TEMPLATE(T, vec_dot) (arg->Crows[i] + j, arg->Arows[i],
+                                  arg->trB + j * arg->br, arg->br, arg->ctx);
+}
 
 void
 TEMPLATE(T, mat_mul_classical) (TEMPLATE(T, mat_t) C,
@@ -56,13 +79,32 @@ TEMPLATE(T, mat_mul_classical) (TEMPLATE(T, mat_t) C,
           trB[j*br + i] = *TEMPLATE(T, mat_entry) (B, i, j);
     }
 
-    for (i = 0; i < ar; i++)
+    /* the rows of C are independent */
+    if (ar >= 2 && flint_get_num_threads() >= 2 &&
+        (double) ar * bc * br * TEMPLATE(T, ctx_degree) (ctx) >= 20000.0)
+    {
+        TEMPLATE(T, mat_mul_classical_arg_t) arg;
+
+        arg.Crows = C->rows;
+        arg.Arows = A->rows;
+        arg.trB = trB;
+        arg.br = br;
+        arg.bc = bc;
+        arg.ctx = ctx;
+
+        flint_parallel_do(TEMPLATE(T, mat_mul_classical_worker), &arg, ar,
+                                                   0, FLINT_PARALLEL_UNIFORM);
+    }
+    else
     {
-        for (j = 0; j < bc; j++)
+        for (i = 0; i < ar; i++)
         {
-            _TEMPLATE(T, vec_dot) (TEMPLATE(T, mat_entry) (C, i, j),
-               A->rows[i], trB + j * br, br, ctx);
+            for (j = 0; j < bc; j++)
+            {
+                _TEMPLATE(T, vec_dot) (TEMPLATE(T, mat_entry) (C, i, j),
+                   A->rows[i], trB + j * br, br, ctx);
 
+            }
         }
     }
 
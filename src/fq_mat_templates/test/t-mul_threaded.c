@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifdef T
+
+#include "templates.h"
+#include "thread_support.h"
+
+int
+main(void)
+{
+    slong i;
+    FLINT_TEST_INIT(state);
+
+    printf("mul_threaded....");
+    fflush(stdout);
+
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        TEMPLATE(T, ctx_t) ctx;
+        TEMPLATE(T, mat_t) A, B, C, D, E;
+        slong m, k, n, j, r1, r2;
+        slong * P1, * P2;
+
+        TEMPLATE(T, ctx_randtest) (ctx, state);
+
+        m = n_randint(state, 60) + 1;
+        k = n_randint(state, 60) + 1;
+        n = n_randint(state, 60) + 1;
+
+        TEMPLATE(T, mat_init) (A, m, k, ctx);
+        TEMPLATE(T, mat_init) (B, k, n, ctx);
+        TEMPLATE(T, mat_init) (C, m, n, ctx);
+        TEMPLATE(T, mat_init) (D, m, n, ctx);
+        TEMPLATE(T, mat_init) (E, m, n, ctx);
+
+        TEMPLATE(T, mat_randtest) (A, state, ctx);
+        TEMPLATE(T, mat_randtest) (B, state, ctx);
+
+        flint_set_num_threads(1);
+        TEMPLATE(T, mat_mul_classical) (C, A, B, ctx);
+
+        flint_set_num_threads(n_randint(state, 4) + 2);
+        TEMPLATE(T, mat_mul_classical) (D, A, B, ctx);
+        TEMPLATE(T, mat_mul_KS) (E, A, B, ctx);
+
+        if (!TEMPLATE(T, mat_equal) (C, D, ctx) ||
+            !TEMPLATE(T, mat_equal) (C, E, ctx))
+        {
+            printf("FAIL (mul):\n");
+            printf("A:\n");
+            TEMPLATE(T, mat_print) (A, ctx);
+            printf("B:\n");
+            TEMPLATE(T, mat_print) (B, ctx);
+            printf("C:\n");
+            TEMPLATE(T, mat_print) (C, ctx);
+            printf("D:\n");
+            TEMPLATE(T, mat_print) (D, ctx);
+            printf("E:\n");
+            TEMPLATE(T, mat_print) (E, ctx);
+            printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* LU decomposition of C, which reduces to multiplication */
+        P1 = flint_malloc(sizeof(slong) * m);
+        P2 = flint_malloc(sizeof(slong) * m);
+        TEMPLATE(T, mat_set) (D, C, ctx);
+
+        r2 = TEMPLATE(T, mat_lu) (P2, D, 0, ctx);
+
+        flint_set_num_threads(1);
+        r1 = TEMPLATE(T, mat_lu) (P1, C, 0, ctx);
+
+        if (r1 != r2 || !TEMPLATE(T, mat_equal) (C, D, ctx))
+        {
+            printf("FAIL (lu):\n");
+            flint_printf("r1 = %wd, r2 = %wd\n", r1, r2);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < m; j++)
+        {
+            if (P1[j] != P2[j])
+            {
+                printf("FAIL (lu permutation):\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        flint_free(P1);
+        flint_free(P2);
+
+        TEMPLATE(T, mat_clear) (A, ctx);
+        TEMPLATE(T, mat_clear) (B, ctx);
+        TEMPLATE(T, mat_clear) (C, ctx);
+        TEMPLATE(T, mat_clear) (D, ctx);
+        TEMPLATE(T, mat_clear) (E, ctx);
+
+        TEMPLATE(T, ctx_clear) (ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+    printf("PASS\n");
+    return 0;
+}
+
+
+#endif
@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "flint.h"
+
+/*
+    _flint_cpu_features holds the FLINT_CPU_* flags of the features which the
+    dispatched kernels may use. It is filled in once by a constructor when the
+    library is loaded, so that the kernels only need to test a global word.
+    Compilers without constructor support leave it zero until the first call
+    to flint_get_cpu_features, which just means the generic code is used.
+*/
+
+ulong _flint_cpu_features = 0;
+
+static ulong _flint_cpu_features_detected = 0;
+static int _flint_cpu_features_init = 0;
+
+#if FLINT_X86_DISPATCH
+
+static ulong _flint_cpu_detect(void)
+{
+    ulong f = 0;
+
+    /* these also check that the operating system saves the registers */
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        f |= FLINT_CPU_X86_AVX2;
+    if (__builtin_cpu_supports("fma"))
+        f |= FLINT_CPU_X86_FMA;
+    if (__builtin_cpu_supports("bmi2"))
+        f |= FLINT_CPU_X86_BMI2;
+    if (__builtin_cpu_supports("avx512f"))
+        f |= FLINT_CPU_X86_AVX512F;
+
+    return f;
+}
+
+#else
+
+static ulong _flint_cpu_detect(void)
+{
+    return 0;
+}
+
+#endif
+
+static void _flint_cpu_features_initialise(void)
+{
+    _flint_cpu_features_detected = _flint_cpu_detect();
+    _flint_cpu_features = _flint_cpu_features_detected;
+    _flint_cpu_features_init = 1;
+}
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+static void _flint_cpu_features_constructor(void)
+{
+    _flint_cpu_features_initialise();
+}
+#endif
+
+ulong flint_get_cpu_features(void)
+{
+    if (!_flint_cpu_features_init)
+        _flint_cpu_features_initialise();
+
+    return _flint_cpu_features;
+}
+
+void flint_set_cpu_features(ulong features)
+{
+    if (!_flint_cpu_features_init)
+        _flint_cpu_features_initialise();
+
+    _flint_cpu_features = features & _flint_cpu_features_detected;
+}
@@ -140,6 +140,53 @@ typedef struct mpoly_heap_s
    void * next;
 } mpoly_heap_s;
 
+/* workspace *****************************************************************/
+
+/*
+    Scratch space for the heap algorithms that is kept between calls. Memory
+    is handed out from one block; requests that do not fit go to extra blocks
+    which are merged into the main block when the outermost user releases the
+    workspace, so that repeated calls of similar size allocate nothing.
+    The main block is not grown beyond MPOLY_WORKSPACE_MAX_ALLOC bytes.
+*/
+#define MPOLY_WORKSPACE_MAX_ALLOC (WORD(1) << 24)
+
+typedef struct
+{
+    char * base;
+    slong alloc;
+    slong used;
+    slong overflow;
+    void * extra;
+    slong depth;
+} mpoly_workspace_struct;
+
+typedef mpoly_workspace_struct mpoly_workspace_t[1];
+
+void mpoly_workspace_init(mpoly_workspace_t W);
+
+void mpoly_workspace_clear(mpoly_workspace_t W);
+
+void * mpoly_workspace_alloc(mpoly_workspace_t W, slong size);
+
+/* the following accept W = NULL, meaning that TMP_ALLOC is used instead */
+
+MPOLY_INLINE
+slong mpoly_workspace_start(mpoly_workspace_struct * W)
+{
+    if (W == NULL)
+        return 0;
+    W->depth++;
+    return W->used;
+}
+
+void mpoly_workspace_end(mpoly_workspace_struct * W, slong mark);
+
+mpoly_workspace_struct * mpoly_workspace_default(void);
+
+#define MPOLY_WORKSPACE_ALLOC(W, size) \
+    ((W) != NULL ? mpoly_workspace_alloc(W, size) : TMP_ALLOC(size))
+
 /* trees *********************************************************************/
 
 /* red-black with ui keys */
@@ -1320,6 +1367,7 @@ void mpoly_from_mpolyl_perm_inflate(
 #define MPOLY_GCD_USE_ZIPPEL2 8
 #define MPOLY_GCD_USE_PRS     16
 #define MPOLY_GCD_USE_ALL     31
+#define MPOLY_GCD_USE_SPARSE_INTERP 32  /* only on request, not part of ALL */
 
 typedef struct
 {
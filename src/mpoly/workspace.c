@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "mpoly.h"
+
+/* keep everything aligned for ulong, pointers and fmpz */
+#define WORKSPACE_ALIGN 16
+#define WORKSPACE_ROUND(size) \
+    (((size) + WORKSPACE_ALIGN - 1) & ~(slong)(WORKSPACE_ALIGN - 1))
+
+void mpoly_workspace_init(mpoly_workspace_t W)
+{
+    W->base = NULL;
+    W->alloc = 0;
+    W->used = 0;
+    W->overflow = 0;
+    W->extra = NULL;
+    W->depth = 0;
+}
+
+static void _workspace_free_extra(mpoly_workspace_t W)
+{
+    while (W->extra != NULL)
+    {
+        void * next = *(void **) W->extra;
+        flint_free(W->extra);
+        W->extra = next;
+    }
+}
+
+void mpoly_workspace_clear(mpoly_workspace_t W)
+{
+    FLINT_ASSERT(W->depth == 0);
+    _workspace_free_extra(W);
+    flint_free(W->base);
+}
+
+void * mpoly_workspace_alloc(mpoly_workspace_t W, slong size)
+{
+    char * p;
+
+    FLINT_ASSERT(W->depth > 0);
+    FLINT_ASSERT(size >= 0);
+
+    size = WORKSPACE_ROUND(size);
+
+    if (W->base != NULL && W->used + size <= W->alloc)
+    {
+        p = W->base + W->used;
+        W->used += size;
+        return p;
+    }
+
+    /* does not fit: chain an extra block and remember the shortfall */
+    p = (char *) flint_malloc(WORKSPACE_ALIGN + size);
+    *(void **) p = W->extra;
+    W->extra = p;
+    W->overflow += size;
+
+    return p + WORKSPACE_ALIGN;
+}
+
+void mpoly_workspace_end(mpoly_workspace_struct * W, slong mark)
+{
+    slong new_alloc;
+
+    if (W == NULL)
+        return;
+
+    FLINT_ASSERT(W->depth > 0);
+    FLINT_ASSERT(0 <= mark && mark <= W->used);
+
+    W->used = mark;
+    W->depth--;
+
+    if (W->depth > 0 || W->extra == NULL)
+        return;
+
+    /* grow the main block so that the same requests fit next time, but
+       never keep more than MPOLY_WORKSPACE_MAX_ALLOC bytes around */
+    _workspace_free_extra(W);
+    new_alloc = FLINT_MIN(W->alloc + W->overflow, MPOLY_WORKSPACE_MAX_ALLOC);
+    W->overflow = 0;
+
+    if (new_alloc > W->alloc)
+    {
+        flint_free(W->base);
+        W->base = (char *) flint_malloc(new_alloc);
+        W->alloc = new_alloc;
+    }
+}
+
+/*
+    A workspace shared between threads would need a lock, so without thread
+    local storage there is no default workspace and the callers fall back to
+    allocating their scratch space on each call.
+*/
+#if FLINT_USES_TLS
+
+FLINT_TLS_PREFIX mpoly_workspace_t _mpoly_default_workspace;
+FLINT_TLS_PREFIX int _mpoly_default_workspace_initialized = 0;
+
+static void _mpoly_default_workspace_cleanup(void)
+{
+    if (_mpoly_default_workspace_initialized)
+    {
+        _mpoly_default_workspace_initialized = 0;
+        mpoly_workspace_clear(_mpoly_default_workspace);
+    }
+}
+
+mpoly_workspace_struct * mpoly_workspace_default(void)
+{
+    if (!_mpoly_default_workspace_initialized)
+    {
+        mpoly_workspace_init(_mpoly_default_workspace);
+        flint_register_cleanup_function(_mpoly_default_workspace_cleanup);
+        _mpoly_default_workspace_initialized = 1;
+    }
+
+    return _mpoly_default_workspace;
+}
+
+#else
+
+mpoly_workspace_struct * mpoly_workspace_default(void)
+{
+    return NULL;
+}
+
+#endif
@@ -826,6 +826,11 @@ int nmod_mpoly_compose_nmod_mpoly(nmod_mpoly_t A,
                     const nmod_mpoly_t B, nmod_mpoly_struct * const * C,
                     const nmod_mpoly_ctx_t ctxB, const nmod_mpoly_ctx_t ctxAC);
 
+int _nmod_mpoly_compose_nmod_mpoly_threaded_pool(nmod_mpoly_t A,
+                     const nmod_mpoly_t B, nmod_mpoly_struct * const * C,
+                     const nmod_mpoly_ctx_t ctxB, const nmod_mpoly_ctx_t ctxAC,
+                        const thread_pool_handle * handles, slong num_handles);
+
 void nmod_mpoly_compose_nmod_mpoly_gen(nmod_mpoly_t A,
                     const nmod_mpoly_t B, const slong * c,
                     const nmod_mpoly_ctx_t ctxB, const nmod_mpoly_ctx_t ctxAC);
@@ -861,6 +866,13 @@ void _nmod_mpoly_mul_johnson_maxfields(nmod_mpoly_t A,
                                  const nmod_mpoly_t C, fmpz * maxCfields,
                                                    const nmod_mpoly_ctx_t ctx);
 
+void _nmod_mpoly_mul_heap_threaded(nmod_mpoly_t A,
+                 const mp_limb_t * Bcoeff, const ulong * Bexp, slong Blen,
+                 const mp_limb_t * Ccoeff, const ulong * Cexp, slong Clen,
+                 flint_bitcnt_t bits, slong N, const ulong * cmpmask,
+                                                   const nmod_mpoly_ctx_t ctx,
+                        const thread_pool_handle * handles, slong num_handles);
+
 void _nmod_mpoly_mul_heap_threaded_pool_maxfields(nmod_mpoly_t A,
            const nmod_mpoly_t B, fmpz * maxBfields,
            const nmod_mpoly_t C, fmpz * maxCfields, const nmod_mpoly_ctx_t ctx,
@@ -897,6 +909,13 @@ void _nmod_mpoly_pow_rmul(nmod_mpoly_t A, const mp_limb_t * Bcoeffs,
                             const ulong * Bexps, slong Blen, ulong k, slong N,
                             const ulong * cmpmask, nmod_t mod, nmod_mpoly_t T);
 
+void _nmod_mpoly_pow_rmul_threaded_pool(nmod_mpoly_t A,
+                            const mp_limb_t * Bcoeffs, const ulong * Bexps,
+                            slong Blen, ulong k, slong N,
+                            const ulong * cmpmask, const nmod_mpoly_ctx_t ctx,
+                            nmod_mpoly_t T, const thread_pool_handle * handles,
+                                                            slong num_handles);
+
 void nmod_mpoly_pow_rmul(nmod_mpoly_t A, const nmod_mpoly_t B,
                                           ulong k, const nmod_mpoly_ctx_t ctx);
 
@@ -1043,6 +1062,34 @@ void nmod_mpoly_deflate(nmod_mpoly_t A, const nmod_mpoly_t B,
 void nmod_mpoly_inflate(nmod_mpoly_t A, const nmod_mpoly_t B,
           const fmpz * shift, const fmpz * stride, const nmod_mpoly_ctx_t ctx);
 
+/* Vectors of multivariate polynomials */
+
+typedef struct
+{
+    nmod_mpoly_struct * p;
+    slong alloc;
+    slong length;
+}
+nmod_mpoly_vec_struct;
+
+typedef nmod_mpoly_vec_struct nmod_mpoly_vec_t[1];
+
+#define nmod_mpoly_vec_entry(vec, i) ((vec)->p + (i))
+
+void nmod_mpoly_vec_init(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_print(const nmod_mpoly_vec_t F, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_swap(nmod_mpoly_vec_t x, nmod_mpoly_vec_t y, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_fit_length(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_clear(nmod_mpoly_vec_t vec, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_set(nmod_mpoly_vec_t dest, const nmod_mpoly_vec_t src, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_append(nmod_mpoly_vec_t vec, const nmod_mpoly_t f, const nmod_mpoly_ctx_t ctx);
+void nmod_mpoly_vec_set_length(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx);
+
+/* Ideals and Groebner bases */
+
+int nmod_mpoly_groebner_f4(nmod_mpoly_vec_t G, const nmod_mpoly_vec_t F, const nmod_mpoly_ctx_t ctx);
+int nmod_mpoly_vec_is_groebner(const nmod_mpoly_vec_t G, const nmod_mpoly_vec_t F, const nmod_mpoly_ctx_t ctx);
+
 
 /******************************************************************************
 
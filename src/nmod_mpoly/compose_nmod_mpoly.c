@@ -10,6 +10,7 @@
 */
 
 #include "fmpz_mat.h"
+#include "thread_support.h"
 #include "nmod_mpoly.h"
 
 /* evaluate B(xbar) at xbar = C */
@@ -19,6 +20,9 @@ int nmod_mpoly_compose_nmod_mpoly(nmod_mpoly_t A,
 {
     slong i;
     fmpz_mat_t M;
+    thread_pool_handle * handles;
+    slong num_handles;
+    int success;
 
     FLINT_ASSERT(A != B);
 
@@ -61,14 +65,10 @@ matrix_no_good:
 
     fmpz_mat_clear(M);
 
-    for (i = 0; i < ctxB->minfo->nvars; i++)
-    {
-        if (C[i]->length > 1)
-        {
-            return nmod_mpoly_compose_nmod_mpoly_horner(A, B, C, ctxB, ctxAC);
-        }
-    }
+    num_handles = flint_request_threads(&handles, B->length/8);
+    success = _nmod_mpoly_compose_nmod_mpoly_threaded_pool(A, B, C,
+                                          ctxB, ctxAC, handles, num_handles);
+    flint_give_back_threads(handles, num_handles);
 
-    return nmod_mpoly_compose_nmod_mpoly_geobucket(A, B, C, ctxB, ctxAC);
+    return success;
 }
-
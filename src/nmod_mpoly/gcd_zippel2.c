@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "nmod_mpoly.h"
 #include "nmod_mpoly_factor.h"
 #include "fq_nmod_mpoly.h"
@@ -483,6 +484,141 @@ static void fq_nmod_mpoly_monomial_evals2(
     deg(A) = deg(gamma) + deg(A) - deg(G)
     deg(B) = deg(gamma) + deg(B) - deg(G)
 */
+/*
+    The zip images at beta^1, beta^2, ... are independent of each other.
+    They are computed in parallel in contiguous blocks, each block starting
+    from its own power of the monomial evaluations, and are then fed to the
+    interpolation in order. A block stops at its first image that would
+    end the zip loop, since the images after it are not needed.
+*/
+#define ZIP_IMAGE_OK        0
+#define ZIP_IMAGE_BAD_EVAL  1
+#define ZIP_IMAGE_GCD_FAIL  2
+
+typedef struct
+{
+    const n_polyun_struct * Aeh_inc, * Beh_inc;
+    const n_poly_struct * gammaeh_inc;
+    const nmod_mpoly_struct * A, * B, * gamma;
+    const nmod_mpoly_ctx_struct * ctx;
+    ulong Abideg, Bbideg, GdegboundXY;
+    n_bpoly_struct * Gevs, * Abarevs, * Bbarevs;
+    ulong * degs;
+    int * status;
+}
+_zip_images_base_struct;
+
+typedef struct
+{
+    _zip_images_base_struct * base;
+    slong start, stop;
+}
+_zip_images_arg_struct;
+
+static void _zip_images_worker(void * varg)
+{
+    _zip_images_arg_struct * arg = (_zip_images_arg_struct *) varg;
+    _zip_images_base_struct * base = arg->base;
+    const nmod_mpoly_ctx_struct * ctx = base->ctx;
+    n_poly_bpoly_stack_t St;
+    n_polyun_t Aeh_cur, Beh_cur;
+    n_poly_t gammaeh_cur;
+    n_bpoly_t Aev, Bev;
+    mp_limb_t gammaev;
+    slong i, j, k;
+
+    n_poly_stack_init(St->poly_stack);
+    n_bpoly_stack_init(St->bpoly_stack);
+    n_polyun_init(Aeh_cur);
+    n_polyun_init(Beh_cur);
+    n_poly_init(gammaeh_cur);
+    n_bpoly_init(Aev);
+    n_bpoly_init(Bev);
+
+    n_polyun_set(Aeh_cur, base->Aeh_inc);
+    for (i = 0; i < Aeh_cur->length; i++)
+        for (j = 0; j < Aeh_cur->coeffs[i].length; j++)
+            Aeh_cur->coeffs[i].coeffs[j] = nmod_pow_ui(
+                      Aeh_cur->coeffs[i].coeffs[j], arg->start + 1, ctx->mod);
+
+    n_polyun_set(Beh_cur, base->Beh_inc);
+    for (i = 0; i < Beh_cur->length; i++)
+        for (j = 0; j < Beh_cur->coeffs[i].length; j++)
+            Beh_cur->coeffs[i].coeffs[j] = nmod_pow_ui(
+                      Beh_cur->coeffs[i].coeffs[j], arg->start + 1, ctx->mod);
+
+    n_poly_set(gammaeh_cur, base->gammaeh_inc);
+    for (i = 0; i < gammaeh_cur->length; i++)
+        gammaeh_cur->coeffs[i] = nmod_pow_ui(gammaeh_cur->coeffs[i],
+                                                    arg->start + 1, ctx->mod);
+
+    for (k = arg->start; k < arg->stop; k++)
+    {
+        base->status[k] = ZIP_IMAGE_BAD_EVAL;
+
+        n_bpoly_mod_eval_step_sep(Aev, Aeh_cur, base->Aeh_inc, base->A, ctx);
+        n_bpoly_mod_eval_step_sep(Bev, Beh_cur, base->Beh_inc, base->B, ctx);
+        gammaev = n_poly_mod_eval_step_sep(gammaeh_cur, base->gammaeh_inc,
+                                                             base->gamma, ctx);
+        if (gammaev == 0)
+            break;
+        if (Aev->length < 1 || n_bpoly_bidegree(Aev) != base->Abideg)
+            break;
+        if (Bev->length < 1 || n_bpoly_bidegree(Bev) != base->Bbideg)
+            break;
+
+        if (!n_bpoly_mod_gcd_brown_smprime(base->Gevs + k, base->Abarevs + k,
+                                  base->Bbarevs + k, Aev, Bev, ctx->mod, St))
+        {
+            base->status[k] = ZIP_IMAGE_GCD_FAIL;
+            break;
+        }
+
+        base->status[k] = ZIP_IMAGE_OK;
+        base->degs[k] = n_bpoly_bidegree(base->Gevs + k);
+        if (base->degs[k] != base->GdegboundXY)
+            break;
+
+        n_bpoly_scalar_mul_nmod(base->Gevs + k, gammaev, ctx->mod);
+    }
+
+    n_poly_stack_clear(St->poly_stack);
+    n_bpoly_stack_clear(St->bpoly_stack);
+    n_polyun_clear(Aeh_cur);
+    n_polyun_clear(Beh_cur);
+    n_poly_clear(gammaeh_cur);
+    n_bpoly_clear(Aev);
+    n_bpoly_clear(Bev);
+}
+
+static void _zip_images(_zip_images_base_struct * base, slong num_images)
+{
+    thread_pool_handle * handles;
+    slong i, num_handles, num_workers;
+    _zip_images_arg_struct * args;
+
+    num_handles = flint_request_threads(&handles, num_images/2);
+    num_workers = num_handles + 1;
+
+    args = FLINT_ARRAY_ALLOC(num_workers, _zip_images_arg_struct);
+    for (i = 0; i < num_workers; i++)
+    {
+        args[i].base = base;
+        args[i].start = i*num_images/num_workers;
+        args[i].stop = (i + 1)*num_images/num_workers;
+    }
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                             _zip_images_worker, args + i + 1);
+    _zip_images_worker(args + 0);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+    flint_free(args);
+}
+
 int nmod_mpolyl_gcd_zippel_smprime(
     nmod_mpoly_t rG, const slong * rGdegs, /* guess at rG degrees, could be NULL */
     nmod_mpoly_t rAbar,
@@ -502,12 +638,11 @@ int nmod_mpolyl_gcd_zippel_smprime(
     nmod_mpoly_t T, G, Abar, Bbar;
     n_polyun_t HG, HAbar, HBbar, MG, MAbar, MBbar, ZG, ZAbar, ZBbar;
     n_bpoly_t Aev, Bev, Gev, Abarev, Bbarev;
-    mp_limb_t gammaev;
     nmod_mpolyn_t Tn, Gn, Abarn, Bbarn;
     slong lastdeg;
     slong cur_zip_image, req_zip_images, this_length;
-    n_polyun_t Aeh_cur, Aeh_inc, Beh_cur, Beh_inc;
-    n_poly_t gammaeh_cur, gammaeh_inc;
+    n_polyun_t Aeh_inc, Beh_inc;
+    n_poly_t gammaeh_inc;
     n_poly_t modulus, alphapow;
     nmod_mpoly_struct * Aevals, * Bevals;
     nmod_mpoly_struct * gammaevals;
@@ -515,6 +650,12 @@ int nmod_mpolyl_gcd_zippel_smprime(
     mp_limb_t c, start_alpha;
     ulong GdegboundXY, newdegXY, Abideg, Bbideg;
     slong degxAB, degyAB;
+    mp_limb_t gammaev;
+    _zip_images_base_struct zip_base[1];
+    n_bpoly_struct * zip_evs = NULL;
+    ulong * zip_degs = NULL;
+    int * zip_status = NULL;
+    slong zip_images_alloc = 0;
 
     FLINT_ASSERT(bits <= FLINT_BITS);
     FLINT_ASSERT(bits == A->bits);
@@ -578,11 +719,8 @@ int nmod_mpolyl_gcd_zippel_smprime(
     nmod_mpolyn_init(Gn, bits, ctx);
     nmod_mpolyn_init(Abarn, bits, ctx);
     nmod_mpolyn_init(Bbarn, bits, ctx);
-    n_polyun_init(Aeh_cur);
     n_polyun_init(Aeh_inc);
-    n_polyun_init(Beh_cur);
     n_polyun_init(Beh_inc);
-    n_poly_init(gammaeh_cur);
     n_poly_init(gammaeh_inc);
     n_poly_init(modulus);
     n_poly_stack_init(St->poly_stack);
@@ -933,31 +1071,49 @@ choose_alphas:
             nmod_mpoly_monomial_evals2(Aeh_inc, Aevals + m, betas + 2, m, ctx);
             nmod_mpoly_monomial_evals2(Beh_inc, Bevals + m, betas + 2, m, ctx);
             nmod_mpoly_monomial_evals(gammaeh_inc, gammaevals + m, betas + 2, 2, m, ctx);
-            n_polyun_set(Aeh_cur, Aeh_inc);
-            n_polyun_set(Beh_cur, Beh_inc);
-            n_poly_set(gammaeh_cur, gammaeh_inc);
-
             n_polyun_zip_start(ZG, HG, req_zip_images);
             n_polyun_zip_start(ZAbar, HAbar, req_zip_images);
             n_polyun_zip_start(ZBbar, HBbar, req_zip_images);
+
+            if (req_zip_images > zip_images_alloc)
+            {
+                zip_evs = FLINT_ARRAY_REALLOC(zip_evs, 3*req_zip_images, n_bpoly_struct);
+                for (i = 3*zip_images_alloc; i < 3*req_zip_images; i++)
+                    n_bpoly_init(zip_evs + i);
+                zip_degs = FLINT_ARRAY_REALLOC(zip_degs, req_zip_images, ulong);
+                zip_status = FLINT_ARRAY_REALLOC(zip_status, req_zip_images, int);
+                zip_images_alloc = req_zip_images;
+            }
+
+            zip_base->Aeh_inc = Aeh_inc;
+            zip_base->Beh_inc = Beh_inc;
+            zip_base->gammaeh_inc = gammaeh_inc;
+            zip_base->A = Aevals + m;
+            zip_base->B = Bevals + m;
+            zip_base->gamma = gammaevals + m;
+            zip_base->ctx = ctx;
+            zip_base->Abideg = Abideg;
+            zip_base->Bbideg = Bbideg;
+            zip_base->GdegboundXY = GdegboundXY;
+            zip_base->Gevs = zip_evs + 0*req_zip_images;
+            zip_base->Abarevs = zip_evs + 1*req_zip_images;
+            zip_base->Bbarevs = zip_evs + 2*req_zip_images;
+            zip_base->degs = zip_degs;
+            zip_base->status = zip_status;
+            _zip_images(zip_base, req_zip_images);
+
             for (cur_zip_image = 0; cur_zip_image < req_zip_images; cur_zip_image++)
             {
-                n_bpoly_mod_eval_step_sep(Aev, Aeh_cur, Aeh_inc, Aevals + m, ctx);
-                n_bpoly_mod_eval_step_sep(Bev, Beh_cur, Beh_inc, Bevals + m, ctx);
-                gammaev = n_poly_mod_eval_step_sep(gammaeh_cur, gammaeh_inc, gammaevals + m, ctx);
-                if (gammaev == 0)
-                    goto choose_betas;
-                if (Aev->length < 1 || n_bpoly_bidegree(Aev) != Abideg)
-                    goto choose_betas;
-                if (Bev->length < 1 || n_bpoly_bidegree(Bev) != Bbideg)
+                if (zip_status[cur_zip_image] == ZIP_IMAGE_BAD_EVAL)
                     goto choose_betas;
 
-                success = n_bpoly_mod_gcd_brown_smprime(Gev, Abarev, Bbarev,
-                                                            Aev, Bev, ctx->mod, St);
-                if (!success)
+                if (zip_status[cur_zip_image] == ZIP_IMAGE_GCD_FAIL)
+                {
+                    success = 0;
                     goto cleanup;
+                }
 
-                newdegXY = n_bpoly_bidegree(Gev);
+                newdegXY = zip_degs[cur_zip_image];
                 if (newdegXY > GdegboundXY)
                     goto choose_betas;
                 if (newdegXY < GdegboundXY)
@@ -968,12 +1124,14 @@ choose_alphas:
                     goto choose_alphas;
                 }
 
-                n_bpoly_scalar_mul_nmod(Gev, gammaev, ctx->mod);
-                if ((use & USE_G) && !n_polyu2n_add_zip_must_match(ZG, Gev, cur_zip_image))
+                if ((use & USE_G) && !n_polyu2n_add_zip_must_match(ZG,
+                                zip_base->Gevs + cur_zip_image, cur_zip_image))
                     goto choose_alphas;
-                if ((use & USE_ABAR) && !n_polyu2n_add_zip_must_match(ZAbar, Abarev, cur_zip_image))
+                if ((use & USE_ABAR) && !n_polyu2n_add_zip_must_match(ZAbar,
+                             zip_base->Abarevs + cur_zip_image, cur_zip_image))
                     goto choose_alphas;
-                if ((use & USE_BBAR) && !n_polyu2n_add_zip_must_match(ZBbar, Bbarev, cur_zip_image))
+                if ((use & USE_BBAR) && !n_polyu2n_add_zip_must_match(ZBbar,
+                             zip_base->Bbarevs + cur_zip_image, cur_zip_image))
                     goto choose_alphas;
             }
 
@@ -1140,12 +1298,15 @@ cleanup:
     nmod_mpolyn_clear(Gn, ctx);
     nmod_mpolyn_clear(Abarn, ctx);
     nmod_mpolyn_clear(Bbarn, ctx);
-    n_polyun_clear(Aeh_cur);
     n_polyun_clear(Aeh_inc);
-    n_polyun_clear(Beh_cur);
     n_polyun_clear(Beh_inc);
-    n_poly_clear(gammaeh_cur);
     n_poly_clear(gammaeh_inc);
+
+    for (i = 0; i < 3*zip_images_alloc; i++)
+        n_bpoly_clear(zip_evs + i);
+    flint_free(zip_evs);
+    flint_free(zip_degs);
+    flint_free(zip_status);
     n_poly_clear(modulus);
     n_poly_stack_clear(St->poly_stack);
     n_bpoly_stack_clear(St->bpoly_stack);
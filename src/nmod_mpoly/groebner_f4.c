@@ -0,0 +1,911 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "thread_support.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_mpoly.h"
+
+/*
+    Faugere's F4 algorithm over Z/pZ.
+
+    All polynomials of the basis are kept monic and packed into one word per
+    field, so that monomials of the basis and of the matrices can be
+    compared, multiplied and tested for divisibility with the single word
+    routines. The pairs are selected by the normal strategy and pruned with
+    the criteria of Gebauer and Moeller.
+
+    For each set of pairs, the matrix of the multiples of the basis elements
+    is built by symbolic preprocessing and stored with one sparse row per
+    multiple. The rows with distinct leading monomials are the pivots.
+    The remaining rows are reduced by the pivots independently of each
+    other, and this step runs in parallel. The reduced rows are then put
+    into echelon form among themselves and the ones with a new leading
+    monomial are added to the basis.
+*/
+
+/* leading monomials are packed with one word per field */
+#define F4_BITS FLINT_BITS
+
+typedef struct
+{
+    slong i, j;
+    ulong deg;
+    ulong * lcm;
+}
+_f4_pair_struct;
+
+typedef struct
+{
+    slong N;
+    slong nvars;
+    ulong mask;
+    const ulong * cmpmask;
+    const nmod_mpoly_ctx_struct * ctx;
+    /* the basis and the elements used in new pairs */
+    nmod_mpoly_struct * polys;
+    int * active;
+    slong length;
+    slong alloc;
+    /* the critical pairs */
+    _f4_pair_struct * pairs;
+    slong pairs_length;
+    slong pairs_alloc;
+    /* scratch for unpacked exponents and one packed monomial */
+    ulong * t1, * t2;
+    ulong * lcm;
+}
+_f4_struct;
+
+/* hash set of monomials, the indices are in the order of insertion */
+typedef struct
+{
+    slong N;
+    ulong * exps;
+    slong length;
+    slong alloc;
+    slong * table;
+    slong table_mask;
+}
+_f4_monomials_struct;
+
+typedef struct
+{
+    slong length;
+    slong * cols;
+    mp_limb_t * coeffs;
+}
+_f4_row_struct;
+
+/* a row before symbolic preprocessing: mult*polys[idx] */
+typedef struct
+{
+    slong idx;
+    slong lm;
+    ulong * mult;
+}
+_f4_mrow_struct;
+
+static ulong _f4_hash(const ulong * e, slong N)
+{
+    slong i;
+    ulong h = 0;
+
+    for (i = 0; i < N; i++)
+        h = (h ^ e[i])*UWORD(0x9e3779b97f4a7c15);
+
+    return h ^ (h >> (FLINT_BITS/2));
+}
+
+static void _f4_monomials_init(_f4_monomials_struct * M, slong N)
+{
+    slong i;
+
+    M->N = N;
+    M->length = 0;
+    M->alloc = 16;
+    M->exps = FLINT_ARRAY_ALLOC(N*M->alloc, ulong);
+    M->table_mask = 63;
+    M->table = FLINT_ARRAY_ALLOC(M->table_mask + 1, slong);
+    for (i = 0; i <= M->table_mask; i++)
+        M->table[i] = -1;
+}
+
+static void _f4_monomials_clear(_f4_monomials_struct * M)
+{
+    flint_free(M->exps);
+    flint_free(M->table);
+}
+
+/* return the index of e, inserting it if it is new */
+static slong _f4_monomials_insert(_f4_monomials_struct * M, const ulong * e)
+{
+    slong N = M->N;
+    slong i, h;
+
+    h = _f4_hash(e, N) & M->table_mask;
+    while (M->table[h] >= 0)
+    {
+        if (mpoly_monomial_equal(M->exps + N*M->table[h], e, N))
+            return M->table[h];
+        h = (h + 1) & M->table_mask;
+    }
+
+    if (M->length >= M->alloc)
+    {
+        M->alloc *= 2;
+        M->exps = FLINT_ARRAY_REALLOC(M->exps, N*M->alloc, ulong);
+    }
+
+    mpoly_monomial_set(M->exps + N*M->length, e, N);
+    M->table[h] = M->length;
+    M->length++;
+
+    /* keep the table at most half full */
+    if (2*M->length > M->table_mask)
+    {
+        slong j;
+
+        M->table_mask = 2*M->table_mask + 1;
+        M->table = FLINT_ARRAY_REALLOC(M->table, M->table_mask + 1, slong);
+        for (i = 0; i <= M->table_mask; i++)
+            M->table[i] = -1;
+
+        for (j = 0; j < M->length; j++)
+        {
+            h = _f4_hash(M->exps + N*j, N) & M->table_mask;
+            while (M->table[h] >= 0)
+                h = (h + 1) & M->table_mask;
+            M->table[h] = j;
+        }
+    }
+
+    return M->length - 1;
+}
+
+/* stable merge sort of perm[0, n) by descending monomial */
+static void _f4_sort_monomials(slong * perm, slong * tmp, slong n,
+                         const ulong * exps, slong N, const ulong * cmpmask)
+{
+    slong i, j, k, m;
+
+    if (n < 2)
+        return;
+
+    m = n/2;
+    _f4_sort_monomials(perm, tmp, m, exps, N, cmpmask);
+    _f4_sort_monomials(perm + m, tmp, n - m, exps, N, cmpmask);
+
+    for (i = 0, j = m, k = 0; i < m && j < n; k++)
+    {
+        if (mpoly_monomial_gt(exps + N*perm[j], exps + N*perm[i], N, cmpmask))
+            tmp[k] = perm[j++];
+        else
+            tmp[k] = perm[i++];
+    }
+
+    while (i < m)
+        tmp[k++] = perm[i++];
+
+    while (j < n)
+        tmp[k++] = perm[j++];
+
+    for (i = 0; i < n; i++)
+        perm[i] = tmp[i];
+}
+
+/* lm of the basis element i */
+#define F4_LM(S, i) ((S)->polys[i].exps + 0)
+
+/* compute the lcm of the leading monomials of i and j and its degree */
+static ulong _f4_lcm(ulong * lcm, _f4_struct * S, slong i, slong j)
+{
+    const mpoly_ctx_struct * mctx = S->ctx->minfo;
+    slong k;
+    ulong deg = 0;
+
+    mpoly_get_monomial_ui(S->t1, F4_LM(S, i), F4_BITS, mctx);
+    mpoly_get_monomial_ui(S->t2, F4_LM(S, j), F4_BITS, mctx);
+
+    for (k = 0; k < S->nvars; k++)
+    {
+        S->t1[k] = FLINT_MAX(S->t1[k], S->t2[k]);
+        deg += S->t1[k];
+    }
+
+    mpoly_set_monomial_ui(lcm, S->t1, F4_BITS, mctx);
+
+    return deg;
+}
+
+/* the leading monomials of i and j have no variable in common */
+static int _f4_coprime(_f4_struct * S, slong i, slong j)
+{
+    const mpoly_ctx_struct * mctx = S->ctx->minfo;
+    slong k;
+
+    mpoly_get_monomial_ui(S->t1, F4_LM(S, i), F4_BITS, mctx);
+    mpoly_get_monomial_ui(S->t2, F4_LM(S, j), F4_BITS, mctx);
+
+    for (k = 0; k < S->nvars; k++)
+        if (S->t1[k] != 0 && S->t2[k] != 0)
+            return 0;
+
+    return 1;
+}
+
+static void _f4_pairs_fit_length(_f4_struct * S, slong len)
+{
+    slong i;
+
+    if (len <= S->pairs_alloc)
+        return;
+
+    len = FLINT_MAX(len, 2*S->pairs_alloc);
+    S->pairs = FLINT_ARRAY_REALLOC(S->pairs, len, _f4_pair_struct);
+    for (i = S->pairs_alloc; i < len; i++)
+        S->pairs[i].lcm = FLINT_ARRAY_ALLOC(S->N, ulong);
+    S->pairs_alloc = len;
+}
+
+/* swap in place, the lcm buffers stay owned by the array */
+static void _f4_pair_swap(_f4_pair_struct * a, _f4_pair_struct * b)
+{
+    _f4_pair_struct t = *a;
+    *a = *b;
+    *b = t;
+}
+
+/*
+    Add the monic polynomial h to the basis and update the pairs
+    following the procedure UPDATE of Becker and Weispfenning.
+*/
+static void _f4_add(_f4_struct * S, nmod_mpoly_t h)
+{
+    slong N = S->N;
+    slong i, j, k, h_idx, n_new;
+    _f4_pair_struct * C;
+    const ulong * hlm;
+    int keep;
+
+    if (S->length >= S->alloc)
+    {
+        slong new_alloc = FLINT_MAX(S->length + 1, 2*S->alloc);
+        S->polys = FLINT_ARRAY_REALLOC(S->polys, new_alloc, nmod_mpoly_struct);
+        S->active = FLINT_ARRAY_REALLOC(S->active, new_alloc, int);
+        S->alloc = new_alloc;
+    }
+
+    h_idx = S->length;
+    nmod_mpoly_init(S->polys + h_idx, S->ctx);
+    nmod_mpoly_swap(S->polys + h_idx, h, S->ctx);
+    S->active[h_idx] = 1;
+    S->length++;
+    hlm = F4_LM(S, h_idx);
+
+    /* the new pairs {h, g} go to the end of the pair array */
+    n_new = 0;
+    for (i = 0; i < h_idx; i++)
+        n_new += S->active[i];
+
+    _f4_pairs_fit_length(S, S->pairs_length + n_new);
+    C = S->pairs + S->pairs_length;
+
+    for (i = 0, k = 0; i < h_idx; i++)
+    {
+        if (!S->active[i])
+            continue;
+
+        C[k].i = i;
+        C[k].j = h_idx;
+        C[k].deg = _f4_lcm(C[k].lcm, S, i, h_idx);
+        k++;
+    }
+
+    /*
+        Chain criterion among the new pairs: {h, g1} is dropped if the lcm
+        of another new pair {h, g2} still under consideration divides it,
+        unless the leading monomials of h and g1 are coprime, in which case
+        it is kept for now to serve as a witness. C[0, k) are kept, C[k, m)
+        are not yet decided.
+    */
+    for (i = 0, k = 0; i < n_new; i++)
+    {
+        keep = _f4_coprime(S, C[i].i, h_idx);
+
+        if (!keep)
+        {
+            keep = 1;
+
+            for (j = i + 1; j < n_new && keep; j++)
+                if (mpoly_monomial_divides_test(C[i].lcm, C[j].lcm, N, S->mask))
+                    keep = 0;
+
+            for (j = 0; j < k && keep; j++)
+                if (mpoly_monomial_divides_test(C[i].lcm, C[j].lcm, N, S->mask))
+                    keep = 0;
+        }
+
+        if (keep)
+            _f4_pair_swap(C + k++, C + i);
+    }
+
+    /* product criterion */
+    for (i = 0, j = 0; i < k; i++)
+    {
+        if (!_f4_coprime(S, C[i].i, h_idx))
+            _f4_pair_swap(C + j++, C + i);
+    }
+    n_new = j;
+
+    /*
+        Old pairs {g1, g2} are dropped if LM(h) divides their lcm strictly,
+        i.e. their lcm is neither lcm(g1, h) nor lcm(g2, h).
+    */
+    for (i = 0, k = 0; i < S->pairs_length; i++)
+    {
+        _f4_pair_struct * P = S->pairs + i;
+
+        keep = 1;
+
+        if (mpoly_monomial_divides_test(P->lcm, hlm, N, S->mask))
+        {
+            _f4_lcm(S->lcm, S, P->i, h_idx);
+            keep = mpoly_monomial_equal(S->lcm, P->lcm, N);
+            if (!keep)
+            {
+                _f4_lcm(S->lcm, S, P->j, h_idx);
+                keep = mpoly_monomial_equal(S->lcm, P->lcm, N);
+            }
+        }
+
+        if (keep)
+            _f4_pair_swap(S->pairs + k++, P);
+    }
+
+    /* move the new pairs down */
+    for (i = 0; i < n_new; i++)
+        _f4_pair_swap(S->pairs + k + i, S->pairs + S->pairs_length + i);
+
+    S->pairs_length = k + n_new;
+
+    /* the elements whose leading monomial is divisible by LM(h) retire */
+    for (i = 0; i < h_idx; i++)
+    {
+        if (S->active[i] &&
+            mpoly_monomial_divides_test(F4_LM(S, i), hlm, N, S->mask))
+        {
+            S->active[i] = 0;
+        }
+    }
+}
+
+typedef struct
+{
+    volatile slong idx;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    _f4_row_struct * rows;
+    const slong * pivot_of_col;
+    slong ncols;
+    slong start;
+    slong stop;
+    nmod_t mod;
+}
+_f4_reduce_base_struct;
+
+/* row r -= sum of multiples of pivots until no column of r has a pivot */
+static void _f4_reduce_row(_f4_row_struct * r, mp_limb_t * acc,
+                            const _f4_row_struct * rows,
+                            const slong * pivot_of_col, slong ncols, nmod_t mod)
+{
+    slong i, c, first, len;
+
+    if (r->length < 1)
+        return;
+
+    first = r->cols[0];
+    for (i = 0; i < r->length; i++)
+        acc[r->cols[i]] = r->coeffs[i];
+
+    len = 0;
+    for (c = first; c < ncols; c++)
+    {
+        const _f4_row_struct * p;
+        mp_limb_t a = acc[c];
+
+        if (a == 0)
+            continue;
+
+        if (pivot_of_col[c] < 0)
+        {
+            len++;
+            continue;
+        }
+
+        /* the pivots are monic */
+        p = rows + pivot_of_col[c];
+        FLINT_ASSERT(p->cols[0] == c && p->coeffs[0] == 1);
+        a = nmod_neg(a, mod);
+        acc[c] = 0;
+        for (i = 1; i < p->length; i++)
+            NMOD_ADDMUL(acc[p->cols[i]], a, p->coeffs[i], mod);
+    }
+
+    r->cols = FLINT_ARRAY_REALLOC(r->cols, FLINT_MAX(len, 1), slong);
+    r->coeffs = FLINT_ARRAY_REALLOC(r->coeffs, FLINT_MAX(len, 1), mp_limb_t);
+    r->length = len;
+
+    for (c = first, i = 0; i < len; c++)
+    {
+        if (acc[c] == 0)
+            continue;
+
+        r->cols[i] = c;
+        r->coeffs[i] = acc[c];
+        acc[c] = 0;
+        i++;
+    }
+}
+
+static void _f4_reduce_worker(void * varg)
+{
+    _f4_reduce_base_struct * base = (_f4_reduce_base_struct *) varg;
+    mp_limb_t * acc;
+    slong i;
+
+    acc = (mp_limb_t *) flint_calloc(base->ncols, sizeof(mp_limb_t));
+
+get_next_row:
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&base->mutex);
+#endif
+    i = base->idx;
+    base->idx = i + 1;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&base->mutex);
+#endif
+
+    if (i < base->stop)
+    {
+        _f4_reduce_row(base->rows + i, acc, base->rows, base->pivot_of_col,
+                                                      base->ncols, base->mod);
+        goto get_next_row;
+    }
+
+    flint_free(acc);
+}
+
+static int _f4_mrow_cmp(const void * a, const void * b)
+{
+    const slong * x = (const slong *) a;
+    const slong * y = (const slong *) b;
+
+    if (x[0] != y[0])
+        return x[0] < y[0] ? -1 : 1;
+
+    if (x[1] != y[1])
+        return x[1] < y[1] ? -1 : 1;
+
+    return 0;
+}
+
+/* insert the monomials of M[lm]/LM(idx)*polys[idx] */
+static void _f4_insert_row_monomials(_f4_monomials_struct * M,
+                                _f4_struct * S, slong lm, slong idx, ulong * t)
+{
+    slong N = S->N;
+    slong i;
+    const nmod_mpoly_struct * g = S->polys + idx;
+
+    for (i = 0; i < g->length; i++)
+    {
+        mpoly_monomial_sub(t, M->exps + N*lm, F4_LM(S, idx), N);
+        mpoly_monomial_add(t, t, g->exps + N*i, N);
+        _f4_monomials_insert(M, t);
+    }
+}
+
+/*
+    Reduce the pairs S->pairs[0, npairs) and append the polynomials with
+    new leading monomials to V.
+*/
+static void _f4_reduce_pairs(_f4_struct * S, slong npairs,
+                                                  nmod_mpoly_vec_t V)
+{
+    slong N = S->N;
+    const nmod_t mod = S->ctx->mod;
+    _f4_monomials_struct M[1];
+    slong * mrows, * perm, * col_of, * pivot_of_col;
+    slong nmrows, mrows_alloc, npivots, nrows, ncols;
+    char * has_pivot;
+    slong has_pivot_alloc;
+    _f4_row_struct * rows;
+    ulong * t;
+    slong i, j, k, m;
+    mp_limb_t * acc;
+    _f4_reduce_base_struct base[1];
+    thread_pool_handle * handles;
+    slong num_handles;
+
+    t = FLINT_ARRAY_ALLOC(N, ulong);
+    _f4_monomials_init(M, N);
+
+    /* the multiples from the pairs, as (index of lm, basis index) */
+    mrows_alloc = 2*npairs + 16;
+    mrows = FLINT_ARRAY_ALLOC(2*mrows_alloc, slong);
+    nmrows = 0;
+    for (i = 0; i < npairs; i++)
+    {
+        m = _f4_monomials_insert(M, S->pairs[i].lcm);
+        mrows[2*nmrows + 0] = m;
+        mrows[2*nmrows + 1] = S->pairs[i].i;
+        nmrows++;
+        mrows[2*nmrows + 0] = m;
+        mrows[2*nmrows + 1] = S->pairs[i].j;
+        nmrows++;
+    }
+
+    qsort(mrows, nmrows, 2*sizeof(slong), _f4_mrow_cmp);
+
+    for (i = 0, j = 0; i < nmrows; i++)
+    {
+        if (j > 0 && _f4_mrow_cmp(mrows + 2*(j - 1), mrows + 2*i) == 0)
+            continue;
+        mrows[2*j + 0] = mrows[2*i + 0];
+        mrows[2*j + 1] = mrows[2*i + 1];
+        j++;
+    }
+    nmrows = j;
+
+    for (i = 0; i < nmrows; i++)
+        _f4_insert_row_monomials(M, S, mrows[2*i + 0], mrows[2*i + 1], t);
+
+    /*
+        Symbolic preprocessing: every monomial that is divisible by a
+        leading monomial of the basis gets a pivot. The monomials are
+        visited in the order of insertion, which includes the monomials
+        inserted by the reducers themselves.
+    */
+    has_pivot_alloc = M->length + 16;
+    has_pivot = (char *) flint_calloc(has_pivot_alloc, sizeof(char));
+    for (i = 0; i < nmrows; i++)
+        has_pivot[mrows[2*i + 0]] = 1;
+
+    for (m = 0; m < M->length; m++)
+    {
+        slong best = -1;
+
+        if (m >= has_pivot_alloc)
+        {
+            slong new_alloc = FLINT_MAX(M->length, 2*has_pivot_alloc);
+            has_pivot = FLINT_ARRAY_REALLOC(has_pivot, new_alloc, char);
+            memset(has_pivot + has_pivot_alloc, 0, new_alloc - has_pivot_alloc);
+            has_pivot_alloc = new_alloc;
+        }
+
+        if (has_pivot[m])
+            continue;
+
+        for (i = 0; i < S->length; i++)
+        {
+            if (!mpoly_monomial_divides_test(M->exps + N*m, F4_LM(S, i),
+                                                                N, S->mask))
+            {
+                continue;
+            }
+
+            if (best < 0 || S->polys[i].length < S->polys[best].length)
+                best = i;
+        }
+
+        if (best < 0)
+            continue;
+
+        has_pivot[m] = 1;
+
+        if (nmrows >= mrows_alloc)
+        {
+            mrows_alloc = 2*mrows_alloc;
+            mrows = FLINT_ARRAY_REALLOC(mrows, 2*mrows_alloc, slong);
+        }
+
+        mrows[2*nmrows + 0] = m;
+        mrows[2*nmrows + 1] = best;
+        nmrows++;
+
+        _f4_insert_row_monomials(M, S, m, best, t);
+    }
+
+    /* columns in descending order of monomial */
+    ncols = M->length;
+    perm = FLINT_ARRAY_ALLOC(3*ncols, slong);
+    col_of = perm + ncols;
+    pivot_of_col = col_of + ncols;
+    for (i = 0; i < ncols; i++)
+        perm[i] = i;
+    _f4_sort_monomials(perm, col_of, ncols, M->exps, N, S->cmpmask);
+    for (i = 0; i < ncols; i++)
+    {
+        col_of[perm[i]] = i;
+        pivot_of_col[i] = -1;
+    }
+
+    /*
+        The pivots come first: the reducers and the first multiple for each
+        leading monomial of the pairs. The other multiples follow.
+    */
+    npivots = 0;
+    for (i = 0; i < nmrows; i++)
+    {
+        slong c = col_of[mrows[2*i + 0]];
+        if (pivot_of_col[c] == -1)
+        {
+            pivot_of_col[c] = -2;
+            npivots++;
+        }
+    }
+
+    rows = FLINT_ARRAY_ALLOC(nmrows, _f4_row_struct);
+    for (i = 0, j = 0, k = npivots; i < nmrows; i++)
+    {
+        slong lm = mrows[2*i + 0];
+        slong idx = mrows[2*i + 1];
+        const nmod_mpoly_struct * g = S->polys + idx;
+        _f4_row_struct * r;
+        slong l;
+
+        if (pivot_of_col[col_of[lm]] == -2)
+        {
+            pivot_of_col[col_of[lm]] = j;
+            r = rows + j++;
+        }
+        else
+        {
+            r = rows + k++;
+        }
+
+        r->length = g->length;
+        r->cols = FLINT_ARRAY_ALLOC(g->length, slong);
+        r->coeffs = FLINT_ARRAY_ALLOC(g->length, mp_limb_t);
+        for (l = 0; l < g->length; l++)
+        {
+            mpoly_monomial_sub(t, M->exps + N*lm, F4_LM(S, idx), N);
+            mpoly_monomial_add(t, t, g->exps + N*l, N);
+            r->cols[l] = col_of[_f4_monomials_insert(M, t)];
+            r->coeffs[l] = g->coeffs[l];
+        }
+    }
+
+    nrows = nmrows;
+    FLINT_ASSERT(M->length == ncols);
+
+    /* reduce the non pivot rows by the pivots in parallel */
+    base->idx = npivots;
+    base->rows = rows;
+    base->pivot_of_col = pivot_of_col;
+    base->ncols = ncols;
+    base->start = npivots;
+    base->stop = nrows;
+    base->mod = mod;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&base->mutex, NULL);
+#endif
+
+    num_handles = flint_request_threads(&handles, (nrows - npivots)/16);
+
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wake(global_thread_pool, handles[i], 0,
+                                                       _f4_reduce_worker, base);
+    _f4_reduce_worker(base);
+    for (i = 0; i < num_handles; i++)
+        thread_pool_wait(global_thread_pool, handles[i]);
+
+    flint_give_back_threads(handles, num_handles);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&base->mutex);
+#endif
+
+    /* echelon form of the reduced rows */
+    acc = (mp_limb_t *) flint_calloc(ncols, sizeof(mp_limb_t));
+    for (i = npivots; i < nrows; i++)
+    {
+        _f4_row_struct * r = rows + i;
+        nmod_mpoly_struct * h;
+        mp_limb_t c;
+
+        _f4_reduce_row(r, acc, rows, pivot_of_col, ncols, mod);
+
+        if (r->length < 1)
+            continue;
+
+        c = nmod_inv(r->coeffs[0], mod);
+        _nmod_vec_scalar_mul_nmod(r->coeffs, r->coeffs, r->length, c, mod);
+        pivot_of_col[r->cols[0]] = i;
+
+        nmod_mpoly_vec_fit_length(V, V->length + 1, S->ctx);
+        h = V->p + V->length;
+        V->length++;
+
+        nmod_mpoly_fit_length_reset_bits(h, r->length, F4_BITS, S->ctx);
+        for (j = 0; j < r->length; j++)
+        {
+            h->coeffs[j] = r->coeffs[j];
+            mpoly_monomial_set(h->exps + N*j, M->exps + N*perm[r->cols[j]], N);
+        }
+        h->length = r->length;
+    }
+    flint_free(acc);
+
+    for (i = 0; i < nrows; i++)
+    {
+        flint_free(rows[i].cols);
+        flint_free(rows[i].coeffs);
+    }
+    flint_free(rows);
+    flint_free(perm);
+    flint_free(has_pivot);
+    flint_free(mrows);
+    _f4_monomials_clear(M);
+    flint_free(t);
+}
+
+int nmod_mpoly_groebner_f4(nmod_mpoly_vec_t G, const nmod_mpoly_vec_t F,
+                                                    const nmod_mpoly_ctx_t ctx)
+{
+    _f4_struct S[1];
+    nmod_mpoly_vec_t V;
+    nmod_mpoly_t h;
+    nmod_mpoly_struct ** B, ** Q;
+    slong i, j, k, npairs, Blen;
+    ulong mindeg;
+
+    if (!n_is_prime(ctx->mod.n))
+        return 0;
+
+    S->N = mpoly_words_per_exp_sp(F4_BITS, ctx->minfo);
+    S->nvars = ctx->minfo->nvars;
+    S->mask = mpoly_overflow_mask_sp(F4_BITS);
+    S->ctx = ctx;
+    S->cmpmask = (ulong *) flint_malloc(S->N*sizeof(ulong));
+    mpoly_get_cmpmask((ulong *) S->cmpmask, S->N, F4_BITS, ctx->minfo);
+    S->polys = NULL;
+    S->active = NULL;
+    S->length = 0;
+    S->alloc = 0;
+    S->pairs = NULL;
+    S->pairs_length = 0;
+    S->pairs_alloc = 0;
+    S->t1 = FLINT_ARRAY_ALLOC(2*S->nvars + S->N + 1, ulong);
+    S->t2 = S->t1 + S->nvars;
+    S->lcm = S->t2 + S->nvars;
+
+    nmod_mpoly_init(h, ctx);
+    nmod_mpoly_vec_init(V, 0, ctx);
+
+    for (i = 0; i < F->length; i++)
+    {
+        if (nmod_mpoly_is_zero(F->p + i, ctx))
+            continue;
+
+        if (!nmod_mpoly_repack_bits(h, F->p + i, F4_BITS, ctx))
+            flint_throw(FLINT_ERROR, "nmod_mpoly_groebner_f4: exponent overflow");
+
+        nmod_mpoly_make_monic(h, h, ctx);
+        _f4_add(S, h);
+    }
+
+    while (S->pairs_length > 0)
+    {
+        /* normal strategy: all pairs whose lcm has the least degree */
+        mindeg = S->pairs[0].deg;
+        for (i = 1; i < S->pairs_length; i++)
+            mindeg = FLINT_MIN(mindeg, S->pairs[i].deg);
+
+        for (i = 0, npairs = 0; i < S->pairs_length; i++)
+            if (S->pairs[i].deg == mindeg)
+                _f4_pair_swap(S->pairs + npairs++, S->pairs + i);
+
+        V->length = 0;
+        _f4_reduce_pairs(S, npairs, V);
+
+        for (i = npairs; i < S->pairs_length; i++)
+            _f4_pair_swap(S->pairs + i - npairs, S->pairs + i);
+        S->pairs_length -= npairs;
+
+        for (i = 0; i < V->length; i++)
+            _f4_add(S, V->p + i);
+    }
+
+    /*
+        Keep one element for each minimal leading monomial and reduce each
+        of them by the others.
+    */
+    B = FLINT_ARRAY_ALLOC(2*S->length + 1, nmod_mpoly_struct *);
+    Q = B + S->length;
+    Blen = 0;
+    for (i = 0; i < S->length; i++)
+    {
+        int keep = S->active[i];
+
+        for (j = 0; j < S->length && keep; j++)
+        {
+            if (j == i || !S->active[j] ||
+                !mpoly_monomial_divides_test(F4_LM(S, i), F4_LM(S, j),
+                                                               S->N, S->mask))
+            {
+                continue;
+            }
+
+            if (j < i || !mpoly_monomial_equal(F4_LM(S, i), F4_LM(S, j), S->N))
+                keep = 0;
+        }
+
+        if (keep)
+            B[Blen++] = S->polys + i;
+    }
+
+    /* sort by ascending leading monomial */
+    for (i = 1; i < Blen; i++)
+    {
+        for (j = i; j > 0 && mpoly_monomial_lt(B[j]->exps, B[j - 1]->exps,
+                                                       S->N, S->cmpmask); j--)
+        {
+            nmod_mpoly_struct * t = B[j];
+            B[j] = B[j - 1];
+            B[j - 1] = t;
+        }
+    }
+
+    nmod_mpoly_vec_set_length(G, Blen, ctx);
+
+    nmod_mpoly_vec_set_length(V, Blen, ctx);
+    for (i = 0; i < Blen; i++)
+        Q[i] = V->p + i;
+
+    for (i = 0; i < Blen; i++)
+    {
+        nmod_mpoly_struct * t = B[i];
+
+        if (Blen < 2)
+        {
+            nmod_mpoly_set(G->p + i, t, ctx);
+            continue;
+        }
+
+        /* divide by the others */
+        B[i] = B[Blen - 1];
+        nmod_mpoly_divrem_ideal(Q, G->p + i, t, B, Blen - 1, ctx);
+        B[i] = t;
+    }
+
+    for (k = 0; k < S->pairs_alloc; k++)
+        flint_free(S->pairs[k].lcm);
+    flint_free(S->pairs);
+
+    for (i = 0; i < S->length; i++)
+        nmod_mpoly_clear(S->polys + i, ctx);
+    flint_free(S->polys);
+    flint_free(S->active);
+    flint_free(S->t1);
+    flint_free((ulong *) S->cmpmask);
+    flint_free(B);
+
+    nmod_mpoly_vec_clear(V, ctx);
+    nmod_mpoly_clear(h, ctx);
+
+    return 1;
+}
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "nmod_mpoly.h"
 
 void _nmod_mpoly_pow_rmul(
@@ -58,6 +59,47 @@ void _nmod_mpoly_pow_rmul(
     }
 }
 
+/* same as _nmod_mpoly_pow_rmul with each product spread over the handles */
+void _nmod_mpoly_pow_rmul_threaded_pool(
+    nmod_mpoly_t A,
+    const mp_limb_t * Bcoeffs, const ulong * Bexps, slong Blen,
+    ulong k,
+    slong N,
+    const ulong * cmpmask,
+    const nmod_mpoly_ctx_t ctx,
+    nmod_mpoly_t T,
+    const thread_pool_handle * handles,
+    slong num_handles)
+{
+    flint_bitcnt_t bits = A->bits;
+
+    FLINT_ASSERT(bits == T->bits);
+    FLINT_ASSERT(Blen > 0);
+
+    if (num_handles < 1 || k < 2)
+    {
+        _nmod_mpoly_pow_rmul(A, Bcoeffs, Bexps, Blen, k, N, cmpmask,
+                                                                ctx->mod, T);
+        return;
+    }
+
+    _nmod_mpoly_fit_length(&A->coeffs, &A->coeffs_alloc,
+                           &A->exps, &A->exps_alloc, N, Blen + 2);
+
+    _nmod_mpoly_mul_heap_threaded(A, Bcoeffs, Bexps, Blen,
+                                     Bcoeffs, Bexps, Blen,
+                                     bits, N, cmpmask, ctx, handles, num_handles);
+    k -= 2;
+    while (k >= 1 && A->length > 0)
+    {
+        _nmod_mpoly_mul_heap_threaded(T, A->coeffs, A->exps, A->length,
+                                         Bcoeffs, Bexps, Blen,
+                                     bits, N, cmpmask, ctx, handles, num_handles);
+        nmod_mpoly_swap(A, T, NULL);
+        k -= 1;
+    }
+}
+
 void nmod_mpoly_pow_rmul(nmod_mpoly_t A, const nmod_mpoly_t B,
                                          ulong k, const nmod_mpoly_ctx_t ctx)
 {
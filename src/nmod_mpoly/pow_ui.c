@@ -10,6 +10,7 @@
 */
 
 #include "fmpz_vec.h"
+#include "thread_support.h"
 #include "nmod_mpoly.h"
 
 int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
@@ -22,6 +23,8 @@ int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
     int freeBexps;
     nmod_mpoly_t T, Atemp;
     nmod_mpoly_struct * R;
+    thread_pool_handle * handles;
+    slong num_handles;
 
     TMP_INIT;
 
@@ -110,10 +113,12 @@ int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
     cmpmask = (ulong*) TMP_ALLOC(N*sizeof(ulong));
     mpoly_get_cmpmask(cmpmask, N, exp_bits, ctx->minfo);
 
+    num_handles = flint_request_threads(&handles, B->length/16);
+
     if (ctx->mod.n > 99999 || !n_is_prime(ctx->mod.n))
     {
-        _nmod_mpoly_pow_rmul(R, B->coeffs, Bexps, B->length, k,
-                                                      N, cmpmask, ctx->mod, T);
+        _nmod_mpoly_pow_rmul_threaded_pool(R, B->coeffs, Bexps, B->length, k,
+                                      N, cmpmask, ctx, T, handles, num_handles);
     }
     else
     {
@@ -135,8 +140,8 @@ int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
             if (kmodn == 0)
                 continue;
 
-            _nmod_mpoly_pow_rmul(S, B->coeffs, Bexps, B->length, kmodn,
-                                                      N, cmpmask, ctx->mod, T);
+            _nmod_mpoly_pow_rmul_threaded_pool(S, B->coeffs, Bexps, B->length,
+                        kmodn, N, cmpmask, ctx, T, handles, num_handles);
 
             mpoly_monomial_mul_ui_mp(S->exps, S->exps, N*S->length, ne);
 
@@ -144,6 +149,13 @@ int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
             {
                 nmod_mpoly_swap(R, S, ctx);
             }
+            else if (num_handles > 0)
+            {
+                _nmod_mpoly_mul_heap_threaded(T, R->coeffs, R->exps, R->length,
+                                           S->coeffs, S->exps, S->length,
+                              exp_bits, N, cmpmask, ctx, handles, num_handles);
+                nmod_mpoly_swap(R, T, ctx);
+            }
             else
             {
                 _nmod_mpoly_mul_johnson(T, R->coeffs, R->exps, R->length,
@@ -156,6 +168,8 @@ int nmod_mpoly_pow_ui(nmod_mpoly_t A, const nmod_mpoly_t B,
         nmod_mpoly_clear(S, ctx);
     }
 
+    flint_give_back_threads(handles, num_handles);
+
     nmod_mpoly_clear(T, ctx);
 
     if (A == B)
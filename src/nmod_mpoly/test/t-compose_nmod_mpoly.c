@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "nmod_mpoly.h"
 
 int
@@ -270,6 +271,8 @@ main(void)
         nmod_mpoly_struct ** vals1;
         mp_limb_t fe, ge;
         mp_limb_t * vals2, * vals3;
+        thread_pool_handle * handles;
+        slong num_handles;
         slong nvars1, nvars2;
         slong len1, len2;
         slong exp_bound1;
@@ -278,6 +281,8 @@ main(void)
 
         modulus = n_randint(state, FLINT_BITS - 1) + 1;
         modulus = n_randbits(state, modulus);
+        flint_set_num_threads(n_randint(state, 4) + 1);
+
         nmod_mpoly_ctx_init_rand(ctx1, state, 4, modulus);
         nmod_mpoly_ctx_init_rand(ctx2, state, 8, modulus);
         nvars1 = ctx1->minfo->nvars;
@@ -333,6 +338,18 @@ main(void)
         nmod_mpoly_assert_canonical(g1, ctx2);
         nmod_mpoly_assert_canonical(g2, ctx2);
 
+        num_handles = flint_request_threads(&handles, WORD_MAX);
+        if (!_nmod_mpoly_compose_nmod_mpoly_threaded_pool(g1, f, vals1,
+                                      ctx1, ctx2, handles, num_handles) ||
+            !nmod_mpoly_equal(g, g1, ctx2))
+        {
+            printf("FAIL\n");
+            flint_printf("Check threaded composition\ni: %wd\n", i);
+            fflush(stdout);
+            flint_abort();
+        }
+        flint_give_back_threads(handles, num_handles);
+
         fe = nmod_mpoly_evaluate_all_ui(f, vals3, ctx1);
         ge = nmod_mpoly_evaluate_all_ui(g, vals2, ctx2);
 
@@ -104,6 +104,7 @@ int
 main(void)
 {
     slong i, j;
+    const slong max_threads = 5;
     FLINT_TEST_INIT(state);
 
     flint_printf("gcd_zippel2....");
@@ -160,6 +161,7 @@ main(void)
 
             nmod_mpoly_randtest_bits(g, state, len, FLINT_BITS, ctx);
 
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
             gcd_check(g, a, b, t, ctx, i, j, "random");
         }
 
@@ -177,6 +179,52 @@ main(void)
         nmod_mpoly_ctx_clear(ctx);
     }
 
+    /* larger gcds so that the images are computed by several threads */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_mpoly_ctx_t ctx;
+        nmod_mpoly_t a, b, g, t;
+        slong len, len1, len2;
+        mp_limb_t modulus;
+
+        modulus = n_randbits(state, n_randint(state, FLINT_BITS - 20) + 20);
+        modulus = n_nextprime(modulus, 1);
+
+        nmod_mpoly_ctx_init(ctx, 3 + n_randint(state, 3), ORD_LEX, modulus);
+
+        nmod_mpoly_init(g, ctx);
+        nmod_mpoly_init(a, ctx);
+        nmod_mpoly_init(b, ctx);
+        nmod_mpoly_init(t, ctx);
+
+        len = n_randint(state, 100) + 50;
+        len1 = n_randint(state, 20) + 1;
+        len2 = n_randint(state, 20) + 1;
+
+        for (j = 0; j < 2; j++)
+        {
+            nmod_mpoly_randtest_bound(a, state, len1, 8, ctx);
+            nmod_mpoly_randtest_bound(b, state, len2, 8, ctx);
+            nmod_mpoly_randtest_bound(t, state, len, 8, ctx);
+            if (nmod_mpoly_is_zero(t, ctx))
+                nmod_mpoly_one(t, ctx);
+
+            nmod_mpoly_mul(a, a, t, ctx);
+            nmod_mpoly_mul(b, b, t, ctx);
+
+            nmod_mpoly_randtest_bits(g, state, len, FLINT_BITS, ctx);
+
+            flint_set_num_threads(n_randint(state, max_threads) + 1);
+            gcd_check(g, a, b, t, ctx, i, j, "threaded");
+        }
+
+        nmod_mpoly_clear(g, ctx);
+        nmod_mpoly_clear(a, ctx);
+        nmod_mpoly_clear(b, ctx);
+        nmod_mpoly_clear(t, ctx);
+        nmod_mpoly_ctx_clear(ctx);
+    }
+
     flint_printf("PASS\n");
     FLINT_TEST_CLEANUP(state);
 
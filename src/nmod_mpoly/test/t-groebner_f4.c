@@ -0,0 +1,174 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_mpoly.h"
+
+int
+main(void)
+{
+    slong i, j, k, max_threads = 5;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("groebner_f4....");
+    fflush(stdout);
+
+    /* Check the result is the reduced Groebner basis of the input */
+    for (i = 0; i < 100 * flint_test_multiplier(); i++)
+    {
+        nmod_mpoly_ctx_t ctx;
+        nmod_mpoly_vec_t F, G, H;
+        nmod_mpoly_struct ** B, ** Q;
+        nmod_mpoly_t r;
+        mp_limb_t modulus;
+        slong nvars, num, len;
+        ulong exp_bound;
+
+        modulus = n_randint(state, FLINT_BITS - 1) + 1;
+        modulus = n_randbits(state, modulus);
+        modulus = n_nextprime(modulus, 1);
+        nmod_mpoly_ctx_init_rand(ctx, state, 4, modulus);
+        nvars = ctx->minfo->nvars;
+
+        nmod_mpoly_vec_init(F, 0, ctx);
+        nmod_mpoly_vec_init(G, 0, ctx);
+        nmod_mpoly_vec_init(H, 0, ctx);
+        nmod_mpoly_init(r, ctx);
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        num = n_randint(state, 6 - FLINT_MIN(nvars, 3));
+        len = n_randint(state, 6) + 1;
+        exp_bound = nvars > 2 ? 2 : n_randint(state, 4) + 2;
+
+        nmod_mpoly_vec_set_length(F, num, ctx);
+        for (j = 0; j < num; j++)
+            nmod_mpoly_randtest_bound(F->p + j, state, len, exp_bound, ctx);
+
+        if (!nmod_mpoly_groebner_f4(G, F, ctx))
+        {
+            flint_printf("FAIL\ncheck prime modulus\ni = %wd\n", i);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (!nmod_mpoly_vec_is_groebner(G, F, ctx))
+        {
+            flint_printf("FAIL\ncheck Groebner basis\ni = %wd\n", i);
+            flint_printf("F = "); nmod_mpoly_vec_print(F, ctx); flint_printf("\n");
+            flint_printf("G = "); nmod_mpoly_vec_print(G, ctx); flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* monic and no term divisible by the leading monomial of another */
+        B = FLINT_ARRAY_ALLOC(2*G->length + 2, nmod_mpoly_struct *);
+        Q = B + G->length + 1;
+        for (j = 0; j < G->length; j++)
+        {
+            if (G->p[j].length < 1 || G->p[j].coeffs[0] != 1)
+            {
+                flint_printf("FAIL\ncheck monic\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            if (G->length < 2)
+                continue;
+
+            for (k = 0; k + 1 < G->length; k++)
+                B[k] = G->p + (k < j ? k : k + 1);
+
+            nmod_mpoly_vec_set_length(H, G->length - 1, ctx);
+            for (k = 0; k + 1 < G->length; k++)
+                Q[k] = H->p + k;
+
+            nmod_mpoly_divrem_ideal(Q, r, G->p + j, B, G->length - 1, ctx);
+
+            if (!nmod_mpoly_equal(r, G->p + j, ctx))
+            {
+                flint_printf("FAIL\ncheck reduced\ni = %wd, j = %wd\n", i, j);
+                flint_printf("G = "); nmod_mpoly_vec_print(G, ctx); flint_printf("\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+        flint_free(B);
+
+        /* the reduced basis is unique */
+        nmod_mpoly_groebner_f4(H, G, ctx);
+
+        if (H->length != G->length)
+        {
+            flint_printf("FAIL\ncheck uniqueness\ni = %wd\n", i);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        for (j = 0; j < G->length; j++)
+        {
+            if (!nmod_mpoly_equal(H->p + j, G->p + j, ctx))
+            {
+                flint_printf("FAIL\ncheck uniqueness\ni = %wd, j = %wd\n", i, j);
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_mpoly_vec_clear(F, ctx);
+        nmod_mpoly_vec_clear(G, ctx);
+        nmod_mpoly_vec_clear(H, ctx);
+        nmod_mpoly_clear(r, ctx);
+        nmod_mpoly_ctx_clear(ctx);
+    }
+
+    /* Check larger systems in graded order, which need several threads */
+    for (i = 0; i < 10 * flint_test_multiplier(); i++)
+    {
+        nmod_mpoly_ctx_t ctx;
+        nmod_mpoly_vec_t F, G;
+        mp_limb_t modulus;
+
+        modulus = n_randint(state, FLINT_BITS - 1) + 1;
+        modulus = n_randbits(state, modulus);
+        modulus = n_nextprime(modulus, 1);
+        nmod_mpoly_ctx_init(ctx, 3, ORD_DEGREVLEX, modulus);
+
+        nmod_mpoly_vec_init(F, 3, ctx);
+        nmod_mpoly_vec_init(G, 0, ctx);
+
+        flint_set_num_threads(n_randint(state, max_threads) + 1);
+
+        for (j = 0; j < 3; j++)
+            nmod_mpoly_randtest_bound(F->p + j, state, n_randint(state, 8) + 1,
+                                                 n_randint(state, 4) + 2, ctx);
+
+        nmod_mpoly_groebner_f4(G, F, ctx);
+
+        if (!nmod_mpoly_vec_is_groebner(G, F, ctx))
+        {
+            flint_printf("FAIL\ncheck Groebner basis graded\ni = %wd\n", i);
+            flint_printf("F = "); nmod_mpoly_vec_print(F, ctx); flint_printf("\n");
+            flint_printf("G = "); nmod_mpoly_vec_print(G, ctx); flint_printf("\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_mpoly_vec_clear(F, ctx);
+        nmod_mpoly_vec_clear(G, ctx);
+        nmod_mpoly_ctx_clear(ctx);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
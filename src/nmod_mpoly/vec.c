@@ -0,0 +1,129 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_mpoly.h"
+
+void
+nmod_mpoly_vec_init(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx)
+{
+    if (len == 0)
+    {
+        vec->p = NULL;
+        vec->length = 0;
+        vec->alloc = 0;
+    }
+    else
+    {
+        slong i;
+        vec->p = flint_malloc(sizeof(nmod_mpoly_struct) * len);
+        for (i = 0; i < len; i++)
+            nmod_mpoly_init(vec->p + i, ctx);
+        vec->length = vec->alloc = len;
+    }
+}
+
+void
+nmod_mpoly_vec_print(const nmod_mpoly_vec_t F, const nmod_mpoly_ctx_t ctx)
+{
+    slong i;
+
+    flint_printf("[");
+    for (i = 0; i < F->length; i++)
+    {
+        nmod_mpoly_print_pretty(F->p + i, NULL, ctx);
+        if (i < F->length - 1)
+            flint_printf(", ");
+    }
+    flint_printf("]");
+}
+
+void
+nmod_mpoly_vec_swap(nmod_mpoly_vec_t x, nmod_mpoly_vec_t y, const nmod_mpoly_ctx_t ctx)
+{
+    nmod_mpoly_vec_t tmp;
+    *tmp = *x;
+    *x = *y;
+    *y = *tmp;
+}
+
+void
+nmod_mpoly_vec_fit_length(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx)
+{
+    if (len > vec->alloc)
+    {
+        slong i;
+
+        if (len < 2 * vec->alloc)
+            len = 2 * vec->alloc;
+
+        vec->p = flint_realloc(vec->p, len * sizeof(nmod_mpoly_struct));
+
+        for (i = vec->alloc; i < len; i++)
+            nmod_mpoly_init(vec->p + i, ctx);
+
+        vec->alloc = len;
+    }
+}
+
+void
+nmod_mpoly_vec_clear(nmod_mpoly_vec_t vec, const nmod_mpoly_ctx_t ctx)
+{
+    slong i;
+
+    for (i = 0; i < vec->alloc; i++)
+        nmod_mpoly_clear(vec->p + i, ctx);
+
+    flint_free(vec->p);
+}
+
+void
+nmod_mpoly_vec_set(nmod_mpoly_vec_t dest, const nmod_mpoly_vec_t src, const nmod_mpoly_ctx_t ctx)
+{
+    if (dest != src)
+    {
+        slong i;
+
+        nmod_mpoly_vec_fit_length(dest, src->length, ctx);
+
+        for (i = 0; i < src->length; i++)
+            nmod_mpoly_set(dest->p + i, src->p + i, ctx);
+
+        dest->length = src->length;
+    }
+}
+
+void
+nmod_mpoly_vec_append(nmod_mpoly_vec_t vec, const nmod_mpoly_t f, const nmod_mpoly_ctx_t ctx)
+{
+    nmod_mpoly_vec_fit_length(vec, vec->length + 1, ctx);
+    nmod_mpoly_set(vec->p + vec->length, f, ctx);
+    vec->length++;
+}
+
+void
+nmod_mpoly_vec_set_length(nmod_mpoly_vec_t vec, slong len, const nmod_mpoly_ctx_t ctx)
+{
+    slong i;
+
+    if (len > vec->length)
+    {
+        nmod_mpoly_vec_fit_length(vec, len, ctx);
+        for (i = vec->length; i < len; i++)
+            nmod_mpoly_zero(vec->p + i, ctx);
+    }
+    else if (len < vec->length)
+    {
+        for (i = len; i < vec->length; i++)
+           nmod_mpoly_zero(vec->p + i, ctx);
+    }
+
+    vec->length = len;
+}
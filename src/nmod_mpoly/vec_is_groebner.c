@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "nmod_mpoly.h"
+
+/* h = the remainder of f modulo G */
+static void _nmod_mpoly_vec_reduce(nmod_mpoly_t h, const nmod_mpoly_t f,
+                        const nmod_mpoly_vec_t G, const nmod_mpoly_ctx_t ctx)
+{
+    slong i, len = G->length;
+    nmod_mpoly_struct ** Q, ** B;
+
+    Q = FLINT_ARRAY_ALLOC(len, nmod_mpoly_struct *);
+    B = FLINT_ARRAY_ALLOC(len, nmod_mpoly_struct *);
+    for (i = 0; i < len; i++)
+    {
+        Q[i] = FLINT_ARRAY_ALLOC(1, nmod_mpoly_struct);
+        nmod_mpoly_init(Q[i], ctx);
+        B[i] = G->p + i;
+    }
+
+    nmod_mpoly_divrem_ideal(Q, h, f, B, len, ctx);
+
+    for (i = 0; i < len; i++)
+    {
+        nmod_mpoly_clear(Q[i], ctx);
+        flint_free(Q[i]);
+    }
+
+    flint_free(Q);
+    flint_free(B);
+}
+
+/* h = the S-polynomial of f and g made from monic multiples */
+static void _nmod_mpoly_spoly(nmod_mpoly_t h, const nmod_mpoly_t f,
+                          const nmod_mpoly_t g, const nmod_mpoly_ctx_t ctx)
+{
+    slong i, n = ctx->minfo->nvars;
+    ulong * exp, * expf, * expg;
+    nmod_mpoly_t T, U;
+
+    exp = FLINT_ARRAY_ALLOC(3*n, ulong);
+    expf = exp + n;
+    expg = expf + n;
+    nmod_mpoly_init(T, ctx);
+    nmod_mpoly_init(U, ctx);
+
+    nmod_mpoly_get_term_exp_ui(expf, f, 0, ctx);
+    nmod_mpoly_get_term_exp_ui(expg, g, 0, ctx);
+
+    for (i = 0; i < n; i++)
+    {
+        exp[i] = FLINT_MAX(expf[i], expg[i]);
+        expf[i] = exp[i] - expf[i];
+        expg[i] = exp[i] - expg[i];
+    }
+
+    nmod_mpoly_set_coeff_ui_ui(T, nmod_inv(f->coeffs[0], ctx->mod), expf, ctx);
+    nmod_mpoly_mul(T, T, f, ctx);
+    nmod_mpoly_set_coeff_ui_ui(U, nmod_inv(g->coeffs[0], ctx->mod), expg, ctx);
+    nmod_mpoly_mul(U, U, g, ctx);
+    nmod_mpoly_sub(h, T, U, ctx);
+
+    flint_free(exp);
+    nmod_mpoly_clear(T, ctx);
+    nmod_mpoly_clear(U, ctx);
+}
+
+int
+nmod_mpoly_vec_is_groebner(const nmod_mpoly_vec_t G, const nmod_mpoly_vec_t F, const nmod_mpoly_ctx_t ctx)
+{
+    slong i, j, len;
+    nmod_mpoly_t h;
+    int result;
+
+    len = G->length;
+
+    if (len == 0)
+    {
+        if (F == NULL)
+            return 1;
+
+        for (i = 0; i < F->length; i++)
+            if (!nmod_mpoly_is_zero(F->p + i, ctx))
+                return 0;
+
+        return 1;
+    }
+
+    for (i = 0; i < len; i++)
+        if (nmod_mpoly_is_zero(G->p + i, ctx))
+            return 0;
+
+    nmod_mpoly_init(h, ctx);
+    result = 1;
+
+    for (i = 0; i < len && result; i++)
+    {
+        for (j = i + 1; j < len && result; j++)
+        {
+            _nmod_mpoly_spoly(h, G->p + i, G->p + j, ctx);
+            _nmod_mpoly_vec_reduce(h, h, G, ctx);
+            if (!nmod_mpoly_is_zero(h, ctx))
+                result = 0;
+        }
+    }
+
+    if (F != NULL)
+    {
+        for (i = 0; i < F->length && result; i++)
+        {
+            _nmod_mpoly_vec_reduce(h, F->p + i, G, ctx);
+            if (!nmod_mpoly_is_zero(h, ctx))
+                result = 0;
+        }
+    }
+
+    nmod_mpoly_clear(h, ctx);
+    return result;
+}
@@ -9,6 +9,7 @@
     (at your option) any later version.  See <https://www.gnu.org/licenses/>.
 */
 
+#include "thread_support.h"
 #include "nmod_mpoly_factor.h"
 
 
@@ -580,6 +581,32 @@ static void n_polyu3_add_zip_limit1(
 }
 
 
+/*
+    Once all images have been collected, the factors are recovered from their
+    zip forms independently of each other. Each factor has its own temporary
+    for the root products.
+*/
+typedef struct
+{
+    nmod_mpoly_struct * B;
+    const n_polyun_struct * Z;
+    nmod_mpolyu_struct * H;
+    const ulong * Bdegs;
+    slong m;
+    const nmod_mpoly_ctx_struct * ctx;
+    n_polyun_struct * M;
+    int * success;
+}
+_from_zip_arg_struct;
+
+static void _from_zip_worker(slong i, void * varg)
+{
+    _from_zip_arg_struct * arg = (_from_zip_arg_struct *) varg;
+
+    arg->success[i] = nmod_mpoly_from_zip(arg->B + i, arg->Z + i, arg->H + i,
+                                  arg->Bdegs[i], arg->m, arg->ctx, arg->M + i);
+}
+
 int nmod_mpoly_hlift_zippel(
     slong m,
     nmod_mpoly_struct * B,
@@ -724,13 +751,49 @@ next_zip_image:
     if (cur_zip_image < req_zip_images)
         goto next_zip_image;
 
-    for (i = 0; i < r; i++)
+    if (flint_get_num_threads() > 1)
     {
-        success = nmod_mpoly_from_zip(B + i, Z + i, H + i, Bdegs[i], m, ctx, M);
-        if (success < 1)
+        _from_zip_arg_struct args[1];
+        n_polyun_struct * Ms = FLINT_ARRAY_ALLOC(r, n_polyun_struct);
+        int * successes = FLINT_ARRAY_ALLOC(r, int);
+
+        for (i = 0; i < r; i++)
+            n_polyun_init(Ms + i);
+
+        args->B = B;
+        args->Z = Z;
+        args->H = H;
+        args->Bdegs = Bdegs;
+        args->m = m;
+        args->ctx = ctx;
+        args->M = Ms;
+        args->success = successes;
+
+        flint_parallel_do(_from_zip_worker, args, r, 0, FLINT_PARALLEL_DYNAMIC);
+
+        success = 1;
+        for (i = 0; i < r; i++)
         {
-            success = 0;
+            success = success && successes[i] > 0;
+            n_polyun_clear(Ms + i);
+        }
+
+        flint_free(Ms);
+        flint_free(successes);
+
+        if (!success)
             goto cleanup;
+    }
+    else
+    {
+        for (i = 0; i < r; i++)
+        {
+            success = nmod_mpoly_from_zip(B + i, Z + i, H + i, Bdegs[i], m, ctx, M);
+            if (success < 1)
+            {
+                success = 0;
+                goto cleanup;
+            }
         }
     }
 
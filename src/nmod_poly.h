@@ -64,6 +64,16 @@ typedef struct
 }
 nmod_poly_compose_mod_precomp_preinv_arg_t;
 
+typedef struct
+{
+    nmod_poly_t poly;
+    slong len1;
+    void * fft;
+}
+nmod_poly_mul_precomp_struct;
+
+typedef nmod_poly_mul_precomp_struct nmod_poly_mul_precomp_t[1];
+
 /* zn_poly helper functions  ************************************************
 
 Copyright (C) 2007, 2008 David Harvey
@@ -488,6 +498,17 @@ void _nmod_poly_mulhigh(mp_ptr res, mp_srcptr poly1, slong len1,
 void nmod_poly_mulhigh(nmod_poly_t res, const nmod_poly_t poly1,
                                               const nmod_poly_t poly2, slong n);
 
+void nmod_poly_mul_precomp_init(nmod_poly_mul_precomp_t M,
+                                         const nmod_poly_t poly2, slong len1);
+
+void nmod_poly_mul_precomp_clear(nmod_poly_mul_precomp_t M);
+
+void _nmod_poly_mul_precomp(mp_ptr res, mp_srcptr poly1, slong len1,
+                                          const nmod_poly_mul_precomp_t M);
+
+void nmod_poly_mul_precomp(nmod_poly_t res, const nmod_poly_t poly1,
+                                          const nmod_poly_mul_precomp_t M);
+
 void _nmod_poly_mulmod(mp_ptr res, mp_srcptr poly1, slong len1,
                              mp_srcptr poly2, slong len2, mp_srcptr f,
                             slong lenf, nmod_t mod);
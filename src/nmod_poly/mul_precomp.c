@@ -0,0 +1,120 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_poly.h"
+
+#ifdef FLINT_HAVE_FFT_SMALL
+#include "fft_small.h"
+
+/* below this length the fixed operand is not transformed */
+#define NMOD_POLY_MUL_PRECOMP_CUTOFF(bits) ((bits) <= 20 ? 400 : 100)
+#endif
+
+void
+nmod_poly_mul_precomp_init(nmod_poly_mul_precomp_t M,
+                                          const nmod_poly_t poly2, slong len1)
+{
+    nmod_poly_init_mod(M->poly, poly2->mod);
+    nmod_poly_set(M->poly, poly2);
+    M->len1 = len1;
+    M->fft = NULL;
+
+#ifdef FLINT_HAVE_FFT_SMALL
+    {
+        slong len2 = poly2->length;
+
+        if (len1 > 0 && FLINT_MIN(len1, len2) >=
+                        NMOD_POLY_MUL_PRECOMP_CUTOFF(NMOD_BITS(poly2->mod)))
+        {
+            mul_precomp_struct * F = flint_malloc(sizeof(mul_precomp_struct));
+            ulong depth = n_max(LG_BLK_SZ, n_clog2(len1 + len2 - 1));
+
+            _mul_precomp_init(F, poly2->coeffs, len2, len2, depth,
+                                          poly2->mod, get_default_mpn_ctx());
+            M->fft = F;
+        }
+    }
+#endif
+}
+
+void
+nmod_poly_mul_precomp_clear(nmod_poly_mul_precomp_t M)
+{
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL)
+    {
+        _mul_precomp_clear((mul_precomp_struct *) M->fft);
+        flint_free(M->fft);
+    }
+#endif
+
+    nmod_poly_clear(M->poly);
+}
+
+void
+_nmod_poly_mul_precomp(mp_ptr res, mp_srcptr poly1, slong len1,
+                                             const nmod_poly_mul_precomp_t M)
+{
+    mp_srcptr poly2 = M->poly->coeffs;
+    slong len2 = M->poly->length;
+    nmod_t mod = M->poly->mod;
+
+#ifdef FLINT_HAVE_FFT_SMALL
+    if (M->fft != NULL && len1 <= M->len1 &&
+        FLINT_MIN(len1, len2) >= NMOD_POLY_MUL_PRECOMP_CUTOFF(NMOD_BITS(mod)))
+    {
+        if (_nmod_poly_mul_mid_precomp(res, 0, len1 + len2 - 1, poly1, len1,
+                   (mul_precomp_struct *) M->fft, mod, get_default_mpn_ctx()))
+            return;
+    }
+#endif
+
+    if (len1 >= len2)
+        _nmod_poly_mul(res, poly1, len1, poly2, len2, mod);
+    else
+        _nmod_poly_mul(res, poly2, len2, poly1, len1, mod);
+}
+
+void
+nmod_poly_mul_precomp(nmod_poly_t res, const nmod_poly_t poly1,
+                                             const nmod_poly_mul_precomp_t M)
+{
+    slong len1 = poly1->length;
+    slong len2 = M->poly->length;
+    slong len_out;
+
+    if (len1 == 0 || len2 == 0)
+    {
+        nmod_poly_zero(res);
+        return;
+    }
+
+    len_out = len1 + len2 - 1;
+
+    if (res == poly1 || res == M->poly)
+    {
+        nmod_poly_t t;
+        nmod_poly_init2(t, poly1->mod.n, len_out);
+        _nmod_poly_mul_precomp(t->coeffs, poly1->coeffs, len1, M);
+        nmod_poly_swap(t, res);
+        nmod_poly_clear(t);
+    }
+    else
+    {
+        nmod_poly_fit_length(res, len_out);
+        _nmod_poly_mul_precomp(res->coeffs, poly1->coeffs, len1, M);
+    }
+
+    res->length = len_out;
+    _nmod_poly_normalise(res);
+}
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_poly.h"
+
+int
+main(void)
+{
+    int i, j, result;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_precomp....");
+    fflush(stdout);
+
+    for (i = 0; i < 20 * flint_test_multiplier(); i++)
+    {
+        nmod_poly_t a, b, c, d;
+        nmod_poly_mul_precomp_t M;
+        slong len1;
+
+        mp_limb_t n = n_randtest_not_zero(state);
+
+        nmod_poly_init(a, n);
+        nmod_poly_init(b, n);
+        nmod_poly_init(c, n);
+        nmod_poly_init(d, n);
+
+        if (n_randint(state, 2))
+        {
+            len1 = n_randint(state, 50) + 1;
+            nmod_poly_randtest(b, state, n_randint(state, 50));
+        }
+        else
+        {
+            len1 = n_randint(state, 3000) + 1;
+            nmod_poly_randtest(b, state, n_randint(state, 3000));
+        }
+
+        nmod_poly_mul_precomp_init(M, b, len1);
+
+        for (j = 0; j < 4; j++)
+        {
+            /* occasionally exceed the announced length */
+            nmod_poly_randtest(a, state, n_randint(state, len1 + (j == 3)) + (j == 3));
+
+            nmod_poly_mul(c, a, b);
+
+            if (n_randint(state, 2))
+            {
+                nmod_poly_mul_precomp(d, a, M);
+            }
+            else
+            {
+                nmod_poly_set(d, a);
+                nmod_poly_mul_precomp(d, d, M);
+            }
+
+            result = (nmod_poly_equal(c, d));
+            if (!result)
+            {
+                flint_printf("FAIL:\n");
+                flint_printf("n = %wu, len1 = %wd, j = %d\n", n, len1, j);
+                nmod_poly_print(a), flint_printf("\n\n");
+                nmod_poly_print(b), flint_printf("\n\n");
+                nmod_poly_print(c), flint_printf("\n\n");
+                nmod_poly_print(d), flint_printf("\n\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_poly_mul_precomp_clear(M);
+
+        nmod_poly_clear(a);
+        nmod_poly_clear(b);
+        nmod_poly_clear(c);
+        nmod_poly_clear(d);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
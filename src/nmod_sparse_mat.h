@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef NMOD_SPARSE_MAT_H
+#define NMOD_SPARSE_MAT_H
+
+#ifdef NMOD_SPARSE_MAT_INLINES_C
+#define NMOD_SPARSE_MAT_INLINE
+#else
+#define NMOD_SPARSE_MAT_INLINE static __inline__
+#endif
+
+#include "nmod_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Matrices are stored in compressed sparse row (CSR) format: the nonzero
+   entries of row i are entries[offsets[i]], ..., entries[offsets[i + 1] - 1]
+   and lie in the columns cols[offsets[i]], ..., cols[offsets[i + 1] - 1],
+   which are strictly increasing. */
+
+#define NMOD_SPARSE_MAT_MUL_THREAD_CUTOFF 20000
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nrows(const nmod_sparse_mat_t A)
+{
+    return A->r;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_ncols(const nmod_sparse_mat_t A)
+{
+    return A->c;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_nnz(const nmod_sparse_mat_t A)
+{
+    return A->nnz;
+}
+
+NMOD_SPARSE_MAT_INLINE
+slong nmod_sparse_mat_row_length(const nmod_sparse_mat_t A, slong i)
+{
+    return A->offsets[i + 1] - A->offsets[i];
+}
+
+/* Memory management */
+
+void nmod_sparse_mat_init(nmod_sparse_mat_t A, slong rows, slong cols, mp_limb_t n);
+void nmod_sparse_mat_clear(nmod_sparse_mat_t A);
+void nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t A, slong nnz);
+void _nmod_sparse_mat_set_shape(nmod_sparse_mat_t A, slong rows, slong cols);
+
+void nmod_sparse_mat_swap(nmod_sparse_mat_t A, nmod_sparse_mat_t B);
+
+/* Basic assignment and conversion */
+
+void nmod_sparse_mat_zero(nmod_sparse_mat_t A);
+void nmod_sparse_mat_set(nmod_sparse_mat_t B, const nmod_sparse_mat_t A);
+
+void nmod_sparse_mat_set_entries(nmod_sparse_mat_t A, const slong * rows,
+                          const slong * cols, mp_srcptr vals, slong nnz);
+
+mp_limb_t nmod_sparse_mat_get_entry(const nmod_sparse_mat_t A, slong i, slong j);
+
+void nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t A, const nmod_mat_t B);
+void nmod_sparse_mat_get_nmod_mat(nmod_mat_t B, const nmod_sparse_mat_t A);
+
+int nmod_sparse_mat_equal(const nmod_sparse_mat_t A, const nmod_sparse_mat_t B);
+
+/* Random generation */
+
+void nmod_sparse_mat_randtest(nmod_sparse_mat_t A, flint_rand_t state,
+                                                          slong row_nnz);
+
+/* Input and output */
+
+void nmod_sparse_mat_print_pretty(const nmod_sparse_mat_t A);
+
+/* Transpose */
+
+void nmod_sparse_mat_transpose(nmod_sparse_mat_t B, const nmod_sparse_mat_t A);
+
+/* Matrix-vector and matrix-matrix multiplication */
+
+void _nmod_sparse_mat_split_rows(slong * bounds, const nmod_sparse_mat_t A, slong num);
+int _nmod_sparse_mat_dot_bound_limbs(const nmod_sparse_mat_t A);
+
+void nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A, mp_srcptr x);
+
+void nmod_sparse_mat_mul_mat(nmod_mat_t Y, const nmod_sparse_mat_t A,
+                                                          const nmod_mat_t X);
+
+/* Gaussian elimination */
+
+slong nmod_sparse_mat_rref(nmod_sparse_mat_t A);
+
+slong _nmod_sparse_mat_rref_structured(nmod_sparse_mat_t A, slong * pivots, slong c1);
+
+slong nmod_sparse_mat_rank(const nmod_sparse_mat_t A);
+
+slong nmod_sparse_mat_nullspace(nmod_sparse_mat_t X, const nmod_sparse_mat_t A);
+
+int nmod_sparse_mat_solve(mp_ptr x, const nmod_sparse_mat_t A, mp_srcptr b);
+
+/* Wiedemann and block Wiedemann */
+
+int nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                       mp_srcptr b, flint_rand_t state);
+
+slong nmod_sparse_mat_nullspace_block_wiedemann(nmod_sparse_mat_t X,
+       const nmod_sparse_mat_t A, slong block_size, flint_rand_t state);
+
+int nmod_sparse_mat_solve_block_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                      mp_srcptr b, slong block_size, flint_rand_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_fit_nnz(nmod_sparse_mat_t A, slong nnz)
+{
+    if (nnz > A->alloc)
+    {
+        slong alloc = FLINT_MAX(nnz, 2 * A->alloc);
+
+        A->entries = (mp_limb_t *) flint_realloc(A->entries, alloc * sizeof(mp_limb_t));
+        A->cols = (slong *) flint_realloc(A->cols, alloc * sizeof(slong));
+        A->alloc = alloc;
+    }
+}
+
+/* Make A a zero matrix of the given shape. */
+void
+_nmod_sparse_mat_set_shape(nmod_sparse_mat_t A, slong rows, slong cols)
+{
+    if (rows != A->r)
+    {
+        flint_free(A->offsets);
+        A->offsets = (slong *) flint_calloc(rows + 1, sizeof(slong));
+        A->r = rows;
+    }
+    else
+    {
+        slong i;
+
+        for (i = 0; i <= rows; i++)
+            A->offsets[i] = 0;
+    }
+
+    A->c = cols;
+    A->nnz = 0;
+}
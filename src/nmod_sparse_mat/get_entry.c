@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+mp_limb_t
+nmod_sparse_mat_get_entry(const nmod_sparse_mat_t A, slong i, slong j)
+{
+    slong lo = A->offsets[i], hi = A->offsets[i + 1];
+
+    /* binary search for column j in row i */
+    while (lo < hi)
+    {
+        slong mid = lo + (hi - lo) / 2;
+
+        if (A->cols[mid] < j)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return (lo < A->offsets[i + 1] && A->cols[lo] == j) ? A->entries[lo] : 0;
+}
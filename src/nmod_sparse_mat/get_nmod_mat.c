@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_get_nmod_mat(nmod_mat_t B, const nmod_sparse_mat_t A)
+{
+    slong i, k;
+
+    if (B->r != A->r || B->c != A->c)
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_get_nmod_mat). "
+                                 "Incompatible dimensions.\n");
+    }
+
+    nmod_mat_zero(B);
+
+    for (i = 0; i < A->r; i++)
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+            nmod_mat_entry(B, i, A->cols[k]) = A->entries[k];
+}
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "thread_support.h"
+#include "nmod_sparse_mat.h"
+
+typedef struct
+{
+    nmod_mat_struct * Y;
+    const nmod_sparse_mat_struct * A;
+    const nmod_mat_struct * X;
+    const slong * bounds;
+    int nlimbs;
+}
+_mul_mat_arg_t;
+
+static void
+_mul_mat_worker(slong t, void * varg)
+{
+    _mul_mat_arg_t * arg = (_mul_mat_arg_t *) varg;
+    const nmod_sparse_mat_struct * A = arg->A;
+    mp_limb_t ** Xrows = arg->X->rows;
+    slong i, j, k, n = arg->X->c;
+
+    for (i = arg->bounds[t]; i < arg->bounds[t + 1]; i++)
+    {
+        const mp_limb_t * entries = A->entries + A->offsets[i];
+        const slong * cols = A->cols + A->offsets[i];
+        slong len = A->offsets[i + 1] - A->offsets[i];
+        mp_ptr Yrow = arg->Y->rows[i];
+
+        for (j = 0; j < n; j++)
+        {
+            NMOD_VEC_DOT(Yrow[j], k, len, entries[k], Xrows[cols[k]][j],
+                                                     A->mod, arg->nlimbs);
+        }
+    }
+}
+
+void
+nmod_sparse_mat_mul_mat(nmod_mat_t Y, const nmod_sparse_mat_t A, const nmod_mat_t X)
+{
+    _mul_mat_arg_t arg;
+    slong num;
+    slong * bounds;
+
+    if (Y->r != A->r || Y->c != X->c || X->r != A->c)
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_mul_mat). "
+                                 "Incompatible dimensions.\n");
+    }
+
+    if (Y == X)
+    {
+        nmod_mat_t T;
+        nmod_mat_init(T, Y->r, Y->c, Y->mod.n);
+        nmod_sparse_mat_mul_mat(T, A, X);
+        nmod_mat_swap_entrywise(Y, T);
+        nmod_mat_clear(T);
+        return;
+    }
+
+    arg.Y = Y;
+    arg.A = A;
+    arg.X = X;
+    arg.nlimbs = _nmod_sparse_mat_dot_bound_limbs(A);
+
+    num = flint_get_num_threads();
+
+    if (num < 2 || A->nnz * X->c < NMOD_SPARSE_MAT_MUL_THREAD_CUTOFF || A->r < 2)
+    {
+        slong b[2];
+        b[0] = 0;
+        b[1] = A->r;
+        arg.bounds = b;
+        _mul_mat_worker(0, &arg);
+        return;
+    }
+
+    num = FLINT_MIN(4 * num, A->r);
+    bounds = (slong *) flint_malloc((num + 1) * sizeof(slong));
+    _nmod_sparse_mat_split_rows(bounds, A, num);
+    arg.bounds = bounds;
+
+    flint_parallel_do(_mul_mat_worker, &arg, num, 0, FLINT_PARALLEL_DYNAMIC);
+
+    flint_free(bounds);
+}
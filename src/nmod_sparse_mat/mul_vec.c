@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "thread_support.h"
+#include "nmod_sparse_mat.h"
+
+/* Split the rows of A into num ranges bounds[t] <= i < bounds[t + 1]
+   holding roughly the same number of nonzero entries. */
+void
+_nmod_sparse_mat_split_rows(slong * bounds, const nmod_sparse_mat_t A, slong num)
+{
+    slong t, i = 0;
+
+    bounds[0] = 0;
+
+    for (t = 1; t < num; t++)
+    {
+        slong target = (slong) (((double) A->nnz * t) / num);
+
+        while (i < A->r && A->offsets[i] < target)
+            i++;
+
+        bounds[t] = i;
+    }
+
+    bounds[num] = A->r;
+}
+
+int
+_nmod_sparse_mat_dot_bound_limbs(const nmod_sparse_mat_t A)
+{
+    slong i, len = 0;
+
+    for (i = 0; i < A->r; i++)
+        len = FLINT_MAX(len, A->offsets[i + 1] - A->offsets[i]);
+
+    return _nmod_vec_dot_bound_limbs(len, A->mod);
+}
+
+typedef struct
+{
+    mp_ptr y;
+    const nmod_sparse_mat_struct * A;
+    mp_srcptr x;
+    const slong * bounds;
+    int nlimbs;
+}
+_mul_vec_arg_t;
+
+static void
+_mul_vec_worker(slong t, void * varg)
+{
+    _mul_vec_arg_t * arg = (_mul_vec_arg_t *) varg;
+    const nmod_sparse_mat_struct * A = arg->A;
+    mp_srcptr x = arg->x;
+    slong i, k;
+
+    for (i = arg->bounds[t]; i < arg->bounds[t + 1]; i++)
+    {
+        const mp_limb_t * entries = A->entries + A->offsets[i];
+        const slong * cols = A->cols + A->offsets[i];
+        slong len = A->offsets[i + 1] - A->offsets[i];
+
+        NMOD_VEC_DOT(arg->y[i], k, len, entries[k], x[cols[k]], A->mod, arg->nlimbs);
+    }
+}
+
+void
+nmod_sparse_mat_mul_vec(mp_ptr y, const nmod_sparse_mat_t A, mp_srcptr x)
+{
+    _mul_vec_arg_t arg;
+    slong num;
+    slong * bounds;
+
+    arg.y = y;
+    arg.A = A;
+    arg.x = x;
+    arg.nlimbs = _nmod_sparse_mat_dot_bound_limbs(A);
+
+    num = flint_get_num_threads();
+
+    if (num < 2 || A->nnz < NMOD_SPARSE_MAT_MUL_THREAD_CUTOFF || A->r < 2)
+    {
+        slong b[2];
+        b[0] = 0;
+        b[1] = A->r;
+        arg.bounds = b;
+        _mul_vec_worker(0, &arg);
+        return;
+    }
+
+    num = FLINT_MIN(4 * num, A->r);
+    bounds = (slong *) flint_malloc((num + 1) * sizeof(slong));
+    _nmod_sparse_mat_split_rows(bounds, A, num);
+    arg.bounds = bounds;
+
+    flint_parallel_do(_mul_vec_worker, &arg, num, 0, FLINT_PARALLEL_DYNAMIC);
+
+    flint_free(bounds);
+}
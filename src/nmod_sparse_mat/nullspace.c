@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+slong
+nmod_sparse_mat_nullspace(nmod_sparse_mat_t X, const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t R;
+    slong i, j, k, n, c = A->c, rank, nullity, nnz;
+    slong * index, * pivots, * rows, * cols;
+    mp_ptr vals;
+
+    nmod_sparse_mat_init(R, A->r, A->c, A->mod.n);
+    nmod_sparse_mat_set(R, A);
+    pivots = (slong *) flint_malloc((FLINT_MIN(A->r, c) + 1) * sizeof(slong));
+    rank = _nmod_sparse_mat_rref_structured(R, pivots, c);
+    nullity = c - rank;
+
+    /* index[j] = number of the basis vector for a non-pivot column j,
+       or -1 if j is a pivot column */
+    index = (slong *) flint_malloc(c * sizeof(slong));
+
+    for (j = 0; j < c; j++)
+        index[j] = 0;
+
+    for (i = 0; i < rank; i++)
+        index[pivots[i]] = -1;
+
+    for (j = 0, n = 0; j < c; j++)
+        if (index[j] == 0)
+            index[j] = n++;
+
+    nnz = R->nnz - rank + nullity;
+    rows = (slong *) flint_malloc((nnz + 1) * sizeof(slong));
+    cols = (slong *) flint_malloc((nnz + 1) * sizeof(slong));
+    vals = _nmod_vec_init(nnz + 1);
+
+    n = 0;
+
+    for (j = 0; j < c; j++)
+    {
+        if (index[j] >= 0)
+        {
+            rows[n] = index[j];
+            cols[n] = j;
+            vals[n] = 1;
+            n++;
+        }
+    }
+
+    for (i = 0; i < rank; i++)
+    {
+        for (k = R->offsets[i]; k < R->offsets[i + 1]; k++)
+        {
+            if (R->cols[k] == pivots[i])
+                continue;
+
+            rows[n] = index[R->cols[k]];
+            cols[n] = pivots[i];
+            vals[n] = nmod_neg(R->entries[k], R->mod);
+            n++;
+        }
+    }
+
+    _nmod_sparse_mat_set_shape(X, nullity, c);
+    X->mod = R->mod;
+    nmod_sparse_mat_set_entries(X, rows, cols, vals, n);
+
+    flint_free(index);
+    flint_free(pivots);
+    flint_free(rows);
+    flint_free(cols);
+    _nmod_vec_clear(vals);
+    nmod_sparse_mat_clear(R);
+
+    return nullity;
+}
@@ -0,0 +1,399 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_poly.h"
+#include "nmod_poly_mat.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    Coppersmith's block Wiedemann algorithm. With random N x m blocks U
+    and V, the sequence S_i = U^T A^(i + 1) V of m x m matrices is computed
+    with one sparse-dense product per term. A matrix generator is then
+    found as a minimal approximant basis of [S(x) | -I] of order D with
+    shifts (0, ..., 0, 1, ..., 1): each column (f, g) satisfies
+    S(x) f(x) = g(x) mod x^D with deg g < deg f <= delta, where delta is
+    the shifted degree of the column. With f(x) = sum f_k x^(delta - k)
+    this means U^T A^i (sum_k A^(k + 1) V f_k) = 0 for 0 <= i < D - delta,
+    and for the columns of small degree it forces
+    v = sum_k A^k V f_k to lie in the kernel of A, or A^j v to do so for
+    some small j.
+
+    The basis is computed by the divide and conquer PM-basis algorithm,
+    with the iterative algorithm of Beckermann and Labahn, which handles one
+    scalar condition at a time, for small orders.
+*/
+
+#define BW_EXTRA_TERMS 8
+#define BW_MAX_POWERS 4
+#define BW_MBASIS_CUTOFF 16
+
+static void
+_nmod_mat_randuniform(nmod_mat_t M, flint_rand_t state)
+{
+    slong i, j;
+
+    for (i = 0; i < M->r; i++)
+        for (j = 0; j < M->c; j++)
+            nmod_mat_entry(M, i, j) = n_randint(state, M->mod.n);
+}
+
+/*
+    Iterative approximant basis: set P to a basis of order d for the m x 2m
+    series F, with the shifted column degrees in deg updated in place. The
+    residual E = F P is updated along with P, so that its coefficient of x^k
+    is available when the conditions of order k are processed.
+*/
+static void
+_mbasis(nmod_poly_mat_t P, slong * deg, const nmod_poly_mat_t F, slong d,
+                                                                   slong m)
+{
+    slong i, j, k, rr;
+    nmod_t mod;
+    nmod_mat_t R;
+    nmod_poly_mat_t E;
+    nmod_poly_t tmp;
+
+    nmod_init(&mod, nmod_poly_mat_modulus(F));
+    nmod_poly_mat_one(P);
+    nmod_poly_mat_init(E, m, 2 * m, mod.n);
+    nmod_poly_mat_set_trunc(E, F, d);
+    nmod_mat_init(R, m, 2 * m, mod.n);
+    nmod_poly_init_mod(tmp, mod);
+
+    for (k = 0; k < d; k++)
+    {
+        for (i = 0; i < m; i++)
+            for (j = 0; j < 2 * m; j++)
+                nmod_mat_entry(R, i, j) =
+                    nmod_poly_get_coeff_ui(nmod_poly_mat_entry(E, i, j), k);
+
+        for (rr = 0; rr < m; rr++)
+        {
+            slong piv = -1;
+            mp_limb_t inv;
+
+            for (j = 0; j < 2 * m; j++)
+                if (nmod_mat_entry(R, rr, j) != 0 && (piv == -1 || deg[j] < deg[piv]))
+                    piv = j;
+
+            if (piv == -1)
+                continue;
+
+            inv = nmod_inv(nmod_mat_entry(R, rr, piv), mod);
+
+            for (j = 0; j < 2 * m; j++)
+            {
+                mp_limb_t cf;
+
+                if (j == piv || nmod_mat_entry(R, rr, j) == 0)
+                    continue;
+
+                cf = nmod_mul(nmod_mat_entry(R, rr, j), inv, mod);
+
+                for (i = 0; i < 2 * m; i++)
+                {
+                    nmod_poly_scalar_mul_nmod(tmp, nmod_poly_mat_entry(P, i, piv), cf);
+                    nmod_poly_sub(nmod_poly_mat_entry(P, i, j),
+                                  nmod_poly_mat_entry(P, i, j), tmp);
+                }
+
+                for (i = 0; i < m; i++)
+                {
+                    nmod_poly_scalar_mul_nmod(tmp, nmod_poly_mat_entry(E, i, piv), cf);
+                    nmod_poly_sub(nmod_poly_mat_entry(E, i, j),
+                                  nmod_poly_mat_entry(E, i, j), tmp);
+                }
+
+                for (i = 0; i < m; i++)
+                    nmod_mat_entry(R, i, j) = nmod_sub(nmod_mat_entry(R, i, j),
+                                  nmod_mul(cf, nmod_mat_entry(R, i, piv), mod), mod);
+            }
+
+            for (i = 0; i < 2 * m; i++)
+                nmod_poly_shift_left(nmod_poly_mat_entry(P, i, piv),
+                                     nmod_poly_mat_entry(P, i, piv), 1);
+
+            for (i = 0; i < m; i++)
+            {
+                nmod_poly_shift_left(nmod_poly_mat_entry(E, i, piv),
+                                     nmod_poly_mat_entry(E, i, piv), 1);
+                nmod_poly_truncate(nmod_poly_mat_entry(E, i, piv), d);
+            }
+
+            for (i = 0; i < m; i++)
+                nmod_mat_entry(R, i, piv) = 0;
+
+            deg[piv]++;
+        }
+    }
+
+    nmod_poly_clear(tmp);
+    nmod_mat_clear(R);
+    nmod_poly_mat_clear(E);
+}
+
+/*
+    Divide and conquer approximant basis (PM-basis): a basis P1 of order
+    d/2 is computed first, then a basis P2 of the remaining order for the
+    residual (F P1) / x^(d/2), and P = P1 P2. This performs the same column
+    operations as _mbasis does for order d, so the result is identical.
+*/
+static void
+_pmbasis(nmod_poly_mat_t P, slong * deg, const nmod_poly_mat_t F, slong d,
+                                                                   slong m)
+{
+    slong d1;
+    mp_limb_t n = nmod_poly_mat_modulus(F);
+    nmod_poly_mat_t P1, P2, F2, Ft;
+
+    if (d <= BW_MBASIS_CUTOFF)
+    {
+        _mbasis(P, deg, F, d, m);
+        return;
+    }
+
+    d1 = d / 2;
+
+    nmod_poly_mat_init(P1, 2 * m, 2 * m, n);
+    nmod_poly_mat_init(P2, 2 * m, 2 * m, n);
+    nmod_poly_mat_init(F2, m, 2 * m, n);
+    nmod_poly_mat_init(Ft, m, 2 * m, n);
+
+    _pmbasis(P1, deg, F, d1, m);
+
+    /* nmod_poly_mat_mul does not allow aliasing in all cases */
+    nmod_poly_mat_set_trunc(Ft, F, d);
+    nmod_poly_mat_mul(F2, Ft, P1);
+    nmod_poly_mat_shift_right(F2, F2, d1);
+    nmod_poly_mat_truncate(F2, d - d1);
+
+    _pmbasis(P2, deg, F2, d - d1, m);
+
+    nmod_poly_mat_mul(P, P1, P2);
+
+    nmod_poly_mat_clear(P1);
+    nmod_poly_mat_clear(P2);
+    nmod_poly_mat_clear(F2);
+    nmod_poly_mat_clear(Ft);
+}
+
+slong
+nmod_sparse_mat_nullspace_block_wiedemann(nmod_sparse_mat_t X,
+        const nmod_sparse_mat_t A, slong block_size, flint_rand_t state)
+{
+    slong N = A->r, m, D, dmax, i, j, k, rr, ncand, nker, rank;
+    nmod_t mod = A->mod;
+    nmod_mat_t U, V, W, T, F, Vacc, Y, K, Kw;
+    nmod_mat_struct * S;
+    nmod_poly_mat_t P, SI;
+    slong * deg, * cand;
+
+    if (A->r != A->c)
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_nullspace_block_wiedemann). "
+                                 "Non-square matrix.\n");
+    }
+
+    if (N == 0)
+    {
+        _nmod_sparse_mat_set_shape(X, 0, N);
+        X->mod = mod;
+        return 0;
+    }
+
+    m = FLINT_MAX(1, FLINT_MIN(block_size, N));
+    dmax = (N + m - 1) / m + BW_EXTRA_TERMS / 2;
+    D = 2 * dmax;
+
+    /* the sequence S_i = U^T A^(i + 1) V */
+    nmod_mat_init(U, m, N, mod.n);
+    nmod_mat_init(V, N, m, mod.n);
+    nmod_mat_init(W, N, m, mod.n);
+    nmod_mat_init(T, N, m, mod.n);
+    _nmod_mat_randuniform(U, state);
+    _nmod_mat_randuniform(V, state);
+
+    S = (nmod_mat_struct *) flint_malloc(D * sizeof(nmod_mat_struct));
+
+    nmod_sparse_mat_mul_mat(W, A, V);
+
+    for (i = 0; i < D; i++)
+    {
+        nmod_mat_init(S + i, m, m, mod.n);
+        nmod_mat_mul(S + i, U, W);
+
+        if (i + 1 < D)
+        {
+            nmod_sparse_mat_mul_mat(T, A, W);
+            nmod_mat_swap(T, W);
+        }
+    }
+
+    /* approximant basis of [S | -I] to order D */
+    nmod_poly_mat_init(P, 2 * m, 2 * m, mod.n);
+    nmod_poly_mat_init(SI, m, 2 * m, mod.n);
+    deg = (slong *) flint_malloc(2 * m * sizeof(slong));
+
+    for (rr = 0; rr < m; rr++)
+    {
+        for (j = 0; j < m; j++)
+        {
+            nmod_poly_struct * f = nmod_poly_mat_entry(SI, rr, j);
+
+            nmod_poly_fit_length(f, D);
+            for (k = 0; k < D; k++)
+                f->coeffs[k] = nmod_mat_entry(S + k, rr, j);
+            _nmod_poly_set_length(f, D);
+            _nmod_poly_normalise(f);
+        }
+
+        nmod_poly_set_coeff_ui(nmod_poly_mat_entry(SI, rr, m + rr), 0,
+                                                         nmod_neg(1, mod));
+    }
+
+    for (j = 0; j < 2 * m; j++)
+        deg[j] = (j < m) ? 0 : 1;
+
+    _pmbasis(P, deg, SI, D, m);
+
+    nmod_poly_mat_clear(SI);
+
+    /* candidate generators: columns of small degree with f != 0 */
+    cand = (slong *) flint_malloc(2 * m * sizeof(slong));
+    ncand = 0;
+    dmax = 0;
+
+    for (j = 0; j < 2 * m; j++)
+    {
+        if (deg[j] > D / 2)
+            continue;
+
+        for (i = 0; i < m; i++)
+            if (!nmod_poly_is_zero(nmod_poly_mat_entry(P, i, j)))
+                break;
+
+        if (i < m)
+        {
+            cand[ncand++] = j;
+            dmax = FLINT_MAX(dmax, deg[j]);
+        }
+    }
+
+    nker = 0;
+
+    if (ncand == 0)
+    {
+        nmod_mat_init(K, 0, N, mod.n);
+    }
+    else
+    {
+        char * done;
+
+        /* Vacc = sum_k A^k V f_k by Horner's rule */
+        nmod_mat_init(F, m, ncand, mod.n);
+        nmod_mat_init(Vacc, N, ncand, mod.n);
+        nmod_mat_init(Y, N, ncand, mod.n);
+
+        for (k = dmax; k >= 0; k--)
+        {
+            for (j = 0; j < ncand; j++)
+            {
+                slong c = cand[j];
+
+                for (i = 0; i < m; i++)
+                    nmod_mat_entry(F, i, j) = (k <= deg[c]) ?
+                        nmod_poly_get_coeff_ui(nmod_poly_mat_entry(P, i, c), deg[c] - k) : 0;
+            }
+
+            nmod_sparse_mat_mul_mat(Y, A, Vacc);
+            nmod_mat_mul(Vacc, V, F);
+            nmod_mat_add(Vacc, Vacc, Y);
+        }
+
+        /* keep v if A v = 0, otherwise try A v, A^2 v, ... */
+        done = (char *) flint_calloc(ncand, 1);
+
+        for (k = 0; k < BW_MAX_POWERS; k++)
+        {
+            nmod_sparse_mat_mul_mat(Y, A, Vacc);
+
+            for (j = 0; j < ncand; j++)
+            {
+                int vzero = 1, yzero = 1;
+
+                if (done[j])
+                    continue;
+
+                for (i = 0; i < N; i++)
+                {
+                    vzero &= (nmod_mat_entry(Vacc, i, j) == 0);
+                    yzero &= (nmod_mat_entry(Y, i, j) == 0);
+                }
+
+                if (vzero)
+                    done[j] = 2;
+                else if (yzero)
+                    done[j] = 1;
+                else
+                    for (i = 0; i < N; i++)
+                        nmod_mat_entry(Vacc, i, j) = nmod_mat_entry(Y, i, j);
+            }
+        }
+
+        for (j = 0; j < ncand; j++)
+            nker += (done[j] == 1);
+
+        /* collect the kernel vectors as rows */
+        nmod_mat_init(K, nker, N, mod.n);
+
+        for (j = 0, k = 0; j < ncand; j++)
+        {
+            if (done[j] == 1)
+            {
+                for (i = 0; i < N; i++)
+                    nmod_mat_entry(K, k, i) = nmod_mat_entry(Vacc, i, j);
+                k++;
+            }
+        }
+
+        flint_free(done);
+        nmod_mat_clear(F);
+        nmod_mat_clear(Vacc);
+        nmod_mat_clear(Y);
+    }
+
+    /* a basis of the span of the vectors found */
+    rank = nmod_mat_rref(K);
+
+    nmod_mat_window_init(Kw, K, 0, 0, rank, N);
+    nmod_sparse_mat_set_nmod_mat(X, Kw);
+    nmod_mat_window_clear(Kw);
+    nmod_mat_clear(K);
+
+    for (i = 0; i < D; i++)
+        nmod_mat_clear(S + i);
+    flint_free(S);
+
+    flint_free(deg);
+    flint_free(cand);
+    nmod_poly_mat_clear(P);
+    nmod_mat_clear(U);
+    nmod_mat_clear(V);
+    nmod_mat_clear(W);
+    nmod_mat_clear(T);
+
+    return rank;
+}
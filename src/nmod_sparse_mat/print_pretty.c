@@ -0,0 +1,37 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_print_pretty(const nmod_sparse_mat_t A)
+{
+    slong i, k;
+
+    flint_printf("<%wd x %wd sparse integer matrix mod %wu, %wd nonzeros>\n",
+                                              A->r, A->c, A->mod.n, A->nnz);
+
+    for (i = 0; i < A->r; i++)
+    {
+        flint_printf("%wd: [", i);
+
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+        {
+            flint_printf("%wd:%wu", A->cols[k], A->entries[k]);
+
+            if (k + 1 < A->offsets[i + 1])
+                flint_printf(", ");
+        }
+
+        flint_printf("]\n");
+    }
+}
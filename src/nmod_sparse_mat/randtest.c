@@ -0,0 +1,52 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_randtest(nmod_sparse_mat_t A, flint_rand_t state, slong row_nnz)
+{
+    slong i, j, k, nnz;
+    slong * rows, * cols;
+    mp_ptr vals;
+
+    if (A->r == 0 || A->c == 0 || row_nnz <= 0)
+    {
+        nmod_sparse_mat_zero(A);
+        return;
+    }
+
+    nnz = A->r * FLINT_MIN(row_nnz, A->c);
+    rows = (slong *) flint_malloc(nnz * sizeof(slong));
+    cols = (slong *) flint_malloc(nnz * sizeof(slong));
+    vals = _nmod_vec_init(nnz);
+
+    for (i = k = 0; i < A->r; i++)
+    {
+        slong len = n_randint(state, FLINT_MIN(row_nnz, A->c) + 1);
+
+        for (j = 0; j < len; j++, k++)
+        {
+            rows[k] = i;
+            cols[k] = n_randint(state, A->c);
+            vals[k] = n_randtest(state);
+        }
+    }
+
+    nmod_sparse_mat_set_entries(A, rows, cols, vals, k);
+
+    flint_free(rows);
+    flint_free(cols);
+    _nmod_vec_clear(vals);
+}
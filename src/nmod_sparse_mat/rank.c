@@ -0,0 +1,27 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+slong
+nmod_sparse_mat_rank(const nmod_sparse_mat_t A)
+{
+    nmod_sparse_mat_t T;
+    slong rank;
+
+    nmod_sparse_mat_init(T, A->r, A->c, A->mod.n);
+    nmod_sparse_mat_set(T, A);
+    rank = _nmod_sparse_mat_rref_structured(T, NULL, T->c);
+    nmod_sparse_mat_clear(T);
+
+    return rank;
+}
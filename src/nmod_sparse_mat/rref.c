@@ -0,0 +1,530 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdlib.h>
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    Sparse Gauss-Jordan elimination.
+
+    Rows are held as separate sparse vectors. We keep for every column the
+    number of active (not yet pivotal) rows containing it, and a list of rows
+    which may contain it; entries of this list can be stale and are checked
+    before use. The pivot row is the shortest active row in the pivot column.
+
+    In structured mode the columns are picked from a heap keyed by their
+    count (Markowitz pivoting), so that columns of weight one, whose
+    elimination costs nothing, are removed first; this is the structured
+    Gaussian elimination used in index calculus and factoring. Columns
+    j >= c1 are only used once no column j < c1 remains. Otherwise the
+    columns are used from left to right, which gives the reduced row
+    echelon form.
+
+    The forward phase leaves pivot rows k which contain no pivot column
+    chosen before k. The backward phase then clears later pivot columns
+    from each pivot row using a dense accumulator.
+*/
+
+typedef struct
+{
+    slong * cols;
+    mp_ptr vals;
+    slong len;
+    slong alloc;
+}
+_spvec_struct;
+
+typedef struct
+{
+    slong count;
+    slong col;
+}
+_heap_entry;
+
+typedef struct
+{
+    _heap_entry * data;
+    slong len;
+    slong alloc;
+}
+_heap_struct;
+
+static void
+_spvec_fit_length(_spvec_struct * v, slong len)
+{
+    if (len > v->alloc)
+    {
+        slong alloc = FLINT_MAX(len, 2 * v->alloc);
+        v->cols = (slong *) flint_realloc(v->cols, alloc * sizeof(slong));
+        v->vals = (mp_ptr) flint_realloc(v->vals, alloc * sizeof(mp_limb_t));
+        v->alloc = alloc;
+    }
+}
+
+static slong
+_spvec_find(const _spvec_struct * v, slong j)
+{
+    slong lo = 0, hi = v->len;
+
+    while (lo < hi)
+    {
+        slong mid = lo + (hi - lo) / 2;
+
+        if (v->cols[mid] < j)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return (lo < v->len && v->cols[lo] == j) ? lo : -1;
+}
+
+static void
+_heap_push(_heap_struct * h, slong count, slong col)
+{
+    slong i;
+
+    if (h->len == h->alloc)
+    {
+        h->alloc = FLINT_MAX(16, 2 * h->alloc);
+        h->data = (_heap_entry *) flint_realloc(h->data, h->alloc * sizeof(_heap_entry));
+    }
+
+    i = h->len++;
+
+    while (i > 0)
+    {
+        slong j = (i - 1) / 2;
+
+        if (h->data[j].count <= count)
+            break;
+
+        h->data[i] = h->data[j];
+        i = j;
+    }
+
+    h->data[i].count = count;
+    h->data[i].col = col;
+}
+
+static _heap_entry
+_heap_pop(_heap_struct * h)
+{
+    _heap_entry top = h->data[0], last = h->data[--h->len];
+    slong i = 0;
+
+    while (1)
+    {
+        slong j = 2 * i + 1;
+
+        if (j >= h->len)
+            break;
+
+        if (j + 1 < h->len && h->data[j + 1].count < h->data[j].count)
+            j++;
+
+        if (last.count <= h->data[j].count)
+            break;
+
+        h->data[i] = h->data[j];
+        i = j;
+    }
+
+    if (h->len > 0)
+        h->data[i] = last;
+
+    return top;
+}
+
+static void
+_col_list_append(slong ** lists, slong * lens, slong * allocs, slong j, slong i)
+{
+    if (lens[j] == allocs[j])
+    {
+        allocs[j] = FLINT_MAX(4, 2 * allocs[j]);
+        lists[j] = (slong *) flint_realloc(lists[j], allocs[j] * sizeof(slong));
+    }
+
+    lists[j][lens[j]++] = i;
+}
+
+/* heap key of column j in structured mode */
+#define KEY(j) (count[j] + ((j) >= c1 ? r + 1 : 0))
+
+static int
+_slong_cmp(const void * a, const void * b)
+{
+    slong x = *((const slong *) a), y = *((const slong *) b);
+    return (x > y) - (x < y);
+}
+
+static slong
+_nmod_sparse_mat_rref_inner(nmod_sparse_mat_t A, slong * pivots,
+                                              int structured, slong c1)
+{
+    slong r = A->r, c = A->c;
+    nmod_t mod = A->mod;
+    _spvec_struct * rows, tmp;
+    slong ** col_rows, * col_len, * col_alloc, * count;
+    slong * prow, * pcol, * pivot_index, * order, * touched;
+    char * active, * in_list;
+    mp_ptr w;
+    _heap_struct heap;
+    slong i, j, k, rank, nnz, next;
+
+    if (r == 0 || c == 0)
+        return 0;
+
+    rows = (_spvec_struct *) flint_calloc(r, sizeof(_spvec_struct));
+    col_rows = (slong **) flint_calloc(c, sizeof(slong *));
+    col_len = (slong *) flint_calloc(c, sizeof(slong));
+    col_alloc = (slong *) flint_calloc(c, sizeof(slong));
+    count = (slong *) flint_calloc(c, sizeof(slong));
+    pivot_index = (slong *) flint_malloc(c * sizeof(slong));
+    active = (char *) flint_malloc(r);
+    prow = (slong *) flint_malloc(FLINT_MIN(r, c) * sizeof(slong));
+    pcol = (slong *) flint_malloc(FLINT_MIN(r, c) * sizeof(slong));
+    tmp.cols = NULL;
+    tmp.vals = NULL;
+    tmp.len = tmp.alloc = 0;
+    heap.data = NULL;
+    heap.len = heap.alloc = 0;
+
+    for (i = 0; i < r; i++)
+    {
+        slong len = A->offsets[i + 1] - A->offsets[i];
+
+        _spvec_fit_length(rows + i, len);
+        rows[i].len = len;
+
+        for (k = 0; k < len; k++)
+        {
+            j = A->cols[A->offsets[i] + k];
+            rows[i].cols[k] = j;
+            rows[i].vals[k] = A->entries[A->offsets[i] + k];
+            count[j]++;
+            _col_list_append(col_rows, col_len, col_alloc, j, i);
+        }
+
+        active[i] = 1;
+    }
+
+    for (j = 0; j < c; j++)
+    {
+        pivot_index[j] = -1;
+
+        if (structured && count[j] != 0)
+            _heap_push(&heap, KEY(j), j);
+    }
+
+    /* forward elimination */
+    rank = 0;
+    next = 0;
+
+    while (1)
+    {
+        slong p, best = -1, pos;
+        _spvec_struct * piv;
+        mp_limb_t inv;
+
+        if (structured)
+        {
+            _heap_entry e;
+
+            if (heap.len == 0)
+                break;
+
+            e = _heap_pop(&heap);
+            p = e.col;
+
+            if (pivot_index[p] >= 0 || count[p] == 0 || e.count != KEY(p))
+                continue;
+        }
+        else
+        {
+            while (next < c && count[next] == 0)
+                next++;
+
+            if (next == c)
+                break;
+
+            p = next++;
+        }
+
+        for (k = 0; k < col_len[p]; k++)
+        {
+            i = col_rows[p][k];
+
+            if (active[i] && (best == -1 || rows[i].len < rows[best].len)
+                          && _spvec_find(rows + i, p) >= 0)
+                best = i;
+        }
+
+        if (best == -1)
+            continue;
+
+        piv = rows + best;
+        pos = _spvec_find(piv, p);
+
+        if (n_gcdinv(&inv, piv->vals[pos], mod.n) != 1)
+            flint_throw(FLINT_IMPINV, "Exception (nmod_sparse_mat_rref). "
+                                      "Modulus is not prime.\n");
+
+        _nmod_vec_scalar_mul_nmod(piv->vals, piv->vals, piv->len, inv, mod);
+
+        active[best] = 0;
+        pivot_index[p] = rank;
+        prow[rank] = best;
+        pcol[rank] = p;
+        rank++;
+
+        for (k = 0; k < piv->len; k++)
+        {
+            j = piv->cols[k];
+            count[j]--;
+
+            if (structured && count[j] > 0 && pivot_index[j] < 0)
+                _heap_push(&heap, KEY(j), j);
+        }
+
+        for (k = 0; k < col_len[p]; k++)
+        {
+            _spvec_struct * row;
+            slong ia, ib, n;
+            mp_limb_t cf;
+
+            i = col_rows[p][k];
+            row = rows + i;
+
+            if (!active[i] || (pos = _spvec_find(row, p)) < 0)
+                continue;
+
+            /* row -= cf * piv */
+            cf = row->vals[pos];
+            _spvec_fit_length(&tmp, row->len + piv->len);
+
+            ia = ib = n = 0;
+
+            while (ia < row->len || ib < piv->len)
+            {
+                if (ib == piv->len || (ia < row->len && row->cols[ia] < piv->cols[ib]))
+                {
+                    tmp.cols[n] = row->cols[ia];
+                    tmp.vals[n] = row->vals[ia];
+                    n++;
+                    ia++;
+                }
+                else if (ia == row->len || piv->cols[ib] < row->cols[ia])
+                {
+                    /* fill in */
+                    j = piv->cols[ib];
+                    tmp.cols[n] = j;
+                    tmp.vals[n] = nmod_neg(nmod_mul(cf, piv->vals[ib], mod), mod);
+                    n++;
+                    ib++;
+
+                    count[j]++;
+                    _col_list_append(col_rows, col_len, col_alloc, j, i);
+                    if (structured && pivot_index[j] < 0)
+                        _heap_push(&heap, KEY(j), j);
+                }
+                else
+                {
+                    mp_limb_t v;
+
+                    j = row->cols[ia];
+                    v = nmod_sub(row->vals[ia], nmod_mul(cf, piv->vals[ib], mod), mod);
+                    ia++;
+                    ib++;
+
+                    if (v != 0)
+                    {
+                        tmp.cols[n] = j;
+                        tmp.vals[n] = v;
+                        n++;
+                    }
+                    else
+                    {
+                        /* cancellation */
+                        count[j]--;
+                        if (structured && count[j] > 0 && pivot_index[j] < 0)
+                            _heap_push(&heap, KEY(j), j);
+                    }
+                }
+            }
+
+            tmp.len = n;
+
+            {
+                _spvec_struct t = *row;
+                *row = tmp;
+                tmp = t;
+            }
+        }
+
+        flint_free(col_rows[p]);
+        col_rows[p] = NULL;
+        col_len[p] = col_alloc[p] = 0;
+    }
+
+    /* backward elimination */
+    w = _nmod_vec_init(c);
+    in_list = (char *) flint_calloc(c, 1);
+    touched = (slong *) flint_malloc(c * sizeof(slong));
+
+    for (k = rank - 1; k >= 0; k--)
+    {
+        _spvec_struct * row = rows + prow[k];
+        slong n, ntouched = 0;
+
+        for (i = 0; i < row->len; i++)
+            if (row->cols[i] != pcol[k] && pivot_index[row->cols[i]] >= 0)
+                break;
+
+        if (i == row->len)
+            continue;
+
+        for (i = 0; i < row->len; i++)
+        {
+            j = row->cols[i];
+            w[j] = row->vals[i];
+            in_list[j] = 1;
+            touched[ntouched++] = j;
+        }
+
+        for (i = 0; i < row->len; i++)
+        {
+            slong kk = pivot_index[row->cols[i]];
+            _spvec_struct * other;
+            mp_limb_t cf;
+
+            if (kk < 0 || kk == k)
+                continue;
+
+            cf = w[row->cols[i]];
+            other = rows + prow[kk];
+
+            for (n = 0; n < other->len; n++)
+            {
+                j = other->cols[n];
+
+                if (!in_list[j])
+                {
+                    in_list[j] = 1;
+                    w[j] = 0;
+                    touched[ntouched++] = j;
+                }
+
+                w[j] = nmod_sub(w[j], nmod_mul(cf, other->vals[n], mod), mod);
+            }
+        }
+
+        qsort(touched, ntouched, sizeof(slong), _slong_cmp);
+
+        _spvec_fit_length(row, ntouched);
+
+        for (i = n = 0; i < ntouched; i++)
+        {
+            j = touched[i];
+
+            if (w[j] != 0)
+            {
+                row->cols[n] = j;
+                row->vals[n] = w[j];
+                n++;
+            }
+
+            in_list[j] = 0;
+        }
+
+        row->len = n;
+    }
+
+    /* write out the pivot rows sorted by pivot column */
+    order = (slong *) flint_malloc(c * sizeof(slong));
+
+    for (j = k = 0; j < c; j++)
+        if (pivot_index[j] >= 0)
+            order[k++] = pivot_index[j];
+
+    nnz = 0;
+    for (k = 0; k < rank; k++)
+        nnz += rows[prow[k]].len;
+
+    _nmod_sparse_mat_set_shape(A, r, c);
+    nmod_sparse_mat_fit_nnz(A, nnz);
+
+    for (k = 0, nnz = 0; k < rank; k++)
+    {
+        _spvec_struct * row = rows + prow[order[k]];
+
+        if (pivots != NULL)
+            pivots[k] = pcol[order[k]];
+
+        for (i = 0; i < row->len; i++)
+        {
+            A->cols[nnz] = row->cols[i];
+            A->entries[nnz] = row->vals[i];
+            nnz++;
+        }
+
+        A->offsets[k + 1] = nnz;
+    }
+
+    for (k = rank; k < r; k++)
+        A->offsets[k + 1] = nnz;
+
+    A->nnz = nnz;
+
+    for (i = 0; i < r; i++)
+    {
+        flint_free(rows[i].cols);
+        flint_free(rows[i].vals);
+    }
+
+    for (j = 0; j < c; j++)
+        flint_free(col_rows[j]);
+
+    flint_free(rows);
+    flint_free(tmp.cols);
+    flint_free(tmp.vals);
+    flint_free(heap.data);
+    flint_free(col_rows);
+    flint_free(col_len);
+    flint_free(col_alloc);
+    flint_free(count);
+    flint_free(pivot_index);
+    flint_free(active);
+    flint_free(prow);
+    flint_free(pcol);
+    flint_free(order);
+    flint_free(touched);
+    flint_free(in_list);
+    _nmod_vec_clear(w);
+
+    return rank;
+}
+
+slong
+nmod_sparse_mat_rref(nmod_sparse_mat_t A)
+{
+    return _nmod_sparse_mat_rref_inner(A, NULL, 0, A->c);
+}
+
+slong
+_nmod_sparse_mat_rref_structured(nmod_sparse_mat_t A, slong * pivots, slong c1)
+{
+    return _nmod_sparse_mat_rref_inner(A, pivots, 1, c1);
+}
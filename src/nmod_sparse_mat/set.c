@@ -0,0 +1,36 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_set(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    slong i;
+
+    if (B == A)
+        return;
+
+    _nmod_sparse_mat_set_shape(B, A->r, A->c);
+    B->mod = A->mod;
+
+    nmod_sparse_mat_fit_nnz(B, A->nnz);
+    flint_mpn_copyi(B->entries, A->entries, A->nnz);
+
+    for (i = 0; i < A->nnz; i++)
+        B->cols[i] = A->cols[i];
+
+    for (i = 0; i <= A->r; i++)
+        B->offsets[i] = A->offsets[i];
+
+    B->nnz = A->nnz;
+}
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_set_entries(nmod_sparse_mat_t A, const slong * rows,
+                          const slong * cols, mp_srcptr vals, slong nnz)
+{
+    slong i, j, k, r = A->r, c = A->c;
+    slong * count, * perm1, * perm2;
+
+    _nmod_sparse_mat_set_shape(A, r, c);
+
+    if (nnz == 0)
+        return;
+
+    /* counting sort by column, then a stable counting sort by row */
+    count = (slong *) flint_calloc(FLINT_MAX(r, c) + 1, sizeof(slong));
+    perm1 = (slong *) flint_malloc(nnz * sizeof(slong));
+    perm2 = (slong *) flint_malloc(nnz * sizeof(slong));
+
+    for (i = 0; i < nnz; i++)
+    {
+        if (rows[i] < 0 || rows[i] >= r || cols[i] < 0 || cols[i] >= c)
+            flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_set_entries). "
+                                     "Index out of range.\n");
+        count[cols[i] + 1]++;
+    }
+
+    for (j = 0; j < c; j++)
+        count[j + 1] += count[j];
+
+    for (i = 0; i < nnz; i++)
+        perm1[count[cols[i]]++] = i;
+
+    for (i = 0; i <= r; i++)
+        count[i] = 0;
+
+    for (i = 0; i < nnz; i++)
+        count[rows[i] + 1]++;
+
+    for (i = 0; i < r; i++)
+        count[i + 1] += count[i];
+
+    for (k = 0; k < nnz; k++)
+    {
+        i = perm1[k];
+        perm2[count[rows[i]]++] = i;
+    }
+
+    /* merge duplicates and drop zeros */
+    nmod_sparse_mat_fit_nnz(A, nnz);
+
+    for (k = 0, j = 0; k < nnz; )
+    {
+        slong row = rows[perm2[k]], col = cols[perm2[k]];
+        mp_limb_t v = 0;
+
+        for ( ; k < nnz && rows[perm2[k]] == row && cols[perm2[k]] == col; k++)
+        {
+            mp_limb_t t = vals[perm2[k]];
+            NMOD_RED(t, t, A->mod);
+            v = nmod_add(v, t, A->mod);
+        }
+
+        if (v != 0)
+        {
+            A->entries[j] = v;
+            A->cols[j] = col;
+            A->offsets[row + 1]++;
+            j++;
+        }
+    }
+
+    for (i = 0; i < r; i++)
+        A->offsets[i + 1] += A->offsets[i];
+
+    A->nnz = j;
+
+    flint_free(count);
+    flint_free(perm1);
+    flint_free(perm2);
+}
@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_set_nmod_mat(nmod_sparse_mat_t A, const nmod_mat_t B)
+{
+    slong i, j, k, nnz;
+
+    nnz = 0;
+    for (i = 0; i < B->r; i++)
+        for (j = 0; j < B->c; j++)
+            nnz += (nmod_mat_entry(B, i, j) != 0);
+
+    _nmod_sparse_mat_set_shape(A, B->r, B->c);
+    A->mod = B->mod;
+    nmod_sparse_mat_fit_nnz(A, nnz);
+
+    for (i = 0, k = 0; i < B->r; i++)
+    {
+        for (j = 0; j < B->c; j++)
+        {
+            if (nmod_mat_entry(B, i, j) != 0)
+            {
+                A->entries[k] = nmod_mat_entry(B, i, j);
+                A->cols[k] = j;
+                k++;
+            }
+        }
+
+        A->offsets[i + 1] = k;
+    }
+
+    A->nnz = nnz;
+}
@@ -0,0 +1,76 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+int
+nmod_sparse_mat_solve(mp_ptr x, const nmod_sparse_mat_t A, mp_srcptr b)
+{
+    nmod_sparse_mat_t R;
+    slong i, k, nnz, r = A->r, c = A->c, rank;
+    slong * pivots;
+    int result = 1;
+
+    /* form the augmented matrix [A | b] */
+    nmod_sparse_mat_init(R, r, c + 1, A->mod.n);
+    nmod_sparse_mat_fit_nnz(R, A->nnz + r);
+
+    for (i = 0, nnz = 0; i < r; i++)
+    {
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+        {
+            R->cols[nnz] = A->cols[k];
+            R->entries[nnz] = A->entries[k];
+            nnz++;
+        }
+
+        if (b[i] != 0)
+        {
+            R->cols[nnz] = c;
+            R->entries[nnz] = b[i];
+            nnz++;
+        }
+
+        R->offsets[i + 1] = nnz;
+    }
+
+    R->nnz = nnz;
+
+    /* the last column is only chosen as a pivot if the system is
+       inconsistent; as pivots come out sorted it is then the last one */
+    pivots = (slong *) flint_malloc((FLINT_MIN(r, c + 1) + 1) * sizeof(slong));
+    rank = _nmod_sparse_mat_rref_structured(R, pivots, c);
+
+    for (k = 0; k < c; k++)
+        x[k] = 0;
+
+    if (rank > 0 && pivots[rank - 1] == c)
+    {
+        result = 0;
+    }
+    else
+    {
+        for (i = 0; i < rank; i++)
+        {
+            k = R->offsets[i + 1] - 1;
+
+            if (R->cols[k] == c)
+                x[pivots[i]] = R->entries[k];
+        }
+    }
+
+    flint_free(pivots);
+
+    nmod_sparse_mat_clear(R);
+
+    return result;
+}
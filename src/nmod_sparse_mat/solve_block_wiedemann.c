@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+/*
+    A solution of A x = b gives the kernel vector (x, 1) of the square
+    matrix [[A, -b], [0, 0]], and conversely any kernel vector (y, t) with
+    t != 0 gives the solution x = y / t.
+*/
+int
+nmod_sparse_mat_solve_block_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                       mp_srcptr b, slong block_size, flint_rand_t state)
+{
+    nmod_sparse_mat_t B, X;
+    slong i, k, nnz, N = A->r;
+    mp_ptr t;
+    int result = 0;
+
+    if (A->r != A->c)
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_solve_block_wiedemann). "
+                                 "Non-square matrix.\n");
+    }
+
+    if (_nmod_vec_is_zero(b, N))
+    {
+        _nmod_vec_zero(x, N);
+        return 1;
+    }
+
+    nmod_sparse_mat_init(B, N + 1, N + 1, A->mod.n);
+    nmod_sparse_mat_init(X, 0, N + 1, A->mod.n);
+    nmod_sparse_mat_fit_nnz(B, A->nnz + N);
+
+    for (i = 0, nnz = 0; i < N; i++)
+    {
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+        {
+            B->cols[nnz] = A->cols[k];
+            B->entries[nnz] = A->entries[k];
+            nnz++;
+        }
+
+        if (b[i] != 0)
+        {
+            B->cols[nnz] = N;
+            B->entries[nnz] = nmod_neg(b[i], A->mod);
+            nnz++;
+        }
+
+        B->offsets[i + 1] = nnz;
+    }
+
+    B->offsets[N + 1] = nnz;
+    B->nnz = nnz;
+
+    nmod_sparse_mat_nullspace_block_wiedemann(X, B, block_size, state);
+
+    for (i = 0; i < X->r && !result; i++)
+    {
+        slong last = X->offsets[i + 1] - 1;
+
+        if (last >= X->offsets[i] && X->cols[last] == N)
+        {
+            mp_limb_t c = nmod_inv(X->entries[last], A->mod);
+
+            _nmod_vec_zero(x, N);
+
+            for (k = X->offsets[i]; k < last; k++)
+                x[X->cols[k]] = nmod_mul(X->entries[k], c, A->mod);
+
+            t = _nmod_vec_init(N);
+            nmod_sparse_mat_mul_vec(t, A, x);
+            result = _nmod_vec_equal(t, b, N);
+            _nmod_vec_clear(t);
+        }
+    }
+
+    nmod_sparse_mat_clear(B);
+    nmod_sparse_mat_clear(X);
+
+    return result;
+}
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_poly.h"
+#include "nmod_sparse_mat.h"
+
+int
+nmod_sparse_mat_solve_wiedemann(mp_ptr x, const nmod_sparse_mat_t A,
+                                        mp_srcptr b, flint_rand_t state)
+{
+    slong i, d, N = A->r;
+    nmod_t mod = A->mod;
+    mp_ptr u, w, t, seq;
+    const nmod_poly_struct * V;
+    nmod_berlekamp_massey_t B;
+    int nlimbs, result;
+
+    if (A->r != A->c)
+    {
+        flint_throw(FLINT_ERROR, "Exception (nmod_sparse_mat_solve_wiedemann). "
+                                 "Non-square matrix.\n");
+    }
+
+    if (_nmod_vec_is_zero(b, N))
+    {
+        _nmod_vec_zero(x, N);
+        return 1;
+    }
+
+    u = _nmod_vec_init(N);
+    w = _nmod_vec_init(N);
+    t = _nmod_vec_init(N);
+    seq = _nmod_vec_init(2 * N);
+    nlimbs = _nmod_vec_dot_bound_limbs(N, mod);
+
+    /* seq[i] = u^T A^i b */
+    for (i = 0; i < N; i++)
+        u[i] = n_randint(state, mod.n);
+
+    _nmod_vec_set(w, b, N);
+
+    for (i = 0; i < 2 * N; i++)
+    {
+        seq[i] = _nmod_vec_dot(u, w, N, mod, nlimbs);
+
+        if (i + 1 < 2 * N)
+        {
+            nmod_sparse_mat_mul_vec(t, A, w);
+            MP_PTR_SWAP(t, w);
+        }
+    }
+
+    nmod_berlekamp_massey_init(B, mod.n);
+    nmod_berlekamp_massey_add_points(B, seq, 2 * N);
+    nmod_berlekamp_massey_reduce(B);
+    V = nmod_berlekamp_massey_V_poly(B);
+    d = V->length - 1;
+
+    result = 0;
+
+    /* V(A) b = 0 with high probability; if V(0) != 0 then
+       x = -V(0)^(-1) (V(A) - V(0)) A^(-1) b solves A x = b */
+    if (d >= 1 && V->coeffs[0] != 0)
+    {
+        mp_limb_t c;
+
+        _nmod_vec_scalar_mul_nmod(w, b, N, V->coeffs[d], mod);
+
+        for (i = d - 1; i >= 1; i--)
+        {
+            nmod_sparse_mat_mul_vec(t, A, w);
+            _nmod_vec_scalar_addmul_nmod(t, b, N, V->coeffs[i], mod);
+            MP_PTR_SWAP(t, w);
+        }
+
+        c = nmod_neg(nmod_inv(V->coeffs[0], mod), mod);
+        _nmod_vec_scalar_mul_nmod(x, w, N, c, mod);
+
+        nmod_sparse_mat_mul_vec(t, A, x);
+        result = _nmod_vec_equal(t, b, N);
+    }
+
+    nmod_berlekamp_massey_clear(B);
+    _nmod_vec_clear(u);
+    _nmod_vec_clear(w);
+    _nmod_vec_clear(t);
+    _nmod_vec_clear(seq);
+
+    return result;
+}
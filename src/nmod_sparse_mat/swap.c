@@ -0,0 +1,24 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_swap(nmod_sparse_mat_t A, nmod_sparse_mat_t B)
+{
+    if (A != B)
+    {
+        nmod_sparse_mat_struct t = *A;
+        *A = *B;
+        *B = t;
+    }
+}
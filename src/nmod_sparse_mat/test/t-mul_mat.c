@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_mat....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t B, X, Y, Z;
+        slong r, c, k;
+        mp_limb_t n;
+
+        if (n_randint(state, 20) == 0)
+        {
+            r = n_randint(state, 1000);
+            c = n_randint(state, 1000);
+        }
+        else
+        {
+            r = n_randint(state, 50);
+            c = n_randint(state, 50);
+        }
+
+        k = n_randint(state, 10);
+        n = n_randtest_not_zero(state);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+        nmod_mat_init(X, c, k, n);
+        nmod_mat_init(Y, r, k, n);
+        nmod_mat_init(Z, r, k, n);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 30));
+        nmod_mat_randtest(X, state);
+
+        nmod_sparse_mat_mul_mat(Y, A, X);
+
+        nmod_sparse_mat_get_nmod_mat(B, A);
+        nmod_mat_mul(Z, B, X);
+
+        if (!nmod_mat_equal(Y, Z))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("r = %wd, c = %wd, k = %wd, n = %wu\n", r, c, k, n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* aliasing */
+        if (r == c)
+        {
+            nmod_sparse_mat_mul_mat(Z, A, Z);
+            nmod_mat_mul(Y, B, Y);
+
+            if (!nmod_mat_equal(Y, Z))
+            {
+                flint_printf("FAIL: aliasing\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(X);
+        nmod_mat_clear(Y);
+        nmod_mat_clear(Z);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
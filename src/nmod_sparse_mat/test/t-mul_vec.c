@@ -0,0 +1,83 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("mul_vec....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t B;
+        mp_ptr x, y, z;
+        slong r, c;
+        mp_limb_t n;
+
+        if (n_randint(state, 20) == 0)
+        {
+            r = n_randint(state, 3000);
+            c = n_randint(state, 3000);
+        }
+        else
+        {
+            r = n_randint(state, 50);
+            c = n_randint(state, 50);
+        }
+
+        n = n_randtest_not_zero(state);
+
+        flint_set_num_threads(n_randint(state, 5) + 1);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+        x = _nmod_vec_init(c);
+        y = _nmod_vec_init(r);
+        z = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 30));
+        _nmod_vec_randtest(x, state, c, A->mod);
+
+        nmod_sparse_mat_mul_vec(y, A, x);
+
+        nmod_sparse_mat_get_nmod_mat(B, A);
+        nmod_mat_mul_nmod_vec(z, B, x, c);
+
+        if (!_nmod_vec_equal(y, z, r))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("r = %wd, c = %wd, n = %wu\n", r, c, n);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(B);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(z);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
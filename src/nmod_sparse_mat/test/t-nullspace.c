@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A, X;
+        nmod_mat_t B, Xd, Xt, AX;
+        slong r, c, rank, nullity;
+        mp_limb_t n;
+
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+        n = n_randtest_prime(state, 0);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_sparse_mat_init(X, 0, 0, n);
+        nmod_mat_init(B, r, c, n);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 6));
+        rank = nmod_sparse_mat_rank(A);
+
+        nullity = nmod_sparse_mat_nullspace(X, A);
+
+        if (nullity != c - rank || X->r != nullity || X->c != c)
+        {
+            flint_printf("FAIL: nullity\n");
+            flint_printf("rank = %wd, nullity = %wd\n", rank, nullity);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_mat_init(Xd, nullity, c, n);
+        nmod_mat_init(Xt, c, nullity, n);
+        nmod_mat_init(AX, r, nullity, n);
+
+        nmod_sparse_mat_get_nmod_mat(Xd, X);
+        nmod_mat_transpose(Xt, Xd);
+        nmod_sparse_mat_mul_mat(AX, A, Xt);
+
+        if (!nmod_mat_is_zero(AX) || nmod_mat_rank(Xd) != nullity)
+        {
+            flint_printf("FAIL: basis\n");
+            nmod_sparse_mat_print_pretty(A);
+            nmod_sparse_mat_print_pretty(X);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* aliasing */
+        nmod_sparse_mat_nullspace(A, A);
+
+        if (!nmod_sparse_mat_equal(A, X))
+        {
+            flint_printf("FAIL: aliasing\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(X);
+        nmod_mat_clear(B);
+        nmod_mat_clear(Xd);
+        nmod_mat_clear(Xt);
+        nmod_mat_clear(AX);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
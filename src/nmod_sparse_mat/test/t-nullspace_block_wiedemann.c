@@ -0,0 +1,97 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("nullspace_block_wiedemann....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 200 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A, X;
+        nmod_mat_t Xd, Xt, AX;
+        slong N, k, nullity, block_size, tries;
+        mp_limb_t n;
+
+        N = n_randint(state, 80);
+        n = n_randprime(state, 2 + n_randint(state, FLINT_BITS - 1), 0);
+        block_size = 1 + n_randint(state, 8);
+
+        nmod_sparse_mat_init(A, N, N, n);
+        nmod_sparse_mat_init(X, 0, 0, n);
+
+        nmod_sparse_mat_randtest(A, state, 1 + n_randint(state, 5));
+        nullity = N - nmod_sparse_mat_rank(A);
+
+        for (tries = 0; tries < 3; tries++)
+        {
+            k = nmod_sparse_mat_nullspace_block_wiedemann(X, A, block_size, state);
+
+            if (k > nullity || X->r != k || X->c != N)
+            {
+                flint_printf("FAIL: dimensions\n");
+                flint_printf("N = %wd, nullity = %wd, k = %wd\n", N, nullity, k);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            nmod_mat_init(Xd, k, N, n);
+            nmod_mat_init(Xt, N, k, n);
+            nmod_mat_init(AX, N, k, n);
+
+            nmod_sparse_mat_get_nmod_mat(Xd, X);
+            nmod_mat_transpose(Xt, Xd);
+            nmod_sparse_mat_mul_mat(AX, A, Xt);
+
+            if (!nmod_mat_is_zero(AX) || nmod_mat_rank(Xd) != k)
+            {
+                flint_printf("FAIL: not a kernel basis\n");
+                nmod_sparse_mat_print_pretty(A);
+                nmod_sparse_mat_print_pretty(X);
+                fflush(stdout);
+                flint_abort();
+            }
+
+            nmod_mat_clear(Xd);
+            nmod_mat_clear(Xt);
+            nmod_mat_clear(AX);
+
+            if (k > 0 || nullity == 0)
+                break;
+        }
+
+        if (k == 0 && nullity > 0 && n > 1000)
+        {
+            flint_printf("FAIL: no kernel vector found\n");
+            flint_printf("N = %wd, nullity = %wd, block_size = %wd\n", N, nullity, block_size);
+            nmod_sparse_mat_print_pretty(A);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(X);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("rref....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t B, C;
+        slong r, c, rank1, rank2;
+        mp_limb_t n;
+
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+        n = n_randtest_prime(state, 0);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+        nmod_mat_init(C, r, c, n);
+
+        if (n_randint(state, 2))
+        {
+            nmod_sparse_mat_randtest(A, state, n_randint(state, 6));
+        }
+        else
+        {
+            nmod_mat_randrank(B, state, n_randint(state, FLINT_MIN(r, c) + 1));
+            nmod_mat_randops(B, n_randint(state, 2 * r + 1), state);
+            nmod_sparse_mat_set_nmod_mat(A, B);
+        }
+
+        nmod_sparse_mat_get_nmod_mat(B, A);
+
+        rank1 = nmod_mat_rref(B);
+        rank2 = nmod_sparse_mat_rref(A);
+
+        nmod_sparse_mat_get_nmod_mat(C, A);
+
+        if (rank1 != rank2 || !nmod_mat_equal(B, C))
+        {
+            flint_printf("FAIL\n");
+            flint_printf("rank1 = %wd, rank2 = %wd\n", rank1, rank2);
+            nmod_mat_print_pretty(B);
+            nmod_mat_print_pretty(C);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (nmod_sparse_mat_rank(A) != rank1)
+        {
+            flint_printf("FAIL: rank\n");
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(C);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("set_entries....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A, B;
+        nmod_mat_t C, D;
+        slong i, j, k, r, c, nnz;
+        slong * rows, * cols;
+        mp_ptr vals;
+        mp_limb_t n;
+
+        r = n_randint(state, 20);
+        c = n_randint(state, 20);
+        n = n_randtest_not_zero(state);
+        nnz = (r == 0 || c == 0) ? 0 : n_randint(state, 2 * r * c + 1);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_sparse_mat_init(B, 0, 0, n);
+        nmod_mat_init(C, r, c, n);
+        nmod_mat_init(D, r, c, n);
+
+        rows = flint_malloc((nnz + 1) * sizeof(slong));
+        cols = flint_malloc((nnz + 1) * sizeof(slong));
+        vals = _nmod_vec_init(nnz + 1);
+
+        /* duplicated indices are summed */
+        for (k = 0; k < nnz; k++)
+        {
+            rows[k] = n_randint(state, r);
+            cols[k] = n_randint(state, c);
+            vals[k] = n_randtest(state);
+
+            nmod_mat_entry(C, rows[k], cols[k]) = nmod_add(
+                nmod_mat_entry(C, rows[k], cols[k]), n_mod2_preinv(vals[k],
+                                           C->mod.n, C->mod.ninv), C->mod);
+        }
+
+        nmod_sparse_mat_set_entries(A, rows, cols, vals, nnz);
+        nmod_sparse_mat_get_nmod_mat(D, A);
+
+        if (!nmod_mat_equal(C, D))
+        {
+            flint_printf("FAIL: set_entries\n");
+            nmod_mat_print_pretty(C);
+            nmod_sparse_mat_print_pretty(A);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* columns strictly increasing, no stored zeros */
+        for (i = 0; i < r; i++)
+        {
+            for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+            {
+                if (A->entries[k] == 0 || A->entries[k] >= n ||
+                    (k > A->offsets[i] && A->cols[k] <= A->cols[k - 1]))
+                {
+                    flint_printf("FAIL: format\n");
+                    nmod_sparse_mat_print_pretty(A);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        for (i = 0; i < r; i++)
+        {
+            for (j = 0; j < c; j++)
+            {
+                if (nmod_sparse_mat_get_entry(A, i, j) != nmod_mat_entry(C, i, j))
+                {
+                    flint_printf("FAIL: get_entry\n");
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        nmod_sparse_mat_set_nmod_mat(B, C);
+
+        if (!nmod_sparse_mat_equal(A, B))
+        {
+            flint_printf("FAIL: set_nmod_mat\n");
+            nmod_sparse_mat_print_pretty(A);
+            nmod_sparse_mat_print_pretty(B);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        flint_free(rows);
+        flint_free(cols);
+        _nmod_vec_clear(vals);
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("solve....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A;
+        nmod_mat_t B, bd, xd;
+        mp_ptr x, b, y;
+        slong i, r, c;
+        int res1, res2;
+        mp_limb_t n;
+
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+        n = n_randtest_prime(state, 0);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_mat_init(B, r, c, n);
+        nmod_mat_init(bd, r, 1, n);
+        nmod_mat_init(xd, c, 1, n);
+        x = _nmod_vec_init(c);
+        y = _nmod_vec_init(r);
+        b = _nmod_vec_init(r);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 6));
+
+        /* consistent right hand side half of the time */
+        if (n_randint(state, 2))
+        {
+            _nmod_vec_randtest(x, state, c, A->mod);
+            nmod_sparse_mat_mul_vec(b, A, x);
+        }
+        else
+        {
+            _nmod_vec_randtest(b, state, r, A->mod);
+        }
+
+        res1 = nmod_sparse_mat_solve(x, A, b);
+
+        nmod_sparse_mat_get_nmod_mat(B, A);
+        for (i = 0; i < r; i++)
+            nmod_mat_entry(bd, i, 0) = b[i];
+        res2 = nmod_mat_can_solve(xd, B, bd);
+
+        if (res1 != res2)
+        {
+            flint_printf("FAIL: consistency\n");
+            flint_printf("res1 = %d, res2 = %d\n", res1, res2);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        if (res1)
+        {
+            nmod_sparse_mat_mul_vec(y, A, x);
+
+            if (!_nmod_vec_equal(y, b, r))
+            {
+                flint_printf("FAIL: solution\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_mat_clear(B);
+        nmod_mat_clear(bd);
+        nmod_mat_clear(xd);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(b);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_vec.h"
+#include "nmod_sparse_mat.h"
+
+/* sparse matrix with random nonzero diagonal, usually nonsingular */
+static void
+_randtest_diag(nmod_sparse_mat_t A, flint_rand_t state, slong row_nnz)
+{
+    slong i, k, N = A->r, nnz = 0;
+    slong * rows, * cols;
+    mp_ptr vals;
+
+    nmod_sparse_mat_randtest(A, state, row_nnz);
+
+    rows = flint_malloc((A->nnz + N) * sizeof(slong));
+    cols = flint_malloc((A->nnz + N) * sizeof(slong));
+    vals = _nmod_vec_init(A->nnz + N);
+
+    for (i = 0; i < N; i++)
+    {
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++, nnz++)
+        {
+            rows[nnz] = i;
+            cols[nnz] = A->cols[k];
+            vals[nnz] = A->entries[k];
+        }
+
+        rows[nnz] = i;
+        cols[nnz] = i;
+        vals[nnz] = n_randint(state, A->mod.n - 1) + 1;
+        nnz++;
+    }
+
+    nmod_sparse_mat_set_entries(A, rows, cols, vals, nnz);
+
+    flint_free(rows);
+    flint_free(cols);
+    _nmod_vec_clear(vals);
+}
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("solve_block_wiedemann....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 200 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A;
+        mp_ptr x, b, y;
+        slong N, tries, block_size;
+        int result;
+        mp_limb_t n;
+
+        N = n_randint(state, 100);
+        n = n_randprime(state, 2 + n_randint(state, FLINT_BITS - 1), 0);
+        block_size = 1 + n_randint(state, 8);
+
+        nmod_sparse_mat_init(A, N, N, n);
+        x = _nmod_vec_init(N);
+        y = _nmod_vec_init(N);
+        b = _nmod_vec_init(N);
+
+        _randtest_diag(A, state, n_randint(state, 5));
+        _nmod_vec_randtest(b, state, N, A->mod);
+
+        for (tries = 0; tries < 3; tries++)
+        {
+            result = nmod_sparse_mat_solve_block_wiedemann(x, A, b, block_size, state);
+
+            if (result)
+            {
+                nmod_sparse_mat_mul_vec(y, A, x);
+
+                if (!_nmod_vec_equal(y, b, N))
+                {
+                    flint_printf("FAIL: wrong solution\n");
+                    fflush(stdout);
+                    flint_abort();
+                }
+
+                break;
+            }
+        }
+
+        if (!result && n > 1000 && nmod_sparse_mat_rank(A) == N)
+        {
+            flint_printf("FAIL: no solution found\n");
+            flint_printf("N = %wd, n = %wu, block_size = %wd\n", N, n, block_size);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        _nmod_vec_clear(x);
+        _nmod_vec_clear(y);
+        _nmod_vec_clear(b);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ulong_extras.h"
+#include "nmod_mat.h"
+#include "nmod_sparse_mat.h"
+
+int
+main(void)
+{
+    slong iter;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("transpose....");
+    fflush(stdout);
+
+    for (iter = 0; iter < 1000 * flint_test_multiplier(); iter++)
+    {
+        nmod_sparse_mat_t A, B;
+        nmod_mat_t C, D, E;
+        slong r, c;
+        mp_limb_t n;
+
+        r = n_randint(state, 30);
+        c = n_randint(state, 30);
+        n = n_randtest_not_zero(state);
+
+        nmod_sparse_mat_init(A, r, c, n);
+        nmod_sparse_mat_init(B, 0, 0, n);
+        nmod_mat_init(C, r, c, n);
+        nmod_mat_init(D, c, r, n);
+        nmod_mat_init(E, c, r, n);
+
+        nmod_sparse_mat_randtest(A, state, n_randint(state, 10));
+        nmod_sparse_mat_transpose(B, A);
+
+        nmod_sparse_mat_get_nmod_mat(C, A);
+        nmod_mat_transpose(D, C);
+        nmod_sparse_mat_get_nmod_mat(E, B);
+
+        if (!nmod_mat_equal(D, E))
+        {
+            flint_printf("FAIL: transpose\n");
+            nmod_sparse_mat_print_pretty(A);
+            nmod_sparse_mat_print_pretty(B);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        /* aliasing */
+        nmod_sparse_mat_transpose(B, B);
+
+        if (!nmod_sparse_mat_equal(A, B))
+        {
+            flint_printf("FAIL: aliasing\n");
+            nmod_sparse_mat_print_pretty(A);
+            nmod_sparse_mat_print_pretty(B);
+            fflush(stdout);
+            flint_abort();
+        }
+
+        nmod_sparse_mat_clear(A);
+        nmod_sparse_mat_clear(B);
+        nmod_mat_clear(C);
+        nmod_mat_clear(D);
+        nmod_mat_clear(E);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
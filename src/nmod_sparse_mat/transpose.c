@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "nmod_sparse_mat.h"
+
+void
+nmod_sparse_mat_transpose(nmod_sparse_mat_t B, const nmod_sparse_mat_t A)
+{
+    slong i, j, k;
+    slong * pos;
+    nmod_sparse_mat_t T;
+
+    if (B == A)
+    {
+        nmod_sparse_mat_init(T, A->c, A->r, A->mod.n);
+        nmod_sparse_mat_transpose(T, A);
+        nmod_sparse_mat_swap(B, T);
+        nmod_sparse_mat_clear(T);
+        return;
+    }
+
+    _nmod_sparse_mat_set_shape(B, A->c, A->r);
+    B->mod = A->mod;
+    nmod_sparse_mat_fit_nnz(B, A->nnz);
+
+    /* count entries per column, then scatter row by row so that
+       the columns of B come out sorted */
+    for (k = 0; k < A->nnz; k++)
+        B->offsets[A->cols[k] + 1]++;
+
+    for (j = 0; j < A->c; j++)
+        B->offsets[j + 1] += B->offsets[j];
+
+    pos = (slong *) flint_malloc((A->c + 1) * sizeof(slong));
+
+    for (j = 0; j <= A->c; j++)
+        pos[j] = B->offsets[j];
+
+    for (i = 0; i < A->r; i++)
+    {
+        for (k = A->offsets[i]; k < A->offsets[i + 1]; k++)
+        {
+            slong t = pos[A->cols[k]]++;
+            B->entries[t] = A->entries[k];
+            B->cols[t] = i;
+        }
+    }
+
+    B->nnz = A->nnz;
+
+    flint_free(pos);
+}
@@ -30,6 +30,21 @@ nmod_mat_struct;
 
 typedef nmod_mat_struct nmod_mat_t[1];
 
+typedef struct
+{
+    mp_limb_t * entries;
+    slong * cols;
+    slong * offsets;
+    slong r;
+    slong c;
+    slong nnz;
+    slong alloc;
+    nmod_t mod;
+}
+nmod_sparse_mat_struct;
+
+typedef nmod_sparse_mat_struct nmod_sparse_mat_t[1];
+
 typedef struct
 {
     mp_ptr coeffs;
@@ -12,11 +12,59 @@
 #include "nmod.h"
 #include "nmod_vec.h"
 
+#if FLINT_X86_DISPATCH
+
+#include <immintrin.h>
+
+/*
+    The single limb case: all entries are < 2^32 and the sum fits in a limb,
+    so that the products can be formed by vpmuludq and summed lanewise.
+*/
+__attribute__((target("avx2")))
+static mp_limb_t
+_nmod_vec_dot1_avx2(mp_srcptr vec1, mp_srcptr vec2, slong len)
+{
+    __m256i s0 = _mm256_setzero_si256();
+    __m256i s1 = _mm256_setzero_si256();
+    mp_limb_t t[4], res;
+    slong i;
+
+    for (i = 0; i + 8 <= len; i += 8)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i *) (vec1 + i));
+        __m256i b0 = _mm256_loadu_si256((const __m256i *) (vec2 + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i *) (vec1 + i + 4));
+        __m256i b1 = _mm256_loadu_si256((const __m256i *) (vec2 + i + 4));
+        s0 = _mm256_add_epi64(s0, _mm256_mul_epu32(a0, b0));
+        s1 = _mm256_add_epi64(s1, _mm256_mul_epu32(a1, b1));
+    }
+
+    _mm256_storeu_si256((__m256i *) t, _mm256_add_epi64(s0, s1));
+    res = t[0] + t[1] + t[2] + t[3];
+
+    for ( ; i < len; i++)
+        res += vec1[i] * vec2[i];
+
+    return res;
+}
+
+#endif
+
 mp_limb_t
 _nmod_vec_dot(mp_srcptr vec1, mp_srcptr vec2, slong len, nmod_t mod, int nlimbs)
 {
     mp_limb_t res;
     slong i;
+
+#if FLINT_X86_DISPATCH
+    if (nlimbs == 1 && len >= 16 && FLINT_CPU_HAVE(FLINT_CPU_X86_AVX2))
+    {
+        res = _nmod_vec_dot1_avx2(vec1, vec2, len);
+        NMOD_RED(res, res, mod);
+        return res;
+    }
+#endif
+
     NMOD_VEC_DOT(res, i, len, vec1[i], vec2[i], mod, nlimbs);
     return res;
 }
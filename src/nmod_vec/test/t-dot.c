@@ -17,12 +17,15 @@ int
 main(void)
 {
     int i;
+    ulong features;
     FLINT_TEST_INIT(state);
 
 
     flint_printf("dot....");
     fflush(stdout);
 
+    features = flint_get_cpu_features();
+
     for (i = 0; i < 1000 * flint_test_multiplier(); i++)
     {
         slong len;
@@ -46,6 +49,9 @@ main(void)
 
         limbs1 = _nmod_vec_dot_bound_limbs(len, mod);
 
+        /* check both the generic code and the dispatched kernels */
+        flint_set_cpu_features(n_randint(state, 2) ? features : 0);
+
         res = _nmod_vec_dot(x, y, len, mod, limbs1);
 
         mpz_init(s);
@@ -76,6 +82,8 @@ main(void)
         _nmod_vec_clear(y);
     }
 
+    flint_set_cpu_features(features);
+
     FLINT_TEST_CLEANUP(state);
 
     flint_printf("PASS\n");
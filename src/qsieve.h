@@ -415,7 +415,8 @@ uint64_t get_null_entry(uint64_t * nullrows, slong i, slong l);
 void reduce_matrix(qs_t qs_inf, slong *nrows, slong *ncols, la_col_t *cols);
 
 uint64_t * block_lanczos(flint_rand_t state, slong nrows,
-			slong dense_rows, slong ncols, la_col_t *B);
+			slong dense_rows, slong ncols, la_col_t *B,
+			const thread_pool_handle *handles, slong num_handles);
 
 void qsieve_square_root(fmpz_t X, fmpz_t Y, qs_t qs_inf,
    uint64_t * nullrows, slong ncols, slong l, fmpz_t N);
@@ -256,20 +256,16 @@ static void precompute_Nx64_64x64(uint64_t *x, uint64_t *c) {
 }
 
 /*-------------------------------------------------------------------*/
-static void mul_Nx64_64x64_acc(uint64_t *v, uint64_t *x, uint64_t *c,
+static void mul_Nx64_precomp_acc(uint64_t *v, uint64_t *c,
 				uint64_t *y, slong n) {
 
-	/* let v[][] be a n x 64 matrix with elements in GF(2),
-	   represented as an array of n 64-bit words. Let c[][]
-	   be an 8 x 256 scratch matrix of 64-bit words.
-	   This code multiplies v[][] by the 64x64 matrix
-	   x[][], then XORs the n x 64 result into y[][] */
+	/* XOR v[][] times the 64x64 matrix whose table of
+	   partial products is c[][] (see precompute_Nx64_64x64)
+	   into y[][] */
 
-    slong i;
+	slong i;
 	uint64_t word;
 
-	precompute_Nx64_64x64(x, c);
-
 	for (i = 0; i < n; i++) {
 		word = v[i];
 		y[i] ^=  c[ 0*256 + ((word>> 0) & 0xff) ]
@@ -562,6 +558,358 @@ void mul_trans_MxN_Nx64(slong dense_rows, slong ncols,
 	}
 }
 
+/*-------------------------------------------------------------------*/
+
+/* The matrix products in the block Lanczos iteration are
+   split across the threads which qsieve_factor holds for
+   sieving. For the product by B, a row-major copy of B is
+   made, cut into vertical strips of LA_STRIP_COLS columns
+   so that the part of x[] which a strip reads stays in
+   cache while the rows of the strip are processed. The
+   product by the transpose of B reads the columns of B
+   directly. */
+
+#define LA_STRIP_COLS 32768	/* 256KB worth of x[] per strip */
+#define LA_THREAD_CUTOFF 10000	/* smaller matrices use one thread */
+
+#define LA_MUL 0
+#define LA_MUL_TRANS 1
+#define LA_MUL_64xN 2
+#define LA_MUL_Nx64_ACC 3
+
+struct la_mat_struct;
+
+typedef struct {
+	struct la_mat_struct *M;
+	slong thread;
+	int op;
+	uint64_t *x;
+	uint64_t *y;
+	uint64_t *c;		/* 8 x 256 table, shared or per thread */
+	slong n;
+	uint64_t xy[64];	/* per thread part of a 64 x 64 product */
+} la_worker_arg_struct;
+
+typedef struct la_mat_struct {
+	slong nrows;		/* 1 + largest row index occurring in B */
+	slong ncols;
+	slong dense_rows;
+	la_col_t *cols;
+	slong nstrips;
+	slong *row_start;	/* row i of strip s occupies entries
+				   row_start[s*(nrows+1) + i] up to
+				   row_start[s*(nrows+1) + i + 1] of idx[] */
+	uint32_t *idx;		/* column indices, strip by strip and
+				   row by row */
+	slong nthreads;
+	slong *row_split;	/* thread t does rows row_split[t] up to
+				   row_split[t+1] of the product by B */
+	slong *col_split;	/* ditto for the columns of the product
+				   by the transpose of B */
+	const thread_pool_handle *handles;
+	la_worker_arg_struct *args;
+	uint64_t *scratch;	/* an 8 x 256 table per thread */
+} la_mat_struct;
+
+/*-------------------------------------------------------------------*/
+static void la_split(slong *split, slong *weight, slong n,
+			slong nthreads) {
+
+	/* split [0, n) into nthreads ranges of roughly equal
+	   total weight */
+
+	slong i, t, total, acc;
+
+	total = 0;
+	for (i = 0; i < n; i++)
+		total += weight[i];
+
+	split[0] = 0;
+	acc = 0;
+	for (i = 0, t = 1; i < n && t < nthreads; i++) {
+		acc += weight[i];
+		while (t < nthreads && acc * nthreads >= total * t)
+			split[t++] = i + 1;
+	}
+	while (t <= nthreads)
+		split[t++] = n;
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mat_init(la_mat_struct *M, slong dense_rows,
+		slong ncols, la_col_t *A,
+		const thread_pool_handle *handles, slong num_handles) {
+
+	slong i, j, s, r, nr, total;
+	slong *pos, *weight;
+
+	/* find the rows which actually occur in A */
+
+	nr = dense_rows;
+	for (i = 0; i < ncols; i++) {
+		for (j = 0; j < A[i].weight; j++)
+			nr = FLINT_MAX(nr, A[i].data[j] + 1);
+	}
+
+	M->nrows = nr;
+	M->ncols = ncols;
+	M->dense_rows = dense_rows;
+	M->cols = A;
+	M->nstrips = FLINT_MAX(1, (ncols + LA_STRIP_COLS - 1) / LA_STRIP_COLS);
+	M->nthreads = (ncols < LA_THREAD_CUTOFF) ? 1 : num_handles + 1;
+	M->handles = handles;
+
+	/* count the entries of each row of each strip */
+
+	M->row_start = (slong *)flint_calloc(M->nstrips * (nr + 1),
+						sizeof(slong));
+	weight = (slong *)flint_calloc(FLINT_MAX(nr, ncols) + 1,
+						sizeof(slong));
+
+	for (i = 0; i < ncols; i++) {
+		slong *row_start = M->row_start + (i / LA_STRIP_COLS) * (nr + 1);
+		slong *dense_entries = A[i].data + A[i].weight;
+
+		for (j = 0; j < A[i].weight; j++)
+			row_start[A[i].data[j] + 1]++;
+
+		for (j = 0; j < dense_rows; j++) {
+			if (dense_entries[j / 32] & ((slong)1 << (j % 32)))
+				row_start[j + 1]++;
+		}
+	}
+
+	/* turn the counts into offsets */
+
+	total = 0;
+	for (s = 0; s < M->nstrips; s++) {
+		slong *row_start = M->row_start + s * (nr + 1);
+
+		for (r = 0; r < nr; r++) {
+			weight[r] += row_start[r + 1];
+			row_start[r] = total;
+			total += row_start[r + 1];
+		}
+		row_start[nr] = total;
+	}
+
+	/* fill in the column indices, which come out sorted */
+
+	M->idx = (uint32_t *)flint_malloc(FLINT_MAX(total, 1) * sizeof(uint32_t));
+	pos = (slong *)flint_malloc(M->nstrips * (nr + 1) * sizeof(slong));
+	memcpy(pos, M->row_start, M->nstrips * (nr + 1) * sizeof(slong));
+
+	for (i = 0; i < ncols; i++) {
+		slong *row_pos = pos + (i / LA_STRIP_COLS) * (nr + 1);
+		slong *dense_entries = A[i].data + A[i].weight;
+
+		for (j = 0; j < A[i].weight; j++)
+			M->idx[row_pos[A[i].data[j]]++] = (uint32_t) i;
+
+		for (j = 0; j < dense_rows; j++) {
+			if (dense_entries[j / 32] & ((slong)1 << (j % 32)))
+				M->idx[row_pos[j]++] = (uint32_t) i;
+		}
+	}
+
+	flint_free(pos);
+
+	/* balance the work of the threads */
+
+	M->row_split = (slong *)flint_malloc((M->nthreads + 1) * sizeof(slong));
+	M->col_split = (slong *)flint_malloc((M->nthreads + 1) * sizeof(slong));
+
+	la_split(M->row_split, weight, nr, M->nthreads);
+
+	for (i = 0; i < ncols; i++)
+		weight[i] = A[i].weight + dense_rows + 1;
+
+	la_split(M->col_split, weight, ncols, M->nthreads);
+
+	flint_free(weight);
+
+	M->args = (la_worker_arg_struct *)flint_malloc(M->nthreads
+					* sizeof(la_worker_arg_struct));
+	M->scratch = (uint64_t *)flint_malloc(M->nthreads * 256 * 8
+					* sizeof(uint64_t));
+
+	for (i = 0; i < M->nthreads; i++) {
+		M->args[i].M = M;
+		M->args[i].thread = i;
+	}
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mat_clear(la_mat_struct *M) {
+
+	flint_free(M->row_start);
+	flint_free(M->idx);
+	flint_free(M->row_split);
+	flint_free(M->col_split);
+	flint_free(M->args);
+	flint_free(M->scratch);
+}
+
+/*-------------------------------------------------------------------*/
+static void la_worker(void *varg) {
+
+	la_worker_arg_struct *arg = (la_worker_arg_struct *) varg;
+	la_mat_struct *M = arg->M;
+	slong t = arg->thread;
+	slong i, j, s, start, stop;
+
+	switch (arg->op) {
+
+	case LA_MUL:
+
+		/* rows [start, stop) of y = B * x */
+
+		start = M->row_split[t];
+		stop = M->row_split[t + 1];
+
+		memset(arg->y + start, 0, (stop - start) * sizeof(uint64_t));
+
+		for (s = 0; s < M->nstrips; s++) {
+			slong *row_start = M->row_start + s * (M->nrows + 1);
+
+			for (i = start; i < stop; i++) {
+				uint64_t accum = arg->y[i];
+
+				for (j = row_start[i]; j < row_start[i + 1]; j++)
+					accum ^= arg->x[M->idx[j]];
+
+				arg->y[i] = accum;
+			}
+		}
+		break;
+
+	case LA_MUL_TRANS:
+
+		/* entries [start, stop) of y = transpose(B) * x */
+
+		start = M->col_split[t];
+		stop = M->col_split[t + 1];
+
+		for (i = start; i < stop; i++) {
+			la_col_t *col = M->cols + i;
+			slong *row_entries = col->data;
+			uint64_t accum = 0;
+
+			for (j = 0; j < col->weight; j++)
+				accum ^= arg->x[row_entries[j]];
+
+			row_entries += col->weight;
+			for (j = 0; j < M->dense_rows; j++) {
+				if (row_entries[j / 32] & ((slong)1 << (j % 32)))
+					accum ^= arg->x[j];
+			}
+
+			arg->y[i] = accum;
+		}
+		break;
+
+	case LA_MUL_64xN:
+
+		start = (arg->n * t) / M->nthreads;
+		stop = (arg->n * (t + 1)) / M->nthreads;
+
+		mul_64xN_Nx64(arg->x + start, arg->y + start,
+			M->scratch + 256 * 8 * t, arg->xy, stop - start);
+		break;
+
+	case LA_MUL_Nx64_ACC:
+
+		start = (arg->n * t) / M->nthreads;
+		stop = (arg->n * (t + 1)) / M->nthreads;
+
+		mul_Nx64_precomp_acc(arg->x + start, arg->c,
+					arg->y + start, stop - start);
+		break;
+	}
+}
+
+/*-------------------------------------------------------------------*/
+static void la_run(la_mat_struct *M, int op, uint64_t *x,
+		uint64_t *y, uint64_t *c, slong n) {
+
+	/* perform the given operation with all threads, the
+	   calling thread doing the last share */
+
+	slong i, nt = M->nthreads;
+
+	for (i = 0; i < nt; i++) {
+		M->args[i].op = op;
+		M->args[i].x = x;
+		M->args[i].y = y;
+		M->args[i].c = c;
+		M->args[i].n = n;
+	}
+
+	for (i = 0; i < nt - 1; i++)
+		thread_pool_wake(global_thread_pool, M->handles[i], 0,
+					la_worker, &M->args[i]);
+
+	la_worker(&M->args[nt - 1]);
+
+	for (i = 0; i < nt - 1; i++)
+		thread_pool_wait(global_thread_pool, M->handles[i]);
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mul_MxN_Nx64(la_mat_struct *M, slong vsize,
+				uint64_t *x, uint64_t *b) {
+
+	/* threaded version of mul_MxN_Nx64 */
+
+	la_run(M, LA_MUL, x, b, NULL, 0);
+
+	if (vsize > M->nrows)
+		memset(b + M->nrows, 0, (vsize - M->nrows) * sizeof(uint64_t));
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mul_trans_MxN_Nx64(la_mat_struct *M,
+				uint64_t *x, uint64_t *b) {
+
+	/* threaded version of mul_trans_MxN_Nx64 */
+
+	la_run(M, LA_MUL_TRANS, x, b, NULL, 0);
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mul_64xN_Nx64(la_mat_struct *M, uint64_t *x,
+				uint64_t *y, uint64_t *xy, slong n) {
+
+	/* threaded version of mul_64xN_Nx64; the threads
+	   compute the product over disjoint ranges of rows
+	   and the partial results are added up */
+
+	slong i, t;
+
+	la_run(M, LA_MUL_64xN, x, y, NULL, n);
+
+	memcpy(xy, M->args[0].xy, 64 * sizeof(uint64_t));
+	for (t = 1; t < M->nthreads; t++) {
+		for (i = 0; i < 64; i++)
+			xy[i] ^= M->args[t].xy[i];
+	}
+}
+
+/*-------------------------------------------------------------------*/
+static void la_mul_Nx64_64x64_acc(la_mat_struct *M, uint64_t *v,
+		uint64_t *x, uint64_t *c, uint64_t *y, slong n) {
+
+	/* let v[][] be a n x 64 matrix with elements in GF(2),
+	   represented as an array of n 64-bit words. Let c[][]
+	   be an 8 x 256 scratch matrix of 64-bit words.
+	   This code multiplies v[][] by the 64x64 matrix
+	   x[][], then XORs the n x 64 result into y[][],
+	   splitting the rows over the threads of M */
+
+	precompute_Nx64_64x64(x, c);
+	la_run(M, LA_MUL_Nx64_ACC, v, y, c, n);
+}
+
 /*-----------------------------------------------------------------------*/
 static void transpose_vector(slong ncols, uint64_t *v, uint64_t **trans) {
 
@@ -706,11 +1054,13 @@ void combine_cols(slong ncols,
 
 /*-----------------------------------------------------------------------*/
 uint64_t * block_lanczos(flint_rand_t state, slong nrows,
-			slong dense_rows, slong ncols, la_col_t *B) {
+			slong dense_rows, slong ncols, la_col_t *B,
+			const thread_pool_handle *handles, slong num_handles) {
 
 	/* Solve Bx = 0 for some nonzero x; the computed
 	   solution, containing up to 64 of these nullspace
-	   vectors, is returned */
+	   vectors, is returned. The matrix products are
+	   split across the given threads */
 
 	uint64_t *vnext, *v[3], *x, *v0;
 	uint64_t *winv[3];
@@ -724,6 +1074,7 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	slong dim0, dim1;
 	uint64_t mask0, mask1;
 	slong vsize;
+	la_mat_struct M[1];
 
 	/* allocate all of the size-n variables. Note that because
 	   B has been preprocessed to ignore singleton rows, the
@@ -754,6 +1105,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	f = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
 	f2 = (uint64_t *)flint_malloc(64 * sizeof(uint64_t));
 
+	la_mat_init(M, dense_rows, ncols, B, handles, num_handles);
+
 	/* The iterations computes v[0], vt_a_v[0],
 	   vt_a2_v[0], s[0] and winv[0]. Subscripts larger
 	   than zero represent past versions of these
@@ -790,8 +1143,8 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 #endif
 
 	memcpy(x, v[0], vsize * sizeof(uint64_t));
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-	mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, v[0]);
+	la_mul_MxN_Nx64(M, vsize, v[0], scratch);
+	la_mul_trans_MxN_Nx64(M, scratch, v[0]);
 	memcpy(v0, v[0], vsize * sizeof(uint64_t));
 
 	/* perform the iteration */
@@ -805,13 +1158,13 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		   version of B, or B'B (apostrophe means
 		   transpose). Use "A" to refer to B'B  */
 
-		mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], scratch);
-		mul_trans_MxN_Nx64(dense_rows, ncols, B, scratch, vnext);
+		la_mul_MxN_Nx64(M, vsize, v[0], scratch);
+		la_mul_trans_MxN_Nx64(M, scratch, vnext);
 
 		/* compute v0'*A*v0 and (A*v0)'(A*v0) */
 
-		mul_64xN_Nx64(v[0], vnext, scratch, vt_a_v[0], n);
-		mul_64xN_Nx64(vnext, vnext, scratch, vt_a2_v[0], n);
+		la_mul_64xN_Nx64(M, v[0], vnext, vt_a_v[0], n);
+		la_mul_64xN_Nx64(M, vnext, vnext, vt_a2_v[0], n);
 
 		/* if the former is orthogonal to itself, then
 		   the iteration has finished */
@@ -878,15 +1231,15 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		for (i = 0; i < n; i++)
 			vnext[i] = vnext[i] & mask0;
 
-		mul_Nx64_64x64_acc(v[0], d, scratch, vnext, n);
-		mul_Nx64_64x64_acc(v[1], e, scratch, vnext, n);
-		mul_Nx64_64x64_acc(v[2], f, scratch, vnext, n);
+		la_mul_Nx64_64x64_acc(M, v[0], d, scratch, vnext, n);
+		la_mul_Nx64_64x64_acc(M, v[1], e, scratch, vnext, n);
+		la_mul_Nx64_64x64_acc(M, v[2], f, scratch, vnext, n);
 
 		/* update the computed solution 'x' */
 
-		mul_64xN_Nx64(v[0], v0, scratch, d, n);
+		la_mul_64xN_Nx64(M, v[0], v0, d, n);
 		mul_64x64_64x64(winv[0], d, d);
-		mul_Nx64_64x64_acc(v[0], d, scratch, x, n);
+		la_mul_Nx64_64x64_acc(M, v[0], d, scratch, x, n);
 
 		/* rotate all the variables */
 
@@ -942,20 +1295,21 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 		flint_free(v[0]);
 		flint_free(v[1]);
 		flint_free(v[2]);
+		la_mat_clear(M);
 		return NULL;
 	}
 
 	/* convert the output of the iteration to an actual
 	   collection of nullspace vectors */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[1]);
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, v[0], v[2]);
+	la_mul_MxN_Nx64(M, vsize, x, v[1]);
+	la_mul_MxN_Nx64(M, vsize, v[0], v[2]);
 
 	combine_cols(ncols, x, v[0], v[1], v[2]);
 
 	/* verify that these really are linear dependencies of B */
 
-	mul_MxN_Nx64(vsize, dense_rows, ncols, B, x, v[0]);
+	la_mul_MxN_Nx64(M, vsize, x, v[0]);
 
 	for (i = 0; i < ncols; i++) {
 		if (v[0][i] != 0)
@@ -969,5 +1323,6 @@ uint64_t * block_lanczos(flint_rand_t state, slong nrows,
 	flint_free(v[0]);
 	flint_free(v[1]);
 	flint_free(v[2]);
+	la_mat_clear(M);
 	return x;
 }
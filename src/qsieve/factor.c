@@ -335,7 +335,8 @@ void qsieve_factor(fmpz_factor_t factors, const fmpz_t n)
 
                     do /* repeat block lanczos until it succeeds */
                     {
-                        nullrows = block_lanczos(state, nrows, 0, ncols, qs_inf->matrix);
+                        nullrows = block_lanczos(state, nrows, 0, ncols, qs_inf->matrix,
+                                           qs_inf->handles, qs_inf->num_handles);
                     } while (nullrows == NULL);
 
                     for (i = 0, mask = 0; i < ncols; i++) /* create mask of nullspace vectors */
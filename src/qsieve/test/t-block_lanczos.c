@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "ulong_extras.h"
+#include "thread_support.h"
+#include "qsieve.h"
+
+int main(void)
+{
+   slong i, iter;
+   FLINT_TEST_INIT(state);
+
+   flint_printf("block_lanczos....");
+   fflush(stdout);
+
+   /* the larger matrices are split across threads */
+   for (iter = 0; iter < 4 * flint_test_multiplier(); iter++)
+   {
+      slong ncols, nrows, weight, num_handles;
+      la_col_t * B;
+      uint64_t * x, * y;
+      thread_pool_handle * handles;
+      flint_rand_t state2;
+
+      ncols = (iter % 2 == 0) ? 100 + n_randint(state, 1000)
+                              : 10000 + n_randint(state, 3000);
+      nrows = ncols - 64 - n_randint(state, 64);
+      weight = 3 + n_randint(state, 10);
+
+      flint_set_num_threads(n_randint(state, 5) + 1);
+      num_handles = flint_request_threads(&handles, flint_get_num_threads());
+
+      B = (la_col_t *) flint_calloc(ncols, sizeof(la_col_t));
+
+      for (i = 0; i < ncols; i++)
+      {
+         slong j, k, r;
+
+         B[i].orig = i;
+
+         for (j = 0; j < weight; j++)
+         {
+            r = n_randint(state, nrows);
+
+            for (k = 0; k < B[i].weight; k++)
+               if (B[i].data[k] == r)
+                  break;
+
+            if (k == B[i].weight)
+               insert_col_entry(B + i, r);
+         }
+      }
+
+      flint_randinit(state2);
+
+      do {
+         x = block_lanczos(state2, nrows, 0, ncols, B, handles, num_handles);
+      } while (x == NULL);
+
+      flint_randclear(state2);
+
+      /* check that x is a nonzero block of nullspace vectors */
+      y = (uint64_t *) flint_calloc(nrows, sizeof(uint64_t));
+
+      for (i = 0; i < ncols; i++)
+      {
+         slong k;
+
+         for (k = 0; k < B[i].weight; k++)
+            y[B[i].data[k]] ^= x[i];
+      }
+
+      for (i = 0; i < nrows; i++)
+      {
+         if (y[i] != 0)
+         {
+            flint_printf("FAIL:\n");
+            flint_printf("ncols = %wd, nrows = %wd, row %wd not zero\n", ncols, nrows, i);
+            fflush(stdout);
+            flint_abort();
+         }
+      }
+
+      for (i = 0; i < ncols; i++)
+         if (x[i] != 0)
+            break;
+
+      if (i == ncols)
+      {
+         flint_printf("FAIL:\n");
+         flint_printf("ncols = %wd, nrows = %wd, no nullspace vector found\n", ncols, nrows);
+         fflush(stdout);
+         flint_abort();
+      }
+
+      flint_give_back_threads(handles, num_handles);
+
+      for (i = 0; i < ncols; i++)
+         free_col(B + i);
+      flint_free(B);
+      flint_free(x);
+      flint_free(y);
+   }
+
+   FLINT_TEST_CLEANUP(state);
+
+   flint_printf("PASS\n");
+   return 0;
+}
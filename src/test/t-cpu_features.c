@@ -0,0 +1,66 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "flint.h"
+#include "ulong_extras.h"
+
+int main(void)
+{
+    int i;
+    ulong all, f;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("cpu_features....");
+    fflush(stdout);
+
+    all = flint_get_cpu_features();
+
+    if (all != _flint_cpu_features)
+    {
+        flint_printf("FAIL: features not initialised\n");
+        fflush(stdout);
+        flint_abort();
+    }
+
+    for (i = 0; i < 1000; i++)
+    {
+        f = n_randtest(state);
+
+        flint_set_cpu_features(f);
+
+        /* only detected features can be enabled */
+        if (flint_get_cpu_features() != (f & all) ||
+            FLINT_CPU_HAVE(f & all) == 0 ||
+            ((f & ~all) != 0 && FLINT_CPU_HAVE(f)))
+        {
+            flint_printf("FAIL:\n");
+            flint_printf("all = %wx, f = %wx, got %wx\n", all, f,
+                                                    flint_get_cpu_features());
+            fflush(stdout);
+            flint_abort();
+        }
+    }
+
+    flint_set_cpu_features(all);
+
+    if (flint_get_cpu_features() != all)
+    {
+        flint_printf("FAIL: features not restored\n");
+        fflush(stdout);
+        flint_abort();
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
@@ -22,6 +22,42 @@
  extern "C" {
 #endif
 
+/*
+    A task for the fork/join scheduler. The state moves from QUEUED to RUNNING
+    when some thread claims the task and from RUNNING to DONE once it returns.
+    The first transition happens under the mutex of the deque holding the
+    task, the second under task_mutex of the pool.
+*/
+#define THREAD_POOL_TASK_QUEUED 0
+#define THREAD_POOL_TASK_RUNNING 1
+#define THREAD_POOL_TASK_DONE 2
+
+typedef struct
+{
+    void (* fxn)(void *);
+    void * fxnarg;
+    int num_workers;
+    void * deque;
+    volatile int state;
+} thread_pool_task_struct;
+
+typedef thread_pool_task_struct thread_pool_task_t[1];
+
+/*
+    Each thread owns a deque of spawned tasks. The owner pushes and pops at
+    the end, thieves take the oldest task from the start.
+*/
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    thread_pool_task_struct ** tasks;
+    slong start;
+    slong end;
+    slong alloc;
+} thread_pool_deque_struct;
+
 typedef struct
 {
 #if FLINT_USES_PTHREAD
@@ -37,6 +73,8 @@ typedef struct
     void * fxnarg;
     volatile int working;
     volatile int exit;
+    volatile int stealing;
+    thread_pool_deque_struct deque;
 } thread_pool_entry_struct;
 
 typedef thread_pool_entry_struct thread_pool_entry_t[1];
@@ -48,9 +86,12 @@ typedef struct
 #endif
 #if FLINT_USES_PTHREAD
     pthread_mutex_t mutex;
+    pthread_mutex_t task_mutex;
+    pthread_cond_t task_done;
 #endif
     thread_pool_entry_struct * tdata;
     slong length;
+    thread_pool_deque_struct deque;     /* for threads outside the pool */
 } thread_pool_struct;
 
 typedef thread_pool_struct thread_pool_t[1];
@@ -60,6 +101,9 @@ typedef int thread_pool_handle;
 FLINT_DLL extern thread_pool_t global_thread_pool;
 FLINT_DLL extern int global_thread_pool_initialized;
 
+/* the pool entry of the calling thread, or NULL outside of any pool */
+extern FLINT_TLS_PREFIX thread_pool_entry_struct * _thread_pool_current_entry;
+
 void * thread_pool_idle_loop(void * varg);
 
 void thread_pool_init(thread_pool_t T, slong l);
@@ -85,6 +129,13 @@ void thread_pool_give_back(thread_pool_t T, thread_pool_handle i);
 
 void thread_pool_clear(thread_pool_t T);
 
+/* fork/join tasks ***********************************************************/
+
+void thread_pool_spawn(thread_pool_t T, thread_pool_task_t task,
+                                                   void (*f)(void*), void * a);
+
+void thread_pool_join(thread_pool_t T, thread_pool_task_t task);
+
 /* misc internal helpers *****************************************************/
 
 void _thread_pool_distribute_work_2(slong start, slong stop,
@@ -94,6 +145,29 @@ void _thread_pool_distribute_work_2(slong start, slong stop,
 ulong _thread_pool_find_work_2(ulong a, ulong alpha,
                                       ulong b, ulong beta, ulong yn, ulong yd);
 
+void _thread_pool_deque_init(thread_pool_deque_struct * Q);
+
+void _thread_pool_deque_clear(thread_pool_deque_struct * Q);
+
+void _thread_pool_deque_push(thread_pool_deque_struct * Q,
+                                               thread_pool_task_struct * task);
+
+int _thread_pool_deque_remove(thread_pool_deque_struct * Q,
+                                               thread_pool_task_struct * task);
+
+thread_pool_task_struct * _thread_pool_deque_pop(thread_pool_deque_struct * Q);
+
+thread_pool_task_struct * _thread_pool_deque_steal(
+                                                 thread_pool_deque_struct * Q);
+
+thread_pool_task_struct * _thread_pool_find_task(thread_pool_t T);
+
+void _thread_pool_run_task(thread_pool_t T, thread_pool_task_struct * task);
+
+void _thread_pool_steal_loop(void * varg);
+
+void _thread_pool_wait_stealers(thread_pool_t T);
+
 #ifdef __cplusplus
 }
 #endif
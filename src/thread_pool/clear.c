@@ -17,6 +17,8 @@ void thread_pool_clear(thread_pool_t T)
     slong i, size;
     thread_pool_entry_struct * D;
 
+    _thread_pool_wait_stealers(T);
+
 #if FLINT_USES_PTHREAD
     pthread_mutex_lock(&T->mutex);
 #endif
@@ -39,6 +41,7 @@ void thread_pool_clear(thread_pool_t T)
         pthread_cond_destroy(&D[i].sleep1);
         pthread_mutex_destroy(&D[i].mutex);
 #endif
+        _thread_pool_deque_clear(&D[i].deque);
     }
     if (D != NULL)
     {
@@ -50,9 +53,12 @@ void thread_pool_clear(thread_pool_t T)
         T->original_affinity = NULL;
     }
 #endif
+    _thread_pool_deque_clear(&T->deque);
 #if FLINT_USES_PTHREAD
     pthread_mutex_unlock(&T->mutex);
     pthread_mutex_destroy(&T->mutex);
+    pthread_cond_destroy(&T->task_done);
+    pthread_mutex_destroy(&T->task_mutex);
 #endif
     T->length = -1;
     T->tdata = NULL;
@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "thread_pool.h"
+
+void _thread_pool_deque_init(thread_pool_deque_struct * Q)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_init(&Q->mutex, NULL);
+#endif
+    Q->tasks = NULL;
+    Q->start = 0;
+    Q->end = 0;
+    Q->alloc = 0;
+}
+
+void _thread_pool_deque_clear(thread_pool_deque_struct * Q)
+{
+    /* all tasks should have been joined */
+    FLINT_ASSERT(Q->start == Q->end);
+
+    if (Q->tasks != NULL)
+        flint_free(Q->tasks);
+#if FLINT_USES_PTHREAD
+    pthread_mutex_destroy(&Q->mutex);
+#endif
+}
+
+/* the caller holds the lock */
+void _thread_pool_deque_push(thread_pool_deque_struct * Q,
+                                                thread_pool_task_struct * task)
+{
+    if (Q->end >= Q->alloc)
+    {
+        if (Q->start > 0)
+        {
+            memmove(Q->tasks, Q->tasks + Q->start,
+                              (Q->end - Q->start)*sizeof(thread_pool_task_struct *));
+            Q->end -= Q->start;
+            Q->start = 0;
+        }
+
+        if (Q->end >= Q->alloc)
+        {
+            Q->alloc = FLINT_MAX(8, 2*Q->alloc);
+            Q->tasks = (thread_pool_task_struct **) flint_realloc(Q->tasks,
+                                     Q->alloc*sizeof(thread_pool_task_struct *));
+        }
+    }
+
+    task->deque = Q;
+    Q->tasks[Q->end] = task;
+    Q->end++;
+}
+
+/*
+    If the task is still queued in Q, remove it, claim it and return 1.
+    Otherwise it has already been claimed by some thread; return 0.
+    Joins usually happen in the reverse order of spawns, so the task is
+    almost always the last one. The caller holds the lock.
+*/
+int _thread_pool_deque_remove(thread_pool_deque_struct * Q,
+                                                thread_pool_task_struct * task)
+{
+    slong i;
+
+    for (i = Q->end - 1; i >= Q->start; i--)
+    {
+        if (Q->tasks[i] == task)
+            break;
+    }
+
+    if (i < Q->start)
+        return 0;
+
+    memmove(Q->tasks + i, Q->tasks + i + 1,
+                              (Q->end - i - 1)*sizeof(thread_pool_task_struct *));
+    Q->end--;
+
+    if (Q->start == Q->end)
+        Q->start = Q->end = 0;
+
+    task->state = THREAD_POOL_TASK_RUNNING;
+    return 1;
+}
+
+/* claim the newest task; the caller holds the lock */
+thread_pool_task_struct * _thread_pool_deque_pop(thread_pool_deque_struct * Q)
+{
+    thread_pool_task_struct * task;
+
+    if (Q->start >= Q->end)
+        return NULL;
+
+    Q->end--;
+    task = Q->tasks[Q->end];
+
+    if (Q->start == Q->end)
+        Q->start = Q->end = 0;
+
+    FLINT_ASSERT(task->state == THREAD_POOL_TASK_QUEUED);
+    task->state = THREAD_POOL_TASK_RUNNING;
+    return task;
+}
+
+/* claim the oldest task; the caller holds the lock */
+thread_pool_task_struct * _thread_pool_deque_steal(thread_pool_deque_struct * Q)
+{
+    thread_pool_task_struct * task;
+
+    if (Q->start >= Q->end)
+        return NULL;
+
+    task = Q->tasks[Q->start];
+    Q->start++;
+
+    if (Q->start == Q->end)
+        Q->start = Q->end = 0;
+
+    FLINT_ASSERT(task->state == THREAD_POOL_TASK_QUEUED);
+    task->state = THREAD_POOL_TASK_RUNNING;
+    return task;
+}
@@ -17,10 +17,15 @@
 thread_pool_t global_thread_pool;
 int global_thread_pool_initialized = 0;
 
+FLINT_TLS_PREFIX thread_pool_entry_struct * _thread_pool_current_entry = NULL;
+
 
 void * thread_pool_idle_loop(void * varg)
 {
     thread_pool_entry_struct * arg = (thread_pool_entry_struct *) varg;
+    thread_pool_struct * T;
+
+    _thread_pool_current_entry = arg;
 
     goto thread_pool_Lock;
 
@@ -31,11 +36,30 @@ thread_pool_DoWork:
 
 thread_pool_Lock:
 
+    /*
+        A thread lent to the scheduler gives itself back. The flag stealing
+        is only set before the thread is woken up, and the pool is then
+        passed as the argument. As in thread_pool_give_back, available is
+        changed while holding the mutex of the pool.
+    */
+    T = (arg->stealing != 0) ? (thread_pool_struct *) arg->fxnarg : NULL;
+
 #if FLINT_USES_PTHREAD
+    if (T != NULL)
+        pthread_mutex_lock(&T->mutex);
     pthread_mutex_lock(&arg->mutex);
 #endif
     arg->working = 0;
 
+    if (T != NULL)
+    {
+        arg->stealing = 0;
+        arg->available = 1;
+#if FLINT_USES_PTHREAD
+        pthread_mutex_unlock(&T->mutex);
+#endif
+    }
+
 thread_pool_CheckExit:
 
     if (arg->exit != 0)
@@ -72,8 +96,11 @@ void thread_pool_init(thread_pool_t T, slong size)
 
 #if FLINT_USES_PTHREAD
     pthread_mutex_init(&T->mutex, NULL);
+    pthread_mutex_init(&T->task_mutex, NULL);
+    pthread_cond_init(&T->task_done, NULL);
 #endif
     T->length = size;
+    _thread_pool_deque_init(&T->deque);
 
 #if FLINT_USES_CPUSET && FLINT_USES_PTHREAD
     T->original_affinity = flint_malloc(sizeof(cpu_set_t));
@@ -108,6 +135,8 @@ void thread_pool_init(thread_pool_t T, slong size)
         D[i].working = -1;
 	D[i].max_workers = 0;
         D[i].exit = 0;
+        D[i].stealing = 0;
+        _thread_pool_deque_init(&D[i].deque);
 #if FLINT_USES_PTHREAD
         pthread_mutex_lock(&D[i].mutex);
         pthread_create(&D[i].pth, NULL, thread_pool_idle_loop, &D[i]);
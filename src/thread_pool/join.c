@@ -0,0 +1,69 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+/*
+    Wait for a task started with thread_pool_spawn. If nobody has claimed it
+    yet, it is run by the calling thread. Otherwise the calling thread keeps
+    running other queued tasks until the task is finished.
+*/
+void thread_pool_join(thread_pool_t T, thread_pool_task_t task)
+{
+#if FLINT_USES_PTHREAD
+    thread_pool_deque_struct * Q = (thread_pool_deque_struct *) task->deque;
+    thread_pool_task_struct * t;
+    int claimed, done;
+
+    if (Q == NULL)
+    {
+        FLINT_ASSERT(task->state == THREAD_POOL_TASK_DONE);
+        return;
+    }
+
+    /* the task is queued exactly when it is still in Q */
+    pthread_mutex_lock(&Q->mutex);
+    claimed = _thread_pool_deque_remove(Q, task);
+    pthread_mutex_unlock(&Q->mutex);
+
+    if (claimed)
+    {
+        /* no other thread can see the task any more */
+        task->fxn(task->fxnarg);
+        task->state = THREAD_POOL_TASK_DONE;
+        return;
+    }
+
+    while (1)
+    {
+        pthread_mutex_lock(&T->task_mutex);
+        done = (task->state == THREAD_POOL_TASK_DONE);
+        pthread_mutex_unlock(&T->task_mutex);
+
+        if (done)
+            break;
+
+        t = _thread_pool_find_task(T);
+        if (t != NULL)
+        {
+            _thread_pool_run_task(T, t);
+            continue;
+        }
+
+        pthread_mutex_lock(&T->task_mutex);
+        if (task->state != THREAD_POOL_TASK_DONE)
+            pthread_cond_wait(&T->task_done, &T->task_mutex);
+        pthread_mutex_unlock(&T->task_mutex);
+    }
+#else
+    FLINT_ASSERT(task->state == THREAD_POOL_TASK_DONE);
+#endif
+}
@@ -19,6 +19,9 @@ int thread_pool_set_size(thread_pool_t T, slong new_size)
 
     new_size = FLINT_MAX(new_size, WORD(0));
 
+    /* threads lent to the scheduler are about to become available */
+    _thread_pool_wait_stealers(T);
+
 #if FLINT_USES_PTHREAD
     pthread_mutex_lock(&T->mutex);
 #endif
@@ -52,6 +55,7 @@ int thread_pool_set_size(thread_pool_t T, slong new_size)
         pthread_cond_destroy(&D[i].sleep1);
         pthread_mutex_destroy(&D[i].mutex);
 #endif
+        _thread_pool_deque_clear(&D[i].deque);
     }
     if (D != NULL)
     {
@@ -78,7 +82,10 @@ int thread_pool_set_size(thread_pool_t T, slong new_size)
             D[i].fxn = NULL;
             D[i].fxnarg = NULL;
             D[i].working = -1;
+            D[i].max_workers = 0;
             D[i].exit = 0;
+            D[i].stealing = 0;
+            _thread_pool_deque_init(&D[i].deque);
 #if FLINT_USES_PTHREAD
             pthread_mutex_lock(&D[i].mutex);
             pthread_create(&D[i].pth, NULL, thread_pool_idle_loop, &D[i]);
@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+/* hand an idle thread of T over to the scheduler so that it steals work */
+static void _thread_pool_wake_stealer(thread_pool_t T)
+{
+    slong i, found = -1;
+    thread_pool_entry_struct * D;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&T->mutex);
+#endif
+    D = T->tdata;
+
+    for (i = 0; i < T->length; i++)
+    {
+        if (D[i].available == 1)
+        {
+            D[i].available = 0;
+            /* stealing is read by _thread_pool_wait_stealers */
+#if FLINT_USES_PTHREAD
+            pthread_mutex_lock(&D[i].mutex);
+#endif
+            D[i].stealing = 1;
+#if FLINT_USES_PTHREAD
+            pthread_mutex_unlock(&D[i].mutex);
+#endif
+            found = i;
+            break;
+        }
+    }
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&T->mutex);
+#endif
+
+    if (found >= 0)
+        thread_pool_wake(T, found, 0, _thread_pool_steal_loop, T);
+}
+
+void thread_pool_spawn(thread_pool_t T, thread_pool_task_t task,
+                                                    void (*f)(void*), void * a)
+{
+    task->fxn = f;
+    task->fxnarg = a;
+    task->num_workers = flint_get_num_threads() - 1;
+    task->deque = NULL;
+    task->state = THREAD_POOL_TASK_QUEUED;
+
+#if FLINT_USES_PTHREAD
+    if (T->length > 0)
+    {
+        thread_pool_entry_struct * self = _thread_pool_current_entry;
+        thread_pool_deque_struct * Q;
+
+        if (self != NULL && self->idx < T->length && T->tdata + self->idx == self)
+            Q = &self->deque;
+        else
+            Q = &T->deque;
+
+        pthread_mutex_lock(&Q->mutex);
+        _thread_pool_deque_push(Q, task);
+        pthread_mutex_unlock(&Q->mutex);
+
+        _thread_pool_wake_stealer(T);
+
+        return;
+    }
+#endif
+
+    /* nobody could steal it: run it right away */
+    task->state = THREAD_POOL_TASK_RUNNING;
+    f(a);
+    task->state = THREAD_POOL_TASK_DONE;
+}
@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+
+/*
+    Claim a task for the calling thread: first the newest task of its own
+    deque, then the oldest task of any other deque of T.
+*/
+thread_pool_task_struct * _thread_pool_find_task(thread_pool_t T)
+{
+#if FLINT_USES_PTHREAD
+    thread_pool_entry_struct * self = _thread_pool_current_entry;
+    thread_pool_task_struct * task;
+    thread_pool_deque_struct * Q;
+    slong i, j, n = T->length;
+
+    if (self != NULL && self->idx < n && T->tdata + self->idx == self)
+    {
+        j = self->idx;
+        Q = &self->deque;
+    }
+    else
+    {
+        j = n;
+        Q = &T->deque;
+    }
+
+    pthread_mutex_lock(&Q->mutex);
+    task = _thread_pool_deque_pop(Q);
+    pthread_mutex_unlock(&Q->mutex);
+
+    if (task != NULL)
+        return task;
+
+    /* deque number n is the one shared by threads outside of the pool */
+    for (i = 1; i <= n; i++)
+    {
+        j = (j == n) ? 0 : j + 1;
+        Q = (j == n) ? &T->deque : &T->tdata[j].deque;
+
+        pthread_mutex_lock(&Q->mutex);
+        task = _thread_pool_deque_steal(Q);
+        pthread_mutex_unlock(&Q->mutex);
+
+        if (task != NULL)
+            return task;
+    }
+#endif
+
+    return NULL;
+}
+
+/* run a claimed task and wake up anyone waiting for it */
+void _thread_pool_run_task(thread_pool_t T, thread_pool_task_struct * task)
+{
+    int num_workers = flint_get_num_threads() - 1;
+
+    FLINT_ASSERT(task->state == THREAD_POOL_TASK_RUNNING);
+
+    _flint_set_num_workers(task->num_workers);
+    task->fxn(task->fxnarg);
+    _flint_set_num_workers(num_workers);
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&T->task_mutex);
+#endif
+    task->state = THREAD_POOL_TASK_DONE;
+#if FLINT_USES_PTHREAD
+    pthread_cond_broadcast(&T->task_done);
+    pthread_mutex_unlock(&T->task_mutex);
+#endif
+}
+
+/*
+    Work done by a pool thread that was handed over to the scheduler by
+    thread_pool_spawn. The thread returns to the available state once it
+    finds nothing more to steal; see thread_pool_idle_loop.
+*/
+void _thread_pool_steal_loop(void * varg)
+{
+    thread_pool_struct * T = (thread_pool_struct *) varg;
+    thread_pool_task_struct * task;
+
+    while ((task = _thread_pool_find_task(T)) != NULL)
+        _thread_pool_run_task(T, task);
+}
+
+/* wait until no thread of T is still looking for tasks to steal */
+void _thread_pool_wait_stealers(thread_pool_t T)
+{
+#if FLINT_USES_PTHREAD
+    slong i;
+    thread_pool_entry_struct * D = T->tdata;
+
+    for (i = 0; i < T->length; i++)
+    {
+        pthread_mutex_lock(&D[i].mutex);
+        while (D[i].stealing != 0)
+            pthread_cond_wait(&D[i].sleep2, &D[i].mutex);
+        pthread_mutex_unlock(&D[i].mutex);
+    }
+#endif
+}
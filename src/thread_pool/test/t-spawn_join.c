@@ -0,0 +1,158 @@
+/*
+    Copyright (C) 2023 The FLINT authors
+
+    This file is part of FLINT.
+
+    FLINT is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <https://www.gnu.org/licenses/>.
+*/
+
+#include "thread_pool.h"
+#include "thread_support.h"
+#include "ulong_extras.h"
+#include "fmpz.h"
+
+/* set x = product of numbers in (min, max] with recursive fork/join */
+
+typedef struct
+{
+    ulong min;
+    ulong max;
+    fmpz_t ans;
+}
+prod_arg_struct;
+
+void prod_helper(fmpz_t x, ulong min, ulong max);
+
+void prod_worker(void * varg)
+{
+    prod_arg_struct * arg = (prod_arg_struct *) varg;
+
+    prod_helper(arg->ans, arg->min, arg->max);
+}
+
+void prod_helper(fmpz_t x, ulong min, ulong max)
+{
+    ulong i, mid;
+
+    if (max - min > UWORD(20))
+    {
+        thread_pool_task_t task;
+        prod_arg_struct arg[1];
+
+        mid = min + ((max - min)/UWORD(2));
+
+        arg->min = min;
+        arg->max = mid;
+        fmpz_init(arg->ans);
+        thread_pool_spawn(global_thread_pool, task, prod_worker, arg);
+
+        prod_helper(x, mid, max);
+
+        thread_pool_join(global_thread_pool, task);
+        fmpz_mul(x, x, arg->ans);
+        fmpz_clear(arg->ans);
+    }
+    else
+    {
+        fmpz_one(x);
+        for (i = max; i > min; i--)
+            fmpz_mul_ui(x, x, i);
+    }
+}
+
+/* tasks that themselves call flint_parallel_do */
+
+typedef struct
+{
+    ulong * res;
+    ulong n;
+}
+nested_arg_struct;
+
+void nested_inner(slong i, void * varg)
+{
+    nested_arg_struct * arg = (nested_arg_struct *) varg;
+
+    arg->res[i] = n_pow(i, 3) + arg->n;
+}
+
+void nested_outer(slong i, void * varg)
+{
+    nested_arg_struct * arg = (nested_arg_struct *) varg;
+    nested_arg_struct inner;
+
+    inner.res = arg->res + i*arg->n;
+    inner.n = i;
+    flint_parallel_do(nested_inner, &inner, arg->n, 0, FLINT_PARALLEL_DYNAMIC);
+}
+
+int
+main(void)
+{
+    slong i, j, k;
+    FLINT_TEST_INIT(state);
+
+    flint_printf("spawn_join....");
+    fflush(stdout);
+
+    for (i = 0; i < 10*flint_test_multiplier(); i++)
+    {
+        fmpz_t x, y;
+        nested_arg_struct arg;
+        ulong n;
+
+        fmpz_init(x);
+        fmpz_init(y);
+        flint_set_num_threads(n_randint(state, 10) + 1);
+
+        for (j = 0; j < 10; j++)
+        {
+            n = n_randint(state, 1000);
+
+            fmpz_fac_ui(y, n);
+            prod_helper(x, 0, n);
+
+            if (!fmpz_equal(x, y))
+            {
+                flint_printf("FAIL (product)\n");
+                flint_printf("n: %wu\n", n);
+                printf("x: "); fmpz_print(x); printf("\n");
+                printf("y: "); fmpz_print(y); printf("\n");
+                fflush(stdout);
+                flint_abort();
+            }
+        }
+
+        n = n_randint(state, 50);
+        arg.n = n;
+        arg.res = flint_malloc(n*n*sizeof(ulong));
+
+        flint_parallel_do(nested_outer, &arg, n, 0, FLINT_PARALLEL_UNIFORM);
+
+        for (j = 0; j < n; j++)
+        {
+            for (k = 0; k < n; k++)
+            {
+                if (arg.res[j*n + k] != n_pow(k, 3) + j)
+                {
+                    flint_printf("FAIL (nested)\n");
+                    flint_printf("n: %wu, j: %wd, k: %wd\n", n, j, k);
+                    fflush(stdout);
+                    flint_abort();
+                }
+            }
+        }
+
+        flint_free(arg.res);
+        fmpz_clear(y);
+        fmpz_clear(x);
+    }
+
+    FLINT_TEST_CLEANUP(state);
+
+    flint_printf("PASS\n");
+    return 0;
+}
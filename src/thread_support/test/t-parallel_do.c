@@ -39,8 +39,9 @@ main(void)
     {
         int * resx;
         int * resy;
+        int * resz;
         slong i, n;
-        f_param_t workx, worky;
+        f_param_t workx, worky, workz;
 
         n = n_randint(state, 1000);
 
@@ -48,16 +49,19 @@ main(void)
 
         resx = flint_malloc(n * sizeof(int));
         resy = flint_malloc(n * sizeof(int));
+        resz = flint_malloc(n * sizeof(int));
 
         workx.res = resx;
         worky.res = resy;
+        workz.res = resz;
 
         flint_parallel_do(f, &workx, n, n_randint(state, 5), FLINT_PARALLEL_UNIFORM);
         flint_parallel_do(f, &worky, n, n_randint(state, 5), FLINT_PARALLEL_STRIDED);
+        flint_parallel_do(f, &workz, n, n_randint(state, 5), FLINT_PARALLEL_DYNAMIC);
 
         for (i = 0; i < n; i++)
         {
-            if (resx[i] != resy[i] || resx[i] != i * i)
+            if (resx[i] != resy[i] || resx[i] != resz[i] || resx[i] != i * i)
             {
                 flint_printf("FAIL\n");
                 flint_printf("num_threads = %wd, i = %wd/%wd\n", flint_get_num_threads(), i, n);
@@ -67,6 +71,7 @@ main(void)
 
         flint_free(resx);
         flint_free(resy);
+        flint_free(resz);
     }
 
     FLINT_TEST_CLEANUP(state);
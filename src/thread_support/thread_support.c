@@ -125,6 +125,18 @@ void flint_give_back_threads(thread_pool_handle * handles, slong num_handles)
         flint_free(handles);
 }
 
+/* number of tasks a dynamic region may still spawn; bounding the number
+   of outstanding tasks by thread_limit - 1 bounds the number of threads
+   working on the region by thread_limit */
+typedef struct
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_t mutex;
+#endif
+    slong available;
+}
+dynamic_slots_t;
+
 typedef struct
 {
     do_func_t f;
@@ -132,6 +144,8 @@ typedef struct
     slong a;
     slong b;
     slong step;
+    slong grain;
+    dynamic_slots_t * slots;
 }
 work_chunk_t;
 
@@ -145,6 +159,73 @@ worker(void * _work)
         work.f(i, work.args);
 }
 
+static int
+dynamic_take_slot(dynamic_slots_t * slots)
+{
+    int ok;
+
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&slots->mutex);
+#endif
+    ok = (slots->available > 0);
+    slots->available -= ok;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&slots->mutex);
+#endif
+
+    return ok;
+}
+
+static void
+dynamic_give_back_slot(dynamic_slots_t * slots)
+{
+#if FLINT_USES_PTHREAD
+    pthread_mutex_lock(&slots->mutex);
+#endif
+    slots->available++;
+#if FLINT_USES_PTHREAD
+    pthread_mutex_unlock(&slots->mutex);
+#endif
+}
+
+/* dynamic scheduling: split the range in halves until it is below grain
+   and let idle threads steal the upper halves; when all slots are taken
+   the halves are done by the calling thread */
+static void
+dynamic_worker(void * _work)
+{
+    work_chunk_t * work = (work_chunk_t *) _work;
+
+    if (work->b - work->a <= work->grain)
+    {
+        worker(work);
+    }
+    else
+    {
+        work_chunk_t left, right;
+        thread_pool_task_t task;
+        slong m = work->a + (work->b - work->a) / 2;
+
+        left = right = *work;
+        left.b = m;
+        right.a = m;
+
+        if (dynamic_take_slot(work->slots))
+        {
+            thread_pool_spawn(global_thread_pool, task, dynamic_worker, &right);
+            dynamic_worker(&left);
+            thread_pool_join(global_thread_pool, task);
+
+            dynamic_give_back_slot(work->slots);
+        }
+        else
+        {
+            dynamic_worker(&left);
+            dynamic_worker(&right);
+        }
+    }
+}
+
 void flint_parallel_do(do_func_t f, void * args, slong n, int thread_limit, int flags)
 {
     slong i;
@@ -152,84 +233,100 @@ void flint_parallel_do(do_func_t f, void * args, slong n, int thread_limit, int
     if (thread_limit <= 0)
         thread_limit = flint_get_num_threads();
 
+    thread_limit = FLINT_MIN(thread_limit, flint_get_num_threads());
     thread_limit = FLINT_MIN(thread_limit, n);
 
-    if (thread_limit <= 1)
+    if (thread_limit <= 1 || !global_thread_pool_initialized)
     {
         for (i = 0; i < n; i++)
             f(i, args);
     }
     else
     {
-        slong i, num_threads, num_workers;
-        thread_pool_handle * handles;
-
-        num_workers = flint_request_threads(&handles, thread_limit);
-        num_threads = num_workers + 1;
+        slong num_threads = thread_limit;
+        work_chunk_t * work;
+        thread_pool_task_struct * tasks;
+        slong chunk_size;
+        TMP_INIT;
+        TMP_START;
 
         if (flags & FLINT_PARALLEL_VERBOSE)
             flint_printf("parallel_do with num_threads = %wd\n", num_threads);
 
-        if (num_workers < 1)
+        if (flags & FLINT_PARALLEL_DYNAMIC)
         {
-            flint_give_back_threads(handles, num_workers);
+            work_chunk_t all;
+            dynamic_slots_t slots;
 
-            for (i = 0; i < n; i++)
-                f(i, args);
+#if FLINT_USES_PTHREAD
+            pthread_mutex_init(&slots.mutex, NULL);
+#endif
+            slots.available = num_threads - 1;
+
+            all.f = f;
+            all.args = args;
+            all.a = 0;
+            all.b = n;
+            all.step = 1;
+            all.grain = FLINT_MAX(1, n / (8 * num_threads));
+            all.slots = &slots;
+
+            dynamic_worker(&all);
+
+#if FLINT_USES_PTHREAD
+            pthread_mutex_destroy(&slots.mutex);
+#endif
+            TMP_END;
+            return;
         }
-        else
-        {
-            work_chunk_t * work;
-            slong chunk_size;
-            TMP_INIT;
-            TMP_START;
 
-            work = TMP_ALLOC(num_threads * sizeof(work_chunk_t));
+        work = TMP_ALLOC(num_threads * sizeof(work_chunk_t));
+        tasks = TMP_ALLOC(num_threads * sizeof(thread_pool_task_struct));
 
-            if (flags & FLINT_PARALLEL_STRIDED)
+        if (flags & FLINT_PARALLEL_STRIDED)
+        {
+            for (i = 0; i < num_threads; i++)
             {
-                for (i = 0; i < num_threads; i++)
-                {
-                    work[i].f = f;
-                    work[i].args = args;
-                    work[i].a = i;
-                    work[i].b = n;
-                    work[i].step = num_threads;
-                }
+                work[i].f = f;
+                work[i].args = args;
+                work[i].a = i;
+                work[i].b = n;
+                work[i].step = num_threads;
             }
-            else
+        }
+        else
+        {
+            chunk_size = (n + num_threads - 1) / num_threads;
+
+            for (i = 0; i < num_threads; i++)
             {
-                chunk_size = (n + num_threads - 1) / num_threads;
-
-                for (i = 0; i < num_threads; i++)
-                {
-                    work[i].f = f;
-                    work[i].args = args;
-                    work[i].a = i * chunk_size;
-                    work[i].b = FLINT_MIN((i + 1) * chunk_size, n);
-                    work[i].step = 1;
-                }
+                work[i].f = f;
+                work[i].args = args;
+                work[i].a = i * chunk_size;
+                work[i].b = FLINT_MIN((i + 1) * chunk_size, n);
+                work[i].step = 1;
             }
+        }
 
-            if (flags & FLINT_PARALLEL_VERBOSE)
+        if (flags & FLINT_PARALLEL_VERBOSE)
+        {
+            for (i = 0; i < num_threads; i++)
             {
-                for (i = 0; i < num_threads; i++)
-                {
-                    flint_printf("thread #%wd allocated a = %wd, b = %wd, step = %wd\n", i, work[i].a, work[i].b, work[i].step);
-                }
+                flint_printf("thread #%wd allocated a = %wd, b = %wd, step = %wd\n", i, work[i].a, work[i].b, work[i].step);
             }
+        }
 
-            for (i = 0; i < num_workers; i++)
-                thread_pool_wake(global_thread_pool, handles[i], 0, worker, &work[i]);
+        /* chunk 0 is done by the calling thread, the rest are stolen
+           by whichever threads are idle */
+        for (i = 1; i < num_threads; i++)
+            thread_pool_spawn(global_thread_pool, tasks + i, worker, &work[i]);
 
-            worker(&work[num_workers]);
+        worker(&work[0]);
 
-            for (i = 0; i < num_workers; i++)
-                thread_pool_wait(global_thread_pool, handles[i]);
+        for (i = num_threads - 1; i >= 1; i--)
+            thread_pool_join(global_thread_pool, tasks + i);
 
-            flint_give_back_threads(handles, num_workers);
-            TMP_END;
-        }
+        TMP_END;
     }
 }
 
@@ -272,10 +369,7 @@ flint_parallel_binary_splitting(void * res, bsplit_basecase_func_t basecase, bsp
     {
         void * left, * right;
         slong m = a + (b - a) / 2;
-        slong nw;
-        slong nw_save;
         slong nt;
-        thread_pool_handle * threads;
         TMP_INIT;
 
         TMP_START;
@@ -299,22 +393,19 @@ flint_parallel_binary_splitting(void * res, bsplit_basecase_func_t basecase, bsp
         if (thread_limit <= 0)
             thread_limit = flint_get_num_threads();
 
-        nt = thread_limit;
-        nw = flint_request_threads(&threads, FLINT_MIN(nt, 2)); /* request one extra worker */
+        nt = FLINT_MIN(thread_limit, flint_get_num_threads());
 
-        if (nw == 0)
+        if (nt <= 1 || !global_thread_pool_initialized)
         {
-            flint_parallel_binary_splitting(left, basecase, merge, sizeof_res, init, clear, args, a, m, basecase_cutoff, thread_limit, flags);
-            flint_parallel_binary_splitting(right, basecase, merge, sizeof_res, init, clear, args, m, b, basecase_cutoff, thread_limit, flags);
+            flint_parallel_binary_splitting(left, basecase, merge, sizeof_res, init, clear, args, a, m, basecase_cutoff, 1, flags);
+            flint_parallel_binary_splitting(right, basecase, merge, sizeof_res, init, clear, args, m, b, basecase_cutoff, 1, flags);
         }
         else
         {
             flint_parallel_binary_splitting_t right_args;
+            thread_pool_task_t task;
 
-            FLINT_ASSERT(nt >= 2);
-
-            nw_save = flint_set_num_workers(nt - nt / 2 - 1);
-
+            /* the right half gets nt / 2 threads, the left half the rest */
             right_args.res = right;
             right_args.basecase = basecase;
             right_args.merge = merge;
@@ -325,19 +416,16 @@ flint_parallel_binary_splitting(void * res, bsplit_basecase_func_t basecase, bsp
             right_args.a = m;
             right_args.b = b;
             right_args.basecase_cutoff = basecase_cutoff;
-            right_args.thread_limit = thread_limit;
+            right_args.thread_limit = nt / 2;
             right_args.flags = flags;
 
-            thread_pool_wake(global_thread_pool, threads[0], nt / 2 - 1, _bsplit_worker, &right_args);
+            thread_pool_spawn(global_thread_pool, task, _bsplit_worker, &right_args);
 
-            flint_parallel_binary_splitting(left, basecase, merge, sizeof_res, init, clear, args, a, m, basecase_cutoff, thread_limit, flags);
+            flint_parallel_binary_splitting(left, basecase, merge, sizeof_res, init, clear, args, a, m, basecase_cutoff, nt - nt / 2, flags);
 
-            flint_reset_num_workers(nw_save);
-            thread_pool_wait(global_thread_pool, threads[0]);
+            thread_pool_join(global_thread_pool, task);
         }
 
-        flint_give_back_threads(threads, nw);
-
         merge(res, left, right, args);
 
         if (flags & FLINT_PARALLEL_BSPLIT_LEFT_INPLACE)